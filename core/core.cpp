@@ -19,6 +19,7 @@ const ObjectLocalId ObjectLocalId::NONE = ObjectLocalId{ { std::numeric_limits<u
 const ObjectNetId ObjectNetId::NONE = ObjectNetId{ { std::numeric_limits<std::uint16_t>::max() } };
 const ObjectHandle ObjectHandle::NONE = ObjectHandle{ { 0 } };
 const SchemeId SchemeId::DEFAULT = SchemeId{ { 0 } };
+const RewindIslandId RewindIslandId::NONE = RewindIslandId{ { std::numeric_limits<std::uint32_t>::max() } };
 
 static const char *ProcessPhaseName[PROCESS_PHASE_COUNT] = {
 	"EARLY PROCESS",
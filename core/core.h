@@ -206,6 +206,87 @@ struct SchemeId : public IdMaker<SchemeId, std::uint8_t> {
 	static const SchemeId DEFAULT;
 };
 
+struct RewindIslandId : public IdMaker<RewindIslandId, std::uint32_t> {
+	/// The objects without an island are always rewound with the whole scene.
+	static const RewindIslandId NONE;
+};
+
+/// Counts the bits networked for an object, a variable or a SyncGroup.
+/// The bits are also accumulated per time window, so the rate can be
+/// computed on the last completed window rather than on the whole session.
+struct BandwidthStats {
+	std::uint64_t bits_sent = 0;
+	std::uint64_t times_sent = 0;
+	std::uint64_t full_snapshot_times_sent = 0;
+	std::uint64_t delta_snapshot_times_sent = 0;
+
+	std::uint32_t window_index = 0;
+	std::uint64_t window_bits = 0;
+	std::uint64_t previous_window_bits = 0;
+
+	void add(std::uint64_t p_bits, bool p_full_snapshot, std::uint32_t p_window_index, std::uint32_t p_recipients_count = 1) {
+		if (p_window_index != window_index) {
+			previous_window_bits = p_window_index == window_index + 1 ? window_bits : 0;
+			window_bits = 0;
+			window_index = p_window_index;
+		}
+
+		bits_sent += p_bits * p_recipients_count;
+		window_bits += p_bits * p_recipients_count;
+		times_sent += p_recipients_count;
+		if (p_full_snapshot) {
+			full_snapshot_times_sent += p_recipients_count;
+		} else {
+			delta_snapshot_times_sent += p_recipients_count;
+		}
+	}
+
+	/// Returns the bits sent during the window preceding `p_window_index`.
+	std::uint64_t get_completed_window_bits(std::uint32_t p_window_index) const {
+		if (p_window_index == window_index) {
+			return previous_window_bits;
+		} else if (p_window_index == window_index + 1) {
+			return window_bits;
+		} else {
+			return 0;
+		}
+	}
+};
+
+/// The bandwidth used by an object, a variable or a SyncGroup.
+struct BandwidthReport {
+	std::uint64_t bits_sent = 0;
+	std::uint64_t times_sent = 0;
+	std::uint64_t full_snapshot_times_sent = 0;
+	std::uint64_t delta_snapshot_times_sent = 0;
+	/// The rate averaged over the last completed window.
+	float bits_per_second = 0.0f;
+};
+
+/// The memory used by the client to store the prediction history.
+struct PredictionMemoryReport {
+	/// The estimated memory (bytes) used by the client snapshots, the dolls
+	/// snapshots and the pending snapshots.
+	std::uint64_t memory_usage_bytes = 0;
+	/// The estimated memory (bytes) used by a single predicted frame.
+	std::uint64_t frame_memory_bytes = 0;
+	/// The predicted frames fitting the budget.
+	std::uint32_t max_predicted_frames = 0;
+	/// The processes on which the client was over budget and degraded.
+	std::uint64_t degradations_count = 0;
+	/// The processes on which the prediction was paused, as the predicted
+	/// frames didn't fit the budget.
+	std::uint64_t paused_frames_count = 0;
+	/// The times the prediction got paused, each pause lasting one or more
+	/// processes.
+	std::uint64_t pauses_count = 0;
+	/// The doll snapshots dropped to stay within the budget.
+	std::uint64_t dropped_doll_snapshots_count = 0;
+	/// The full snapshots requested to drop the pending snapshots, counting
+	/// only the requests sent to the server.
+	std::uint64_t full_snapshot_requests_count = 0;
+};
+
 enum class ScheduledProcedurePhase : std::uint8_t {
 	/// The procedure is called with in this phase only on the server when collecting the arguments.
 	COLLECTING_ARGUMENTS = 0,
@@ -16,12 +16,12 @@
 
 #ifdef DEBUG_DATA_BUFFER
 #define DEB_WRITE(dt, compression, input)                                                             \
-	if (debug_enabled) {                                                                              \
+	if (debug_enabled && get_debugger().get_dump_enabled()) {                                         \
 		get_debugger().databuffer_write(dt, compression, bit_offset, std::string(input).c_str()); \
 	}
 
 #define DEB_READ(dt, compression, input)                                                             \
-	if (debug_enabled) {                                                                             \
+	if (debug_enabled && get_debugger().get_dump_enabled()) {                                        \
 		get_debugger().databuffer_read(dt, compression, bit_offset, std::string(input).c_str()); \
 	}
 
@@ -34,8 +34,15 @@
 #define DEB_ENABLE debug_enabled = was_debug_enabled;
 
 #else
-#define DEB_WRITE(dt, compression, input) (void)(input);
-#define DEB_READ(dt, compression, input) (void)(input);
+// The input is never evaluated, so the debug strings are not built.
+#define DEB_WRITE(dt, compression, input) \
+	if (false) {                          \
+		(void)(input);                    \
+	}
+#define DEB_READ(dt, compression, input) \
+	if (false) {                         \
+		(void)(input);                   \
+	}
 #define DEB_DISABLE
 #define DEB_ENABLE
 #endif
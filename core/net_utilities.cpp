@@ -6,6 +6,7 @@
 #include "peer_networked_controller.h"
 #include "quick_sort.h"
 #include "scene_synchronizer_debugger.h"
+#include <algorithm>
 
 NS::SceneSynchronizerDebugger &NS::SyncGroup::get_debugger() const {
 	return scene_sync->get_debugger();
@@ -17,9 +18,22 @@ void NS::SyncGroup::advance_timer_state_notifier(
 		const int p_max_objects_count_per_partial_update,
 		bool &r_send_update,
 		std::vector<std::size_t> &r_partial_update_simulated_objects_info_indices) {
+	if (adaptive_notify_enabled) {
+		// Update the activity using the changes happened since the last frame,
+		// smoothed over the last second.
+		const float frame_changes_per_second = p_delta > 0.0f ? float(pending_changes_count) / p_delta : 0.0f;
+		const float smoothing = std::min(p_delta, 1.0f);
+		activity += (frame_changes_per_second - activity) * smoothing;
+
+		// The more active and important the group is, the more often it's notified.
+		const float level = std::clamp((activity * importance) / saturation_changes_per_second, 0.0f, 1.0f);
+		notify_timespan = max_notify_timespan + ((min_notify_timespan - max_notify_timespan) * level);
+	}
+	pending_changes_count = 0;
+
 	// Notify the state if needed
 	state_notifier_timer += p_delta;
-	r_send_update = state_notifier_timer >= p_frame_confirmation_timespan;
+	r_send_update = state_notifier_timer >= get_notify_timespan(p_frame_confirmation_timespan);
 	if (r_send_update) {
 		state_notifier_timer = 0.0;
 
@@ -63,6 +77,26 @@ void NS::SyncGroup::force_state_notify() {
 	state_notifier_timer = std::numeric_limits<float>::max() - 100.0f;
 }
 
+void NS::SyncGroup::set_adaptive_notify_timespan(bool p_enabled, float p_min_timespan, float p_max_timespan, float p_saturation_changes_per_second) {
+	NS_ENSURE_MSG(p_min_timespan >= 0.0f && p_min_timespan <= p_max_timespan, "The adaptive notify timespan expects `0 <= min_timespan <= max_timespan`.");
+	NS_ENSURE_MSG(p_saturation_changes_per_second > 0.0f, "The `saturation_changes_per_second` must be greater than 0.");
+	adaptive_notify_enabled = p_enabled;
+	min_notify_timespan = p_min_timespan;
+	max_notify_timespan = p_max_timespan;
+	saturation_changes_per_second = p_saturation_changes_per_second;
+	// Start from the lowest rate, the activity will speed it up.
+	notify_timespan = max_notify_timespan;
+	activity = 0.0f;
+}
+
+void NS::SyncGroup::set_importance(float p_importance) {
+	importance = std::max(p_importance, 0.0f);
+}
+
+float NS::SyncGroup::get_notify_timespan(float p_frame_confirmation_timespan) const {
+	return adaptive_notify_enabled ? notify_timespan : p_frame_confirmation_timespan;
+}
+
 bool NS::SyncGroup::is_realtime_node_list_changed() const {
 	return simulated_sync_objects_ADDED.size() > 0 || simulated_sync_objects_REMOVED.size() > 0;
 }
@@ -94,6 +128,7 @@ void NS::SyncGroup::mark_changes_as_notified(bool p_is_partial_update, const std
 
 		for (const std::size_t index : p_partial_update_simulated_objects_info_indices) {
 			simulated_sync_objects[index].change.unknown = false;
+			simulated_sync_objects[index].change.state_hash_mismatched = false;
 			simulated_sync_objects[index].change.vars.clear();
 			simulated_sync_objects[index].change.changed_scheduled_procedures.clear();
 		}
@@ -104,6 +139,7 @@ void NS::SyncGroup::mark_changes_as_notified(bool p_is_partial_update, const std
 		// Mark all the simulated objects as updated
 		for (auto &sso : simulated_sync_objects) {
 			sso.change.unknown = false;
+			sso.change.state_hash_mismatched = false;
 			sso.change.vars.clear();
 			sso.change.changed_scheduled_procedures.clear();
 		}
@@ -340,9 +376,33 @@ void NS::SyncGroup::notify_variable_changed(ObjectData *p_object_data, VarId p_v
 	const std::size_t index = find_simulated(*p_object_data);
 	if (index != VecFunc::index_none()) {
 		VecFunc::insert_unique(simulated_sync_objects[index].change.vars, p_var_id);
+		pending_changes_count += 1;
 	}
 }
 
+void NS::SyncGroup::notify_state_hash_mismatch(ObjectData *p_object_data) {
+	const std::size_t index = find_simulated(*p_object_data);
+	if (index != VecFunc::index_none()) {
+		simulated_sync_objects[index].change.state_hash_mismatched = true;
+		// Mark the hashed variables as changed, so the next snapshot networks them.
+		for (VarId::IdType v = 0; v < p_object_data->vars.size(); v++) {
+			if (p_object_data->vars[v].is_state_hashed()) {
+				VecFunc::insert_unique(simulated_sync_objects[index].change.vars, VarId{ v });
+				pending_changes_count += 1;
+			}
+		}
+	}
+}
+
+bool NS::SyncGroup::is_state_hash_mismatched() const {
+	for (const SimulatedObjectInfo &info : simulated_sync_objects) {
+		if (info.change.state_hash_mismatched) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void NS::SyncGroup::notify_scheduled_procedure_changed(ObjectData &p_object_data, ScheduledProcedureId p_scheduled_procedure_id) {
 	const std::size_t index = find_simulated(p_object_data);
 	if (index != VecFunc::index_none()) {
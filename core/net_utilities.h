@@ -296,17 +296,31 @@ struct PeerServerData {
 	// For new peers a full snapshot is needed.
 	bool need_full_snapshot = true;
 
+	// True while the full snapshot is being streamed to this peer.
+	bool full_snapshot_streaming = false;
+
+	// Indexed by ObjectNetId: true for the objects not yet delivered while the
+	// full snapshot is being streamed.
+	std::vector<bool> full_snapshot_pending_objects;
+
 	// How much time (seconds) from the latest latency update sent via snapshot.
 	float latency_update_via_snapshot_sec = 0.0;
 
 	// How much time (seconds) from the latest update sent to the client.
 	float netstats_peer_update_sec = 0.0;
+
+	// The dolls inputs to send to this peer at the end of the tick, check
+	// `ServerSynchronizer::process_dolls_inputs_forwarding()`.
+	std::vector<std::uint8_t> dolls_inputs_packet;
 };
 
 struct SyncGroup {
 public:
 	struct Change {
 		bool unknown = false;
+		/// The client prediction of this object mismatched the state hash, so
+		/// the group is networked by value until this change is notified.
+		bool state_hash_mismatched = false;
 		std::vector<VarId> vars;
 		bool controlling_peer_changed = false;
 		std::vector<ScheduledProcedureHandle> changed_scheduled_procedures;
@@ -399,9 +413,30 @@ private:
 
 	float state_notifier_timer = 0.0;
 
+	/// When enabled, the state notify timespan adapts between
+	/// `min_notify_timespan` and `max_notify_timespan` using the group activity
+	/// and importance; otherwise the `frame_confirmation_timespan` is used.
+	bool adaptive_notify_enabled = false;
+	float min_notify_timespan = 0.0f;
+	float max_notify_timespan = 1.0f;
+	/// The activity (changes per second) at which the `min_notify_timespan` is reached.
+	float saturation_changes_per_second = 60.0f;
+	/// The app assigned importance: it scales the group activity.
+	float importance = 1.0f;
+
+	/// The amount of variable changes since the last timer advance.
+	std::uint32_t pending_changes_count = 0;
+	/// The smoothed amount of variable changes per second.
+	float activity = 0.0f;
+	/// The notify timespan currently used by this group.
+	float notify_timespan = 1.0f;
+
 public:
 	uint64_t user_data = 0;
 
+	/// The bits sent by the snapshots of this group.
+	BandwidthStats bandwidth_stats;
+
 public:
 	class SceneSynchronizerDebugger &get_debugger() const;
 
@@ -414,6 +449,24 @@ public:
 
 	void force_state_notify();
 
+	void set_adaptive_notify_timespan(bool p_enabled, float p_min_timespan, float p_max_timespan, float p_saturation_changes_per_second);
+	bool is_adaptive_notify_timespan_enabled() const {
+		return adaptive_notify_enabled;
+	}
+
+	void set_importance(float p_importance);
+	float get_importance() const {
+		return importance;
+	}
+
+	/// Returns the smoothed amount of variable changes per second.
+	float get_activity() const {
+		return activity;
+	}
+
+	/// Returns the notify timespan in use, that is the adaptive one when enabled.
+	float get_notify_timespan(float p_frame_confirmation_timespan) const;
+
 	bool is_realtime_node_list_changed() const;
 
 	const std::vector<ObjectNetId> &get_simulated_sync_objects_ADDED() const {
@@ -458,6 +511,10 @@ public:
 
 	void notify_new_variable(struct ObjectData *p_object_data, VarId p_var_id);
 	void notify_variable_changed(struct ObjectData *p_object_data, VarId p_var_id);
+	void notify_state_hash_mismatch(struct ObjectData *p_object_data);
+	/// Returns true when the client prediction of any simulated object
+	/// mismatched, and the object was not notified yet.
+	bool is_state_hash_mismatched() const;
 
 	void notify_scheduled_procedure_changed(struct ObjectData &p_object_data, ScheduledProcedureId p_scheduled_procedure_id);
 
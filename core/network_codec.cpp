@@ -3,6 +3,8 @@
 #include "../scene_synchronizer.h"
 #include "data_buffer.h"
 #include "var_data.h"
+#include <algorithm>
+#include <limits>
 
 NS_NAMESPACE_BEGIN
 void encode_variable(bool val, DataBuffer &r_buffer) {
@@ -110,7 +112,300 @@ void encode_variable(const DataBuffer &val, DataBuffer &r_buffer) {
 }
 
 void decode_variable(DataBuffer &val, DataBuffer &p_buffer) {
+	// Rewinds the buffer, so a reused one keeps its memory.
+	val.begin_write(p_buffer.get_debugger(), 0);
 	p_buffer.read(val);
 }
 
+static const int OBJECT_NET_ID_SET_ENCODING_BITS = 2;
+static const int OBJECT_NET_ID_SET_WIDTH_BITS = 5;
+static const int OBJECT_NET_ID_BITS = int(sizeof(ObjectNetId::IdType)) * 8;
+
+static inline int ns_get_bits_needed(std::uint32_t p_value) {
+	int bits = 0;
+	while (p_value > 0) {
+		bits += 1;
+		p_value >>= 1;
+	}
+	return bits;
+}
+
+static inline void ns_add_packed_uint(DataBuffer &r_buffer, std::uint32_t p_value, int p_bits) {
+	if (p_bits <= 0) {
+		return;
+	}
+	const std::uint8_t bytes[4] = {
+		std::uint8_t(p_value & 0xFF),
+		std::uint8_t((p_value >> 8) & 0xFF),
+		std::uint8_t((p_value >> 16) & 0xFF),
+		std::uint8_t((p_value >> 24) & 0xFF)
+	};
+	r_buffer.add_bits(bytes, p_bits);
+}
+
+static inline std::uint32_t ns_read_packed_uint(DataBuffer &p_buffer, int p_bits) {
+	if (p_bits <= 0) {
+		return 0;
+	}
+	std::uint8_t bytes[4] = { 0, 0, 0, 0 };
+	p_buffer.read_bits(bytes, p_bits);
+	return std::uint32_t(bytes[0]) |
+			(std::uint32_t(bytes[1]) << 8) |
+			(std::uint32_t(bytes[2]) << 16) |
+			(std::uint32_t(bytes[3]) << 24);
+}
+
+int get_object_net_id_set_encoded_size(const std::vector<ObjectNetId> &p_sorted_ids, ObjectNetIdSetEncoding p_encoding) {
+	if (p_sorted_ids.empty()) {
+		// Just the `has_ids` flag.
+		return 1;
+	}
+
+	// The `has_ids` flag, the encoding and the ids count.
+	const int count_width = ns_get_bits_needed(std::uint32_t(p_sorted_ids.size() - 1));
+	const int header_size = 1 + OBJECT_NET_ID_SET_ENCODING_BITS + OBJECT_NET_ID_SET_WIDTH_BITS + count_width;
+
+	switch (p_encoding) {
+		case ObjectNetIdSetEncoding::SORTED_DELTA: {
+			std::uint32_t max_delta = 0;
+			for (std::size_t i = 1; i < p_sorted_ids.size(); i++) {
+				max_delta = std::max<std::uint32_t>(max_delta, p_sorted_ids[i].id - p_sorted_ids[i - 1].id - 1);
+			}
+			if (p_sorted_ids.size() == 1) {
+				// The single id doesn't need the delta width.
+				return header_size + OBJECT_NET_ID_BITS;
+			}
+			return header_size + OBJECT_NET_ID_BITS + OBJECT_NET_ID_SET_WIDTH_BITS + int(p_sorted_ids.size() - 1) * ns_get_bits_needed(max_delta);
+		}
+		case ObjectNetIdSetEncoding::BITSET: {
+			// The first and the last ids are stored explicitly.
+			const int span = p_sorted_ids.back().id - p_sorted_ids.front().id;
+			return header_size + (OBJECT_NET_ID_BITS * 2) + std::max(span - 1, 0);
+		}
+		case ObjectNetIdSetEncoding::RUN_LENGTH: {
+			int runs = 1;
+			std::uint32_t max_length = 0;
+			std::uint32_t max_gap = 0;
+			std::uint32_t run_start = p_sorted_ids[0].id;
+			for (std::size_t i = 1; i <= p_sorted_ids.size(); i++) {
+				if (i < p_sorted_ids.size() && p_sorted_ids[i].id == p_sorted_ids[i - 1].id + 1) {
+					continue;
+				}
+				max_length = std::max<std::uint32_t>(max_length, p_sorted_ids[i - 1].id - run_start);
+				if (i < p_sorted_ids.size()) {
+					max_gap = std::max<std::uint32_t>(max_gap, p_sorted_ids[i].id - p_sorted_ids[i - 1].id - 2);
+					run_start = p_sorted_ids[i].id;
+					runs += 1;
+				}
+			}
+			return header_size + OBJECT_NET_ID_BITS + (OBJECT_NET_ID_SET_WIDTH_BITS * 2) + (runs * ns_get_bits_needed(max_length)) + ((runs - 1) * ns_get_bits_needed(max_gap));
+		}
+	}
+
+	NS_ASSERT_NO_ENTRY();
+	return 0;
+}
+
+void encode_object_net_id_set(const std::vector<ObjectNetId> &p_ids, DataBuffer &r_buffer) {
+	std::vector<ObjectNetId> sorted_ids = p_ids;
+	std::sort(sorted_ids.begin(), sorted_ids.end());
+	sorted_ids.erase(std::unique(sorted_ids.begin(), sorted_ids.end()), sorted_ids.end());
+	NS_ASSERT_COND(sorted_ids.size() < std::numeric_limits<ObjectNetId::IdType>::max());
+	NS_ASSERT_COND(sorted_ids.empty() || sorted_ids.back() != ObjectNetId::NONE);
+
+	// Pick the cheapest encoding for this set.
+	ObjectNetIdSetEncoding encoding = ObjectNetIdSetEncoding::SORTED_DELTA;
+	int encoding_size = get_object_net_id_set_encoded_size(sorted_ids, encoding);
+	for (ObjectNetIdSetEncoding candidate : { ObjectNetIdSetEncoding::BITSET, ObjectNetIdSetEncoding::RUN_LENGTH }) {
+		const int candidate_size = get_object_net_id_set_encoded_size(sorted_ids, candidate);
+		if (candidate_size < encoding_size) {
+			encoding = candidate;
+			encoding_size = candidate_size;
+		}
+	}
+
+	// The empty set, which is the most common one, takes a single bit.
+	r_buffer.add(!sorted_ids.empty());
+	if (sorted_ids.empty()) {
+		return;
+	}
+
+	ns_add_packed_uint(r_buffer, std::uint32_t(encoding), OBJECT_NET_ID_SET_ENCODING_BITS);
+
+	// The count is never 0 at this point, so `count - 1` is stored using the bits it needs.
+	const std::uint32_t count_minus_one = std::uint32_t(sorted_ids.size() - 1);
+	const int count_width = ns_get_bits_needed(count_minus_one);
+	ns_add_packed_uint(r_buffer, count_width, OBJECT_NET_ID_SET_WIDTH_BITS);
+	ns_add_packed_uint(r_buffer, count_minus_one, count_width);
+
+	switch (encoding) {
+		case ObjectNetIdSetEncoding::SORTED_DELTA: {
+			std::uint32_t max_delta = 0;
+			for (std::size_t i = 1; i < sorted_ids.size(); i++) {
+				max_delta = std::max<std::uint32_t>(max_delta, sorted_ids[i].id - sorted_ids[i - 1].id - 1);
+			}
+			const int width = ns_get_bits_needed(max_delta);
+			r_buffer.add(sorted_ids[0].id);
+			if (sorted_ids.size() == 1) {
+				break;
+			}
+			ns_add_packed_uint(r_buffer, width, OBJECT_NET_ID_SET_WIDTH_BITS);
+			for (std::size_t i = 1; i < sorted_ids.size(); i++) {
+				ns_add_packed_uint(r_buffer, sorted_ids[i].id - sorted_ids[i - 1].id - 1, width);
+			}
+		} break;
+		case ObjectNetIdSetEncoding::BITSET: {
+			const ObjectNetId::IdType first = sorted_ids.front().id;
+			const ObjectNetId::IdType last = sorted_ids.back().id;
+			r_buffer.add(first);
+			r_buffer.add(last);
+			// One bit for each id in between the first and the last.
+			const int bit_count = std::max(int(last) - int(first) - 1, 0);
+			if (bit_count > 0) {
+				std::vector<std::uint8_t> bits((bit_count + 7) / 8, 0);
+				for (std::size_t i = 1; i + 1 < sorted_ids.size(); i++) {
+					const int bit = sorted_ids[i].id - first - 1;
+					bits[bit / 8] |= std::uint8_t(1 << (bit % 8));
+				}
+				r_buffer.add_bits(bits.data(), bit_count);
+			}
+		} break;
+		case ObjectNetIdSetEncoding::RUN_LENGTH: {
+			// Collect the runs as pairs of `start` and `length - 1`.
+			std::vector<std::pair<std::uint32_t, std::uint32_t>> runs;
+			std::uint32_t max_length = 0;
+			std::uint32_t max_gap = 0;
+			std::uint32_t run_start = sorted_ids[0].id;
+			for (std::size_t i = 1; i <= sorted_ids.size(); i++) {
+				if (i < sorted_ids.size() && sorted_ids[i].id == sorted_ids[i - 1].id + 1) {
+					continue;
+				}
+				runs.push_back({ run_start, sorted_ids[i - 1].id - run_start });
+				max_length = std::max(max_length, runs.back().second);
+				if (i < sorted_ids.size()) {
+					max_gap = std::max<std::uint32_t>(max_gap, sorted_ids[i].id - sorted_ids[i - 1].id - 2);
+					run_start = sorted_ids[i].id;
+				}
+			}
+			const int length_width = ns_get_bits_needed(max_length);
+			const int gap_width = ns_get_bits_needed(max_gap);
+			r_buffer.add(sorted_ids[0].id);
+			ns_add_packed_uint(r_buffer, length_width, OBJECT_NET_ID_SET_WIDTH_BITS);
+			ns_add_packed_uint(r_buffer, gap_width, OBJECT_NET_ID_SET_WIDTH_BITS);
+			for (std::size_t i = 0; i < runs.size(); i++) {
+				if (i > 0) {
+					const std::uint32_t previous_end = runs[i - 1].first + runs[i - 1].second;
+					ns_add_packed_uint(r_buffer, runs[i].first - previous_end - 2, gap_width);
+				}
+				ns_add_packed_uint(r_buffer, runs[i].second, length_width);
+			}
+		} break;
+	}
+}
+
+bool decode_object_net_id_set(std::vector<ObjectNetId> &r_ids, DataBuffer &p_buffer) {
+	bool has_ids = false;
+	p_buffer.read(has_ids);
+	if (p_buffer.is_buffer_failed()) {
+		return false;
+	}
+	if (!has_ids) {
+		return true;
+	}
+
+	const std::uint32_t encoding = ns_read_packed_uint(p_buffer, OBJECT_NET_ID_SET_ENCODING_BITS);
+	const int count_width = int(ns_read_packed_uint(p_buffer, OBJECT_NET_ID_SET_WIDTH_BITS));
+	if (p_buffer.is_buffer_failed() || count_width > OBJECT_NET_ID_BITS) {
+		return false;
+	}
+	const std::uint32_t count = ns_read_packed_uint(p_buffer, count_width) + 1;
+	if (p_buffer.is_buffer_failed() || count >= ObjectNetId::NONE.id) {
+		return false;
+	}
+
+	const std::size_t initial_size = r_ids.size();
+	r_ids.reserve(initial_size + count);
+
+	// The ids are always smaller than `ObjectNetId::NONE`.
+	const std::uint32_t max_id = ObjectNetId::NONE.id;
+
+	switch (ObjectNetIdSetEncoding(encoding)) {
+		case ObjectNetIdSetEncoding::SORTED_DELTA: {
+			ObjectNetId::IdType first;
+			p_buffer.read(first);
+			if (first >= max_id) {
+				return false;
+			}
+			std::uint32_t id = first;
+			r_ids.push_back(ObjectNetId{ { first } });
+			if (count == 1) {
+				break;
+			}
+			const int width = int(ns_read_packed_uint(p_buffer, OBJECT_NET_ID_SET_WIDTH_BITS));
+			if (width > OBJECT_NET_ID_BITS) {
+				return false;
+			}
+			for (std::uint32_t i = 1; i < count; i++) {
+				id += ns_read_packed_uint(p_buffer, width) + 1;
+				if (id >= max_id) {
+					return false;
+				}
+				r_ids.push_back(ObjectNetId{ { ObjectNetId::IdType(id) } });
+			}
+		} break;
+		case ObjectNetIdSetEncoding::BITSET: {
+			ObjectNetId::IdType first;
+			ObjectNetId::IdType last;
+			p_buffer.read(first);
+			p_buffer.read(last);
+			if (first > last || last >= max_id) {
+				return false;
+			}
+			r_ids.push_back(ObjectNetId{ { first } });
+			const int bit_count = std::max(int(last) - int(first) - 1, 0);
+			if (bit_count > 0) {
+				std::vector<std::uint8_t> bits((bit_count + 7) / 8, 0);
+				p_buffer.read_bits(bits.data(), bit_count);
+				for (int bit = 0; bit < bit_count; bit++) {
+					if (bits[bit / 8] & (1 << (bit % 8))) {
+						r_ids.push_back(ObjectNetId{ { ObjectNetId::IdType(first + bit + 1) } });
+					}
+				}
+			}
+			if (last != first) {
+				r_ids.push_back(ObjectNetId{ { last } });
+			}
+		} break;
+		case ObjectNetIdSetEncoding::RUN_LENGTH: {
+			ObjectNetId::IdType first;
+			p_buffer.read(first);
+			const int length_width = int(ns_read_packed_uint(p_buffer, OBJECT_NET_ID_SET_WIDTH_BITS));
+			const int gap_width = int(ns_read_packed_uint(p_buffer, OBJECT_NET_ID_SET_WIDTH_BITS));
+			if (length_width > OBJECT_NET_ID_BITS || gap_width > OBJECT_NET_ID_BITS) {
+				return false;
+			}
+			std::uint32_t run_start = first;
+			std::uint32_t previous_end = 0;
+			while (r_ids.size() - initial_size < count && !p_buffer.is_buffer_failed()) {
+				if (r_ids.size() > initial_size) {
+					run_start = previous_end + 2 + ns_read_packed_uint(p_buffer, gap_width);
+				}
+				const std::uint32_t run_end = run_start + ns_read_packed_uint(p_buffer, length_width);
+				if (run_end >= max_id || (run_end - run_start) >= (count - (r_ids.size() - initial_size))) {
+					// The run overflows the set.
+					return false;
+				}
+				for (std::uint32_t id = run_start; id <= run_end; id++) {
+					r_ids.push_back(ObjectNetId{ { ObjectNetId::IdType(id) } });
+				}
+				previous_end = run_end;
+			}
+		} break;
+		default:
+			return false;
+	}
+
+	return !p_buffer.is_buffer_failed() && (r_ids.size() - initial_size) == count;
+}
+
 NS_NAMESPACE_END
\ No newline at end of file
@@ -41,6 +41,28 @@ void decode_variable(std::vector<std::uint8_t> &val, DataBuffer &p_buffer);
 void encode_variable(const DataBuffer &val, DataBuffer &r_buffer);
 void decode_variable(DataBuffer &val, DataBuffer &p_buffer);
 
+/// The encodings available to network a set of `ObjectNetId`.
+enum class ObjectNetIdSetEncoding : std::uint8_t {
+	/// The sorted ids are stored as the distance from the previous id.
+	SORTED_DELTA = 0,
+	/// A bit is stored for each id between the smallest and the biggest one.
+	BITSET = 1,
+	/// The sorted ids are stored as runs of consecutive ids.
+	RUN_LENGTH = 2,
+};
+
+/// Returns the size in bits the sorted and unique `p_sorted_ids` take once
+/// encoded using `p_encoding`.
+int get_object_net_id_set_encoded_size(const std::vector<ObjectNetId> &p_sorted_ids, ObjectNetIdSetEncoding p_encoding);
+
+/// Encodes the set of ids using the cheapest encoding for this specific set.
+/// NOTE: The set order is not preserved: the ids are decoded sorted.
+void encode_object_net_id_set(const std::vector<ObjectNetId> &p_ids, DataBuffer &r_buffer);
+
+/// Decodes the set of ids encoded by `encode_object_net_id_set`, appending them
+/// to `r_ids`. Returns false if the buffer is corrupted.
+bool decode_object_net_id_set(std::vector<ObjectNetId> &r_ids, DataBuffer &p_buffer);
+
 template <int Index>
 void encode_variables(DataBuffer &r_buffer) {}
 
@@ -97,6 +97,12 @@ void NetworkInterface::rpc_receive(int p_sender_peer, DataBuffer &p_db) {
 	}
 }
 
+void NetworkInterface::rpc_send_multicast(const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const DataBuffer> &p_db) {
+	for (int peer : p_peers_recipients) {
+		rpc_send(peer, p_reliable, *p_db);
+	}
+}
+
 void NetworkInterface::__fetch_rpc_info_from_object(
 		ObjectLocalId p_id,
 		int p_rpc_index,
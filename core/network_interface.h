@@ -7,6 +7,8 @@
 #include "scene_synchronizer_debugger.h"
 #include "peer_data.h"
 
+#include <memory>
+#include <tuple>
 #include <vector>
 
 NS_NAMESPACE_BEGIN
@@ -134,9 +136,11 @@ private:
 
 		// Create an intermediate lambda, which is easy to store, that is
 		// responsible to execute the user rpc function.
+		// The arguments are stored within the lambda, so their memory is
+		// reused by each call rather than allocated again.
 		std::function<void(DataBuffer &)> func =
-				[p_rpc_func](DataBuffer &p_db) {
-			internal_call_rpc(p_rpc_func, p_db);
+				[p_rpc_func, args = RpcArgs<ARGS...>()](DataBuffer &p_db) mutable {
+			internal_call_rpc(p_rpc_func, args, p_db);
 		};
 
 		const std::uint8_t rpc_index = std::uint8_t(r_rpcs_info.size());
@@ -158,31 +162,23 @@ public:
 	}
 
 protected:
-	virtual void rpc_send(int p_peer_recipient, bool p_reliable, DataBuffer &&p_db) = 0;
+	virtual void rpc_send(int p_peer_recipient, bool p_reliable, const DataBuffer &p_db) = 0;
+
+	/// Sends the same payload to all the recipients. The payload is immutable
+	/// and shared, so the transport can fan it out without copying it per peer
+	/// or use a native multicast.
+	/// By default, this calls `rpc_send` for each recipient passing the shared
+	/// payload.
+	virtual void rpc_send_multicast(const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const DataBuffer> &p_db);
 
 	void __fetch_rpc_info_from_object(ObjectLocalId p_id, int p_rpc_index, ObjectNetId &r_net_id, RPCInfo *&r_rpc_info) const;
 
 private: // ------------------------------------------------------- RPC internal
 	template <typename... ARGS>
-	static void internal_call_rpc(std::function<void()> p_func, DataBuffer &p_buffer);
-
-	template <typename A1>
-	static void internal_call_rpc(std::function<void(A1)> p_func, DataBuffer &p_buffer);
-
-	template <typename A1, typename A2>
-	static void internal_call_rpc(std::function<void(A1, A2)> p_func, DataBuffer &p_buffer);
-
-	template <typename A1, typename A2, typename A3>
-	static void internal_call_rpc(std::function<void(A1, A2, A3)> p_func, DataBuffer &p_buffer);
-
-	template <typename A1, typename A2, typename A3, typename A4>
-	static void internal_call_rpc(std::function<void(A1, A2, A3, A4)> p_func, DataBuffer &p_buffer);
-
-	template <typename A1, typename A2, typename A3, typename A4, typename A5>
-	static void internal_call_rpc(std::function<void(A1, A2, A3, A4, A5)> p_func, DataBuffer &p_buffer);
+	using RpcArgs = std::tuple<typename std::remove_const<typename std::remove_reference<ARGS>::type>::type...>;
 
-	template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
-	static void internal_call_rpc(std::function<void(A1, A2, A3, A4, A5, A6)> p_func, DataBuffer &p_buffer);
+	template <typename... ARGS>
+	static void internal_call_rpc(const std::function<void(ARGS...)> &p_func, RpcArgs<ARGS...> &r_args, DataBuffer &p_buffer);
 };
 
 template <typename... ARGs>
@@ -194,8 +190,9 @@ template <typename... ARGs>
 void RpcHandle<ARGs...>::rpc(NetworkInterface &p_network_interface, const std::vector<int> &p_peers_recipients, ARGs... p_args) const {
 	debugger = &p_network_interface.get_debugger();
 
-	DataBuffer db(get_debugger());
-	db.begin_write(get_debugger(), 0);
+	// The payload is shared by all the recipients.
+	std::shared_ptr<DataBuffer> db = std::make_shared<DataBuffer>(get_debugger());
+	db->begin_write(get_debugger(), 0);
 
 	RPCInfo *rpc_info = nullptr;
 	if (target_object_id != ObjectLocalId::NONE) {
@@ -205,138 +202,53 @@ void RpcHandle<ARGs...>::rpc(NetworkInterface &p_network_interface, const std::v
 		NS_ENSURE(net_id!=ObjectNetId::NONE);
 		NS_ENSURE(rpc_info!=nullptr);
 
-		db.add(true);
-		db.add(net_id.id);
+		db->add(true);
+		db->add(net_id.id);
 	} else {
-		db.add(false);
+		db->add(false);
 		NS_ENSURE(p_network_interface.rpcs_info.size() > index);
 		rpc_info = &p_network_interface.rpcs_info[index];
 	}
 
 	// Add the rpc id.
-	db.add(index);
+	db->add(index);
 
 	// Encode the properties into a DataBuffer.
-	encode_variables<0>(db, p_args...);
+	encode_variables<0>(*db, p_args...);
 
-	db.dry();
-	db.begin_read(get_debugger());
+	db->dry();
 
-	bool called_locally = false;
+	bool call_locally = rpc_info->call_local;
+	std::vector<int> remote_recipients;
+	remote_recipients.reserve(p_peers_recipients.size());
 	for (int peer : p_peers_recipients) {
-		db.begin_read(get_debugger());
 		if (p_network_interface.get_local_peer_id() == peer) {
 			// This rpc goes directly to self
-			p_network_interface.rpc_receive(p_network_interface.get_local_peer_id(), db);
-			called_locally = true;
+			call_locally = true;
 		} else {
-			p_network_interface.rpc_send(peer, rpc_info->is_reliable, std::move(db));
+			remote_recipients.push_back(peer);
 		}
 	}
 
-	if (rpc_info->call_local && !called_locally) {
-		db.begin_read(get_debugger());
-		p_network_interface.rpc_receive(p_network_interface.get_local_peer_id(), db);
+	if (call_locally) {
+		db->begin_read(get_debugger());
+		p_network_interface.rpc_receive(p_network_interface.get_local_peer_id(), *db);
+	}
+
+	if (!remote_recipients.empty()) {
+		// From now on the payload is never modified.
+		db->begin_read(get_debugger());
+		p_network_interface.rpc_send_multicast(remote_recipients, rpc_info->is_reliable, db);
 	}
 
 	debugger = nullptr;
 }
 
 template <typename... ARGS>
-void NetworkInterface::internal_call_rpc(std::function<void()> p_func, DataBuffer &p_buffer) {
-	p_func();
-}
-
-template <typename A1>
-void NetworkInterface::internal_call_rpc(std::function<void(A1)> p_func, DataBuffer &p_buffer) {
-	typename std::remove_const<typename std::remove_reference<A1>::type>::type p1;
-	decode_variable(p1, p_buffer);
-	p_func(p1);
-}
-
-template <typename A1, typename A2>
-void NetworkInterface::internal_call_rpc(std::function<void(A1, A2)> p_func, DataBuffer &p_buffer) {
-	typename std::remove_const<typename std::remove_reference<A1>::type>::type p1;
-	decode_variable(p1, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A2>::type>::type p2;
-	decode_variable(p2, p_buffer);
-
-	p_func(p1, p2);
-}
-
-template <typename A1, typename A2, typename A3>
-void NetworkInterface::internal_call_rpc(std::function<void(A1, A2, A3)> p_func, DataBuffer &p_buffer) {
-	typename std::remove_const<typename std::remove_reference<A1>::type>::type p1;
-	decode_variable(p1, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A2>::type>::type p2;
-	decode_variable(p2, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A3>::type>::type p3;
-	decode_variable(p3, p_buffer);
-
-	p_func(p1, p2, p3);
-}
-
-template <typename A1, typename A2, typename A3, typename A4>
-void NetworkInterface::internal_call_rpc(std::function<void(A1, A2, A3, A4)> p_func, DataBuffer &p_buffer) {
-	typename std::remove_const<typename std::remove_reference<A1>::type>::type p1;
-	decode_variable(p1, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A2>::type>::type p2;
-	decode_variable(p2, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A3>::type>::type p3;
-	decode_variable(p3, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A4>::type>::type p4;
-	decode_variable(p4, p_buffer);
-
-	p_func(p1, p2, p3, p4);
-}
-
-template <typename A1, typename A2, typename A3, typename A4, typename A5>
-void NetworkInterface::internal_call_rpc(std::function<void(A1, A2, A3, A4, A5)> p_func, DataBuffer &p_buffer) {
-	typename std::remove_const<typename std::remove_reference<A1>::type>::type p1;
-	decode_variable(p1, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A2>::type>::type p2;
-	decode_variable(p2, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A3>::type>::type p3;
-	decode_variable(p3, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A4>::type>::type p4;
-	decode_variable(p4, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A5>::type>::type p5;
-	decode_variable(p5, p_buffer);
-
-	p_func(p1, p2, p3, p4, p5);
-}
-
-template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
-void NetworkInterface::internal_call_rpc(std::function<void(A1, A2, A3, A4, A5, A6)> p_func, DataBuffer &p_buffer) {
-	typename std::remove_const<typename std::remove_reference<A1>::type>::type p1;
-	decode_variable(p1, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A2>::type>::type p2;
-	decode_variable(p2, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A3>::type>::type p3;
-	decode_variable(p3, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A4>::type>::type p4;
-	decode_variable(p4, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A5>::type>::type p5;
-	decode_variable(p5, p_buffer);
-
-	typename std::remove_const<typename std::remove_reference<A6>::type>::type p6;
-	decode_variable(p6, p_buffer);
-
-	p_func(p1, p2, p3, p4, p5, p6);
+void NetworkInterface::internal_call_rpc(const std::function<void(ARGS...)> &p_func, RpcArgs<ARGS...> &r_args, DataBuffer &p_buffer) {
+	// Decodes the arguments in order, overwriting the ones of the previous call.
+	std::apply([&p_buffer](auto &...p_args) { (decode_variable(p_args, p_buffer), ...); }, r_args);
+	std::apply(p_func, r_args);
 }
 
 NS_NAMESPACE_END
\ No newline at end of file
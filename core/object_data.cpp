@@ -134,6 +134,11 @@ bool ObjectData::set_controlled_by_peer(SceneSynchronizerBase &synchronizer, int
 		synchronizer.get_synchronizer_internal()->on_object_data_controller_changed(*this, old_peer);
 	}
 
+	if (interpolation_enabled) {
+		// The controlled objects are not interpolated, so they are processed.
+		synchronizer.process_functions__clear();
+	}
+
 	return true;
 }
 
@@ -26,6 +26,27 @@ struct NameAndVar {
 	static NameAndVar make_copy(const NameAndVar &p_other);
 };
 
+/// Defines how the client compares a variable against the server value, to
+/// decide whether a rewind is needed.
+struct VarComparePolicy {
+	/// The values are considered equal when the difference is within this
+	/// absolute tolerance.
+	/// NOTE: The tolerance is evaluated by the installed `var_data_compare_approx_func`,
+	///       when it's not installed the variable is compared strictly.
+	float absolute_tolerance = 0.0f;
+	/// The values are considered equal when the difference is within this
+	/// tolerance, relative to the server value magnitude.
+	float relative_tolerance = 0.0f;
+	/// The variable is compared only when at least this amount of frames
+	/// passed since it was last compared, no matter the snapshots cadence.
+	/// `1` compares it each time.
+	std::uint32_t compare_every_n_frames = 1;
+
+	bool is_strict() const {
+		return absolute_tolerance <= 0.0f && relative_tolerance <= 0.0f;
+	}
+};
+
 struct VarDescriptor {
 	const VarId id;
 	NameAndVar var;
@@ -34,6 +55,23 @@ struct VarDescriptor {
 	NS_VarDataSetFunc set_func = nullptr;
 	NS_VarDataGetFunc get_func = nullptr;
 	bool skip_rewinding = false;
+	/// When true, the value is replaced with its networked (encoded then
+	/// decoded) version after each frame.
+	bool quantize_on_write = false;
+	VarComparePolicy compare_policy;
+	/// The server frame this variable was last compared on, used by
+	/// `VarComparePolicy::compare_every_n_frames` (client only).
+	mutable GlobalFrameIndex last_compared_frame = GlobalFrameIndex::NONE;
+	/// The amount of rewinds triggered by this variable (client only).
+	std::uint64_t rewind_triggers_count = 0;
+	/// The lag compensation history of this variable (server only): the slot
+	/// of each frame is defined by `ObjectData::lag_compensation_history_frames`.
+	std::vector<VarData> lag_compensation_history;
+	/// The bits sent by the server snapshots for this variable value.
+	BandwidthStats bandwidth_stats;
+	/// Unique version of `var.value`, changed each time the value is updated.
+	/// Used to skip copying the unchanged values into the client snapshots.
+	std::uint64_t value_version = 0;
 	bool enabled = false;
 	std::vector<struct ChangesListener *> changes_listeners;
 
@@ -47,6 +85,16 @@ struct VarDescriptor {
 			NS_VarDataGetFunc p_get_func,
 			bool p_skip_rewinding,
 			bool p_enabled);
+
+	/// Returns true when this variable is part of the object state hash:
+	/// only the variables compared strictly on each frame can be checked
+	/// using the hash.
+	bool is_state_hashed() const {
+		return enabled &&
+				!skip_rewinding &&
+				compare_policy.is_strict() &&
+				compare_policy.compare_every_n_frames <= 1;
+	}
 };
 
 struct ObjectData {
@@ -98,6 +146,23 @@ public:
 	std::vector<VarDescriptor> vars;
 	Processor<float> functions[PROCESS_PHASE_COUNT];
 
+	/// The frame stored into each slot of the variables lag compensation
+	/// history; the slot of a frame is `frame % size`.
+	/// Empty when the lag compensation history is disabled.
+	std::vector<GlobalFrameIndex> lag_compensation_history_frames;
+
+	/// The bits sent by the server snapshots for this object, including the
+	/// object header, the variables and the scheduled procedures.
+	BandwidthStats bandwidth_stats;
+
+	/// The interaction island of this object, used by the selective rewind:
+	/// the objects of an island never interact with the objects outside it.
+	RewindIslandId rewind_island = RewindIslandId::NONE;
+
+	/// When true, the client interpolates the received server values instead
+	/// of predicting this object. Check `is_client_interpolated`.
+	bool interpolation_enabled = false;
+
 	struct ScheduledProcedureInfo {
 		NS_ScheduledProcedureFunc func = nullptr;
 		GlobalFrameIndex execute_frame = GlobalFrameIndex{ 0 };
@@ -134,6 +199,12 @@ public:
 	bool has_registered_process_functions() const;
 	bool can_trickled_sync() const;
 
+	/// Returns true when the client interpolates this object, rather than
+	/// predicting it: the controlled objects are always predicted.
+	bool is_client_interpolated() const {
+		return interpolation_enabled && realtime_sync_enabled_on_client && controlled_by_peer <= 0;
+	}
+
 	void setup_controller(
 			std::function<void(float /*delta*/, DataBuffer & /*r_data_buffer*/)> p_collect_input_func = nullptr,
 			std::function<bool(DataBuffer & /*p_data_buffer_A*/, DataBuffer & /*p_data_buffer_B*/)> p_are_inputs_different_func = nullptr,
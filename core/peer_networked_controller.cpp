@@ -2,7 +2,6 @@
 
 #include "../scene_synchronizer.h"
 #include "ensure.h"
-#include "quick_sort.h"
 #include "scene_synchronizer_debugger.h"
 #include <algorithm>
 #include <string>
@@ -13,27 +12,92 @@
 #define METADATA_SIZE (16)
 
 NS_NAMESPACE_BEGIN
-static inline unsigned int ns_encode_uint32(std::uint32_t p_uint, std::uint8_t *p_arr) {
-	for (int i = 0; i < 4; i++) {
-		*p_arr = p_uint & 0xFF;
-		p_arr++;
-		p_uint >>= 8;
+/// Writes the lowest `p_bits` of `p_value` into the inputs packet, growing it.
+static void ns_write_bits(std::vector<std::uint8_t> &r_buffer, int &r_bit_offset, std::uint64_t p_value, int p_bits) {
+	const std::size_t needed_bytes = std::size_t(r_bit_offset + p_bits + 7) / 8;
+	if (r_buffer.size() < needed_bytes) {
+		r_buffer.resize(needed_bytes, 0);
 	}
 
-	return sizeof(std::uint32_t);
+	while (p_bits > 0) {
+		const int bit_in_byte = r_bit_offset % 8;
+		const int bits_to_write = std::min(p_bits, 8 - bit_in_byte);
+		const std::uint8_t mask = std::uint8_t(((1u << bits_to_write) - 1u) << bit_in_byte);
+		std::uint8_t &byte = r_buffer[r_bit_offset / 8];
+		byte = std::uint8_t((byte & ~mask) | (std::uint8_t(p_value << bit_in_byte) & mask));
+
+		p_value >>= bits_to_write;
+		p_bits -= bits_to_write;
+		r_bit_offset += bits_to_write;
+	}
+}
+
+/// Reads `p_bits` from the inputs packet, returns false if the packet is too short.
+static bool ns_read_bits(const std::vector<std::uint8_t> &p_buffer, int &r_bit_offset, int p_bits, std::uint64_t &r_value) {
+	if (std::size_t(r_bit_offset + p_bits) > p_buffer.size() * 8) {
+		return false;
+	}
+
+	r_value = 0;
+	int value_bit_offset = 0;
+	while (p_bits > 0) {
+		const int bit_in_byte = r_bit_offset % 8;
+		const int bits_to_read = std::min(p_bits, 8 - bit_in_byte);
+		const std::uint64_t bits = (p_buffer[r_bit_offset / 8] >> bit_in_byte) & ((1u << bits_to_read) - 1u);
+		r_value |= bits << value_bit_offset;
+
+		value_bit_offset += bits_to_read;
+		p_bits -= bits_to_read;
+		r_bit_offset += bits_to_read;
+	}
+	return true;
+}
+
+/// Writes the amount of unchanged bits preceding a changed bit, using chunks
+/// of 4 bits each followed by a bit telling if another chunk follows.
+static void ns_write_zero_run(std::vector<std::uint8_t> &r_buffer, int &r_bit_offset, std::uint32_t p_run) {
+	do {
+		ns_write_bits(r_buffer, r_bit_offset, p_run & 0xF, 4);
+		p_run >>= 4;
+		ns_write_bits(r_buffer, r_bit_offset, p_run > 0 ? 1 : 0, 1);
+	} while (p_run > 0);
 }
 
-static inline std::uint32_t ns_decode_uint32(const std::uint8_t *p_arr) {
-	std::uint32_t u = 0;
+static bool ns_read_zero_run(const std::vector<std::uint8_t> &p_buffer, int &r_bit_offset, std::uint32_t &r_run) {
+	r_run = 0;
+	// The input size is an uint16, so the run never takes more than 4 chunks.
+	for (int shift = 0; shift < 16; shift += 4) {
+		std::uint64_t chunk;
+		std::uint64_t has_more;
+		if (!ns_read_bits(p_buffer, r_bit_offset, 4, chunk) || !ns_read_bits(p_buffer, r_bit_offset, 1, has_more)) {
+			return false;
+		}
+		r_run |= std::uint32_t(chunk) << shift;
+		if (has_more == 0) {
+			return true;
+		}
+	}
+	return false;
+}
 
-	for (int i = 0; i < 4; i++) {
-		std::uint32_t b = *p_arr;
-		b <<= (i * 8);
-		u |= b;
-		p_arr++;
+static inline int ns_count_leading_zeros(std::uint32_t p_value) {
+	int count = 32;
+	while (p_value != 0) {
+		p_value >>= 1;
+		count -= 1;
 	}
+	return count;
+}
 
-	return u;
+/// Returns the byte `p_byte` of the input, the bits past `p_size_in_bits` are
+/// always 0 so two inputs having a different size can be XORed.
+static inline std::uint8_t ns_input_byte(const std::vector<std::uint8_t> &p_input, std::uint16_t p_size_in_bits, int p_byte) {
+	const int remaining_bits = int(p_size_in_bits) - (p_byte * 8);
+	if (remaining_bits <= 0) {
+		return 0;
+	}
+	const std::uint8_t byte = p_input[p_byte];
+	return remaining_bits >= 8 ? byte : std::uint8_t(byte & ((1u << remaining_bits) - 1u));
 }
 
 PeerNetworkedController::PeerNetworkedController(SceneSynchronizerBase &p_scene_synchronizer):
@@ -92,6 +156,19 @@ int PeerNetworkedController::get_max_redundant_inputs() const {
 	return scene_synchronizer ? scene_synchronizer->get_max_redundant_inputs() : 0;
 }
 
+int PeerNetworkedController::get_redundant_inputs() const {
+	const int max_redundant_inputs = get_max_redundant_inputs();
+	if (redundant_inputs < 0 || !scene_synchronizer) {
+		return max_redundant_inputs;
+	}
+	const int min_redundant_inputs = std::min(scene_synchronizer->get_min_redundant_inputs(), max_redundant_inputs);
+	return std::clamp(redundant_inputs, min_redundant_inputs, max_redundant_inputs);
+}
+
+void PeerNetworkedController::set_redundant_inputs(int p_redundant_inputs) {
+	redundant_inputs = p_redundant_inputs;
+}
+
 FrameIndex PeerNetworkedController::get_checked_frame_index() const {
 	NS_ENSURE_V(controller, FrameIndex::NONE);
 	return controller->get_checked_frame_index();
@@ -312,6 +389,11 @@ void PeerNetworkedController::notify_receive_inputs(const std::vector<std::uint8
 }
 
 void PeerNetworkedController::store_input_buffer(std::deque<FrameInput> &r_frames_input, FrameIndex p_frame_index) {
+	r_frames_input.emplace_back(get_debugger());
+	store_input_buffer(r_frames_input.back(), p_frame_index);
+}
+
+void PeerNetworkedController::store_input_buffer(FrameInput &r_input, FrameIndex p_frame_index) {
 	const std::uint16_t buffer_size_bits = get_inputs_buffer().size() + METADATA_SIZE;
 
 #ifdef NS_DEBUG_ENABLED
@@ -326,44 +408,48 @@ void PeerNetworkedController::store_input_buffer(std::deque<FrameInput> &r_frame
 	NS_ASSERT_COND_MSG(buffer_size_bits>=METADATA_SIZE, "The buffer size can't be less than the metadata.");
 #endif
 
-	FrameInput inputs(get_debugger());
-	inputs.id = p_frame_index;
-	inputs.inputs_buffer = get_inputs_buffer().get_buffer();
-	inputs.buffer_size_bit = buffer_size_bits;
-	inputs.similarity = FrameIndex::NONE;
-	r_frames_input.push_back(inputs);
+	r_input.id = p_frame_index;
+	r_input.inputs_buffer = get_inputs_buffer().get_buffer();
+	r_input.buffer_size_bit = buffer_size_bits;
+	r_input.similarity = FrameIndex::NONE;
 }
 
 void PeerNetworkedController::encode_inputs(std::deque<FrameInput> &p_frames_input, std::vector<std::uint8_t> &r_buffer) {
-	// The inputs buffer is composed as follows:
-	// - The following four bytes for the first input ID.
-	// - Array of inputs:
-	// |-- First byte the amount of times this input is duplicated in the packet.
-	// |-- Input buffer.
-
-	const size_t inputs_count = std::min(p_frames_input.size(), std::max(static_cast<size_t>(1), static_cast<size_t>(get_max_redundant_inputs())));
+	const size_t inputs_count = std::min(p_frames_input.size(), std::max(static_cast<size_t>(1), static_cast<size_t>(get_redundant_inputs())));
+	encode_inputs(p_frames_input, p_frames_input.size() - inputs_count, inputs_count, r_buffer);
+}
+
+template <typename FrameInputs>
+void PeerNetworkedController::encode_inputs(FrameInputs &p_frames_input, std::size_t p_first_input_index, std::size_t p_inputs_count, std::vector<std::uint8_t> &r_buffer) {
+	// The inputs buffer is a bit stream composed as follows:
+	// - 32 bits for the first input ID.
+	// - Array of inputs, each one is:
+	// |-- 1 bit set to 1, telling that an input follows.
+	// |-- The input buffer: the first input is written in full, while the
+	// |   others start with 1 bit telling if the input is written as the XOR
+	// |   against the previous written input or in full.
+	// |   Check `write_input_delta()`.
+	// |-- 1 bit telling if the input is duplicated, then 8 bits for the
+	// |   amount of times this input is duplicated in the packet.
+	// - 1 bit set to 0, which terminates the array.
+
+	const size_t end_input_index = std::min(p_frames_input.size(), p_first_input_index + p_inputs_count);
+	const size_t inputs_count = end_input_index > p_first_input_index ? end_input_index - p_first_input_index : 0;
 	if make_unlikely(inputs_count <= 0) {
 		// Nothing to send.
 		return;
 	}
 
-#define MAKE_ROOM(p_size)                                              \
-	if (r_buffer.size() < static_cast<size_t>(ofs + p_size)) \
-		r_buffer.resize(ofs + p_size);
-
-	int ofs = 0;
+	int bit_offset = 0;
 	r_buffer.clear();
-	// At this point both the cached_packet_data and ofs are the same.
-	NS_ASSERT_COND(ofs == r_buffer.size());
 
 	// Let's store the ID of the first snapshot.
-	MAKE_ROOM(4);
-	const FrameIndex first_input_id = p_frames_input[p_frames_input.size() - inputs_count].id;
-	ofs += ns_encode_uint32(first_input_id.id, r_buffer.data() + ofs);
+	const FrameIndex first_input_id = p_frames_input[p_first_input_index].id;
+	ns_write_bits(r_buffer, bit_offset, first_input_id.id, 32);
 
+	std::size_t previous_input_index = p_frames_input.size();
 	FrameIndex previous_input_id = FrameIndex::NONE;
 	FrameIndex previous_input_similarity = FrameIndex::NONE;
-	int previous_buffer_size = 0;
 	uint8_t duplication_count = 0;
 
 	DataBuffer pir_A(get_debugger());
@@ -371,7 +457,7 @@ void PeerNetworkedController::encode_inputs(std::deque<FrameInput> &p_frames_inp
 	pir_A.copy(get_inputs_buffer().get_buffer());
 
 	// Compose the packets
-	for (size_t i = p_frames_input.size() - inputs_count; i < p_frames_input.size(); i += 1) {
+	for (size_t i = p_first_input_index; i < end_input_index; i += 1) {
 		bool is_similar = false;
 
 		if (previous_input_id == FrameIndex::NONE) {
@@ -432,30 +518,24 @@ void PeerNetworkedController::encode_inputs(std::deque<FrameInput> &p_frames_inp
 
 			if (previous_input_id != FrameIndex::NONE) {
 				// We can finally finalize the previous input
-				r_buffer[ofs - previous_buffer_size - 1] = duplication_count;
+				write_input_duplication(r_buffer, bit_offset, duplication_count);
 			}
 
 			// Resets the duplication count.
 			duplication_count = 0;
 
-			// Writes the duplication_count for this new input
-			MAKE_ROOM(1);
-			r_buffer[ofs] = 0;
-			ofs += 1;
-
 			// Write the inputs
-			const int buffer_size = (int)p_frames_input[i].inputs_buffer.get_bytes().size();
-			MAKE_ROOM(buffer_size);
-			memcpy(
-					r_buffer.data() + ofs,
-					p_frames_input[i].inputs_buffer.get_bytes().data(),
-					buffer_size);
-			ofs += buffer_size;
+			ns_write_bits(r_buffer, bit_offset, 1, 1);
+			write_input_delta(
+					r_buffer,
+					bit_offset,
+					previous_input_index < p_frames_input.size() ? &p_frames_input[previous_input_index] : nullptr,
+					p_frames_input[i]);
 
 			// Let's see if we can duplicate this input.
+			previous_input_index = i;
 			previous_input_id = p_frames_input[i].id;
 			previous_input_similarity = p_frames_input[i].similarity;
-			previous_buffer_size = buffer_size;
 
 			pir_A.get_buffer_mut() = p_frames_input[i].inputs_buffer;
 			pir_A.shrink_to(METADATA_SIZE, p_frames_input[i].buffer_size_bit - METADATA_SIZE);
@@ -463,12 +543,80 @@ void PeerNetworkedController::encode_inputs(std::deque<FrameInput> &p_frames_inp
 	}
 
 	// Finalize the last added input_buffer.
-	r_buffer[ofs - previous_buffer_size - 1] = duplication_count;
+	write_input_duplication(r_buffer, bit_offset, duplication_count);
+
+	// Terminate the inputs array.
+	ns_write_bits(r_buffer, bit_offset, 0, 1);
+
+	// At this point the bit stream MUST fit the buffer.
+	NS_ASSERT_COND(r_buffer.size() == std::size_t(bit_offset + 7) / 8);
+}
+
+void PeerNetworkedController::write_input_delta(std::vector<std::uint8_t> &r_buffer, int &r_bit_offset, const FrameInput *p_previous_input, const FrameInput &p_input) {
+	const std::vector<std::uint8_t> &input = p_input.inputs_buffer.get_bytes();
+	const int input_size_bytes = (int(p_input.buffer_size_bit) + 7) / 8;
+	NS_ASSERT_COND(int(input.size()) >= input_size_bytes);
+
+	// The input is written as the XOR against the previous input: each bit
+	// that changed is written as the amount of unchanged bits preceding it,
+	// so the inputs changing just few bits take just few bits.
+	// The METADATA is part of the XOR, so the size is sent only if it changed.
+	// NOTE: When most of the bits changed, the input is written in full.
+	if (p_previous_input) {
+		const std::vector<std::uint8_t> &previous_input = p_previous_input->inputs_buffer.get_bytes();
+
+		int delta_size_bits = 1;
+		int next_bit = 0;
+		for (int i = 0; i < input_size_bytes && delta_size_bits < p_input.buffer_size_bit; i++) {
+			const std::uint8_t changed_bits =
+					ns_input_byte(input, p_input.buffer_size_bit, i) ^
+					ns_input_byte(previous_input, p_previous_input->buffer_size_bit, i);
+			for (int b = 0; changed_bits != 0 && b < 8; b++) {
+				if ((changed_bits >> b) & 1) {
+					const int bit = (i * 8) + b;
+					// The changed bit flag + the zero run chunks, 5 bits each.
+					delta_size_bits += 1 + (5 * std::max(1, (32 - ns_count_leading_zeros(std::uint32_t(bit - next_bit)) + 3) / 4));
+					next_bit = bit + 1;
+				}
+			}
+		}
+
+		const bool write_delta = delta_size_bits < p_input.buffer_size_bit;
+		ns_write_bits(r_buffer, r_bit_offset, write_delta ? 1 : 0, 1);
+
+		if (write_delta) {
+			next_bit = 0;
+			for (int i = 0; i < input_size_bytes; i++) {
+				const std::uint8_t changed_bits =
+						ns_input_byte(input, p_input.buffer_size_bit, i) ^
+						ns_input_byte(previous_input, p_previous_input->buffer_size_bit, i);
+				for (int b = 0; changed_bits != 0 && b < 8; b++) {
+					if ((changed_bits >> b) & 1) {
+						const int bit = (i * 8) + b;
+						ns_write_bits(r_buffer, r_bit_offset, 1, 1);
+						ns_write_zero_run(r_buffer, r_bit_offset, std::uint32_t(bit - next_bit));
+						next_bit = bit + 1;
+					}
+				}
+			}
+			// No more changed bits.
+			ns_write_bits(r_buffer, r_bit_offset, 0, 1);
+			return;
+		}
+	}
 
-	// At this point both the cached_packet_data.size() and ofs MUST be the same.
-	NS_ASSERT_COND(ofs == r_buffer.size());
+	// Write the input in full. Its first 16 bits are the METADATA, containing
+	// the input size.
+	for (int i = 0; i < input_size_bytes; i++) {
+		ns_write_bits(r_buffer, r_bit_offset, ns_input_byte(input, p_input.buffer_size_bit, i), std::min(8, int(p_input.buffer_size_bit) - (i * 8)));
+	}
+}
 
-#undef MAKE_ROOM
+void PeerNetworkedController::write_input_duplication(std::vector<std::uint8_t> &r_buffer, int &r_bit_offset, std::uint8_t p_duplication_count) {
+	ns_write_bits(r_buffer, r_bit_offset, p_duplication_count > 0 ? 1 : 0, 1);
+	if (p_duplication_count > 0) {
+		ns_write_bits(r_buffer, r_bit_offset, p_duplication_count, 8);
+	}
 }
 
 bool PeerNetworkedController::can_simulate() {
@@ -498,78 +646,117 @@ bool PeerNetworkedController::__input_data_parse(
 		const std::vector<std::uint8_t> &p_data,
 		void *p_user_pointer,
 		void (*p_input_parse)(void *p_user_pointer, FrameIndex p_input_id, std::uint16_t p_input_size_in_bits, const BitArray &p_input)) {
-	// The packet is composed as follow:
-	// |- Four bytes for the first input ID.
+	// The packet is a bit stream composed as follow, check `encode_inputs()`:
+	// |- 32 bits for the first input ID.
 	// \- Array of inputs:
-	//      |-- First byte the amount of times this input is duplicated in the packet.
-	//      |-- inputs buffer.
+	//      |-- 1 bit set to 1, telling that an input follows.
+	//      |-- inputs buffer, in full or XORed against the previous input (1 bit flag, omitted for the first input).
+	//      |-- 1 bit + 8 bits for the amount of times this input is duplicated.
+	// |- 1 bit set to 0.
 	//
 	// Let's decode it!
 
-	const int data_len = (int)p_data.size();
+	int bit_offset = 0;
+	std::uint64_t value;
 
-	int ofs = 0;
-
-	NS_ENSURE_V(data_len >= 4, false);
-	const FrameIndex first_input_id = FrameIndex{ { ns_decode_uint32(p_data.data() + ofs) } };
-	ofs += 4;
+	NS_ENSURE_V(ns_read_bits(p_data, bit_offset, 32, value), false);
+	const FrameIndex first_input_id = FrameIndex{ { std::uint32_t(value) } };
 
 	uint32_t inserted_input_count = 0;
 
-	// Contains the entire packet and in turn it will be seek to specific location
-	// so I will not need to copy chunk of the packet data.
-	DataBuffer pir(get_debugger());
-	pir.copy(BitArray(get_debugger(), p_data));
-	pir.begin_read(get_debugger());
-
-	while (ofs < data_len) {
-		NS_ENSURE_V_MSG(ofs + 1 <= data_len, false, "The arrived packet size doesn't meet the expected size.");
-		// First byte is used for the duplication count.
-		const uint8_t duplication = p_data[ofs];
-		ofs += 1;
-
-		// Validate input
-		const int input_buffer_offset_bit = ofs * 8;
-		pir.shrink_to(input_buffer_offset_bit, (data_len - ofs) * 8);
-		pir.seek(input_buffer_offset_bit);
-		NS_ENSURE_V(!pir.is_buffer_failed(), false);
-
-		// Read metadata
-		std::uint16_t input_size_in_bits;
-		pir.read(input_size_in_bits);
-		NS_ENSURE_V(!pir.is_buffer_failed(), false);
-
-		// Pad to 8 bits.
-		const int input_size_padded =
-				int(std::ceil(static_cast<float>(input_size_in_bits) / 8.0f));
-		NS_ENSURE_V_MSG(ofs + input_size_padded <= data_len, false, "The arrived packet size doesn't meet the expected size.");
-
-		// Extract the data and copy into a BitArray.
-		BitArray bit_array;
-		bit_array.get_bytes_mut().resize(input_size_padded);
-		memcpy(
-				bit_array.get_bytes_mut().data(),
-				p_data.data() + ofs,
-				input_size_padded);
+	// Contains the last decoded input, the next one is XORed against it.
+	BitArray input(get_debugger());
+	std::uint16_t input_size_in_bits = 0;
+
+	while (true) {
+		NS_ENSURE_V_MSG(ns_read_bits(p_data, bit_offset, 1, value), false, "The arrived packet size doesn't meet the expected size.");
+		if (value == 0) {
+			// No more inputs.
+			break;
+		}
+
+		std::vector<std::uint8_t> &input_bytes = input.get_bytes_mut();
+		bool is_delta = false;
+		if (inserted_input_count > 0) {
+			NS_ENSURE_V_MSG(ns_read_bits(p_data, bit_offset, 1, value), false, "The arrived packet size doesn't meet the expected size.");
+			is_delta = value == 1;
+		}
+
+		if (!is_delta) {
+			// The input is written in full, starting from its METADATA.
+			NS_ENSURE_V_MSG(ns_read_bits(p_data, bit_offset, METADATA_SIZE, value), false, "The arrived packet size doesn't meet the expected size.");
+			input_size_in_bits = std::uint16_t(value);
+			NS_ENSURE_V_MSG(input_size_in_bits >= METADATA_SIZE, false, "The arrived packet contains an invalid input size.");
+
+			input_bytes.assign((input_size_in_bits + 7) / 8, 0);
+			int input_bit_offset = 0;
+			ns_write_bits(input_bytes, input_bit_offset, input_size_in_bits, METADATA_SIZE);
+			while (input_bit_offset < input_size_in_bits) {
+				const int bits = std::min(8, input_size_in_bits - input_bit_offset);
+				NS_ENSURE_V_MSG(ns_read_bits(p_data, bit_offset, bits, value), false, "The arrived packet size doesn't meet the expected size.");
+				ns_write_bits(input_bytes, input_bit_offset, value, bits);
+			}
+		} else {
+			// Flip the changed bits of the previous input.
+			int next_bit = 0;
+			while (true) {
+				NS_ENSURE_V_MSG(ns_read_bits(p_data, bit_offset, 1, value), false, "The arrived packet size doesn't meet the expected size.");
+				if (value == 0) {
+					break;
+				}
+				std::uint32_t zero_run;
+				NS_ENSURE_V_MSG(ns_read_zero_run(p_data, bit_offset, zero_run), false, "The arrived packet size doesn't meet the expected size.");
+				const std::uint32_t bit = next_bit + zero_run;
+				NS_ENSURE_V_MSG(bit <= UINT16_MAX, false, "The arrived packet contains an invalid input.");
+				if (input_bytes.size() <= bit / 8) {
+					input_bytes.resize((bit / 8) + 1, 0);
+				}
+				input_bytes[bit / 8] ^= std::uint8_t(1u << (bit % 8));
+				next_bit = int(bit) + 1;
+			}
+
+			// The METADATA was XORed too, so it contains the new size.
+			int metadata_bit_offset = 0;
+			NS_ENSURE_V(ns_read_bits(input_bytes, metadata_bit_offset, METADATA_SIZE, value), false);
+			input_size_in_bits = std::uint16_t(value);
+			NS_ENSURE_V_MSG(input_size_in_bits >= METADATA_SIZE && next_bit <= input_size_in_bits, false, "The arrived packet contains an invalid input size.");
+
+			// Drop the previous input bits, past the new size.
+			input_bytes.resize((input_size_in_bits + 7) / 8, 0);
+			if (input_size_in_bits % 8 != 0) {
+				input_bytes.back() &= std::uint8_t((1u << (input_size_in_bits % 8)) - 1u);
+			}
+		}
+
+		std::uint8_t duplication = 0;
+		NS_ENSURE_V_MSG(ns_read_bits(p_data, bit_offset, 1, value), false, "The arrived packet size doesn't meet the expected size.");
+		if (value == 1) {
+			NS_ENSURE_V_MSG(ns_read_bits(p_data, bit_offset, 8, value), false, "The arrived packet size doesn't meet the expected size.");
+			duplication = std::uint8_t(value);
+		}
 
 		// The input is valid, and the bit array is created: now execute the callback.
 		for (int sub = 0; sub <= duplication; sub += 1) {
 			const FrameIndex input_id = first_input_id + inserted_input_count;
 			inserted_input_count += 1;
 
-			p_input_parse(p_user_pointer, input_id, input_size_in_bits, bit_array);
+			p_input_parse(p_user_pointer, input_id, input_size_in_bits, input);
 		}
-
-		// Advance the offset to parse the next input.
-		ofs += input_size_padded;
 	}
 
-	NS_ENSURE_V_MSG(ofs == data_len, false, "At the end was detected that the arrived packet has an unexpected size.");
+	NS_ENSURE_V_MSG(std::size_t(bit_offset + 7) / 8 == p_data.size(), false, "At the end was detected that the arrived packet has an unexpected size.");
 	return true;
 }
 
 RemotelyControlledController::RemotelyControlledController(PeerNetworkedController *p_peer_controller) :
 	Controller(p_peer_controller) {
+	// Preallocate the inputs ring, so the received inputs don't allocate.
+	// The client can't be ahead more than this, so the ring never grows.
+	const std::size_t max_inputs =
+			peer_controller->scene_synchronizer->get_client_max_frames_storage_size() +
+			std::size_t(std::max(0, peer_controller->get_max_redundant_inputs()));
+	frames_input.reserve(max_inputs);
+	frames_input.set_max_capacity(max_inputs);
 }
 
 void RemotelyControlledController::on_peer_update(bool p_peer_enabled) {
@@ -799,10 +986,7 @@ void RemotelyControlledController::process(float p_delta) {
 		return;
 	}
 
-#ifdef NS_DEBUG_ENABLED
-	const bool is_new_input =
-#endif
-			fetch_next_input(p_delta);
+	const bool is_new_input = fetch_next_input(p_delta);
 
 	if make_unlikely(current_input_buffer_id == FrameIndex::NONE) {
 		// Skip this until the first input arrive.
@@ -810,11 +994,14 @@ void RemotelyControlledController::process(float p_delta) {
 		return;
 	}
 
-#ifdef NS_DEBUG_ENABLED
 	if (!is_new_input) {
+		if (!streaming_paused) {
+			missing_inputs_count += 1;
+		}
+#ifdef NS_DEBUG_ENABLED
 		peer_controller->event_input_missed.broadcast(current_input_buffer_id + 1);
-	}
 #endif
+	}
 
 	peer_controller->get_debugger().print(VERBOSE, "RemotelyControlled process index: " + current_input_buffer_id, "CONTROLLER-" + std::to_string(peer_controller->authority_peer));
 
@@ -827,8 +1014,30 @@ void RemotelyControlledController::process(float p_delta) {
 	peer_controller->get_debugger().databuffer_operation_end_record();
 }
 
-bool is_remote_frame_A_older(const FrameInput &p_snap_a, const FrameInput &p_snap_b) {
-	return p_snap_a.id < p_snap_b.id;
+bool RemotelyControlledController::store_received_input(FrameIndex p_input_id, std::uint16_t p_input_size_in_bits, const BitArray &p_input) {
+	// Reject the inputs too far in the future: the client can't produce
+	// them, so the packet is malformed.
+	const FrameIndex reference_input_id = current_input_buffer_id != FrameIndex::NONE ? current_input_buffer_id : frames_input.front_index();
+	NS_ENSURE_V_MSG(
+			reference_input_id == FrameIndex::NONE || p_input_id <= reference_input_id || std::size_t(p_input_id.id - reference_input_id.id) <= frames_input.get_max_capacity(),
+			false,
+			"The input " + std::to_string(p_input_id.id) + " is too far in the future, it's discarded.");
+
+	bool inserted;
+	FrameInput *frame_input_ptr = frames_input.insert(p_input_id, inserted);
+	if (!inserted) {
+		// This is a redundant input, already stored, or too old.
+		return false;
+	}
+
+	// The slot may contain a removed input: overwrite it, reusing its memory.
+	FrameInput &frame_input = *frame_input_ptr;
+	frame_input.id = p_input_id;
+	frame_input.buffer_size_bit = p_input_size_in_bits;
+	frame_input.inputs_buffer = p_input;
+	frame_input.similarity = FrameIndex::NONE;
+	on_input_stored(frame_input);
+	return true;
 }
 
 bool RemotelyControlledController::receive_inputs(const std::vector<std::uint8_t> &p_data) {
@@ -846,32 +1055,15 @@ bool RemotelyControlledController::receive_inputs(const std::vector<std::uint8_t
 			[](void *p_user_pointer, FrameIndex p_input_id, std::uint16_t p_input_size_in_bits, const BitArray &p_bit_array) -> void {
 				SCParseTmpData *pd = static_cast<SCParseTmpData *>(p_user_pointer);
 
+				// The inputs are sorted, so the last one is the newest.
+				pd->controller.last_packet_newest_input = p_input_id;
+
 				if make_unlikely(pd->controller.current_input_buffer_id != FrameIndex::NONE && pd->controller.current_input_buffer_id >= p_input_id) {
 					// We already have this input, so we don't need it anymore.
 					return;
 				}
 
-				FrameInput rfs(pd->controller.get_debugger());
-				rfs.id = p_input_id;
-
-				const bool found = std::binary_search(
-						pd->controller.frames_input.begin(),
-						pd->controller.frames_input.end(),
-						rfs,
-						is_remote_frame_A_older);
-
-				if (!found) {
-					rfs.buffer_size_bit = p_input_size_in_bits;
-					rfs.inputs_buffer = p_bit_array;
-
-					pd->controller.frames_input.push_back(rfs);
-
-					// Sort the added frame input.
-					NS_JOLT::QuickSort(
-							pd->controller.frames_input.begin(),
-							pd->controller.frames_input.end(),
-							is_remote_frame_A_older);
-				}
+				pd->controller.store_received_input(p_input_id, p_input_size_in_bits, p_bit_array);
 			});
 
 #ifdef NS_DEBUG_ENABLED
@@ -892,6 +1084,12 @@ bool RemotelyControlledController::receive_inputs(const std::vector<std::uint8_t
 ServerController::ServerController(
 		PeerNetworkedController *p_peer_controller) :
 	RemotelyControlledController(p_peer_controller) {
+	// Besides the received inputs, the last forwarded ones are kept.
+	const std::size_t max_inputs_to_forward =
+			frames_input.get_max_capacity() +
+			std::size_t(std::max(1, peer_controller->get_max_redundant_inputs()));
+	forwarding_frames_input.reserve(max_inputs_to_forward);
+	forwarding_frames_input.set_max_capacity(max_inputs_to_forward);
 }
 
 void ServerController::process(float p_delta) {
@@ -900,10 +1098,8 @@ void ServerController::process(float p_delta) {
 	if (!streaming_paused) {
 		// Update the consecutive inputs.
 		int consecutive_inputs = 0;
-		for (std::size_t i = 0; i < frames_input.size(); i += 1) {
-			if (frames_input[i].id == (current_input_buffer_id + consecutive_inputs + 1)) {
-				consecutive_inputs += 1;
-			}
+		while (frames_input.find(current_input_buffer_id + consecutive_inputs + 1)) {
+			consecutive_inputs += 1;
 		}
 	}
 }
@@ -916,16 +1112,22 @@ void ServerController::on_peer_update(bool p_peer_enabled) {
 
 	// ~~ Reset everything to avoid accumulate old data. ~~
 	RemotelyControlledController::on_peer_update(p_peer_enabled);
+	forwarding_frames_input.clear();
+	oldest_input_to_forward = FrameIndex::NONE;
 }
 
 void ServerController::set_frame_input(const FrameInput &p_frame_snapshot, bool p_first_input) {
 	RemotelyControlledController::set_frame_input(p_frame_snapshot, p_first_input);
 }
 
-void ServerController::notify_send_state() {
+bool ServerController::is_current_input_void() const {
+	return current_input_buffer_id != FrameIndex::NONE && peer_controller->get_inputs_buffer().size() == 0;
+}
+
+void ServerController::notify_send_state(bool p_void_input) {
 	// If the notified input is a void buffer, the client is allowed to pause
 	// the input streaming. So missing packets are just handled as void inputs.
-	if (current_input_buffer_id != FrameIndex::NONE && peer_controller->get_inputs_buffer().size() == 0) {
+	if (p_void_input) {
 		streaming_paused = true;
 	}
 }
@@ -934,35 +1136,137 @@ bool ServerController::receive_inputs(const std::vector<std::uint8_t> &p_data) {
 	const bool success = RemotelyControlledController::receive_inputs(p_data);
 
 	if (success) {
-		// The input parsing succeded on the server, now ping pong this to all the dolls.
-		std::vector<int> recipients;
-		for (int peer_id : peers_simulating_this_controller) {
-			if (peer_id == peer_controller->authority_peer || peer_id == peer_controller->scene_synchronizer->get_network_interface().get_server_peer()) {
-				continue;
+		// Track the lost packets: each packet carries a new input, so the
+		// newest inputs skipped are the lost packets.
+		received_input_packets += 1;
+		if (newest_received_input == FrameIndex::NONE || newest_received_input < last_packet_newest_input) {
+			if (newest_received_input != FrameIndex::NONE) {
+				const std::uint32_t lost_packets = last_packet_newest_input.id - newest_received_input.id - 1;
+				lost_input_packets += lost_packets;
+				longest_input_packets_loss = std::max(longest_input_packets_loss, lost_packets);
 			}
-			recipients.push_back(peer_id);
-		}
-
-		if (recipients.size() > 0) {
-			peer_controller->scene_synchronizer->call_rpc_receive_inputs(
-					recipients,
-					peer_controller->authority_peer,
-					p_data);
+			newest_received_input = last_packet_newest_input;
 		}
 	}
 
 	return success;
 }
 
+/// Exposes the consecutive inputs stored into the ring, as an array.
+struct FrameInputsRun {
+	FrameRingBuffer<FrameInput> &frames_input;
+	FrameIndex first_input_id;
+	std::size_t inputs_count;
+
+	std::size_t size() const {
+		return inputs_count;
+	}
+
+	FrameInput &operator[](std::size_t p_index) {
+		return *frames_input.find(first_input_id + std::uint32_t(p_index));
+	}
+};
+
+FrameIndex ServerController::get_first_input_to_forward(int p_redundant_inputs) const {
+	if (oldest_input_to_forward == FrameIndex::NONE) {
+		return FrameIndex::NONE;
+	}
+
+	const std::uint32_t previous_inputs = std::uint32_t(std::max(p_redundant_inputs, 1) - 1);
+	const FrameIndex first_input_id = forwarding_frames_input.front_index();
+	return oldest_input_to_forward.id - first_input_id.id > previous_inputs ? oldest_input_to_forward - previous_inputs : first_input_id;
+}
+
+const std::vector<std::uint8_t> *ServerController::encode_next_inputs_to_forward(FrameIndex &r_input_id) {
+	if (r_input_id == FrameIndex::NONE) {
+		return nullptr;
+	}
+
+	// The inputs lost or received out of order leave gaps between the IDs,
+	// while the inputs in a packet must be consecutive.
+	const FrameInput *first_input = forwarding_frames_input.find_at_or_after(r_input_id);
+	if (!first_input) {
+		return nullptr;
+	}
+
+	FrameInputsRun run{ forwarding_frames_input, first_input->id, 1 };
+	while (forwarding_frames_input.find(run.first_input_id + std::uint32_t(run.inputs_count))) {
+		run.inputs_count += 1;
+	}
+
+	peer_controller->encode_inputs(run, 0, run.inputs_count, cached_forward_packet);
+	r_input_id = run.first_input_id + std::uint32_t(run.inputs_count);
+	return &cached_forward_packet;
+}
+
+void ServerController::notify_inputs_forwarded() {
+	oldest_input_to_forward = FrameIndex::NONE;
+
+	if (forwarding_frames_input.empty()) {
+		return;
+	}
+
+	// Keep the newest inputs, forwarded again with the next ones.
+	const std::uint32_t kept_inputs = std::uint32_t(std::max(1, peer_controller->get_max_redundant_inputs()));
+	const FrameIndex newest_input_id = forwarding_frames_input.back_index();
+	if (newest_input_id.id - forwarding_frames_input.front_index().id >= kept_inputs) {
+		forwarding_frames_input.remove_older_than(newest_input_id + 1 - kept_inputs);
+	}
+}
+
+FrameInput *ServerController::store_input_to_forward(FrameIndex p_input_id) {
+	bool inserted;
+	FrameInput *input = forwarding_frames_input.insert(p_input_id, inserted);
+	if (input && (oldest_input_to_forward == FrameIndex::NONE || p_input_id < oldest_input_to_forward)) {
+		oldest_input_to_forward = p_input_id;
+	}
+	return input;
+}
+
+void ServerController::on_input_stored(const FrameInput &p_input) {
+	FrameInput *input = store_input_to_forward(p_input.id);
+	if (input) {
+		// This reuses the slot memory.
+		*input = p_input;
+	}
+}
+
+int ServerController::fetch_optimal_redundant_inputs(float p_reported_packet_loss) {
+	const SceneSynchronizerBase &scene_sync = *peer_controller->scene_synchronizer;
+	const int max_redundant_inputs = std::max(1, scene_sync.get_max_redundant_inputs());
+	const int min_redundant_inputs = std::clamp(scene_sync.get_min_redundant_inputs(), 1, max_redundant_inputs);
+
+	const std::uint32_t sent_input_packets = received_input_packets + lost_input_packets;
+	const float observed_packet_loss = sent_input_packets > 0 ? float(lost_input_packets) / float(sent_input_packets) : 0.0f;
+	const float packet_loss = std::max(observed_packet_loss, p_reported_packet_loss);
+
+	// The burst decreases slowly, so the redundancy doesn't oscillate when
+	// the bursts are sporadic.
+	input_packets_loss_burst = std::max(longest_input_packets_loss, input_packets_loss_burst > 0 ? input_packets_loss_burst - 1 : 0);
+
+	// 1. After a burst of N lost packets, the next packet must contain N+1
+	//    inputs to deliver all of them.
+	int redundant_inputs = int(std::min(input_packets_loss_burst, std::uint32_t(max_redundant_inputs))) + 1;
+
+	// 2. Each input is lost only if all the R packets containing it are lost:
+	//    with a packet loss P that happens with probability P^R, so pick the
+	//    R making it negligible.
+	if (packet_loss > scene_sync.get_negligible_packet_loss()) {
+		const float clamped_packet_loss = std::min(packet_loss, 0.99f);
+		const float required = std::log(scene_sync.get_negligible_packet_loss()) / std::log(clamped_packet_loss);
+		redundant_inputs = std::max(redundant_inputs, int(std::ceil(std::min(required, float(max_redundant_inputs)))));
+	}
+
+	received_input_packets = 0;
+	lost_input_packets = 0;
+	longest_input_packets_loss = 0;
+
+	return std::clamp(redundant_inputs, min_redundant_inputs, max_redundant_inputs);
+}
+
 AutonomousServerController::AutonomousServerController(
 		PeerNetworkedController *p_peer_controller) :
 	ServerController(p_peer_controller) {
-	event_handler_on_app_process_end =
-			peer_controller->scene_synchronizer->event_app_process_end.bind(std::bind(&AutonomousServerController::on_app_process_end, this, std::placeholders::_1));
-}
-
-AutonomousServerController::~AutonomousServerController() {
-	event_handler_on_app_process_end = nullptr;
 }
 
 bool AutonomousServerController::receive_inputs(const std::vector<std::uint8_t> &p_data) {
@@ -990,40 +1294,15 @@ bool AutonomousServerController::fetch_next_input(float p_delta) {
 		current_input_buffer_id += 1;
 	}
 
-	peer_controller->store_input_buffer(frames_input, current_input_buffer_id);
+	FrameInput *input = store_input_to_forward(current_input_buffer_id);
+	if (input) {
+		peer_controller->store_input_buffer(*input, current_input_buffer_id);
+	}
 
 	// The input is always new.
 	return true;
 }
 
-void AutonomousServerController::on_app_process_end(float p_delta_seconds) {
-	// Removes all the old inputs
-	while (frames_input.size() > peer_controller->get_max_redundant_inputs()) {
-		frames_input.pop_front();
-	}
-
-	// Send inputs to clients.
-	if (frames_input.size() == 0) {
-		return;
-	}
-
-	peer_controller->encode_inputs(frames_input, cached_packet_data);
-
-	std::vector<int> recipients;
-	for (int peer_id : peers_simulating_this_controller) {
-		if (peer_id != peer_controller->authority_peer) {
-			recipients.push_back(peer_id);
-		}
-	}
-
-	if (recipients.size() > 0) {
-		peer_controller->scene_synchronizer->call_rpc_receive_inputs(
-				recipients,
-				peer_controller->authority_peer,
-				cached_packet_data);
-	}
-}
-
 PlayerController::PlayerController(PeerNetworkedController *p_peer_controller) :
 	Controller(p_peer_controller),
 	current_input_id(FrameIndex::NONE),
@@ -1168,20 +1447,7 @@ void PlayerController::process(float p_delta) {
 		NS_ASSERT_COND_MSG(accept_new_inputs, "This can't be triggered because this function is never executed since the `ClientSynchronizer::can_execute_scene_process()` ensure this is paused if no more inputs can be collected.");
 #endif
 
-		current_input_id = FrameIndex{ { input_buffers_counter } };
-
-		peer_controller->get_debugger().print(VERBOSE, "Player process index: " + std::string(current_input_id), "CONTROLLER-" + std::to_string(peer_controller->authority_peer));
-
-		peer_controller->controllable_collect_input(p_delta, peer_controller->get_inputs_buffer_mut());
-
-		// Unpause streaming?
-		if (peer_controller->get_inputs_buffer().size() > 0) {
-			streaming_paused = false;
-		}
-
-		peer_controller->get_inputs_buffer_mut().dry();
-		peer_controller->get_inputs_buffer_mut().begin_read(get_debugger());
-		peer_controller->get_inputs_buffer_mut().seek(METADATA_SIZE); // Skip meta.
+		collect_new_input(p_delta);
 
 		peer_controller->get_debugger().databuffer_operation_begin_record(peer_controller->authority_peer, SceneSynchronizerDebugger::READ);
 		// The physics process is always emitted, because we still need to simulate
@@ -1189,15 +1455,49 @@ void PlayerController::process(float p_delta) {
 		peer_controller->controllable_process(p_delta, peer_controller->get_inputs_buffer_mut());
 		peer_controller->get_debugger().databuffer_operation_end_record();
 
-		if (!streaming_paused) {
-			input_buffers_counter += 1;
-			peer_controller->store_input_buffer(frames_input, current_input_id);
+		store_new_input();
+	}
+}
 
-			// Keep sending inputs, despite the server seems not responding properly,
-			// to make sure the server becomes up to date at some point.
-			has_pending_inputs_sent = true;
-		}
+bool PlayerController::collect_deferred_input(float p_delta) {
+	if (!peer_controller->is_ready_to_process()) {
+		// Nothing to collect.
+		return false;
+	}
+
+	collect_new_input(p_delta);
+	return store_new_input();
+}
+
+void PlayerController::collect_new_input(float p_delta) {
+	current_input_id = FrameIndex{ { input_buffers_counter } };
+
+	peer_controller->get_debugger().print(VERBOSE, "Player process index: " + std::string(current_input_id), "CONTROLLER-" + std::to_string(peer_controller->authority_peer));
+
+	peer_controller->controllable_collect_input(p_delta, peer_controller->get_inputs_buffer_mut());
+
+	// Unpause streaming?
+	if (peer_controller->get_inputs_buffer().size() > 0) {
+		streaming_paused = false;
 	}
+
+	peer_controller->get_inputs_buffer_mut().dry();
+	peer_controller->get_inputs_buffer_mut().begin_read(get_debugger());
+	peer_controller->get_inputs_buffer_mut().seek(METADATA_SIZE); // Skip meta.
+}
+
+bool PlayerController::store_new_input() {
+	if (streaming_paused) {
+		return false;
+	}
+
+	input_buffers_counter += 1;
+	peer_controller->store_input_buffer(frames_input, current_input_id);
+
+	// Keep sending inputs, despite the server seems not responding properly,
+	// to make sure the server becomes up to date at some point.
+	has_pending_inputs_sent = true;
+	return true;
 }
 
 void PlayerController::on_state_validated(FrameIndex p_frame_index, bool p_detected_desync) {
@@ -1242,28 +1542,19 @@ bool PlayerController::can_accept_new_inputs() const {
 
 DollController::DollController(PeerNetworkedController *p_peer_controller) :
 	RemotelyControlledController(p_peer_controller) {
-	event_handler_received_snapshot =
-			peer_controller->scene_synchronizer->event_received_server_snapshot.bind(std::bind(&DollController::on_received_server_snapshot, this, std::placeholders::_1));
-
-	event_handler_client_snapshot_updated =
-			peer_controller->scene_synchronizer->event_snapshot_update_finished.bind(std::bind(&DollController::on_snapshot_update_finished, this, std::placeholders::_1));
+	// The snapshots are indexed by the doll executed input, so they can't
+	// span more frames than the stored inputs. Bounding the rings, the stale
+	// snapshots are dropped rather than growing the storage when the frame
+	// index jumps, e.g. after the doll pauses and resumes.
+	server_snapshots.set_max_capacity(frames_input.get_max_capacity());
+	client_snapshots.set_max_capacity(frames_input.get_max_capacity());
 
 	event_handler_state_validated =
 			peer_controller->scene_synchronizer->event_state_validated.bind(std::bind(&DollController::on_state_validated, this, std::placeholders::_1, std::placeholders::_2));
-
-	event_handler_rewind_frame_begin =
-			peer_controller->scene_synchronizer->event_rewind_frame_begin.bind(std::bind(&DollController::on_rewind_frame_begin, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-
-	event_handler_snapshot_applied =
-			peer_controller->scene_synchronizer->event_snapshot_applied.bind(std::bind(&DollController::on_snapshot_applied, this, std::placeholders::_1, std::placeholders::_2));
 }
 
 DollController::~DollController() {
-	event_handler_received_snapshot = nullptr;
-	event_handler_client_snapshot_updated = nullptr;
 	event_handler_state_validated = nullptr;
-	event_handler_rewind_frame_begin = nullptr;
-	event_handler_snapshot_applied = nullptr;
 }
 
 bool DollController::receive_inputs(const std::vector<uint8_t> &p_data) {
@@ -1286,27 +1577,7 @@ bool DollController::receive_inputs(const std::vector<uint8_t> &p_data) {
 					return;
 				}
 
-				FrameInput rfs(pd->controller.get_debugger());
-				rfs.id = p_frame_index;
-
-				const bool found = std::binary_search(
-						pd->controller.frames_input.begin(),
-						pd->controller.frames_input.end(),
-						rfs,
-						is_remote_frame_A_older);
-
-				if (!found) {
-					rfs.buffer_size_bit = p_input_size_in_bits;
-					rfs.inputs_buffer = p_bit_array;
-
-					pd->controller.frames_input.push_back(std::move(rfs));
-
-					// Sort the added frame input.
-					NS_JOLT::QuickSort(
-							pd->controller.frames_input.begin(),
-							pd->controller.frames_input.end(),
-							is_remote_frame_A_older);
-				}
+				pd->controller.store_received_input(p_frame_index, p_input_size_in_bits, p_bit_array);
 			});
 
 	if (!success) {
@@ -1316,10 +1587,6 @@ bool DollController::receive_inputs(const std::vector<uint8_t> &p_data) {
 	return success;
 }
 
-bool is_doll_snap_A_older(const DollController::DollSnapshot &p_snap_a, const DollController::DollSnapshot &p_snap_b) {
-	return p_snap_a.doll_executed_input < p_snap_b.doll_executed_input;
-}
-
 void DollController::on_rewind_frame_begin(FrameIndex p_frame_index, int p_rewinding_index, int p_rewinding_frame_count) {
 	NS_PROFILE
 
@@ -1361,14 +1628,10 @@ bool DollController::fetch_next_input(float p_delta) {
 		// phase.
 		const FrameIndex frame_to_process = queued_frame_index_to_process + queued_instant_to_process;
 		// Search the input.
-		for (const FrameInput &frame : frames_input) {
-			if (frame.id == frame_to_process) {
-				set_frame_input(frame, false);
-				return true;
-			} else if (frame_to_process < frame.id) {
-				// The frames are sorted, so it's impossible we find the frame in this case.
-				break;
-			}
+		const FrameInput *frame = frames_input.find(frame_to_process);
+		if (frame) {
+			set_frame_input(*frame, false);
+			return true;
 		}
 		// The doll controller is compensating for missing inputs, so return
 		// false, on this frame to stop processing untill then.
@@ -1388,26 +1651,10 @@ bool DollController::fetch_next_input(float p_delta) {
 	const FrameIndex next_input_id = current_input_buffer_id + 1;
 
 	// -------------------------------------------------------- Search the input
-	int closest_frame_index = -1;
-	int closest_frame_distance = std::numeric_limits<int>::max();
-	// NOTE: Iterating in reverse order since I've noticed it's likely to find
-	// the input at the end of this vector.
-	for (int i = (int)frames_input.size() - 1; i >= 0; i--) {
-		if (frames_input[i].id == next_input_id) {
-			set_frame_input(frames_input[i], false);
-			return true;
-		}
-
-		const int distance = (int)std::abs(std::int64_t(frames_input[i].id.id) - std::int64_t(next_input_id.id));
-		if (distance < closest_frame_distance) {
-			closest_frame_index = i;
-			closest_frame_distance = distance;
-		} else {
-			// The frames_input is a sorted vector, when the distance to the
-			// searched input increases it means we can't find it anylonger.
-			// So interrupt the loop.
-			break;
-		}
+	const FrameInput *next_input = frames_input.find(next_input_id);
+	if (next_input) {
+		set_frame_input(*next_input, false);
+		return true;
 	}
 
 	if (!peer_controller->scene_synchronizer->get_settings().lag_compensation.doll_allow_guess_input_when_missing) {
@@ -1416,13 +1663,20 @@ bool DollController::fetch_next_input(float p_delta) {
 		return false;
 	}
 
-	if (closest_frame_index >= 0) {
+	// Pick the closest input, preferring the newer one when equally distant.
+	const FrameInput *closest_frame = frames_input.find_at_or_after(next_input_id);
+	const FrameInput *previous_frame = frames_input.find_at_or_before(next_input_id);
+	if (previous_frame && (!closest_frame || (next_input_id.id - previous_frame->id.id) < (closest_frame->id.id - next_input_id.id))) {
+		closest_frame = previous_frame;
+	}
+
+	if (closest_frame) {
 		// It was impossible to find the input, so just pick the closest one and
 		// assume it's the one we are executing.
-		FrameInput guessed_fi = frames_input[closest_frame_index];
+		FrameInput guessed_fi = *closest_frame;
 		guessed_fi.id = next_input_id;
 		set_frame_input(guessed_fi, false);
-		peer_controller->get_debugger().print(VERBOSE, "The input " + next_input_id + " is missing. Copying it from " + std::string(frames_input[closest_frame_index].id));
+		peer_controller->get_debugger().print(VERBOSE, "The input " + next_input_id + " is missing. Copying it from " + std::string(closest_frame->id));
 		return true;
 	} else {
 		// The input is not set and there is no suitable one.
@@ -1438,10 +1692,10 @@ void DollController::process(float p_delta) {
 		// timeline than the one processed by the client.
 		// Whenever it found a server snapshot, it's applied.
 		// 1. Try fetching the previous server snapshot.
-		auto server_snap_it = VecFunc::find(server_snapshots, DollSnapshot(current_input_buffer_id - 1));
-		if (server_snap_it != server_snapshots.end()) {
+		const DollSnapshot *server_snap = server_snapshots.find(current_input_buffer_id - 1);
+		if (server_snap) {
 			// 2. The snapshot was found, so apply it.
-			static_cast<ClientSynchronizer *>(peer_controller->scene_synchronizer->get_synchronizer_internal())->apply_snapshot(server_snap_it->data, 0, 0, nullptr, true, true, true, true, true, false);
+			static_cast<ClientSynchronizer *>(peer_controller->scene_synchronizer->get_synchronizer_internal())->apply_snapshot(server_snap->data, 0, 0, nullptr, true, true, true, true, true, false);
 		}
 	}
 
@@ -1489,9 +1743,7 @@ void DollController::notify_frame_checked(FrameIndex p_doll_frame_index) {
 		//       It's quite important to keep that snapshot to ensure the function
 		//       `apply_snapshot_instant_input_reconciliation` can work properly.
 		//       It needs the snapshot the doll is at, to safely apply the reconciliation.
-		while (!server_snapshots.empty() && server_snapshots.front().doll_executed_input < p_doll_frame_index) {
-			VecFunc::remove_at(server_snapshots, 0);
-		}
+		server_snapshots.remove_older_than(p_doll_frame_index);
 
 		// Removed all the checked doll frame snapshots.
 		// NOTE: This logic is removing all the snapshots older than the specified
@@ -1499,12 +1751,10 @@ void DollController::notify_frame_checked(FrameIndex p_doll_frame_index) {
 		//       It's quite important to keep that snapshot to ensure the function
 		//       `apply_snapshot_instant_input_reconciliation` can work properly.
 		//       It needs the snapshot the doll is at, to safely apply the reconciliation.
-		while (!client_snapshots.empty() && client_snapshots.front().doll_executed_input < p_doll_frame_index) {
-			VecFunc::remove_at(client_snapshots, 0);
-		}
+		client_snapshots.remove_older_than(p_doll_frame_index);
 	} else {
-		VecFunc::remove(server_snapshots, FrameIndex::NONE);
-		VecFunc::remove(client_snapshots, FrameIndex::NONE);
+		// NOTE: The client snapshots are never stored without a doll executed input.
+		has_not_simulated_server_snapshot = false;
 	}
 
 	last_doll_validated_input = p_doll_frame_index;
@@ -1514,13 +1764,7 @@ void DollController::clear_previously_generated_client_snapshots() {
 	if make_likely(current_input_buffer_id != FrameIndex::NONE) {
 		// Removed all the client snapshots which input is more than the specified one
 		// to ensure the function `__pcr__fetch_recovery_info` works properly.
-		for (int i = int(client_snapshots.size()) - 1; i >= 0; i--) {
-			if (client_snapshots[i].doll_executed_input > current_input_buffer_id) {
-				VecFunc::remove_at(client_snapshots, i);
-			} else {
-				break;
-			}
-		}
+		client_snapshots.remove_newer_than(current_input_buffer_id);
 	}
 }
 
@@ -1538,9 +1782,10 @@ void DollController::on_received_server_snapshot(const Snapshot &p_snapshot) {
 		// The received snapshot doesn't have a FrameIndex set, it means there is no controller
 		// so assume this is the most up-to-date snapshot.
 		server_snapshots.clear();
+		has_not_simulated_server_snapshot = false;
 	} else {
 		// Make sure to remove all the snapshots with FrameIndex::NONE received before this one.
-		VecFunc::remove(server_snapshots, DollSnapshot(FrameIndex::NONE));
+		has_not_simulated_server_snapshot = false;
 	}
 
 	copy_controlled_objects_snapshot(p_snapshot, server_snapshots, true);
@@ -1559,22 +1804,14 @@ void DollController::on_snapshot_update_finished(const Snapshot &p_snapshot) {
 
 void DollController::copy_controlled_objects_snapshot(
 		const Snapshot &p_snapshot,
-		std::vector<DollSnapshot> &r_snapshots,
+		FrameRingBuffer<DollSnapshot> &r_snapshots,
 		bool p_store_even_when_doll_is_not_processing) {
 	NS_PROFILE
 	const FrameIndexWithMeta doll_executed_input_meta = MapFunc::at(p_snapshot.peers_frames_index, peer_controller->get_authority_peer(), FrameIndexWithMeta());
 
-	std::vector<ObjectData *> controlled_objects;
-	for (const SimulatedObjectInfo &sim_object : p_snapshot.simulated_objects) {
-		if (sim_object.controlled_by_peer == peer_controller->get_authority_peer()) {
-			ObjectData *object_data = peer_controller->scene_synchronizer->get_object_data(sim_object.net_id);
-			if (object_data) {
-				controlled_objects.push_back(peer_controller->scene_synchronizer->get_object_data(sim_object.net_id));
-			} else {
-				get_debugger().print(WARNING, "The object data with ID `" + sim_object.net_id + "` was not found, but it's expected to be found as this peer is simulating and controlling it. If this happens too many times and the game miss behave, this might be something to investigate.");
-			}
-		}
-	}
+	// NOTE: These are fetched by the `ClientSynchronizer` for all the dolls
+	//       at once, and are all simulated by the `p_snapshot`.
+	const std::vector<ObjectData *> &controlled_objects = snapshot_controlled_objects;
 
 	if (!p_store_even_when_doll_is_not_processing) {
 		if (doll_executed_input_meta.frame_index == FrameIndex::NONE) {
@@ -1588,14 +1825,27 @@ void DollController::copy_controlled_objects_snapshot(
 	}
 
 	DollSnapshot *snap;
-	{
-		auto it = VecFunc::find(r_snapshots, DollSnapshot(doll_executed_input_meta.frame_index));
-		if (it == r_snapshots.end()) {
-			r_snapshots.push_back(DollSnapshot(FrameIndex::NONE));
-			snap = &r_snapshots.back();
-			snap->doll_executed_input = doll_executed_input_meta.frame_index;
-		} else {
-			snap = &*it;
+	bool is_new_snapshot;
+	if (doll_executed_input_meta.frame_index == FrameIndex::NONE) {
+		// Only the server snapshots are stored when the doll is not processing.
+		NS_ASSERT_COND(&r_snapshots == &server_snapshots);
+		snap = &not_simulated_server_snapshot;
+		is_new_snapshot = !has_not_simulated_server_snapshot;
+		has_not_simulated_server_snapshot = true;
+	} else {
+		snap = r_snapshots.insert(doll_executed_input_meta.frame_index, is_new_snapshot);
+		if (!snap) {
+			// This snapshot is older than all the stored ones.
+			return;
+		}
+	}
+
+	if (is_new_snapshot) {
+		// The slot is recycled: drop the old data keeping the memory.
+		snap->doll_executed_input = doll_executed_input_meta.frame_index;
+		snap->data.simulated_objects.clear();
+		for (ObjectDataSnapshot &object : snap->data.objects) {
+			object.clear();
 		}
 	}
 
@@ -1626,11 +1876,6 @@ void DollController::copy_controlled_objects_snapshot(
 
 	// Now store the vars info.
 	for (ObjectData *object_data : controlled_objects) {
-		if (!VecFunc::has(p_snapshot.simulated_objects, object_data->get_net_id())) {
-			// This object was not simulated.
-			continue;
-		}
-
 		const std::vector<std::optional<VarData>> *vars = p_snapshot.get_object_vars(object_data->get_net_id());
 		NS_ENSURE_CONTINUE_MSG(vars, "[FATAL] The snapshot didn't contain the object: " + object_data->get_net_id() + ". If this error spams for a long period (1/2 seconds) or never recover, it's a bug since.");
 
@@ -1639,53 +1884,77 @@ void DollController::copy_controlled_objects_snapshot(
 
 		snap->data.simulated_objects.push_back(object_data->get_net_id());
 
-		// Copy the vars
-		snap->data.objects[object_data->get_net_id().id].vars.clear();
-		for (const std::optional<VarData> &nav : *vars) {
-			if (nav.has_value()) {
-				snap->data.objects[object_data->get_net_id().id].vars.push_back(VarData::make_copy(nav.value()));
+		// Copy the vars, into the already allocated storage.
+		ObjectDataSnapshot &object_snapshot = snap->data.objects[object_data->get_net_id().id];
+		object_snapshot.vars.resize(vars->size());
+		for (std::size_t v = 0; v < vars->size(); v++) {
+			if ((*vars)[v].has_value()) {
+				if (object_snapshot.vars[v].has_value()) {
+					object_snapshot.vars[v]->copy((*vars)[v].value());
+				} else {
+					object_snapshot.vars[v].emplace(VarData::make_copy((*vars)[v].value()));
+				}
 			} else {
-				snap->data.objects[object_data->get_net_id().id].vars.push_back(std::optional<VarData>());
+				object_snapshot.vars[v].reset();
 			}
 		}
 
 		// Copy the scheduled procedures
-		snap->data.objects[object_data->get_net_id().id].procedures.clear();
-		for (const ScheduledProcedureSnapshot &proc : *procedures) {
-			snap->data.objects[object_data->get_net_id().id].procedures.push_back(proc);
-		}
+		object_snapshot.procedures.assign(procedures->begin(), procedures->end());
 	}
 
-	// This array must be always sorted to ensure the snapshots order.
-	NS_JOLT::QuickSort(
-			r_snapshots.begin(),
-			r_snapshots.end(),
-			is_doll_snap_A_older);
+	snapshot_memory_usage = snap->data.get_memory_usage();
 }
 
 FrameIndex DollController::fetch_checkable_snapshot(DollSnapshot *&r_client_snapshot, DollSnapshot *&r_server_snapshot) {
 	clear_previously_generated_client_snapshots();
 
-	for (auto client_snap_it = client_snapshots.rbegin(); client_snap_it != client_snapshots.rend(); client_snap_it++) {
-		if (client_snap_it->doll_executed_input != FrameIndex::NONE) {
-			NS_ASSERT_COND_MSG(client_snap_it->doll_executed_input <= current_input_buffer_id, "All the client snapshots are properly cleared when the `current_input_id` is manipulated. So this function is impossible to trigger. If it does, there is a bug on the `clear_previously_generated_client_snapshots`.");
+	if (client_snapshots.empty() || server_snapshots.empty()) {
+		return FrameIndex::NONE;
+	}
 
-			auto server_snap_it = VecFunc::find(server_snapshots, client_snap_it->doll_executed_input);
-			if (server_snap_it != server_snapshots.end()) {
-				r_client_snapshot = &(*client_snap_it);
-				r_server_snapshot = &*server_snap_it;
-				return client_snap_it->doll_executed_input;
+	// Only the frames having both the snapshots can be checked.
+	const FrameIndex newest = std::min(client_snapshots.back_index(), server_snapshots.back_index());
+	const FrameIndex oldest = std::max(client_snapshots.front_index(), server_snapshots.front_index());
+	for (FrameIndex i = newest; oldest <= i && i != FrameIndex::NONE; i -= 1) {
+		DollSnapshot *client_snap = client_snapshots.find(i);
+		if (client_snap) {
+			NS_ASSERT_COND_MSG(client_snap->doll_executed_input <= current_input_buffer_id, "All the client snapshots are properly cleared when the `current_input_id` is manipulated. So this function is impossible to trigger. If it does, there is a bug on the `clear_previously_generated_client_snapshots`.");
+
+			DollSnapshot *server_snap = server_snapshots.find(i);
+			if (server_snap) {
+				r_client_snapshot = client_snap;
+				r_server_snapshot = server_snap;
+				return i;
 			}
 		}
 	}
 	return FrameIndex::NONE;
 }
 
+std::size_t DollController::get_snapshots_memory_usage() const {
+	const std::size_t snapshots_count = server_snapshots.size() + client_snapshots.size() + (has_not_simulated_server_snapshot ? 1 : 0);
+	return snapshots_count * snapshot_memory_usage;
+}
+
+std::size_t DollController::drop_oldest_snapshots(std::size_t p_max_snapshots) {
+	std::size_t dropped = 0;
+	while (server_snapshots.size() + client_snapshots.size() > p_max_snapshots) {
+		// Drops the oldest one, between the server and the client snapshots.
+		const bool drop_server = client_snapshots.empty() || (!server_snapshots.empty() && server_snapshots.front_index() <= client_snapshots.front_index());
+		FrameRingBuffer<DollSnapshot> &snapshots = drop_server ? server_snapshots : client_snapshots;
+		snapshots.remove_older_than(snapshots.front_index() + 1);
+		dropped += 1;
+	}
+	return dropped;
+}
+
 bool DollController::__pcr__fetch_recovery_info(
 		const FrameIndex p_checking_frame_index,
 		const int p_frame_count_to_rewind,
 		Snapshot *r_no_rewind_recover,
-		std::vector<std::string> *r_differences_info
+		std::vector<std::string> *r_differences_info,
+		std::vector<std::pair<ObjectNetId, VarId>> *r_rewind_trigger_vars
 #ifdef NS_DEBUG_ENABLED
 		,
 		std::vector<ObjectNetId> *r_different_node_data
@@ -1726,7 +1995,8 @@ bool DollController::__pcr__fetch_recovery_info(
 			client_snapshot->data,
 			peer_controller->get_authority_peer(),
 			r_no_rewind_recover,
-			r_differences_info
+			r_differences_info,
+			r_rewind_trigger_vars
 #ifdef NS_DEBUG_ENABLED
 			,
 			r_different_node_data
@@ -1738,7 +2008,8 @@ bool DollController::__pcr__fetch_recovery_info(
 
 void DollController::on_snapshot_applied(
 		const Snapshot &p_global_server_snapshot,
-		const int p_frame_count_to_rewind) {
+		const int p_frame_count_to_rewind,
+		std::vector<const Snapshot *> &r_snapshots_to_apply) {
 #ifdef NS_DEBUG_ENABLED
 	// The `DollController` is never created on the server, and the below
 	// assertion is always satisfied.
@@ -1757,9 +2028,9 @@ void DollController::on_snapshot_applied(
 
 	skip_snapshot_validation = false;
 
-	if make_unlikely(!server_snapshots.empty() && server_snapshots.back().doll_executed_input == FrameIndex::NONE) {
+	if make_unlikely(has_not_simulated_server_snapshot) {
 		// This controller is not simulating on the server. This function handles this case.
-		apply_snapshot_no_simulation(p_global_server_snapshot);
+		apply_snapshot_no_simulation(p_global_server_snapshot, r_snapshots_to_apply);
 	}
 
 	const FrameIndexWithMeta doll_executed_input_meta = MapFunc::at(p_global_server_snapshot.peers_frames_index, peer_controller->get_authority_peer(), FrameIndexWithMeta());
@@ -1769,49 +2040,39 @@ void DollController::on_snapshot_applied(
 
 		skip_snapshot_validation = true;
 
-		apply_snapshot_no_input_reconciliation(p_global_server_snapshot, doll_executed_input_meta.frame_index);
+		apply_snapshot_no_input_reconciliation(p_global_server_snapshot, doll_executed_input_meta.frame_index, r_snapshots_to_apply);
 		return;
 	}
 
 	if make_likely(current_input_buffer_id != FrameIndex::NONE) {
 		if (p_frame_count_to_rewind == 0) {
-			apply_snapshot_instant_input_reconciliation(p_global_server_snapshot, p_frame_count_to_rewind);
+			apply_snapshot_instant_input_reconciliation(p_global_server_snapshot, p_frame_count_to_rewind, r_snapshots_to_apply);
 		} else {
-			apply_snapshot_rewinding_input_reconciliation(p_global_server_snapshot, p_frame_count_to_rewind);
+			apply_snapshot_rewinding_input_reconciliation(p_global_server_snapshot, p_frame_count_to_rewind, r_snapshots_to_apply);
 		}
 	}
 }
 
-void DollController::apply_snapshot_no_simulation(const Snapshot &p_global_server_snapshot) {
+void DollController::apply_snapshot_no_simulation(const Snapshot &p_global_server_snapshot, std::vector<const Snapshot *> &r_snapshots_to_apply) {
 	// Apply the latest received server snapshot right away since the doll is not
 	// yet still processing on the server.
 
-	NS_ASSERT_COND(server_snapshots.back().doll_executed_input == FrameIndex::NONE);
+	NS_ASSERT_COND(has_not_simulated_server_snapshot);
 
-	static_cast<ClientSynchronizer *>(peer_controller->scene_synchronizer->get_synchronizer_internal())->apply_snapshot(server_snapshots.back().data, 0, 0, nullptr, true, true, true, true, true, false);
+	r_snapshots_to_apply.push_back(&not_simulated_server_snapshot.data);
 	last_doll_compared_input = FrameIndex::NONE;
 	current_input_buffer_id = FrameIndex::NONE;
 	queued_frame_index_to_process = FrameIndex::NONE;
 }
 
-void DollController::apply_snapshot_no_input_reconciliation(const Snapshot &p_global_server_snapshot, FrameIndex p_frame_index) {
-	static_cast<ClientSynchronizer *>(peer_controller->scene_synchronizer->get_synchronizer_internal())->apply_snapshot(
-			p_global_server_snapshot,
-			0,
-			0,
-			nullptr,
-			true,
-			true,
-			true,
-			true,
-			true,
-			false);
+void DollController::apply_snapshot_no_input_reconciliation(const Snapshot &p_global_server_snapshot, FrameIndex p_frame_index, std::vector<const Snapshot *> &r_snapshots_to_apply) {
+	r_snapshots_to_apply.push_back(&p_global_server_snapshot);
 	current_input_buffer_id = p_frame_index;
 	queued_frame_index_to_process = current_input_buffer_id + 1;
 	skip_snapshot_validation = true;
 }
 
-void DollController::apply_snapshot_instant_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind) {
+void DollController::apply_snapshot_instant_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind, std::vector<const Snapshot *> &r_snapshots_to_apply) {
 	// This function assume the "frame count to rewind" is always 0.
 	NS_ASSERT_COND(p_frame_count_to_rewind == 0);
 
@@ -1847,25 +2108,18 @@ void DollController::apply_snapshot_instant_input_reconciliation(const Snapshot
 	//    Notice that this logic is build so to prefer building a bigger input buffer
 	//    than needed, while keeping the scene consistent, rather than breaking
 	//    the synchronization.
-	const DollSnapshot *snapshot_to_apply = nullptr;
-	for (const DollSnapshot &snapshot : server_snapshots) {
-		if (snapshot.doll_executed_input <= last_doll_compared_input) {
-			snapshot_to_apply = &snapshot;
-		} else {
-			break;
-		}
-	}
+	const DollSnapshot *snapshot_to_apply = server_snapshots.find_at_or_before(last_doll_compared_input);
 
 	// 4. Just apply the snapshot.
 	if (snapshot_to_apply) {
-		static_cast<ClientSynchronizer *>(peer_controller->scene_synchronizer->get_synchronizer_internal())->apply_snapshot(snapshot_to_apply->data, 0, 0, nullptr, true, true, true, true, true, false);
+		r_snapshots_to_apply.push_back(&snapshot_to_apply->data);
 		// Bring everything back to this point.
 		last_doll_compared_input = snapshot_to_apply->doll_executed_input;
 		current_input_buffer_id = last_doll_compared_input;
 	}
 }
 
-void DollController::apply_snapshot_rewinding_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind) {
+void DollController::apply_snapshot_rewinding_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind, std::vector<const Snapshot *> &r_snapshots_to_apply) {
 	// This function applies the snapshot and handles the reconciliation mechanism
 	// during the rewinding process.
 	// The input reconciliation performed during the rewinding is the best because
@@ -1899,30 +2153,25 @@ void DollController::apply_snapshot_rewinding_input_reconciliation(const Snapsho
 		// 4. Ensure there is a server snapshot at some point, in between the new
 		//    rewinding process queue or return and wait until there is a
 		//    server snapshot.
-		bool server_snapshot_found = false;
-		for (auto it = server_snapshots.rbegin(); it != server_snapshots.rend(); it++) {
-			if (it->doll_executed_input < (new_last_doll_compared_input + optimal_input_count)) {
-				if make_likely(it->doll_executed_input > new_last_doll_compared_input) {
-					// This is the most common case: The server snapshot is in between the rewinding.
-					// Nothing to do here.
-				} else if (it->doll_executed_input == new_last_doll_compared_input) {
-					// In this case the rewinding is still in between the rewinding
-					// though as an optimization we just assign the snapshot to apply
-					// to avoid searching it.
-					server_snapshot = &*it;
-				} else {
-					// In this case the server snapshot ISN'T part of the rewinding
-					// so it brings the rewinding back a bit, to ensure the server
-					// snapshot is applied.
-					new_last_doll_compared_input = it->doll_executed_input;
-					server_snapshot = &*it;
-				}
-				server_snapshot_found = true;
-				break;
+		// NOTE: `optimal_input_count` is always greater than 0.
+		const DollSnapshot *newest_server_snapshot = server_snapshots.find_at_or_before(new_last_doll_compared_input + optimal_input_count - 1);
+		if (newest_server_snapshot) {
+			if make_likely(newest_server_snapshot->doll_executed_input > new_last_doll_compared_input) {
+				// This is the most common case: The server snapshot is in between the rewinding.
+				// Nothing to do here.
+			} else if (newest_server_snapshot->doll_executed_input == new_last_doll_compared_input) {
+				// In this case the rewinding is still in between the rewinding
+				// though as an optimization we just assign the snapshot to apply
+				// to avoid searching it.
+				server_snapshot = newest_server_snapshot;
+			} else {
+				// In this case the server snapshot ISN'T part of the rewinding
+				// so it brings the rewinding back a bit, to ensure the server
+				// snapshot is applied.
+				new_last_doll_compared_input = newest_server_snapshot->doll_executed_input;
+				server_snapshot = newest_server_snapshot;
 			}
-		}
-
-		if (!server_snapshot_found) {
+		} else {
 			// Server snapshot not found: Set this to none to signal that this
 			// rewind should not be performed.
 			new_last_doll_compared_input = FrameIndex::NONE;
@@ -1959,27 +2208,20 @@ void DollController::apply_snapshot_rewinding_input_reconciliation(const Snapsho
 		//    for the input we have to reset.
 		//    In this case, it's mandatory to apply that, to ensure the scene
 		//    reconciliation.
-		static_cast<ClientSynchronizer *>(peer_controller->scene_synchronizer->get_synchronizer_internal())->apply_snapshot(server_snapshots.back().data, 0, 0, nullptr, true, true, true, true, true, false);
+		r_snapshots_to_apply.push_back(&server_snapshots.back().data);
 	} else if make_likely(!client_snapshots.empty()) {
 		// 7. Get the closest available snapshot, and apply it, no need to be
 		//    precise here, since the process will apply the server snapshot
 		//    when available.
-		int distance = std::numeric_limits<int>::max();
-		DollSnapshot *best = nullptr;
-		for (auto &snap : client_snapshots) {
-			const int delta = (int)std::abs(std::int64_t(last_doll_compared_input.id) - std::int64_t(snap.doll_executed_input.id));
-			if (delta < distance) {
-				best = &snap;
-				distance = delta;
-			} else {
-				// Since the snapshots are sorted, it can interrupt the
-				// processing right after the distance start increasing.
-				break;
-			}
+		//    On equal distance, the older snapshot is preferred.
+		DollSnapshot *best = client_snapshots.find_at_or_before(last_doll_compared_input);
+		DollSnapshot *next = client_snapshots.find_at_or_after(last_doll_compared_input);
+		if (!best || (next && (next->doll_executed_input.id - last_doll_compared_input.id) < (last_doll_compared_input.id - best->doll_executed_input.id))) {
+			best = next;
 		}
 
 		if (best) {
-			static_cast<ClientSynchronizer *>(peer_controller->scene_synchronizer->get_synchronizer_internal())->apply_snapshot(best->data, 0, 0, nullptr, true, true, true, true, true, false);
+			r_snapshots_to_apply.push_back(&best->data);
 		}
 	}
 }
@@ -4,6 +4,7 @@
 #include "data_buffer.h"
 #include "event_processor.h"
 #include "processor.h"
+#include "ring_buffer.h"
 #include "snapshot.h"
 
 #include <deque>
@@ -89,6 +90,10 @@ private:
 
 	std::unique_ptr<EventProcessor<int, bool, bool>::Handler> event_handler_peer_status_updated;
 
+	/// The amount of time the player inputs are re-sent to the server, set by
+	/// the server depending on the connection health. -1 when not yet set.
+	int redundant_inputs = -1;
+
 public: // -------------------------------------------------------------- Events
 	EventProcessor<> event_controller_reset;
 #ifdef NS_DEBUG_ENABLED
@@ -107,6 +112,10 @@ public: // ---------------------------------------------------------------- APIs
 	const std::vector<ObjectData *> &get_sorted_controllable_objects();
 
 	int get_max_redundant_inputs() const;
+	/// Returns the amount of inputs sent with each packet, within the
+	/// `min_redundant_inputs` and `max_redundant_inputs` bounds.
+	int get_redundant_inputs() const;
+	void set_redundant_inputs(int p_redundant_inputs);
 
 	FrameIndex get_checked_frame_index() const;
 	FrameIndex get_current_frame_index() const;
@@ -170,7 +179,21 @@ public:
 	void notify_receive_inputs(const std::vector<std::uint8_t> &p_data);
 
 	void store_input_buffer(std::deque<FrameInput> &r_frames_input, FrameIndex p_frame_index);
+	/// Stores the current input into `r_input`, reusing its memory.
+	void store_input_buffer(FrameInput &r_input, FrameIndex p_frame_index);
 	void encode_inputs(std::deque<FrameInput> &p_frames_input, std::vector<std::uint8_t> &r_buffer);
+	/// Encodes `p_inputs_count` inputs starting from `p_first_input_index`.
+	/// `FrameInputs` is any container exposing `size()` and `operator[]`.
+	/// NOTE: The encoded inputs must have consecutive IDs.
+	template <typename FrameInputs>
+	void encode_inputs(FrameInputs &p_frames_input, std::size_t p_first_input_index, std::size_t p_inputs_count, std::vector<std::uint8_t> &r_buffer);
+
+private:
+	/// Writes the input into the packet, as the XOR against the previous input
+	/// when it takes less bits. When `p_previous_input` is null the input is
+	/// written in full.
+	void write_input_delta(std::vector<std::uint8_t> &r_buffer, int &r_bit_offset, const FrameInput *p_previous_input, const FrameInput &p_input);
+	void write_input_duplication(std::vector<std::uint8_t> &r_buffer, int &r_bit_offset, std::uint8_t p_duplication_count);
 
 public:
 	bool can_simulate();
@@ -213,7 +236,13 @@ struct Controller {
 struct RemotelyControlledController : public Controller {
 	FrameIndex current_input_buffer_id = FrameIndex::NONE;
 	std::uint32_t ghost_input_count = 0;
-	std::deque<FrameInput> frames_input;
+	/// The newest input contained by the last received inputs packet.
+	FrameIndex last_packet_newest_input = FrameIndex::NONE;
+	/// The processed frames which input was missing.
+	std::uint32_t missing_inputs_count = 0;
+	/// The received inputs, indexed by the input id: the redundant inputs are
+	/// discarded and the new ones are stored without allocating nor sorting.
+	FrameRingBuffer<FrameInput> frames_input;
 	// The stream is paused when the client send an empty buffer.
 	bool streaming_paused = false;
 
@@ -238,11 +267,40 @@ public:
 	virtual void process(float p_delta) override;
 
 	virtual bool receive_inputs(const std::vector<std::uint8_t> &p_data) override;
+
+protected:
+	/// Stores the received input, returns false if already stored.
+	bool store_received_input(FrameIndex p_input_id, std::uint16_t p_input_size_in_bits, const BitArray &p_input);
+
+	/// Called when a new input is stored by `store_received_input()`.
+	virtual void on_input_stored(const FrameInput &p_input) {}
 };
 
 struct ServerController : public RemotelyControlledController {
 	std::vector<int> peers_simulating_this_controller;
 
+	/// The input packets received and lost since the last netstats update.
+	/// Each packet contains a new input, so the lost packets are detected
+	/// through the gaps between the newest inputs.
+	std::uint32_t received_input_packets = 0;
+	std::uint32_t lost_input_packets = 0;
+	/// The longest sequence of lost input packets since the last netstats update.
+	std::uint32_t longest_input_packets_loss = 0;
+	/// The loss burst covered by the redundant inputs, it decreases by one
+	/// packet per netstats update.
+	std::uint32_t input_packets_loss_burst = 0;
+	FrameIndex newest_received_input = FrameIndex::NONE;
+
+	/// The inputs forwarded at the end of the tick to the peers simulating
+	/// this controller: the inputs stored during this tick, and the last
+	/// forwarded ones which are forwarded again, as the forwarding is unreliable.
+	/// The slots are reused, so storing the inputs to forward doesn't allocate.
+	/// Check `ServerSynchronizer::process_dolls_inputs_forwarding()`.
+	FrameRingBuffer<FrameInput> forwarding_frames_input;
+	/// The oldest input stored during this tick, NONE when there are no new inputs.
+	FrameIndex oldest_input_to_forward = FrameIndex::NONE;
+	std::vector<std::uint8_t> cached_forward_packet;
+
 	ServerController(
 			PeerNetworkedController *p_node);
 
@@ -252,25 +310,51 @@ struct ServerController : public RemotelyControlledController {
 
 	virtual void set_frame_input(const FrameInput &p_frame_snapshot, bool p_first_input) override;
 
-	void notify_send_state();
+	/// Returns true when the current input, notified by the snapshot, is void.
+	bool is_current_input_void() const;
+
+	/// Called once the snapshot notifying the input is sent. The `p_void_input`
+	/// is the `is_current_input_void()` taken when the snapshot was captured.
+	void notify_send_state(bool p_void_input);
 
 	virtual bool receive_inputs(const std::vector<std::uint8_t> &p_data) override;
-};
 
-struct AutonomousServerController final : public ServerController {
-	std::unique_ptr<EventProcessor<float>::Handler> event_handler_on_app_process_end = nullptr;
+	/// Returns the redundant inputs the client should send, to cover the
+	/// packet loss observed since the last call, and resets the statistics.
+	int fetch_optimal_redundant_inputs(float p_reported_packet_loss);
 
-	std::vector<std::uint8_t> cached_packet_data;
+	bool has_inputs_to_forward() const {
+		return oldest_input_to_forward != FrameIndex::NONE;
+	}
+
+	/// Returns the first input to forward to a peer receiving each input
+	/// `p_redundant_inputs` times: the new inputs and the ones preceding them.
+	FrameIndex get_first_input_to_forward(int p_redundant_inputs) const;
 
+	/// Encodes the inputs to forward having consecutive IDs, starting from
+	/// `r_input_id` which is moved past them.
+	/// Returns nullptr when all the inputs to forward were encoded.
+	const std::vector<std::uint8_t> *encode_next_inputs_to_forward(FrameIndex &r_input_id);
+
+	/// Called once the inputs are forwarded, keeps only the inputs to forward
+	/// again with the next ones.
+	void notify_inputs_forwarded();
+
+protected:
+	/// Returns the slot where the input to forward is stored, nullptr when
+	/// it's too old to be forwarded.
+	FrameInput *store_input_to_forward(FrameIndex p_input_id);
+
+	virtual void on_input_stored(const FrameInput &p_input) override;
+};
+
+struct AutonomousServerController final : public ServerController {
 	AutonomousServerController(
 			PeerNetworkedController *p_node);
-	~AutonomousServerController();
 
 	virtual bool receive_inputs(const std::vector<std::uint8_t> &p_data) override;
 	virtual int get_inputs_count() const override;
 	virtual bool fetch_next_input(float p_delta) override;
-
-	void on_app_process_end(float p_delta_seconds);
 };
 
 struct PlayerController final : public Controller {
@@ -302,6 +386,10 @@ struct PlayerController final : public Controller {
 	bool has_another_instant_to_process_after(int p_i) const;
 	bool has_queued_instant_to_process() const;
 	virtual void process(float p_delta) override;
+	/// Collects and stores the input of a new frame, without processing it.
+	/// The frame is processed later by the time-sliced rewind.
+	/// Returns false when no input was stored.
+	bool collect_deferred_input(float p_delta);
 	void on_state_validated(FrameIndex p_frame_index, bool p_detected_desync);
 	void on_app_process_end(float p_delta_seconds);
 
@@ -312,6 +400,10 @@ struct PlayerController final : public Controller {
 	void send_frame_input_buffer_to_server();
 
 	bool can_accept_new_inputs() const;
+
+private:
+	void collect_new_input(float p_delta);
+	bool store_new_input();
 };
 
 /// The doll controller is kind of special controller, it's using a
@@ -350,11 +442,9 @@ public:
 	};
 
 public:
-	std::unique_ptr<EventProcessor<const Snapshot &>::Handler> event_handler_received_snapshot = nullptr;
-	std::unique_ptr<EventProcessor<FrameIndex, int, int>::Handler> event_handler_rewind_frame_begin = nullptr;
+	// NOTE: The snapshots and the rewinding are notified by the `ClientSynchronizer`,
+	//       which reconciles all the dolls in a single pass.
 	std::unique_ptr<EventProcessor<FrameIndex, bool>::Handler> event_handler_state_validated = nullptr;
-	std::unique_ptr<EventProcessor<const Snapshot &>::Handler> event_handler_client_snapshot_updated = nullptr;
-	std::unique_ptr<EventProcessor<const Snapshot &, int>::Handler> event_handler_snapshot_applied = nullptr;
 
 	// The lastest `FrameIndex` validated.
 	FrameIndex last_doll_validated_input = FrameIndex::NONE;
@@ -365,11 +455,22 @@ public:
 	FrameIndex queued_frame_index_to_process = FrameIndex{ { 0 } };
 	int queued_instant_to_process = -1;
 
-	// Contains the controlled nodes frames snapshot.
-	std::vector<DollSnapshot> server_snapshots;
+	// Contains the controlled nodes frames snapshot, indexed by the doll executed input.
+	FrameRingBuffer<DollSnapshot> server_snapshots;
+	// The server snapshot received when the doll is not simulating on the server:
+	// it has no doll executed input, so it's stored apart.
+	bool has_not_simulated_server_snapshot = false;
+	DollSnapshot not_simulated_server_snapshot;
 
-	// Contains the controlled nodes frames snapshot.
-	std::vector<DollSnapshot> client_snapshots;
+	// Contains the controlled nodes frames snapshot, indexed by the doll executed input.
+	FrameRingBuffer<DollSnapshot> client_snapshots;
+
+	/// The estimated memory (bytes) used by the last stored snapshot.
+	std::size_t snapshot_memory_usage = 0;
+
+	/// The objects controlled by this doll simulated by the snapshot being
+	/// stored, set by the `ClientSynchronizer` before `copy_controlled_objects_snapshot`.
+	std::vector<ObjectData *> snapshot_controlled_objects;
 
 public:
 	DollController(PeerNetworkedController *p_node);
@@ -389,29 +490,39 @@ public:
 	void on_snapshot_update_finished(const Snapshot &p_snapshot);
 	void copy_controlled_objects_snapshot(
 			const Snapshot &p_snapshot,
-			std::vector<DollSnapshot> &r_snapshots,
+			FrameRingBuffer<DollSnapshot> &r_snapshots,
 			bool p_store_even_when_doll_is_not_processing);
 
 	FrameIndex fetch_checkable_snapshot(DollSnapshot *&r_client_snapshot, DollSnapshot *&r_server_snapshot);
 
+	/// Returns the estimated memory (bytes) used by the stored snapshots.
+	std::size_t get_snapshots_memory_usage() const;
+	/// Drops the oldest snapshots, so that at most `p_max_snapshots` server
+	/// and client snapshots are kept. Returns the dropped snapshots count.
+	std::size_t drop_oldest_snapshots(std::size_t p_max_snapshots);
+
 	// Checks whether this doll requires a reconciliation.
 	// The check done is relative to the doll timeline, and not the scene sync timeline.
 	bool __pcr__fetch_recovery_info(
 			const FrameIndex p_checking_frame_index,
 			const int p_frame_count_to_rewind,
 			Snapshot *r_no_rewind_recover,
-			std::vector<std::string> *r_differences_info
+			std::vector<std::string> *r_differences_info,
+			std::vector<std::pair<ObjectNetId, VarId>> *r_rewind_trigger_vars
 #ifdef NS_DEBUG_ENABLED
 			,
 			std::vector<ObjectNetId> *r_different_node_data
 #endif
 			);
 
-	void on_snapshot_applied(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind);
-	void apply_snapshot_no_simulation(const Snapshot &p_global_server_snapshot);
-	void apply_snapshot_no_input_reconciliation(const Snapshot &p_global_server_snapshot, FrameIndex p_frame_index);
-	void apply_snapshot_instant_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind);
-	void apply_snapshot_rewinding_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind);
+	/// Prepares the doll reconciliation, the snapshots to apply are appended
+	/// to `r_snapshots_to_apply` so the `ClientSynchronizer` can apply the
+	/// snapshots of all the dolls together.
+	void on_snapshot_applied(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind, std::vector<const Snapshot *> &r_snapshots_to_apply);
+	void apply_snapshot_no_simulation(const Snapshot &p_global_server_snapshot, std::vector<const Snapshot *> &r_snapshots_to_apply);
+	void apply_snapshot_no_input_reconciliation(const Snapshot &p_global_server_snapshot, FrameIndex p_frame_index, std::vector<const Snapshot *> &r_snapshots_to_apply);
+	void apply_snapshot_instant_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind, std::vector<const Snapshot *> &r_snapshots_to_apply);
+	void apply_snapshot_rewinding_input_reconciliation(const Snapshot &p_global_server_snapshot, const int p_frame_count_to_rewind, std::vector<const Snapshot *> &r_snapshots_to_apply);
 };
 
 /// This controller is used when the game instance is not a peer of any kind.
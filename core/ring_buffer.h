@@ -0,0 +1,429 @@
+#pragma once
+
+#include "core.h"
+#include "ensure.h"
+#include <algorithm>
+#include <vector>
+
+NS_NAMESPACE_BEGIN
+
+/// FIFO queue backed by a ring of preallocated slots.
+/// The popped elements are not destroyed: the slot, with all the memory it
+/// owns, is returned again by `push_back()` so the caller can overwrite it
+/// without allocating. The storage grows only when the ring is full.
+template <typename T>
+class RingBuffer {
+	std::vector<T> slots;
+	std::size_t head = 0;
+	std::size_t count = 0;
+
+public:
+	/// Makes sure the ring can store `p_capacity` elements without growing.
+	void reserve(std::size_t p_capacity);
+	std::size_t capacity() const { return slots.size(); }
+
+	std::size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	/// Appends an element and returns it.
+	/// NOTE: The returned slot may contain the data of a popped element, it's
+	///       up to the caller to reset it.
+	T &push_back();
+	void pop_front();
+
+	/// Empties the ring, the slots are kept to be reused.
+	void clear();
+
+	/// Releases the slots, and the memory they own, exceeding `p_capacity`.
+	/// The stored elements are always kept.
+	void shrink(std::size_t p_capacity);
+
+	T &front() { return at(0); }
+	const T &front() const { return at(0); }
+	T &back() { return at(count - 1); }
+	const T &back() const { return at(count - 1); }
+
+	T &operator[](std::size_t p_index) { return at(p_index); }
+	const T &operator[](std::size_t p_index) const { return at(p_index); }
+
+private:
+	T &at(std::size_t p_index);
+	const T &at(std::size_t p_index) const;
+};
+
+template <typename T>
+void RingBuffer<T>::reserve(std::size_t p_capacity) {
+	if (p_capacity <= slots.size()) {
+		return;
+	}
+
+	// Move the elements at the beginning of the new storage, preserving the order.
+	std::vector<T> new_slots(p_capacity);
+	for (std::size_t i = 0; i < count; i++) {
+		new_slots[i] = std::move(at(i));
+	}
+	// Keep the popped slots too, so their memory can still be reused.
+	for (std::size_t i = count; i < slots.size(); i++) {
+		new_slots[i] = std::move(slots[(head + i) % slots.size()]);
+	}
+	slots = std::move(new_slots);
+	head = 0;
+}
+
+template <typename T>
+T &RingBuffer<T>::push_back() {
+	if (count == slots.size()) {
+		reserve(std::max(slots.size() * 2, std::size_t(4)));
+	}
+	count += 1;
+	return at(count - 1);
+}
+
+template <typename T>
+void RingBuffer<T>::pop_front() {
+	NS_ASSERT_COND(count > 0);
+	head = (head + 1) % slots.size();
+	count -= 1;
+}
+
+template <typename T>
+void RingBuffer<T>::clear() {
+	head = 0;
+	count = 0;
+}
+
+template <typename T>
+void RingBuffer<T>::shrink(std::size_t p_capacity) {
+	p_capacity = std::max(p_capacity, count);
+	if (p_capacity >= slots.size()) {
+		return;
+	}
+
+	// Move the elements at the beginning of the new storage, preserving the order.
+	std::vector<T> new_slots(p_capacity);
+	for (std::size_t i = 0; i < count; i++) {
+		new_slots[i] = std::move(at(i));
+	}
+	// Keep the popped slots fitting the new storage, so their memory can still be reused.
+	for (std::size_t i = count; i < p_capacity; i++) {
+		new_slots[i] = std::move(slots[(head + i) % slots.size()]);
+	}
+	slots = std::move(new_slots);
+	head = 0;
+}
+
+template <typename T>
+T &RingBuffer<T>::at(std::size_t p_index) {
+#ifdef NS_DEBUG_ENABLED
+	NS_ASSERT_COND(p_index < count);
+#endif
+	return slots[(head + p_index) % slots.size()];
+}
+
+template <typename T>
+const T &RingBuffer<T>::at(std::size_t p_index) const {
+#ifdef NS_DEBUG_ENABLED
+	NS_ASSERT_COND(p_index < count);
+#endif
+	return slots[(head + p_index) % slots.size()];
+}
+
+/// Stores the elements indexed by `FrameIndex`, into the slot
+/// `FrameIndex % capacity`: insert, lookup and expiry don't search nor sort.
+/// The removed elements are not destroyed: `insert()` returns the slot, with
+/// all the memory it owns, so the caller can overwrite it without allocating.
+/// The storage grows only when the stored frames span more than the capacity,
+/// up to `max_capacity`: past it the oldest frames are evicted. It shrinks back
+/// when a removal leaves it mostly unused, e.g. after a frame index jump.
+/// NOTE: `FrameIndex::NONE` can't be stored.
+template <typename T>
+class FrameRingBuffer {
+	struct Slot {
+		FrameIndex frame_index = FrameIndex::NONE;
+		T value;
+	};
+
+	std::vector<Slot> slots;
+	FrameIndex oldest = FrameIndex::NONE;
+	FrameIndex newest = FrameIndex::NONE;
+	std::size_t count = 0;
+	std::size_t max_capacity = 1 << 16;
+
+public:
+	/// Makes sure the ring can store `p_capacity` consecutive frames without growing.
+	void reserve(std::size_t p_capacity);
+	std::size_t capacity() const { return slots.size(); }
+
+	/// The maximum span of frames the ring can store, the storage never grows
+	/// past it.
+	void set_max_capacity(std::size_t p_max_capacity);
+	std::size_t get_max_capacity() const { return max_capacity; }
+
+	std::size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	/// The oldest and the newest stored frames, NONE when empty.
+	FrameIndex front_index() const { return oldest; }
+	FrameIndex back_index() const { return newest; }
+
+	T &front() { return *find(oldest); }
+	const T &front() const { return *find(oldest); }
+	T &back() { return *find(newest); }
+	const T &back() const { return *find(newest); }
+
+	/// Returns the element stored for this frame, nullptr if missing.
+	T *find(FrameIndex p_frame_index);
+	const T *find(FrameIndex p_frame_index) const;
+
+	/// Returns the newest element stored at or before this frame, nullptr if missing.
+	T *find_at_or_before(FrameIndex p_frame_index);
+	/// Returns the oldest element stored at or after this frame, nullptr if missing.
+	T *find_at_or_after(FrameIndex p_frame_index);
+
+	/// Returns the element stored for this frame, adding it when missing.
+	/// When the stored frames would span more than `max_capacity`, the oldest
+	/// frames are evicted; it returns nullptr if this frame is the oldest.
+	/// NOTE: When `r_inserted` is true, the returned slot may contain the data
+	///       of a removed element, it's up to the caller to reset it.
+	T *insert(FrameIndex p_frame_index, bool &r_inserted);
+
+	/// Removes the oldest element.
+	void pop_front();
+	/// Removes the elements older than this frame, this frame excluded.
+	void remove_older_than(FrameIndex p_frame_index);
+	/// Removes the elements newer than this frame, this frame excluded.
+	void remove_newer_than(FrameIndex p_frame_index);
+
+	/// Empties the ring, the slots are kept to be reused.
+	void clear();
+
+private:
+	/// Moves the slots into a storage of `p_capacity` slots, which must fit
+	/// the span of the stored frames.
+	void resize_slots(std::size_t p_capacity);
+	/// Shrinks the storage when the removal of `p_removed_span` frames left it
+	/// mostly unused.
+	void compact(std::size_t p_removed_span);
+
+	Slot &slot(FrameIndex p_frame_index) { return slots[p_frame_index.id % slots.size()]; }
+	const Slot &slot(FrameIndex p_frame_index) const { return slots[p_frame_index.id % slots.size()]; }
+};
+
+template <typename T>
+void FrameRingBuffer<T>::reserve(std::size_t p_capacity) {
+	if (p_capacity <= slots.size()) {
+		return;
+	}
+	resize_slots(p_capacity);
+}
+
+template <typename T>
+void FrameRingBuffer<T>::resize_slots(std::size_t p_capacity) {
+	std::vector<Slot> new_slots(p_capacity);
+	std::vector<bool> used(p_capacity, false);
+	for (Slot &s : slots) {
+		if (s.frame_index != FrameIndex::NONE) {
+			const std::size_t index = s.frame_index.id % p_capacity;
+			new_slots[index] = std::move(s);
+			used[index] = true;
+		}
+	}
+	// Keep the removed slots too, so their memory can still be reused.
+	std::size_t free_index = 0;
+	for (Slot &s : slots) {
+		if (s.frame_index == FrameIndex::NONE) {
+			while (free_index < p_capacity && used[free_index]) {
+				free_index += 1;
+			}
+			if (free_index == p_capacity) {
+				// Shrinking: the exceeding removed slots are released.
+				break;
+			}
+			new_slots[free_index] = std::move(s);
+			used[free_index] = true;
+		}
+	}
+	slots = std::move(new_slots);
+}
+
+template <typename T>
+void FrameRingBuffer<T>::set_max_capacity(std::size_t p_max_capacity) {
+	max_capacity = std::max(p_max_capacity, std::size_t(1));
+	if (count > 0 && std::size_t(newest.id - oldest.id) >= max_capacity) {
+		remove_older_than(newest + 1 - std::uint32_t(max_capacity));
+	}
+}
+
+template <typename T>
+T *FrameRingBuffer<T>::find(FrameIndex p_frame_index) {
+	if (count == 0 || p_frame_index == FrameIndex::NONE || p_frame_index < oldest || newest < p_frame_index) {
+		return nullptr;
+	}
+	Slot &s = slot(p_frame_index);
+	return s.frame_index == p_frame_index ? &s.value : nullptr;
+}
+
+template <typename T>
+const T *FrameRingBuffer<T>::find(FrameIndex p_frame_index) const {
+	if (count == 0 || p_frame_index == FrameIndex::NONE || p_frame_index < oldest || newest < p_frame_index) {
+		return nullptr;
+	}
+	const Slot &s = slot(p_frame_index);
+	return s.frame_index == p_frame_index ? &s.value : nullptr;
+}
+
+template <typename T>
+T *FrameRingBuffer<T>::find_at_or_before(FrameIndex p_frame_index) {
+	if (count == 0 || p_frame_index == FrameIndex::NONE || p_frame_index < oldest) {
+		return nullptr;
+	}
+	for (FrameIndex i = std::min(p_frame_index, newest);; i -= 1) {
+		Slot &s = slot(i);
+		if (s.frame_index == i) {
+			return &s.value;
+		}
+		// Unreachable, because the `oldest` is always stored.
+		NS_ASSERT_COND(oldest < i);
+	}
+}
+
+template <typename T>
+T *FrameRingBuffer<T>::find_at_or_after(FrameIndex p_frame_index) {
+	if (count == 0 || p_frame_index == FrameIndex::NONE || newest < p_frame_index) {
+		return nullptr;
+	}
+	for (FrameIndex i = std::max(p_frame_index, oldest);; i += 1) {
+		Slot &s = slot(i);
+		if (s.frame_index == i) {
+			return &s.value;
+		}
+		// Unreachable, because the `newest` is always stored.
+		NS_ASSERT_COND(i < newest);
+	}
+}
+
+template <typename T>
+T *FrameRingBuffer<T>::insert(FrameIndex p_frame_index, bool &r_inserted) {
+	NS_ASSERT_COND(p_frame_index != FrameIndex::NONE);
+	r_inserted = false;
+
+	T *existing = find(p_frame_index);
+	if (existing) {
+		return existing;
+	}
+
+	if (count > 0) {
+		if (p_frame_index < oldest) {
+			if (std::size_t(newest.id - p_frame_index.id) >= max_capacity) {
+				// Too old to be stored without evicting newer frames.
+				return nullptr;
+			}
+		} else if (std::size_t(p_frame_index.id - oldest.id) >= max_capacity) {
+			// Evict the oldest frames, rather than growing past the max capacity.
+			remove_older_than(p_frame_index + 1 - std::uint32_t(max_capacity));
+		}
+	}
+
+	const FrameIndex new_oldest = count == 0 ? p_frame_index : std::min(oldest, p_frame_index);
+	const FrameIndex new_newest = count == 0 ? p_frame_index : std::max(newest, p_frame_index);
+	const std::size_t span = std::size_t(new_newest.id - new_oldest.id) + 1;
+	if (span > slots.size()) {
+		std::size_t new_capacity = std::max(slots.size() * 2, std::size_t(4));
+		while (new_capacity < span) {
+			new_capacity *= 2;
+		}
+		reserve(std::min(new_capacity, std::max(max_capacity, span)));
+	}
+
+	oldest = new_oldest;
+	newest = new_newest;
+	count += 1;
+
+	Slot &s = slot(p_frame_index);
+	s.frame_index = p_frame_index;
+	r_inserted = true;
+	return &s.value;
+}
+
+template <typename T>
+void FrameRingBuffer<T>::pop_front() {
+	NS_ASSERT_COND(count > 0);
+	remove_older_than(oldest + 1);
+}
+
+template <typename T>
+void FrameRingBuffer<T>::remove_older_than(FrameIndex p_frame_index) {
+	if (count == 0 || !(oldest < p_frame_index)) {
+		return;
+	}
+	const std::size_t removed_span = newest < p_frame_index ? std::size_t(newest.id - oldest.id) + 1 : std::size_t(p_frame_index.id - oldest.id);
+	if (newest < p_frame_index) {
+		// Everything is removed, without walking the span.
+		clear();
+	} else {
+		while (oldest < p_frame_index) {
+			slot(oldest).frame_index = FrameIndex::NONE;
+			count -= 1;
+			do {
+				oldest += 1;
+			} while (slot(oldest).frame_index != oldest);
+		}
+	}
+	compact(removed_span);
+}
+
+template <typename T>
+void FrameRingBuffer<T>::remove_newer_than(FrameIndex p_frame_index) {
+	if (count == 0 || !(p_frame_index < newest)) {
+		return;
+	}
+	const std::size_t removed_span = p_frame_index < oldest ? std::size_t(newest.id - oldest.id) + 1 : std::size_t(newest.id - p_frame_index.id);
+	if (p_frame_index < oldest) {
+		// Everything is removed, without walking the span.
+		clear();
+	} else {
+		while (p_frame_index < newest) {
+			slot(newest).frame_index = FrameIndex::NONE;
+			count -= 1;
+			do {
+				newest -= 1;
+			} while (slot(newest).frame_index != newest);
+		}
+	}
+	compact(removed_span);
+}
+
+template <typename T>
+void FrameRingBuffer<T>::compact(std::size_t p_removed_span) {
+	// The small rings and the regular expiry of a few frames are ignored, so
+	// the storage doesn't shrink and grow back continuously.
+	const std::size_t min_capacity = 16;
+	if (slots.size() <= min_capacity || p_removed_span < slots.size() / 2) {
+		return;
+	}
+
+	const std::size_t span = count == 0 ? 0 : std::size_t(newest.id - oldest.id) + 1;
+	if (span * 4 > slots.size()) {
+		return;
+	}
+
+	std::size_t new_capacity = 4;
+	while (new_capacity < span * 2) {
+		new_capacity *= 2;
+	}
+	resize_slots(std::max(new_capacity, min_capacity));
+}
+
+template <typename T>
+void FrameRingBuffer<T>::clear() {
+	if (count > 0) {
+		for (Slot &s : slots) {
+			s.frame_index = FrameIndex::NONE;
+		}
+	}
+	oldest = FrameIndex::NONE;
+	newest = FrameIndex::NONE;
+	count = 0;
+}
+
+NS_NAMESPACE_END
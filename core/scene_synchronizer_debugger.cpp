@@ -60,6 +60,10 @@ bool SceneSynchronizerDebugger::get_dump_enabled() const {
 #endif
 }
 
+bool SceneSynchronizerDebugger::is_printing(PrintMessageType p_level) const {
+	return log_level <= p_level || get_dump_enabled();
+}
+
 void SceneSynchronizerDebugger::setup_debugger(const std::string &p_dump_name, int p_peer) {
 #ifdef NS_DEBUG_ENABLED
 	if (setup_done == false) {
@@ -411,6 +415,10 @@ void SceneSynchronizerDebugger::print(PrintMessageType p_level, const std::strin
 			frame_dump_storage->frame_dump__has_errors = true;
 	}
 
+	if (!is_printing(p_level) && !p_force_print_to_log) {
+		return;
+	}
+
 	const std::string log_level_str = get_log_level_txt(p_level);
 
 	if ((log_level <= p_level) || p_force_print_to_log) {
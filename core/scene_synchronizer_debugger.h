@@ -93,6 +93,10 @@ public:
 	void set_dump_enabled(bool p_dump_enabled);
 	bool get_dump_enabled() const;
 
+	/// Returns true when a message of this level is printed or dumped: use it
+	/// to avoid building the messages that would be discarded anyway.
+	bool is_printing(PrintMessageType p_level) const;
+
 	void setup_debugger(const std::string &p_dump_name, int p_peer);
 
 private:
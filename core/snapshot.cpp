@@ -3,6 +3,99 @@
 #include "../scene_synchronizer.h"
 
 NS_NAMESPACE_BEGIN
+const std::size_t Snapshot::COMPARE_MIN_OBJECTS_PER_THREAD = 256;
+
+SnapshotComparePool::~SnapshotComparePool() {
+	stop();
+}
+
+void SnapshotComparePool::start(std::size_t p_workers_count) {
+	if (workers.size() == p_workers_count) {
+		return;
+	}
+
+	stop();
+
+	exit = false;
+	workers.reserve(p_workers_count);
+	for (std::size_t i = 0; i < p_workers_count; i++) {
+		workers.emplace_back(&SnapshotComparePool::worker_main, this);
+	}
+}
+
+void SnapshotComparePool::stop() {
+	if (workers.empty()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		exit = true;
+	}
+	condition.notify_all();
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	workers.clear();
+}
+
+void SnapshotComparePool::execute(std::size_t p_tasks_count, const std::function<void(std::size_t)> &p_task) {
+	if (workers.empty() || p_tasks_count <= 1) {
+		for (std::size_t i = 0; i < p_tasks_count; i++) {
+			p_task(i);
+		}
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	NS_ASSERT_COND_MSG(task == nullptr, "The SnapshotComparePool is not reentrant.");
+	task = &p_task;
+	tasks_count = p_tasks_count;
+	next_task = 0;
+	pending_tasks = p_tasks_count;
+	condition.notify_all();
+
+	// The calling thread executes the tasks too.
+	while (execute_next_task(lock)) {
+	}
+	done_condition.wait(lock, [this]() { return pending_tasks == 0; });
+
+	task = nullptr;
+	tasks_count = 0;
+	next_task = 0;
+}
+
+void SnapshotComparePool::worker_main() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		condition.wait(lock, [this]() { return exit || next_task < tasks_count; });
+		if (exit) {
+			return;
+		}
+		execute_next_task(lock);
+	}
+}
+
+bool SnapshotComparePool::execute_next_task(std::unique_lock<std::mutex> &p_lock) {
+	if (next_task >= tasks_count) {
+		return false;
+	}
+
+	const std::size_t task_index = next_task;
+	next_task += 1;
+	const std::function<void(std::size_t)> &current_task = *task;
+
+	p_lock.unlock();
+	current_task(task_index);
+	p_lock.lock();
+
+	pending_tasks -= 1;
+	if (pending_tasks == 0) {
+		done_condition.notify_all();
+	}
+	return true;
+}
+
 NS::Snapshot::operator std::string() const {
 	std::string s;
 	s += "Snapshot input ID: " + input_id;
@@ -23,10 +116,14 @@ NS::Snapshot::operator std::string() const {
 
 bool compare_vars(
 		const NS::ObjectData &p_object_data,
+		const NS::GlobalFrameIndex p_server_global_frame_index,
 		const std::vector<std::optional<NS::VarData>> &p_server_vars,
 		const std::vector<std::optional<NS::VarData>> &p_client_vars,
+		bool p_skip_state_hashed_vars,
 		NS::Snapshot *r_no_rewind_recover,
-		std::vector<std::string> *r_differences_info) {
+		bool &r_no_rewind_recovered,
+		std::vector<std::string> *r_differences_info,
+		std::vector<std::pair<NS::ObjectNetId, NS::VarId>> *r_rewind_trigger_vars) {
 	const std::optional<NS::VarData> *s_vars = p_server_vars.data();
 	const std::optional<NS::VarData> *c_vars = p_client_vars.data();
 
@@ -45,14 +142,33 @@ bool compare_vars(
 			continue;
 		}
 
+		if (p_skip_state_hashed_vars && p_object_data.vars[var_index].is_state_hashed()) {
+			// Already verified by the state hash.
+			continue;
+		}
+
+		const NS::VarComparePolicy &compare_policy = p_object_data.vars[var_index].compare_policy;
+		if (compare_policy.compare_every_n_frames > 1) {
+			NS::GlobalFrameIndex &last_compared_frame = p_object_data.vars[var_index].last_compared_frame;
+			if (
+					last_compared_frame != NS::GlobalFrameIndex::NONE &&
+					p_server_global_frame_index > last_compared_frame &&
+					(p_server_global_frame_index.id - last_compared_frame.id) < compare_policy.compare_every_n_frames) {
+				// This variable was compared recently.
+				continue;
+			}
+			last_compared_frame = p_server_global_frame_index;
+		}
+
 		// Compare.
 		const bool different =
 				// Make sure this variable is set.
 				!c_vars[var_index].has_value() ||
 				// Check if the value is different.
-				!NS::SceneSynchronizerBase::var_data_compare(
+				!NS::SceneSynchronizerBase::var_data_compare_approx(
 						s_vars[var_index].value(),
-						c_vars[var_index].value());
+						c_vars[var_index].value(),
+						compare_policy);
 
 		if (different) {
 			if (p_object_data.vars[var_index].skip_rewinding) {
@@ -62,12 +178,7 @@ bool compare_vars(
 						r_no_rewind_recover->objects[p_object_data.get_net_id().id].vars.resize(var_index + 1);
 					}
 					r_no_rewind_recover->objects[p_object_data.get_net_id().id].vars[var_index].emplace(NS::VarData::make_copy(s_vars[var_index].value()));
-					// Sets `input_id` to 0 to signal that this snapshot contains
-					// no-rewind data.
-					r_no_rewind_recover->input_id = NS::FrameIndex{ { 0 } };
-
-					// Also insert this object into the simulated objects to ensure it gets updated.
-					NS::VecFunc::insert_unique(r_no_rewind_recover->simulated_objects, p_object_data.get_net_id());
+					r_no_rewind_recovered = true;
 				}
 
 				if (r_differences_info) {
@@ -78,6 +189,9 @@ bool compare_vars(
 				}
 			} else {
 				// The vars are different.
+				if (r_rewind_trigger_vars) {
+					r_rewind_trigger_vars->push_back(std::make_pair(p_object_data.get_net_id(), NS::VarId{ { NS::VarId::IdType(var_index) } }));
+				}
 				if (r_differences_info) {
 					r_differences_info->push_back(
 							"Difference found on var #" + std::to_string(var_index) + " name `" + p_object_data.vars[var_index].var.name + "` " +
@@ -105,6 +219,7 @@ bool compare_procedures(
 		const std::vector<NS::ScheduledProcedureSnapshot> &p_server_procedures,
 		const std::vector<NS::ScheduledProcedureSnapshot> &p_client_procedures,
 		NS::Snapshot *r_no_rewind_recover,
+		bool &r_no_rewind_recovered,
 		std::vector<std::string> *r_differences_info) {
 	// NOTICE: Since the scheduled procedures are an information that is necessary
 	// to execute an operation in the future and is not important to validate 
@@ -155,12 +270,7 @@ bool compare_procedures(
 
 			for (uint32_t proc_index = 0; proc_index < uint32_t(p_server_procedures.size()); proc_index += 1) {
 				r_no_rewind_recover->objects[p_object_data.get_net_id().id].procedures[proc_index] = p_server_procedures[proc_index];
-
-				// Sets `input_id` to 0 to signal that this snapshot contains
-				// no-rewind data.
-				r_no_rewind_recover->input_id = NS::FrameIndex{ { 0 } };
-				// Also insert this object into the simulated objects to ensure it gets updated.
-				NS::VecFunc::insert_unique(r_no_rewind_recover->simulated_objects, p_object_data.get_net_id());
+				r_no_rewind_recovered = true;
 			}
 		}
 	}
@@ -168,6 +278,115 @@ bool compare_procedures(
 	return true;
 }
 
+struct CompareObjectsResult {
+	bool is_equal = true;
+	std::vector<NS::ObjectNetId> no_rewind_recovered_objects;
+	std::vector<std::string> differences_info;
+	std::vector<std::pair<NS::ObjectNetId, NS::VarId>> rewind_trigger_vars;
+	std::vector<NS::ObjectNetId> different_objects;
+};
+
+/// Compares the objects in the range [p_begin, p_end).
+/// NOTE: This is executed by many threads at once, so it writes only the
+///       `r_result` and the no rewind data of the compared objects.
+void compare_objects(
+		const NS::SceneSynchronizerBase &scene_synchronizer,
+		const NS::Snapshot &p_snap_A,
+		const NS::Snapshot &p_snap_B,
+		const int p_skip_objects_not_controlled_by_peer,
+		const std::vector<bool> &p_state_hash_verified_objects,
+		std::size_t p_begin,
+		std::size_t p_end,
+		NS::Snapshot *r_no_rewind_recover,
+		bool p_collect_differences_info,
+		bool p_collect_rewind_trigger_vars,
+		CompareObjectsResult &r_result) {
+	std::vector<std::string> *r_differences_info = p_collect_differences_info ? &r_result.differences_info : nullptr;
+	std::vector<std::pair<NS::ObjectNetId, NS::VarId>> *r_rewind_trigger_vars = p_collect_rewind_trigger_vars ? &r_result.rewind_trigger_vars : nullptr;
+
+	// TODO instead to iterate over all the object_vars, iterate over the simulated. This will make it save a bunch of time.
+	for (NS::ObjectNetId net_object_id = NS::ObjectNetId{ { NS::ObjectNetId::IdType(p_begin) } }; net_object_id < NS::ObjectNetId{ { NS::ObjectNetId::IdType(p_end) } }; net_object_id += 1) {
+		const NS::ObjectData *rew_object_data = scene_synchronizer.get_object_data(net_object_id);
+		if (rew_object_data == nullptr || rew_object_data->realtime_sync_enabled_on_client == false) {
+			continue;
+		}
+
+		if (rew_object_data->is_client_interpolated()) {
+			// The interpolated objects are not predicted, so there is nothing to compare.
+			continue;
+		}
+
+		if (rew_object_data->get_controlled_by_peer() > 0 && rew_object_data->get_controlled_by_peer() != p_skip_objects_not_controlled_by_peer) {
+			// This object is being controlled by a doll, which mostly handles
+			// the reconciliation. The doll will be asked if a rewind is needed
+			// separately from this.
+			// There is nothing more to do for this object at this time.
+			continue;
+		}
+
+		bool no_rewind_recovered = false;
+		bool are_nodes_different = false;
+		if (net_object_id >= NS::ObjectNetId{ { NS::ObjectNetId::IdType(p_snap_B.objects.size()) } }) {
+			if (r_differences_info) {
+				r_differences_info->push_back("Difference detected because the snapshot B doesn't contain this object: " + rew_object_data->get_object_name());
+			}
+			r_result.is_equal = false;
+#ifndef NS_DEBUG_ENABLED
+			return;
+#endif
+			are_nodes_different = true;
+		} else {
+			are_nodes_different = !compare_vars(
+					*rew_object_data,
+					p_snap_A.global_frame_index,
+					p_snap_A.objects[net_object_id.id].vars,
+					p_snap_B.objects[net_object_id.id].vars,
+					net_object_id.id < p_state_hash_verified_objects.size() && p_state_hash_verified_objects[net_object_id.id],
+					r_no_rewind_recover,
+					no_rewind_recovered,
+					r_differences_info,
+					r_rewind_trigger_vars);
+
+			if (are_nodes_different) {
+				if (r_differences_info) {
+					r_differences_info->push_back("Difference detected on snapshot B. OBJECT NAME: " + rew_object_data->get_object_name());
+				}
+				r_result.is_equal = false;
+#ifndef NS_DEBUG_ENABLED
+				return;
+#endif
+			}
+
+			if (!are_nodes_different) {
+				are_nodes_different = !compare_procedures(
+						*rew_object_data,
+						p_snap_A.objects[net_object_id.id].procedures,
+						p_snap_B.objects[net_object_id.id].procedures,
+						r_no_rewind_recover,
+						no_rewind_recovered,
+						r_differences_info);
+				if (are_nodes_different) {
+					if (r_differences_info) {
+						r_differences_info->push_back("Difference detected on snapshot B. OBJECT NAME: " + rew_object_data->get_object_name());
+					}
+					r_result.is_equal = false;
+#ifndef NS_DEBUG_ENABLED
+					return;
+#endif
+				}
+			}
+		}
+
+		if (no_rewind_recovered) {
+			r_result.no_rewind_recovered_objects.push_back(net_object_id);
+		}
+
+		if (are_nodes_different) {
+			r_result.different_objects.push_back(net_object_id);
+		}
+	}
+}
+
 const std::vector<std::optional<VarData>> *Snapshot::get_object_vars(ObjectNetId p_id) const {
 	if (objects.size() > p_id.id) {
 		return &objects[p_id.id].vars;
@@ -198,17 +417,56 @@ void ObjectDataSnapshot::copy(const ObjectDataSnapshot &p_other) {
 		}
 	}
 	procedures = p_other.procedures;
+	// The copy is not tracked.
+	vars_version.clear();
 }
 
 void ObjectDataSnapshot::clear() {
 	vars.clear();
 	procedures.clear();
+	vars_version.clear();
+}
+
+void Snapshot::recycle() {
+	input_id = FrameIndex::NONE;
+	global_frame_index = GlobalFrameIndex::NONE;
+	simulated_objects.clear();
+	state_hash_verified_objects.clear();
+	has_custom_data = false;
+	custom_data = VarData();
+}
+
+std::size_t Snapshot::get_memory_usage() const {
+	std::size_t usage = sizeof(Snapshot);
+	usage += simulated_objects.capacity() * sizeof(SimulatedObjectInfo);
+	usage += state_hash_verified_objects.capacity() * sizeof(ObjectNetId);
+	// The map nodes have 4 pointers besides the value.
+	usage += peers_frames_index.size() * (sizeof(std::pair<const int, FrameIndexWithMeta>) + 4 * sizeof(void *));
+	usage += objects.capacity() * sizeof(ObjectDataSnapshot);
+	for (const ObjectDataSnapshot &object : objects) {
+		usage += object.vars.capacity() * sizeof(std::optional<VarData>);
+		usage += object.vars_version.capacity() * sizeof(std::uint64_t);
+		usage += object.procedures.capacity() * sizeof(ScheduledProcedureSnapshot);
+		for (const ScheduledProcedureSnapshot &procedure : object.procedures) {
+			usage += std::size_t(procedure.args.total_size() / 8);
+		}
+	}
+	return usage;
+}
+
+void RollingUpdateSnapshot::clear_update_info() {
+	was_partially_updated = false;
+	is_just_updated_simulated_objects = false;
+	is_just_updated_custom_data = false;
+	just_updated_object_vars.clear();
+	just_received_state_hashes.clear();
 }
 
 void Snapshot::copy(const Snapshot &p_other) {
 	input_id = p_other.input_id;
 	global_frame_index = p_other.global_frame_index;
 	simulated_objects = p_other.simulated_objects;
+	state_hash_verified_objects = p_other.state_hash_verified_objects;
 	peers_frames_index = p_other.peers_frames_index;
 	objects.resize(p_other.objects.size());
 	for (std::size_t i = 0; i < p_other.objects.size(); i++) {
@@ -218,13 +476,39 @@ void Snapshot::copy(const Snapshot &p_other) {
 	custom_data.copy(p_other.custom_data);
 }
 
+bool NS::Snapshot::compare_object_vars(
+		const ObjectData &p_object_data,
+		const Snapshot &p_snap_A,
+		const Snapshot &p_snap_B) {
+	const ObjectNetId net_id = p_object_data.get_net_id();
+	if (p_snap_A.objects.size() <= net_id.id) {
+		// Nothing to compare.
+		return true;
+	}
+	if (p_snap_B.objects.size() <= net_id.id) {
+		return false;
+	}
+	bool no_rewind_recovered = false;
+	return compare_vars(
+			p_object_data,
+			p_snap_A.global_frame_index,
+			p_snap_A.objects[net_id.id].vars,
+			p_snap_B.objects[net_id.id].vars,
+			false,
+			nullptr,
+			no_rewind_recovered,
+			nullptr,
+			nullptr);
+}
+
 bool NS::Snapshot::compare(
 		const SceneSynchronizerBase &scene_synchronizer,
 		const Snapshot &p_snap_A,
 		const Snapshot &p_snap_B,
 		const int p_skip_objects_not_controlled_by_peer,
 		Snapshot *r_no_rewind_recover,
-		std::vector<std::string> *r_differences_info
+		std::vector<std::string> *r_differences_info,
+		std::vector<std::pair<ObjectNetId, VarId>> *r_rewind_trigger_vars
 #ifdef NS_DEBUG_ENABLED
 		,
 		std::vector<ObjectNetId> *r_different_node_data
@@ -301,74 +585,78 @@ bool NS::Snapshot::compare(
 		r_no_rewind_recover->objects.resize(std::max(p_snap_A.objects.size(), p_snap_B.objects.size()));
 	}
 
-	// TODO instead to iterate over all the object_vars, iterate over the simulated. This will make it save a bunch of time.
-	for (ObjectNetId net_object_id = ObjectNetId{ { 0 } }; net_object_id < ObjectNetId{ { ObjectNetId::IdType(p_snap_A.objects.size()) } }; net_object_id += 1) {
-		const ObjectData *rew_object_data = scene_synchronizer.get_object_data(net_object_id);
-		if (rew_object_data == nullptr || rew_object_data->realtime_sync_enabled_on_client == false) {
-			continue;
+	// The objects verified by the state hash.
+	std::vector<bool> state_hash_verified_objects;
+	if (!p_snap_A.state_hash_verified_objects.empty()) {
+		state_hash_verified_objects.resize(p_snap_A.objects.size(), false);
+		for (ObjectNetId net_id : p_snap_A.state_hash_verified_objects) {
+			if (net_id.id < state_hash_verified_objects.size()) {
+				state_hash_verified_objects[net_id.id] = true;
+			}
 		}
+	}
 
-		if (rew_object_data->get_controlled_by_peer() > 0 && rew_object_data->get_controlled_by_peer() != p_skip_objects_not_controlled_by_peer) {
-			// This object is being controlled by a doll, which mostly handles
-			// the reconciliation. The doll will be asked if a rewind is needed
-			// separately from this.
-			// There is nothing more to do for this object at this time.
-			continue;
+	// The objects are compared independently, so they are split in ranges
+	// compared in parallel. The results are then merged following the
+	// objects order, so they are the same regardless the threads count.
+	// The differences info stringifies the vars and it's a debug only
+	// feature, so it's collected on the calling thread.
+	SnapshotComparePool &compare_pool = scene_synchronizer.get_snapshot_compare_pool();
+	const std::size_t objects_count = p_snap_A.objects.size();
+	const std::size_t threads_count = r_differences_info ? 1 : std::max(
+			std::size_t(1),
+			std::min(
+					compare_pool.get_workers_count() + 1,
+					objects_count / COMPARE_MIN_OBJECTS_PER_THREAD));
+	const std::size_t objects_per_thread = (objects_count + threads_count - 1) / threads_count;
+
+	std::vector<CompareObjectsResult> results(threads_count);
+	const std::function<void(std::size_t)> compare_range = [&](std::size_t p_thread_index) {
+		const std::size_t begin = p_thread_index * objects_per_thread;
+		const std::size_t end = std::min(objects_count, begin + objects_per_thread);
+		compare_objects(
+				scene_synchronizer,
+				p_snap_A,
+				p_snap_B,
+				p_skip_objects_not_controlled_by_peer,
+				state_hash_verified_objects,
+				begin,
+				end,
+				r_no_rewind_recover,
+				r_differences_info != nullptr,
+				r_rewind_trigger_vars != nullptr,
+				results[p_thread_index]);
+	};
+
+	compare_pool.execute(threads_count, compare_range);
+
+	for (CompareObjectsResult &result : results) {
+		for (ObjectNetId net_id : result.no_rewind_recovered_objects) {
+			// Sets `input_id` to 0 to signal that this snapshot contains
+			// no-rewind data.
+			r_no_rewind_recover->input_id = FrameIndex{ { 0 } };
+			// Also insert this object into the simulated objects to ensure it gets updated.
+			VecFunc::insert_unique(r_no_rewind_recover->simulated_objects, net_id);
+		}
+		if (r_differences_info) {
+			r_differences_info->insert(
+					r_differences_info->end(),
+					std::make_move_iterator(result.differences_info.begin()),
+					std::make_move_iterator(result.differences_info.end()));
+		}
+		if (r_rewind_trigger_vars) {
+			r_rewind_trigger_vars->insert(r_rewind_trigger_vars->end(), result.rewind_trigger_vars.begin(), result.rewind_trigger_vars.end());
 		}
-
-		bool are_nodes_different = false;
-		if (net_object_id >= ObjectNetId{ { ObjectNetId::IdType(p_snap_B.objects.size()) } }) {
-			if (r_differences_info) {
-				r_differences_info->push_back("Difference detected because the snapshot B doesn't contain this object: " + rew_object_data->get_object_name());
-			}
 #ifdef NS_DEBUG_ENABLED
+		if (r_different_node_data) {
+			r_different_node_data->insert(r_different_node_data->end(), result.different_objects.begin(), result.different_objects.end());
+		}
+		if (!result.is_equal) {
 			is_equal = false;
+		}
 #else
+		if (!result.is_equal) {
 			return false;
-#endif
-			are_nodes_different = true;
-		} else {
-			are_nodes_different = !compare_vars(
-					*rew_object_data,
-					p_snap_A.objects[net_object_id.id].vars,
-					p_snap_B.objects[net_object_id.id].vars,
-					r_no_rewind_recover,
-					r_differences_info);
-
-			if (are_nodes_different) {
-				if (r_differences_info) {
-					r_differences_info->push_back("Difference detected on snapshot B. OBJECT NAME: " + rew_object_data->get_object_name());
-				}
-#ifdef NS_DEBUG_ENABLED
-				is_equal = false;
-#else
-				return false;
-#endif
-			}
-
-			if (!are_nodes_different) {
-				are_nodes_different = !compare_procedures(
-						*rew_object_data,
-						p_snap_A.objects[net_object_id.id].procedures,
-						p_snap_B.objects[net_object_id.id].procedures,
-						r_no_rewind_recover,
-						r_differences_info);
-				if (are_nodes_different) {
-					if (r_differences_info) {
-						r_differences_info->push_back("Difference detected on snapshot B. OBJECT NAME: " + rew_object_data->get_object_name());
-					}
-#ifdef NS_DEBUG_ENABLED
-					is_equal = false;
-#else
-				return false;
-#endif
-				}
-			}
-		}
-
-#ifdef NS_DEBUG_ENABLED
-		if (are_nodes_different && r_different_node_data) {
-			r_different_node_data->push_back(net_object_id);
 		}
 #endif
 	}
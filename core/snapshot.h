@@ -2,8 +2,12 @@
 
 #include "core.h"
 #include "object_data.h"
+#include <condition_variable>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <thread>
 
 NS_NAMESPACE_BEGIN
 class SceneSynchronizerBase;
@@ -75,12 +79,55 @@ struct ScheduledProcedureSnapshot {
 struct ObjectDataSnapshot {
 	std::vector<std::optional<VarData>> vars;
 	std::vector<ScheduledProcedureSnapshot> procedures;
+	/// The `VarDescriptor::value_version` of each stored var, used by the
+	/// client to copy only the changed vars into a recycled snapshot.
+	/// NOTE: It's empty when the versions are unknown.
+	std::vector<std::uint64_t> vars_version;
 
 	void copy(const ObjectDataSnapshot &p_other);
 	void clear();
 };
 
+/// The persistent worker threads used by `Snapshot::compare`, so the threads
+/// are not created on each comparison.
+class SnapshotComparePool {
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::condition_variable done_condition;
+	bool exit = false;
+	const std::function<void(std::size_t)> *task = nullptr;
+	std::size_t tasks_count = 0;
+	std::size_t next_task = 0;
+	std::size_t pending_tasks = 0;
+
+public:
+	~SnapshotComparePool();
+
+	/// Starts the given amount of worker threads, stopping the previous ones.
+	void start(std::size_t p_workers_count);
+	void stop();
+
+	std::size_t get_workers_count() const {
+		return workers.size();
+	}
+
+	/// Executes `p_task` once per each index in [0, p_tasks_count) using the
+	/// workers and the calling thread, and returns when all are done.
+	/// NOTE: This is not reentrant, and it's called by the main thread only.
+	void execute(std::size_t p_tasks_count, const std::function<void(std::size_t)> &p_task);
+
+private:
+	void worker_main();
+	/// Executes the next task, if any. Called with the mutex locked.
+	bool execute_next_task(std::unique_lock<std::mutex> &p_lock);
+};
+
 struct Snapshot {
+	/// The minimum amount of objects compared by each thread, check
+	/// `SceneSynchronizerBase::snapshot_compare_threads_count`.
+	static const std::size_t COMPARE_MIN_OBJECTS_PER_THREAD;
+
 	FrameIndex input_id = FrameIndex::NONE;
 	GlobalFrameIndex global_frame_index = GlobalFrameIndex::NONE;
 	std::vector<SimulatedObjectInfo> simulated_objects;
@@ -88,6 +135,11 @@ struct Snapshot {
 	/// matters because the index is the `ObjectNetId`.
 	std::vector<ObjectDataSnapshot> objects;
 
+	/// The objects having the hashed variables verified using the state hash
+	/// networked by the server: these variables are the same as the client
+	/// ones and the comparison skips them. Check `VarDescriptor::is_state_hashed`.
+	std::vector<ObjectNetId> state_hash_verified_objects;
+
 	/// The executed FrameIndex for the simulating peers.
 	/// NOTE: Due to the nature of the doll simulation, when comparing the
 	///       server snapshot with the client snapshot this map is never checked.
@@ -110,13 +162,35 @@ public:
 	static Snapshot make_copy(const Snapshot &p_other);
 	void copy(const Snapshot &p_other);
 
+	/// Returns the estimated memory (bytes) used by this snapshot.
+	/// NOTE: The memory referenced by the `VarData::shared_buffer` is not counted.
+	std::size_t get_memory_usage() const;
+
+	/// Resets the snapshot to be reused for another frame, keeping the
+	/// allocated memory.
+	/// NOTE: The objects are kept, so the vars which didn't change since
+	///       can be skipped by the next update. Check `vars_version`.
+	void recycle();
+
+	/// Returns true when the vars of this object are the same on both
+	/// snapshots. The vars which skip the rewinding are not checked.
+	static bool compare_object_vars(
+			const ObjectData &p_object_data,
+			const Snapshot &p_snap_A,
+			const Snapshot &p_snap_B);
+
+	/// Compares the snapshots, splitting the objects across the
+	/// `SceneSynchronizerBase::get_snapshot_compare_pool()` threads.
+	/// NOTE: When `r_differences_info` is set, the comparison runs on the
+	///       calling thread only, since it stringifies the variables.
 	static bool compare(
 			const SceneSynchronizerBase &scene_synchronizer,
 			const Snapshot &p_snap_A,
 			const Snapshot &p_snap_B,
 			const int p_skip_objects_not_controlled_by_peer,
 			Snapshot *r_no_rewind_recover,
-			std::vector<std::string> *r_differences_info
+			std::vector<std::string> *r_differences_info,
+			std::vector<std::pair<ObjectNetId, VarId>> *r_rewind_trigger_vars
 #ifdef NS_DEBUG_ENABLED
 			,
 			std::vector<ObjectNetId> *r_different_node_data);
@@ -132,6 +206,11 @@ struct RollingUpdateSnapshot final : public Snapshot {
 	bool is_just_updated_custom_data = false;
 	/// The list of the updated object vars on the last update.
 	std::vector<ObjectNetId> just_updated_object_vars;
+	/// The objects state hashes received on the last update.
+	std::vector<std::pair<ObjectNetId, std::uint32_t>> just_received_state_hashes;
+
+	/// Resets the info about the last update, keeping the allocated memory.
+	void clear_update_info();
 };
 
 NS_NAMESPACE_END
\ No newline at end of file
@@ -272,7 +272,7 @@ void NS_GD_Test::test_var_data_conversin() {
 	}
 }
 
-void GdNetworkInterface::rpc_send(int p_peer_recipient, bool p_reliable, NS::DataBuffer &&p_buffer) {
+static Vector<uint8_t> ns_to_gd_buffer(const NS::DataBuffer &p_buffer) {
 	const std::vector<std::uint8_t> &buffer = p_buffer.get_buffer().get_bytes();
 
 	// TODO use RPC directly from MultiPlayerPeer that allows to sent raw buffers. This would avoid this conversion to Vector.
@@ -280,6 +280,11 @@ void GdNetworkInterface::rpc_send(int p_peer_recipient, bool p_reliable, NS::Dat
 	for (auto b : buffer) {
 		gd_buffer.push_back(b);
 	}
+	return gd_buffer;
+}
+
+void GdNetworkInterface::rpc_send(int p_peer_recipient, bool p_reliable, const NS::DataBuffer &p_buffer) {
+	const Vector<uint8_t> gd_buffer = ns_to_gd_buffer(p_buffer);
 
 	if (p_reliable) {
 		owner->rpc_id(p_peer_recipient, SNAME("_rpc_net_sync_reliable"), gd_buffer);
@@ -288,6 +293,19 @@ void GdNetworkInterface::rpc_send(int p_peer_recipient, bool p_reliable, NS::Dat
 	}
 }
 
+void GdNetworkInterface::rpc_send_multicast(const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const NS::DataBuffer> &p_buffer) {
+	// Convert the payload once: the Vector is COW, so it's shared by all the rpcs.
+	const Vector<uint8_t> gd_buffer = ns_to_gd_buffer(*p_buffer);
+
+	for (int peer : p_peers_recipients) {
+		if (p_reliable) {
+			owner->rpc_id(peer, SNAME("_rpc_net_sync_reliable"), gd_buffer);
+		} else {
+			owner->rpc_id(peer, SNAME("_rpc_net_sync_unreliable"), gd_buffer);
+		}
+	}
+}
+
 void GdNetworkInterface::gd_rpc_receive(const Vector<uint8_t> &p_gd_buffer) {
 	NS::DataBuffer db;
 	db.get_buffer_mut().get_bytes_mut().reserve(p_gd_buffer.size());
@@ -48,7 +48,8 @@ public: // ---------------------------------------------------------------- APIs
 	/// Can be used to verify if the local peer is the server.
 	virtual bool is_local_peer_server() const override;
 
-	virtual void rpc_send(int p_peer_recipient, bool p_reliable, NS::DataBuffer &&p_buffer) override;
+	virtual void rpc_send(int p_peer_recipient, bool p_reliable, const NS::DataBuffer &p_buffer) override;
+	virtual void rpc_send_multicast(const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const NS::DataBuffer> &p_buffer) override;
 	void gd_rpc_receive(const Vector<uint8_t> &p_args);
 
 	virtual void server_update_net_stats(int p_peer, NS::PeerData &r_peer_data) const override;
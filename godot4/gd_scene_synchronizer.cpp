@@ -6,6 +6,7 @@
 #include "core/object/object.h"
 #include "core/string/string_name.h"
 #include "core/string/ustring.h"
+#include "core/templates/hashfuncs.h"
 #include "gd_data_buffer.h"
 #include "modules/network_synchronizer/core/core.h"
 #include "modules/network_synchronizer/core/data_buffer.h"
@@ -114,6 +115,24 @@ void GdSceneSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_frame_confirmation_timespan", "interval"), &GdSceneSynchronizer::set_frame_confirmation_timespan);
 	ClassDB::bind_method(D_METHOD("get_frame_confirmation_timespan"), &GdSceneSynchronizer::get_frame_confirmation_timespan);
 
+	ClassDB::bind_method(D_METHOD("set_snapshot_encoding_async", "enabled"), &GdSceneSynchronizer::set_snapshot_encoding_async);
+	ClassDB::bind_method(D_METHOD("is_snapshot_encoding_async"), &GdSceneSynchronizer::is_snapshot_encoding_async);
+
+	ClassDB::bind_method(D_METHOD("set_snapshot_decoding_async", "enabled"), &GdSceneSynchronizer::set_snapshot_decoding_async);
+	ClassDB::bind_method(D_METHOD("is_snapshot_decoding_async"), &GdSceneSynchronizer::is_snapshot_decoding_async);
+
+	ClassDB::bind_method(D_METHOD("set_snapshot_state_hashing_enabled", "enabled"), &GdSceneSynchronizer::set_snapshot_state_hashing_enabled);
+	ClassDB::bind_method(D_METHOD("is_snapshot_state_hashing_enabled"), &GdSceneSynchronizer::is_snapshot_state_hashing_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_interpolation_delay", "delay"), &GdSceneSynchronizer::set_interpolation_delay);
+	ClassDB::bind_method(D_METHOD("get_interpolation_delay"), &GdSceneSynchronizer::get_interpolation_delay);
+
+	ClassDB::bind_method(D_METHOD("set_max_extrapolation", "max_extrapolation"), &GdSceneSynchronizer::set_max_extrapolation);
+	ClassDB::bind_method(D_METHOD("get_max_extrapolation"), &GdSceneSynchronizer::get_max_extrapolation);
+
+	ClassDB::bind_method(D_METHOD("set_client_prediction_memory_budget", "bytes"), &GdSceneSynchronizer::set_client_prediction_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_client_prediction_memory_budget"), &GdSceneSynchronizer::get_client_prediction_memory_budget);
+
 	ClassDB::bind_method(D_METHOD("set_nodes_relevancy_update_time", "time"), &GdSceneSynchronizer::set_nodes_relevancy_update_time);
 	ClassDB::bind_method(D_METHOD("get_nodes_relevancy_update_time"), &GdSceneSynchronizer::get_nodes_relevancy_update_time);
 
@@ -131,6 +150,10 @@ void GdSceneSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_variable_id", "node", "variable"), &GdSceneSynchronizer::get_variable_id);
 
 	ClassDB::bind_method(D_METHOD("set_skip_rewinding", "node", "variable", "skip_rewinding"), &GdSceneSynchronizer::set_skip_rewinding);
+	ClassDB::bind_method(D_METHOD("set_quantize_on_write", "node", "variable", "quantize_on_write"), &GdSceneSynchronizer::set_quantize_on_write);
+	ClassDB::bind_method(D_METHOD("set_compare_policy", "node", "variable", "absolute_tolerance", "relative_tolerance", "compare_every_n_frames"), &GdSceneSynchronizer::set_compare_policy, DEFVAL(0.0), DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("set_node_interpolation_enabled", "node", "enabled"), &GdSceneSynchronizer::set_node_interpolation_enabled);
+	ClassDB::bind_method(D_METHOD("get_rewind_triggers_count", "node", "variable"), &GdSceneSynchronizer::get_rewind_triggers_count);
 
 	ClassDB::bind_method(D_METHOD("track_variable_changes", "nodes", "variables", "callable", "flags"), &GdSceneSynchronizer::track_variable_changes, DEFVAL(NetEventFlag::DEFAULT));
 	ClassDB::bind_method(D_METHOD("untrack_variable_changes", "handle"), &GdSceneSynchronizer::untrack_variable_changes);
@@ -147,12 +170,23 @@ void GdSceneSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_peer_latency_jitter_ms", "peer"), &GdSceneSynchronizer::get_peer_latency_jitter_ms);
 	ClassDB::bind_method(D_METHOD("get_peer_packet_loss_percentage", "peer"), &GdSceneSynchronizer::get_peer_packet_loss_percentage);
 
+	ClassDB::bind_method(D_METHOD("set_lag_compensation_history_enabled", "node", "enabled"), &GdSceneSynchronizer::set_lag_compensation_history_enabled);
+	ClassDB::bind_method(D_METHOD("is_lag_compensation_history_enabled", "node"), &GdSceneSynchronizer::is_lag_compensation_history_enabled);
+	ClassDB::bind_method(D_METHOD("lag_compensation_get_peer_view_frame", "peer"), &GdSceneSynchronizer::lag_compensation_get_peer_view_frame);
+	ClassDB::bind_method(D_METHOD("lag_compensation_rewind_for_peer", "peer", "nodes"), &GdSceneSynchronizer::lag_compensation_rewind_for_peer);
+	ClassDB::bind_method(D_METHOD("lag_compensation_restore"), &GdSceneSynchronizer::lag_compensation_restore);
+
 	ClassDB::bind_method(D_METHOD("sync_group_create"), &GdSceneSynchronizer::sync_group_create);
 	ClassDB::bind_method(D_METHOD("sync_group_add_node", "node_id", "group_id", "realtime"), &GdSceneSynchronizer::sync_group_add_node_by_id);
 	ClassDB::bind_method(D_METHOD("sync_group_remove_node", "node_id", "group_id"), &GdSceneSynchronizer::sync_group_remove_node_by_id);
 	ClassDB::bind_method(D_METHOD("sync_group_move_peer_to", "peer_id", "group_id"), &GdSceneSynchronizer::sync_group_move_peer_to);
 	ClassDB::bind_method(D_METHOD("sync_group_set_trickled_update_rate", "node_id", "group_id", "update_rate"), &GdSceneSynchronizer::sync_group_set_trickled_update_rate_by_id);
 	ClassDB::bind_method(D_METHOD("sync_group_get_trickled_update_rate", "node_id", "group_id"), &GdSceneSynchronizer::sync_group_get_trickled_update_rate_by_id);
+	ClassDB::bind_method(D_METHOD("sync_group_set_adaptive_notify_timespan", "group_id", "enabled", "min_timespan", "max_timespan", "saturation_changes_per_second"), &GdSceneSynchronizer::sync_group_set_adaptive_notify_timespan);
+	ClassDB::bind_method(D_METHOD("sync_group_set_importance", "group_id", "importance"), &GdSceneSynchronizer::sync_group_set_importance);
+	ClassDB::bind_method(D_METHOD("sync_group_get_importance", "group_id"), &GdSceneSynchronizer::sync_group_get_importance);
+	ClassDB::bind_method(D_METHOD("sync_group_get_notify_timespan", "group_id"), &GdSceneSynchronizer::sync_group_get_notify_timespan);
+	ClassDB::bind_method(D_METHOD("get_server_notify_timespan"), &GdSceneSynchronizer::get_server_notify_timespan);
 
 	ClassDB::bind_method(D_METHOD("is_resyncing"), &GdSceneSynchronizer::is_resyncing);
 	ClassDB::bind_method(D_METHOD("is_resetting"), &GdSceneSynchronizer::is_resetting);
@@ -180,6 +214,12 @@ void GdSceneSynchronizer::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "frame_confirmation_timespan", PROPERTY_HINT_RANGE, "0.001,10.0,0.0001"), "set_frame_confirmation_timespan", "get_frame_confirmation_timespan");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "nodes_relevancy_update_time", PROPERTY_HINT_RANGE, "0.0,2.0,0.01"), "set_nodes_relevancy_update_time", "get_nodes_relevancy_update_time");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "snapshot_encoding_async"), "set_snapshot_encoding_async", "is_snapshot_encoding_async");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "snapshot_decoding_async"), "set_snapshot_decoding_async", "is_snapshot_decoding_async");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "snapshot_state_hashing_enabled"), "set_snapshot_state_hashing_enabled", "is_snapshot_state_hashing_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interpolation_delay", PROPERTY_HINT_RANGE, "0.0,1.0,0.001"), "set_interpolation_delay", "get_interpolation_delay");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_extrapolation", PROPERTY_HINT_RANGE, "0.0,1.0,0.001"), "set_max_extrapolation", "get_max_extrapolation");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "client_prediction_memory_budget", PROPERTY_HINT_RANGE, "0,1073741824,1,or_greater,suffix:B"), "set_client_prediction_memory_budget", "get_client_prediction_memory_budget");
 
 	ADD_SIGNAL(MethodInfo("sync_started"));
 	ADD_SIGNAL(MethodInfo("sync_paused"));
@@ -435,6 +475,54 @@ real_t GdSceneSynchronizer::get_frame_confirmation_timespan() const {
 	return scene_synchronizer.get_frame_confirmation_timespan();
 }
 
+void GdSceneSynchronizer::set_snapshot_encoding_async(bool p_enabled) {
+	scene_synchronizer.set_snapshot_encoding_async(p_enabled);
+}
+
+bool GdSceneSynchronizer::is_snapshot_encoding_async() const {
+	return scene_synchronizer.is_snapshot_encoding_async();
+}
+
+void GdSceneSynchronizer::set_snapshot_decoding_async(bool p_enabled) {
+	scene_synchronizer.set_snapshot_decoding_async(p_enabled);
+}
+
+bool GdSceneSynchronizer::is_snapshot_decoding_async() const {
+	return scene_synchronizer.is_snapshot_decoding_async();
+}
+
+void GdSceneSynchronizer::set_snapshot_state_hashing_enabled(bool p_enabled) {
+	scene_synchronizer.set_snapshot_state_hashing_enabled(p_enabled);
+}
+
+bool GdSceneSynchronizer::is_snapshot_state_hashing_enabled() const {
+	return scene_synchronizer.is_snapshot_state_hashing_enabled();
+}
+
+void GdSceneSynchronizer::set_interpolation_delay(real_t p_delay) {
+	scene_synchronizer.set_interpolation_delay(p_delay);
+}
+
+real_t GdSceneSynchronizer::get_interpolation_delay() const {
+	return scene_synchronizer.get_interpolation_delay();
+}
+
+void GdSceneSynchronizer::set_max_extrapolation(real_t p_max_extrapolation) {
+	scene_synchronizer.set_max_extrapolation(p_max_extrapolation);
+}
+
+real_t GdSceneSynchronizer::get_max_extrapolation() const {
+	return scene_synchronizer.get_max_extrapolation();
+}
+
+void GdSceneSynchronizer::set_client_prediction_memory_budget(int64_t p_bytes) {
+	scene_synchronizer.set_client_prediction_memory_budget(std::uint64_t(std::max(p_bytes, int64_t(0))));
+}
+
+int64_t GdSceneSynchronizer::get_client_prediction_memory_budget() const {
+	return int64_t(scene_synchronizer.get_client_prediction_memory_budget());
+}
+
 void GdSceneSynchronizer::set_nodes_relevancy_update_time(real_t p_time) {
 	scene_synchronizer.set_objects_relevancy_update_time(p_time);
 }
@@ -598,6 +686,39 @@ void GdSceneSynchronizer::set_skip_rewinding(Node *p_node, const StringName &p_v
 	}
 }
 
+void GdSceneSynchronizer::set_quantize_on_write(Node *p_node, const StringName &p_variable, bool p_quantize_on_write) {
+	NS::ObjectLocalId id = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node));
+	if (id != NS::ObjectLocalId::NONE) {
+		scene_synchronizer.set_quantize_on_write(id, std::string(String(p_variable).utf8()), p_quantize_on_write);
+	}
+}
+
+void GdSceneSynchronizer::set_compare_policy(Node *p_node, const StringName &p_variable, real_t p_absolute_tolerance, real_t p_relative_tolerance, int p_compare_every_n_frames) {
+	NS::ObjectLocalId id = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node));
+	if (id != NS::ObjectLocalId::NONE) {
+		NS::VarComparePolicy policy;
+		policy.absolute_tolerance = p_absolute_tolerance;
+		policy.relative_tolerance = p_relative_tolerance;
+		policy.compare_every_n_frames = std::uint32_t(MAX(p_compare_every_n_frames, 1));
+		scene_synchronizer.set_compare_policy(id, std::string(String(p_variable).utf8()), policy);
+	}
+}
+
+void GdSceneSynchronizer::set_node_interpolation_enabled(Node *p_node, bool p_enabled) {
+	NS::ObjectLocalId id = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node));
+	if (id != NS::ObjectLocalId::NONE) {
+		scene_synchronizer.set_object_interpolation_enabled(id, p_enabled);
+	}
+}
+
+uint64_t GdSceneSynchronizer::get_rewind_triggers_count(Node *p_node, const StringName &p_variable) const {
+	const NS::ObjectLocalId id = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node));
+	if (id != NS::ObjectLocalId::NONE) {
+		return scene_synchronizer.get_rewind_triggers_count(id, std::string(String(p_variable).utf8()));
+	}
+	return 0;
+}
+
 uint64_t GdSceneSynchronizer::track_variable_changes(
 		Array p_nodes,
 		Array p_vars,
@@ -714,6 +835,42 @@ float GdSceneSynchronizer::get_peer_packet_loss_percentage(int p_peer) const {
 	return scene_synchronizer.get_peer_packet_loss_percentage(p_peer);
 }
 
+void GdSceneSynchronizer::set_lag_compensation_history_enabled(Node *p_node, bool p_enabled) {
+	const NS::ObjectLocalId id = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node));
+	if (id != NS::ObjectLocalId::NONE) {
+		scene_synchronizer.set_lag_compensation_history_enabled(id, p_enabled);
+	}
+}
+
+bool GdSceneSynchronizer::is_lag_compensation_history_enabled(Node *p_node) const {
+	const NS::ObjectLocalId id = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node));
+	if (id != NS::ObjectLocalId::NONE) {
+		return scene_synchronizer.is_lag_compensation_history_enabled(id);
+	}
+	return false;
+}
+
+uint32_t GdSceneSynchronizer::lag_compensation_get_peer_view_frame(int p_peer) const {
+	return scene_synchronizer.lag_compensation_get_peer_view_frame(p_peer).id;
+}
+
+bool GdSceneSynchronizer::lag_compensation_rewind_for_peer(int p_peer, Array p_nodes) {
+	std::vector<NS::ObjectLocalId> objects_ids;
+	objects_ids.reserve(p_nodes.size());
+	for (int i = 0; i < int(p_nodes.size()); i++) {
+		Object *obj = p_nodes[i];
+		Node *node = dynamic_cast<Node *>(obj);
+		const NS::ObjectLocalId id = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(node));
+		ERR_CONTINUE(id == NS::ObjectLocalId::NONE);
+		objects_ids.push_back(id);
+	}
+	return scene_synchronizer.lag_compensation_rewind_for_peer(p_peer, objects_ids);
+}
+
+void GdSceneSynchronizer::lag_compensation_restore() {
+	scene_synchronizer.lag_compensation_restore();
+}
+
 bool GdSceneSynchronizer::client_is_object_simulating(Node *p_node) const {
 	return client_is_object_simulating(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)));
 }
@@ -810,6 +967,26 @@ uint64_t GdSceneSynchronizer::sync_group_get_user_data(uint32_t p_group_id) cons
 	return scene_synchronizer.sync_group_get_user_data(NS::SyncGroupId{ { p_group_id } });
 }
 
+void GdSceneSynchronizer::sync_group_set_adaptive_notify_timespan(uint32_t p_group_id, bool p_enabled, real_t p_min_timespan, real_t p_max_timespan, real_t p_saturation_changes_per_second) {
+	scene_synchronizer.sync_group_set_adaptive_notify_timespan(NS::SyncGroupId{ { p_group_id } }, p_enabled, p_min_timespan, p_max_timespan, p_saturation_changes_per_second);
+}
+
+void GdSceneSynchronizer::sync_group_set_importance(uint32_t p_group_id, real_t p_importance) {
+	scene_synchronizer.sync_group_set_importance(NS::SyncGroupId{ { p_group_id } }, p_importance);
+}
+
+real_t GdSceneSynchronizer::sync_group_get_importance(uint32_t p_group_id) const {
+	return scene_synchronizer.sync_group_get_importance(NS::SyncGroupId{ { p_group_id } });
+}
+
+real_t GdSceneSynchronizer::sync_group_get_notify_timespan(uint32_t p_group_id) const {
+	return scene_synchronizer.sync_group_get_notify_timespan(NS::SyncGroupId{ { p_group_id } });
+}
+
+real_t GdSceneSynchronizer::get_server_notify_timespan() const {
+	return scene_synchronizer.get_server_notify_timespan();
+}
+
 bool GdSceneSynchronizer::is_resyncing() const {
 	return scene_synchronizer.is_resyncing();
 }
@@ -1081,6 +1258,97 @@ bool GdSceneSynchronizer::compare(const NS::VarData &p_A, const NS::VarData &p_B
 	return vA == vB;
 }
 
+static bool is_real_equal_approx(real_t p_A, real_t p_B, float p_absolute_tolerance, float p_relative_tolerance) {
+	return Math::abs(p_A - p_B) <= (p_absolute_tolerance + (p_relative_tolerance * Math::abs(p_A)));
+}
+
+bool GdSceneSynchronizer::compare_approx(const NS::VarData &p_A, const NS::VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance) {
+	Variant vA;
+	Variant vB;
+	convert(vA, p_A);
+	convert(vB, p_B);
+	if (vA.get_type() != vB.get_type()) {
+		return false;
+	}
+
+	// Only the floating point types are compared using the tolerance.
+	switch (vA.get_type()) {
+		case Variant::FLOAT: {
+			return is_real_equal_approx(vA, vB, p_absolute_tolerance, p_relative_tolerance);
+		}
+		case Variant::VECTOR2: {
+			const Vector2 a = vA;
+			const Vector2 b = vB;
+			return is_real_equal_approx(a.x, b.x, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.y, b.y, p_absolute_tolerance, p_relative_tolerance);
+		}
+		case Variant::VECTOR3: {
+			const Vector3 a = vA;
+			const Vector3 b = vB;
+			return is_real_equal_approx(a.x, b.x, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.y, b.y, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.z, b.z, p_absolute_tolerance, p_relative_tolerance);
+		}
+		case Variant::VECTOR4: {
+			const Vector4 a = vA;
+			const Vector4 b = vB;
+			return is_real_equal_approx(a.x, b.x, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.y, b.y, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.z, b.z, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.w, b.w, p_absolute_tolerance, p_relative_tolerance);
+		}
+		case Variant::QUATERNION: {
+			const Quaternion a = vA;
+			const Quaternion b = vB;
+			return is_real_equal_approx(a.x, b.x, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.y, b.y, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.z, b.z, p_absolute_tolerance, p_relative_tolerance) &&
+					is_real_equal_approx(a.w, b.w, p_absolute_tolerance, p_relative_tolerance);
+		}
+		default:
+			return vA == vB;
+	}
+}
+
+std::uint32_t GdSceneSynchronizer::hash(const NS::VarData &p_val, std::uint32_t p_seed) {
+	Variant v;
+	convert(v, p_val);
+	return hash_murmur3_one_32(v.recursive_hash(0), p_seed);
+}
+
+bool GdSceneSynchronizer::interpolate(NS::VarData &r_result, const NS::VarData &p_A, const NS::VarData &p_B, float p_alpha) {
+	Variant vA;
+	Variant vB;
+	convert(vA, p_A);
+	convert(vB, p_B);
+	if (vA.get_type() != vB.get_type()) {
+		return false;
+	}
+
+	switch (vA.get_type()) {
+		case Variant::NIL:
+		case Variant::BOOL:
+		case Variant::OBJECT:
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH:
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::DICTIONARY:
+		case Variant::ARRAY:
+			// These are snapped.
+			return false;
+		default:
+			break;
+	}
+
+	Variant result;
+	Variant::interpolate(vA, vB, p_alpha, result);
+	convert(r_result, result);
+	return true;
+}
+
 // This was needed to optimize the godot stringify for byte arrays.. it was slowing down perfs.
 std::string stringify_byte_array_fast(const Vector<uint8_t> &p_array, bool p_verbose) {
 	std::string str;
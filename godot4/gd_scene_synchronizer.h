@@ -65,6 +65,24 @@ public: // ---------------------------------------------------------- Properties
 	void set_frame_confirmation_timespan(real_t p_interval);
 	real_t get_frame_confirmation_timespan() const;
 
+	void set_snapshot_encoding_async(bool p_enabled);
+	bool is_snapshot_encoding_async() const;
+
+	void set_snapshot_decoding_async(bool p_enabled);
+	bool is_snapshot_decoding_async() const;
+
+	void set_snapshot_state_hashing_enabled(bool p_enabled);
+	bool is_snapshot_state_hashing_enabled() const;
+
+	void set_interpolation_delay(real_t p_delay);
+	real_t get_interpolation_delay() const;
+
+	void set_max_extrapolation(real_t p_max_extrapolation);
+	real_t get_max_extrapolation() const;
+
+	void set_client_prediction_memory_budget(int64_t p_bytes);
+	int64_t get_client_prediction_memory_budget() const;
+
 	void set_nodes_relevancy_update_time(real_t p_time);
 	real_t get_nodes_relevancy_update_time() const;
 
@@ -128,6 +146,10 @@ public: // ---------------------------------------------------------------- APIs
 	uint32_t get_variable_id(Node *p_node, const StringName &p_variable);
 
 	void set_skip_rewinding(Node *p_node, const StringName &p_variable, bool p_skip_rewinding);
+	void set_quantize_on_write(Node *p_node, const StringName &p_variable, bool p_quantize_on_write);
+	void set_compare_policy(Node *p_node, const StringName &p_variable, real_t p_absolute_tolerance, real_t p_relative_tolerance, int p_compare_every_n_frames);
+	void set_node_interpolation_enabled(Node *p_node, bool p_enabled);
+	uint64_t get_rewind_triggers_count(Node *p_node, const StringName &p_variable) const;
 
 	uint64_t track_variable_changes(Array p_nodes, Array p_vars, const Callable &p_callable, NetEventFlag p_flags = NetEventFlag::DEFAULT);
 	void untrack_variable_changes(uint64_t p_handle);
@@ -154,6 +176,12 @@ public: // ---------------------------------------------------------------- APIs
 	int get_peer_latency_jitter_ms(int p_peer) const;
 	float get_peer_packet_loss_percentage(int p_peer) const;
 
+	void set_lag_compensation_history_enabled(Node *p_node, bool p_enabled);
+	bool is_lag_compensation_history_enabled(Node *p_node) const;
+	uint32_t lag_compensation_get_peer_view_frame(int p_peer) const;
+	bool lag_compensation_rewind_for_peer(int p_peer, Array p_nodes);
+	void lag_compensation_restore();
+
 	bool client_is_object_simulating(Node *p_node) const;
 	bool client_is_object_simulating(NS::ObjectLocalId p_id) const;
 	bool client_is_object_simulating(NS::ObjectNetId p_id) const;
@@ -185,6 +213,12 @@ public: // ---------------------------------------------------------------- APIs
 	void sync_group_set_user_data(uint32_t p_group_id, uint64_t p_user_ptr);
 	uint64_t sync_group_get_user_data(uint32_t p_group_id) const;
 
+	void sync_group_set_adaptive_notify_timespan(uint32_t p_group_id, bool p_enabled, real_t p_min_timespan, real_t p_max_timespan, real_t p_saturation_changes_per_second);
+	void sync_group_set_importance(uint32_t p_group_id, real_t p_importance);
+	real_t sync_group_get_importance(uint32_t p_group_id) const;
+	real_t sync_group_get_notify_timespan(uint32_t p_group_id) const;
+	real_t get_server_notify_timespan() const;
+
 	bool is_resyncing() const;
 	bool is_resetting() const;
 	bool is_rewinding() const;
@@ -214,6 +248,9 @@ public: // ---------------------------------------------------------------- APIs
 	static void convert(NS::VarData &r_vd, const Variant &p_variant);
 
 	static bool compare(const NS::VarData &p_A, const NS::VarData &p_B);
+	static bool compare_approx(const NS::VarData &p_A, const NS::VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance);
+	static std::uint32_t hash(const NS::VarData &p_val, std::uint32_t p_seed);
+	static bool interpolate(NS::VarData &r_result, const NS::VarData &p_A, const NS::VarData &p_B, float p_alpha);
 
 	static std::string stringify(const NS::VarData &p_var_data, bool p_verbose);
 };
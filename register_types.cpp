@@ -69,6 +69,9 @@ void initialize_network_synchronizer_module(ModuleInitializationLevel p_level) {
 				[]() {
 					_err_flush_stdout();
 				});
+		NS::SceneSynchronizerBase::install_var_data_compare_approx(GdSceneSynchronizer::compare_approx);
+		NS::SceneSynchronizerBase::install_var_data_hash(GdSceneSynchronizer::hash);
+		NS::SceneSynchronizerBase::install_var_data_interpolate(GdSceneSynchronizer::interpolate);
 
 		GDREGISTER_CLASS(GdDataBuffer);
 		GDREGISTER_CLASS(GdSceneSynchronizer);
@@ -5,11 +5,14 @@
 #include "core/ensure.h"
 #include "core/net_math.h"
 #include "core/net_utilities.h"
+#include "core/network_codec.h"
 #include "core/object_data.h"
 #include "core/peer_networked_controller.h"
 #include "core/quick_sort.h"
 #include "core/snapshot.h"
 #include "core/var_data.h"
+#include <algorithm>
+#include <chrono>
 #include <limits>
 #include <string>
 #include <vector>
@@ -18,7 +21,10 @@ NS_NAMESPACE_BEGIN
 void (*SceneSynchronizerBase::var_data_encode_func)(DataBuffer &r_buffer, const VarData &p_val) = nullptr;
 void (*SceneSynchronizerBase::var_data_decode_func)(VarData &r_val, DataBuffer &p_buffer, std::uint8_t p_variable_type) = nullptr;
 bool (*SceneSynchronizerBase::var_data_compare_func)(const VarData &p_A, const VarData &p_B) = nullptr;
+bool (*SceneSynchronizerBase::var_data_compare_approx_func)(const VarData &p_A, const VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance) = nullptr;
 std::string (*SceneSynchronizerBase::var_data_stringify_func)(const VarData &p_var_data, bool p_verbose) = nullptr;
+std::uint32_t (*SceneSynchronizerBase::var_data_hash_func)(const VarData &p_val, std::uint32_t p_seed) = nullptr;
+bool (*SceneSynchronizerBase::var_data_interpolate_func)(VarData &r_result, const VarData &p_A, const VarData &p_B, float p_alpha) = nullptr;
 bool SceneSynchronizerBase::var_data_stringify_force_verbose = false;
 void (*SceneSynchronizerBase::print_line_func)(PrintMessageType p_level, const std::string &p_str) = nullptr;
 void (*SceneSynchronizerBase::print_code_message_func)(const char *p_function, const char *p_file, int p_line, const std::string &p_error, const std::string &p_message, NS::PrintMessageType p_type) = nullptr;
@@ -60,6 +66,21 @@ void SceneSynchronizerBase::install_synchronizer(
 	print_flush_stdout_func = p_print_flush_stdout_func;
 }
 
+void SceneSynchronizerBase::install_var_data_compare_approx(
+		bool (*p_var_data_compare_approx_func)(const VarData &p_A, const VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance)) {
+	var_data_compare_approx_func = p_var_data_compare_approx_func;
+}
+
+void SceneSynchronizerBase::install_var_data_hash(
+		std::uint32_t (*p_var_data_hash_func)(const VarData &p_val, std::uint32_t p_seed)) {
+	var_data_hash_func = p_var_data_hash_func;
+}
+
+void SceneSynchronizerBase::install_var_data_interpolate(
+		bool (*p_var_data_interpolate_func)(VarData &r_result, const VarData &p_A, const VarData &p_B, float p_alpha)) {
+	var_data_interpolate_func = p_var_data_interpolate_func;
+}
+
 void SceneSynchronizerBase::setup(SynchronizerManager &p_synchronizer_interface) {
 	reset();
 
@@ -89,6 +110,12 @@ void SceneSynchronizerBase::setup(SynchronizerManager &p_synchronizer_interface)
 					true,
 					false);
 
+	rpc_handler_notify_state_hash_mismatch =
+			network_interface->rpc_config(
+					std::function<void(DataBuffer &)>(std::bind(&SceneSynchronizerBase::rpc__notify_state_hash_mismatch, this, std::placeholders::_1)),
+					true,
+					false);
+
 	rpc_handler_set_network_enabled =
 			network_interface->rpc_config(
 					std::function<void(bool)>(std::bind(&SceneSynchronizerBase::rpc_set_network_enabled, this, std::placeholders::_1)),
@@ -137,6 +164,12 @@ void SceneSynchronizerBase::setup(SynchronizerManager &p_synchronizer_interface)
 					false,
 					false);
 
+	rpc_handle_receive_dolls_inputs =
+			network_interface->rpc_config(
+					std::function<void(const std::vector<std::uint8_t> &)>(std::bind(&SceneSynchronizerBase::rpc_receive_dolls_inputs, this, std::placeholders::_1)),
+					false,
+					false);
+
 	reset_synchronizer_mode();
 
 	// Fetch the peers connected from the Network Interface and ini them.
@@ -163,6 +196,7 @@ void SceneSynchronizerBase::conclude() {
 
 	rpc_handler_state.reset();
 	rpc_handler_notify_need_full_snapshot.reset();
+	rpc_handler_notify_state_hash_mismatch.reset();
 	rpc_handler_set_network_enabled.reset();
 	rpc_handler_notify_peer_status.reset();
 	rpc_handler_trickled_sync_data.reset();
@@ -171,6 +205,7 @@ void SceneSynchronizerBase::conclude() {
 	rpc_handle_notify_scheduled_procedure_stop.reset();
 	rpc_handle_notify_scheduled_procedure_pause.reset();
 	rpc_handle_receive_input.reset();
+	rpc_handle_receive_dolls_inputs.reset();
 
 	time_bank = 0.0;
 }
@@ -222,6 +257,31 @@ bool SceneSynchronizerBase::var_data_compare(const VarData &p_A, const VarData &
 	return var_data_compare_func(p_A, p_B);
 }
 
+bool SceneSynchronizerBase::var_data_compare_approx(const VarData &p_A, const VarData &p_B, const VarComparePolicy &p_policy) {
+	NS_PROFILE
+	if (p_policy.is_strict() || !var_data_compare_approx_func) {
+		return var_data_compare_func(p_A, p_B);
+	}
+	return var_data_compare_approx_func(p_A, p_B, p_policy.absolute_tolerance, p_policy.relative_tolerance);
+}
+
+bool SceneSynchronizerBase::is_var_data_hash_installed() {
+	return var_data_hash_func != nullptr;
+}
+
+std::uint32_t SceneSynchronizerBase::var_data_hash(const VarData &p_val, std::uint32_t p_seed) {
+	NS_PROFILE
+	return var_data_hash_func(p_val, p_seed);
+}
+
+bool SceneSynchronizerBase::var_data_interpolate(VarData &r_result, const VarData &p_A, const VarData &p_B, float p_alpha) {
+	NS_PROFILE
+	if (!var_data_interpolate_func) {
+		return false;
+	}
+	return var_data_interpolate_func(r_result, p_A, p_B, p_alpha);
+}
+
 std::string SceneSynchronizerBase::var_data_stringify(const VarData &p_var_data, bool p_verbose) {
 	NS_PROFILE
 	return var_data_stringify_func(p_var_data, p_verbose || var_data_stringify_force_verbose);
@@ -344,6 +404,16 @@ float SceneSynchronizerBase::get_frame_confirmation_timespan() const {
 	return frame_confirmation_timespan;
 }
 
+void SceneSynchronizerBase::set_bandwidth_stats_window_seconds(float p_seconds) {
+	NS_ENSURE_MSG(p_seconds > 0.0f, "The bandwidth stats window must be greater than 0.");
+	bandwidth_stats_window_seconds = p_seconds;
+}
+
+std::uint32_t SceneSynchronizerBase::get_bandwidth_stats_window_index() const {
+	const std::uint32_t window_frames = std::max(std::uint32_t(1), std::uint32_t(std::round(bandwidth_stats_window_seconds * float(get_frames_per_seconds()))));
+	return global_frame_index.id / window_frames;
+}
+
 void SceneSynchronizerBase::set_max_predicted_intervals(float p_max_predicted_intevals) {
 	max_predicted_intervals = std::max(p_max_predicted_intevals, 1.5f);
 }
@@ -557,6 +627,8 @@ void SceneSynchronizerBase::register_variable(ObjectLocalId p_id, const std::str
 						p_get_func,
 						false,
 						true));
+		var_value_version_counter += 1;
+		object_data->vars.back().value_version = var_value_version_counter;
 	} else {
 		// Make sure the var is active.
 		object_data->vars[var_id.id].enabled = true;
@@ -668,6 +740,116 @@ void SceneSynchronizerBase::set_skip_rewinding(ObjectLocalId p_id, const std::st
 	od->vars[id.id].skip_rewinding = p_skip_rewinding;
 }
 
+void SceneSynchronizerBase::set_quantize_on_write(ObjectLocalId p_id, const std::string &p_variable, bool p_quantize_on_write) {
+	NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE(od);
+
+	const VarId id = od->find_variable_id(p_variable);
+	NS_ENSURE(id != VarId::NONE);
+
+	od->vars[id.id].quantize_on_write = p_quantize_on_write;
+}
+
+void SceneSynchronizerBase::set_compare_policy(ObjectLocalId p_id, const std::string &p_variable, const VarComparePolicy &p_policy) {
+	NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE(od);
+
+	const VarId id = od->find_variable_id(p_variable);
+	NS_ENSURE(id != VarId::NONE);
+	NS_ENSURE_MSG(p_policy.compare_every_n_frames > 0, "The `compare_every_n_frames` must be at least 1.");
+
+	od->vars[id.id].compare_policy = p_policy;
+}
+
+void SceneSynchronizerBase::set_object_rewind_island(ObjectLocalId p_id, RewindIslandId p_island) {
+	NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE(od);
+	od->rewind_island = p_island;
+}
+
+RewindIslandId SceneSynchronizerBase::get_object_rewind_island(ObjectLocalId p_id) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE_V(od, RewindIslandId::NONE);
+	return od->rewind_island;
+}
+
+void SceneSynchronizerBase::set_object_interpolation_enabled(ObjectLocalId p_id, bool p_enabled) {
+	NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE(od);
+	if (od->interpolation_enabled == p_enabled) {
+		return;
+	}
+	od->interpolation_enabled = p_enabled;
+
+	// The interpolated objects are not processed.
+	process_functions__clear();
+}
+
+bool SceneSynchronizerBase::is_object_interpolation_enabled(ObjectLocalId p_id) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE_V(od, false);
+	return od->interpolation_enabled;
+}
+
+std::uint64_t SceneSynchronizerBase::get_rewind_triggers_count(ObjectLocalId p_id, const std::string &p_variable) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE_V(od, 0);
+
+	const VarId id = od->find_variable_id(p_variable);
+	NS_ENSURE_V(id != VarId::NONE, 0);
+
+	return od->vars[id.id].rewind_triggers_count;
+}
+
+BandwidthReport SceneSynchronizerBase::get_object_bandwidth(ObjectLocalId p_id) const {
+	BandwidthReport report;
+	const NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE_V(od, report);
+
+	bandwidth_report_add(od->bandwidth_stats, report);
+	return report;
+}
+
+BandwidthReport SceneSynchronizerBase::get_variable_bandwidth(ObjectLocalId p_id, const std::string &p_variable) const {
+	BandwidthReport report;
+	const NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE_V(od, report);
+
+	const VarId id = od->find_variable_id(p_variable);
+	NS_ENSURE_V(id != VarId::NONE, report);
+
+	bandwidth_report_add(od->vars[id.id].bandwidth_stats, report);
+	return report;
+}
+
+BandwidthReport SceneSynchronizerBase::get_scheme_variable_bandwidth(SchemeId p_scheme_id, const std::string &p_variable) const {
+	BandwidthReport report;
+	for (const ObjectData *od : objects_data_storage.get_sorted_objects_data()) {
+		if (!od || od->get_scheme_id() != p_scheme_id) {
+			continue;
+		}
+
+		const VarId id = od->find_variable_id(p_variable);
+		if (id != VarId::NONE) {
+			bandwidth_report_add(od->vars[id.id].bandwidth_stats, report);
+		}
+	}
+	return report;
+}
+
+PredictionMemoryReport SceneSynchronizerBase::client_get_prediction_memory_report() const {
+	NS_ENSURE_V_MSG(is_client(), PredictionMemoryReport(), "This function can be called only on client scene synchronizer.");
+	return static_cast<const ClientSynchronizer *>(synchronizer)->prediction_memory_report;
+}
+
+void SceneSynchronizerBase::bandwidth_report_add(const BandwidthStats &p_stats, BandwidthReport &r_report) const {
+	r_report.bits_sent += p_stats.bits_sent;
+	r_report.times_sent += p_stats.times_sent;
+	r_report.full_snapshot_times_sent += p_stats.full_snapshot_times_sent;
+	r_report.delta_snapshot_times_sent += p_stats.delta_snapshot_times_sent;
+	r_report.bits_per_second += float(p_stats.get_completed_window_bits(get_bandwidth_stats_window_index())) / bandwidth_stats_window_seconds;
+}
+
 ListenerHandle SceneSynchronizerBase::track_variable_changes(
 		ObjectLocalId p_id,
 		const std::string &p_variable,
@@ -1143,6 +1325,135 @@ float SceneSynchronizerBase::get_peer_packet_loss_percentage(int p_peer) const {
 	}
 }
 
+void SceneSynchronizerBase::set_lag_compensation_history_enabled(ObjectLocalId p_id, bool p_enabled) {
+	NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE(od);
+	NS_ENSURE_MSG(!lag_compensation_rewind_in_progress, "The lag compensation history can't be changed while a lag compensation rewind is in progress.");
+	NS_ENSURE_MSG(!p_enabled || settings.lag_compensation.history_frames_count > 0, "The lag compensation `history_frames_count` must be at least 1.");
+
+	const std::size_t frames_count = p_enabled ? std::size_t(settings.lag_compensation.history_frames_count) : 0;
+	od->lag_compensation_history_frames.clear();
+	od->lag_compensation_history_frames.resize(frames_count, GlobalFrameIndex::NONE);
+	for (VarDescriptor &var_desc : od->vars) {
+		var_desc.lag_compensation_history.clear();
+		var_desc.lag_compensation_history.resize(frames_count);
+	}
+}
+
+bool SceneSynchronizerBase::is_lag_compensation_history_enabled(ObjectLocalId p_id) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	NS_ENSURE_V(od, false);
+	return !od->lag_compensation_history_frames.empty();
+}
+
+GlobalFrameIndex SceneSynchronizerBase::lag_compensation_get_peer_view_frame(int p_peer) const {
+	NS_ENSURE_V_MSG(is_server(), GlobalFrameIndex::NONE, "This function CAN be used only on the server.");
+	const PeerData *pd = MapFunc::get_or_null(peer_data, p_peer);
+	NS_ENSURE_V_MSG(pd, GlobalFrameIndex::NONE, "The peer " + std::to_string(p_peer) + " doesn't exist.");
+
+	// The peer sees the server state half RTT after it's processed, then the
+	// input produced by the peer takes another half RTT to reach the server,
+	// where it waits into the controller buffer until processed.
+	const float latency_seconds = std::max(0.0f, pd->get_latency()) / 1000.0f;
+	std::uint32_t frames_back = std::uint32_t(std::round(latency_seconds * float(get_frames_per_seconds())));
+
+	const PeerNetworkedController *peer_controller = get_controller_for_peer(p_peer);
+	if (peer_controller) {
+		frames_back += std::uint32_t(std::max(0, peer_controller->get_server_controller_unchecked()->get_frames_to_process()));
+	}
+
+	return GlobalFrameIndex{ global_frame_index.id - std::min(frames_back, global_frame_index.id) };
+}
+
+bool SceneSynchronizerBase::lag_compensation_rewind(GlobalFrameIndex p_frame, const std::vector<ObjectLocalId> &p_objects) {
+	NS_PROFILE
+	NS_ENSURE_V_MSG(is_server(), false, "This function CAN be used only on the server.");
+	NS_ENSURE_V_MSG(!lag_compensation_rewind_in_progress, false, "A lag compensation rewind is already in progress, call `lag_compensation_restore` first.");
+	NS_ENSURE_V(p_frame != GlobalFrameIndex::NONE, false);
+
+	lag_compensation_rewind_in_progress = true;
+	lag_compensation_restore_info.clear();
+
+	bool all_rewound = true;
+	for (ObjectLocalId id : p_objects) {
+		ObjectData *od = get_object_data(id);
+		NS_ENSURE_CONTINUE(od);
+
+		const std::vector<GlobalFrameIndex> &frames = od->lag_compensation_history_frames;
+		NS_ENSURE_CONTINUE_MSG(!frames.empty(), "The object `" + od->get_object_name() + "` doesn't have the lag compensation history enabled.");
+
+		const std::size_t slot = p_frame.id % frames.size();
+		if (frames[slot] != p_frame) {
+			// The frame is not in the history (too old or not yet processed).
+			all_rewound = false;
+			continue;
+		}
+
+		for (VarDescriptor &var_desc : od->vars) {
+			if (!var_desc.enabled || slot >= var_desc.lag_compensation_history.size()) {
+				continue;
+			}
+
+			LagCompensationRestoreInfo info;
+			info.id = id;
+			info.var_id = var_desc.id;
+			var_desc.get_func(
+					*synchronizer_manager,
+					od->app_object_handle,
+					var_desc.var.name,
+					info.value);
+
+			const VarData &past_value = var_desc.lag_compensation_history[slot];
+			if (SceneSynchronizerBase::var_data_compare(info.value, past_value)) {
+				// Nothing to rewind.
+				continue;
+			}
+
+			var_desc.set_func(
+					*synchronizer_manager,
+					od->app_object_handle,
+					var_desc.var.name,
+					past_value);
+			lag_compensation_restore_info.push_back(std::move(info));
+		}
+	}
+
+	return all_rewound;
+}
+
+bool SceneSynchronizerBase::lag_compensation_rewind_for_peer(int p_peer, const std::vector<ObjectLocalId> &p_objects) {
+	const GlobalFrameIndex frame = lag_compensation_get_peer_view_frame(p_peer);
+	NS_ENSURE_V(frame != GlobalFrameIndex::NONE, false);
+	return lag_compensation_rewind(frame, p_objects);
+}
+
+void SceneSynchronizerBase::lag_compensation_restore() {
+	NS_PROFILE
+	NS_ENSURE_MSG(lag_compensation_rewind_in_progress, "No lag compensation rewind is in progress.");
+
+	for (const LagCompensationRestoreInfo &info : lag_compensation_restore_info) {
+		ObjectData *od = get_object_data(info.id, false);
+		if (!od) {
+			// The object was destroyed meanwhile.
+			continue;
+		}
+
+		VarDescriptor &var_desc = od->vars[info.var_id.id];
+		var_desc.set_func(
+				*synchronizer_manager,
+				od->app_object_handle,
+				var_desc.var.name,
+				info.value);
+	}
+
+	lag_compensation_restore_info.clear();
+	lag_compensation_rewind_in_progress = false;
+}
+
+bool SceneSynchronizerBase::is_lag_compensation_rewind_in_progress() const {
+	return lag_compensation_rewind_in_progress;
+}
+
 SyncGroupId SceneSynchronizerBase::sync_group_create() {
 	NS_ENSURE_V_MSG(is_server(), SyncGroupId::NONE, "This function CAN be used only on the server.");
 	const SyncGroupId id = static_cast<ServerSynchronizer *>(synchronizer)->sync_group_create();
@@ -1310,6 +1621,49 @@ uint64_t SceneSynchronizerBase::sync_group_get_user_data(SyncGroupId p_group_id)
 	return static_cast<ServerSynchronizer *>(synchronizer)->sync_group_get_user_data(p_group_id);
 }
 
+void SceneSynchronizerBase::sync_group_set_adaptive_notify_timespan(SyncGroupId p_group_id, bool p_enabled, float p_min_timespan, float p_max_timespan, float p_saturation_changes_per_second) {
+	NS_ENSURE_MSG(is_server(), "This function CAN be used only on the server.");
+	ServerSynchronizer *r = static_cast<ServerSynchronizer *>(synchronizer);
+	NS_ENSURE_MSG(p_group_id.id < r->sync_groups.size(), "The group id `" + p_group_id + "` doesn't exist.");
+	r->sync_groups[p_group_id.id].set_adaptive_notify_timespan(p_enabled, p_min_timespan, p_max_timespan, p_saturation_changes_per_second);
+}
+
+void SceneSynchronizerBase::sync_group_set_importance(SyncGroupId p_group_id, float p_importance) {
+	NS_ENSURE_MSG(is_server(), "This function CAN be used only on the server.");
+	ServerSynchronizer *r = static_cast<ServerSynchronizer *>(synchronizer);
+	NS_ENSURE_MSG(p_group_id.id < r->sync_groups.size(), "The group id `" + p_group_id + "` doesn't exist.");
+	r->sync_groups[p_group_id.id].set_importance(p_importance);
+}
+
+float SceneSynchronizerBase::sync_group_get_importance(SyncGroupId p_group_id) const {
+	NS_ENSURE_V_MSG(is_server(), 0.0f, "This function CAN be used only on the server.");
+	const ServerSynchronizer *r = static_cast<const ServerSynchronizer *>(synchronizer);
+	NS_ENSURE_V_MSG(p_group_id.id < r->sync_groups.size(), 0.0f, "The group id `" + p_group_id + "` doesn't exist.");
+	return r->sync_groups[p_group_id.id].get_importance();
+}
+
+float SceneSynchronizerBase::sync_group_get_notify_timespan(SyncGroupId p_group_id) const {
+	NS_ENSURE_V_MSG(is_server(), 0.0f, "This function CAN be used only on the server.");
+	const ServerSynchronizer *r = static_cast<const ServerSynchronizer *>(synchronizer);
+	NS_ENSURE_V_MSG(p_group_id.id < r->sync_groups.size(), 0.0f, "The group id `" + p_group_id + "` doesn't exist.");
+	return r->sync_groups[p_group_id.id].get_notify_timespan(get_frame_confirmation_timespan());
+}
+
+BandwidthReport SceneSynchronizerBase::sync_group_get_bandwidth(SyncGroupId p_group_id) const {
+	BandwidthReport report;
+	NS_ENSURE_V_MSG(is_server(), report, "This function CAN be used only on the server.");
+	const ServerSynchronizer *r = static_cast<const ServerSynchronizer *>(synchronizer);
+	NS_ENSURE_V_MSG(p_group_id.id < r->sync_groups.size(), report, "The group id `" + p_group_id + "` doesn't exist.");
+	bandwidth_report_add(r->sync_groups[p_group_id.id].bandwidth_stats, report);
+	return report;
+}
+
+float SceneSynchronizerBase::get_server_notify_timespan() const {
+	NS_ENSURE_V_MSG(is_client(), get_frame_confirmation_timespan(), "This function CAN be used only on the client.");
+	const ClientSynchronizer *c = static_cast<const ClientSynchronizer *>(synchronizer);
+	return c->server_notify_timespan >= 0.0f ? c->server_notify_timespan : get_frame_confirmation_timespan();
+}
+
 bool SceneSynchronizerBase::is_resyncing() const {
 	return recover_in_progress;
 }
@@ -1333,7 +1687,8 @@ std::size_t SceneSynchronizerBase::get_client_max_frames_storage_size() const {
 	// These two settings are used to make the frames input buffer big enough
 	// to allow the clients to collect inputs until expected, then the client stops
 	// collecting new inputs until the server confirmation is received.
-	const float frames_produced_per_confirmation_interval = std::max(get_frame_confirmation_timespan() * float(get_frames_per_seconds()), 1.f);
+	const float confirmation_timespan = is_client() ? std::max(get_frame_confirmation_timespan(), get_server_notify_timespan()) : get_frame_confirmation_timespan();
+	const float frames_produced_per_confirmation_interval = std::max(confirmation_timespan * float(get_frames_per_seconds()), 1.f);
 	const float maximum_frames_input_buffer_size = (frames_produced_per_confirmation_interval * get_max_predicted_intervals()) + float(max_server_input_buffer_size);
 	return std::size_t(std::ceil(maximum_frames_input_buffer_size));
 }
@@ -1633,6 +1988,8 @@ void SceneSynchronizerBase::reset() {
 	clear();
 
 	global_frame_index = GlobalFrameIndex{ 0 };
+	lag_compensation_restore_info.clear();
+	lag_compensation_rewind_in_progress = false;
 
 	event_sync_started.clear();
 	event_sync_paused.clear();
@@ -1640,6 +1997,7 @@ void SceneSynchronizerBase::reset() {
 	event_peer_status_updated.clear();
 	event_state_validated.clear();
 	event_sent_snapshot.clear();
+	event_full_snapshot_streaming_completed.clear();
 	event_snapshot_update_finished.clear();
 	event_snapshot_applied.clear();
 	event_received_server_snapshot.clear();
@@ -1662,11 +2020,13 @@ void SceneSynchronizerBase::reset() {
 
 	rpc_handler_state.reset();
 	rpc_handler_notify_need_full_snapshot.reset();
+	rpc_handler_notify_state_hash_mismatch.reset();
 	rpc_handler_set_network_enabled.reset();
 	rpc_handler_notify_peer_status.reset();
 	rpc_handler_trickled_sync_data.reset();
 	rpc_handle_notify_netstats.reset();
 	rpc_handle_receive_input.reset();
+	rpc_handle_receive_dolls_inputs.reset();
 	network_interface->reset();
 }
 
@@ -1690,6 +2050,21 @@ void SceneSynchronizerBase::rpc__notify_need_full_snapshot() {
 	static_cast<ServerSynchronizer *>(synchronizer)->notify_need_full_snapshot(peer, false);
 }
 
+void SceneSynchronizerBase::rpc__notify_state_hash_mismatch(DataBuffer &p_data) {
+	NS_ENSURE_MSG(is_server(), "Only the server can receive the state hash mismatches.");
+	p_data.begin_read(get_debugger());
+
+	const int peer = network_interface->rpc_get_sender();
+	const std::uint64_t objects_count = p_data.read_uint(DataBuffer::COMPRESSION_LEVEL_2);
+	NS_ENSURE_MSG(!p_data.is_buffer_failed(), "Failed to read the mismatched objects count.");
+	for (std::uint64_t i = 0; i < objects_count; i++) {
+		ObjectNetId net_id;
+		p_data.read(net_id.id);
+		NS_ENSURE_MSG(!p_data.is_buffer_failed(), "Failed to read the mismatched object NetId.");
+		static_cast<ServerSynchronizer *>(synchronizer)->notify_state_hash_mismatch(peer, net_id);
+	}
+}
+
 void SceneSynchronizerBase::rpc_set_network_enabled(bool p_enabled) {
 	NS_ENSURE_MSG(is_server(), "The peer status is supposed to be received by the server.");
 	set_peer_networking_enable(
@@ -1728,6 +2103,10 @@ void SceneSynchronizerBase::rpc_notify_netstats(DataBuffer &p_data) {
 	p_data.read(compressed_input_count);
 	NS_ENSURE_MSG(!p_data.is_buffer_failed(), "Failed to read compressed input count.");
 
+	std::uint8_t redundant_inputs;
+	p_data.read(redundant_inputs);
+	NS_ENSURE_MSG(!p_data.is_buffer_failed(), "Failed to read the redundant inputs.");
+
 	// 1. Updates the peer network statistics
 	const int local_peer = network_interface->get_local_peer_id();
 	PeerData *local_peer_data = NS::MapFunc::get_or_null(peer_data, local_peer);
@@ -1740,6 +2119,11 @@ void SceneSynchronizerBase::rpc_notify_netstats(DataBuffer &p_data) {
 	//    the network health.
 	ClientSynchronizer *client_sync = static_cast<ClientSynchronizer *>(synchronizer);
 
+	// Sends the redundant inputs the server asked, depending on the packet loss.
+	if (client_sync->player_controller) {
+		client_sync->player_controller->set_redundant_inputs(redundant_inputs);
+	}
+
 	// The optimal frame count the server should have according to the network
 	// conditions.
 	float optimal_frame_distance = 0.0f;
@@ -1790,6 +2174,7 @@ void SceneSynchronizerBase::rpc_notify_netstats(DataBuffer &p_data) {
 				"\n  Average jitter (ms): `" + std::to_string(local_peer_data->get_latency_jitter_ms()) + "`" +
 				"\n  Optimal frame count on server: `" + std::to_string(optimal_frame_distance) + "`" +
 				"\n  Frame count on server: `" + std::to_string(compressed_input_count) + "`" +
+				"\n  Redundant inputs: `" + std::to_string(redundant_inputs) + "`" +
 				"\n  Acceleration fps: `" + std::to_string(client_sync->acceleration_fps_speed) + "`" +
 				"\n  Acceleration time: `" + std::to_string(client_sync->acceleration_fps_timer) + "`",
 				get_network_interface().get_owner_name(),
@@ -1839,6 +2224,31 @@ void SceneSynchronizerBase::rpc_receive_inputs(int p_peer, const std::vector<std
 	pd->get_controller()->notify_receive_inputs(p_data);
 }
 
+void SceneSynchronizerBase::rpc_receive_dolls_inputs(const std::vector<std::uint8_t> &p_data) {
+	NS_ENSURE(is_client());
+
+	// The packet contains the inputs of many dolls, each one composed as
+	// follows, check `ServerSynchronizer::process_dolls_inputs_forwarding()`:
+	// - 4 bytes for the peer.
+	// - 2 bytes for the inputs size.
+	// - The inputs, encoded by `PeerNetworkedController::encode_inputs()`.
+	std::vector<std::uint8_t> inputs;
+	std::size_t offset = 0;
+	while (offset < p_data.size()) {
+		NS_ENSURE_MSG(offset + 6 <= p_data.size(), "The dolls inputs packet is corrupted.");
+		const int peer = int(std::uint32_t(p_data[offset]) | (std::uint32_t(p_data[offset + 1]) << 8) | (std::uint32_t(p_data[offset + 2]) << 16) | (std::uint32_t(p_data[offset + 3]) << 24));
+		const std::size_t inputs_size = std::size_t(p_data[offset + 4]) | (std::size_t(p_data[offset + 5]) << 8);
+		offset += 6;
+		NS_ENSURE_MSG(offset + inputs_size <= p_data.size(), "The dolls inputs packet is corrupted.");
+		inputs.assign(p_data.begin() + offset, p_data.begin() + offset + inputs_size);
+		offset += inputs_size;
+
+		PeerData *pd = MapFunc::get_or_null(peer_data, peer);
+		NS_ENSURE_CONTINUE_MSG(pd && pd->get_controller(), "The PeerData or its controller was not found during `rpc_receive_dolls_inputs` for peer " + std::to_string(peer));
+		pd->get_controller()->notify_receive_inputs(inputs);
+	}
+}
+
 
 void SceneSynchronizerBase::detect_and_signal_changed_variables(int p_flags) {
 	const std::vector<ObjectData *> &active_objects = synchronizer->get_active_objects();
@@ -2223,6 +2633,8 @@ std::string SceneSynchronizerBase::debug_get_data_objects_table(int columns_coun
 					if (od->vars.size() > i) {
 						value = od->vars[i].enabled ? "" : "[Disabled] ";
 						value += od->vars[i].skip_rewinding ? "[No rewinding] " : "";
+						value += od->vars[i].rewind_triggers_count > 0 ? "[Rewinds: " + std::to_string(od->vars[i].rewind_triggers_count) + "] " : "";
+						value += od->vars[i].bandwidth_stats.bits_sent > 0 ? "[Sent: " + std::to_string(od->vars[i].bandwidth_stats.bits_sent) + " bits] " : "";
 						value += od->vars[i].var.name + ": ";
 						value += var_data_stringify(od->vars[i].var.value, false);
 					}
@@ -2295,12 +2707,19 @@ bool SceneSynchronizerBase::process_functions__execute() {
 		}
 
 		// Build the cached_process_functions, making sure the node data order is kept.
+		cached_process_functions_interpolated_objects = 0;
 		for (auto od : objects_data_storage.get_sorted_objects_data()) {
 			if (od == nullptr || (is_client() && od->realtime_sync_enabled_on_client == false)) {
 				// Nothing to process
 				continue;
 			}
 
+			if (is_client() && od->is_client_interpolated()) {
+				// The interpolated objects are not predicted.
+				cached_process_functions_interpolated_objects += 1;
+				continue;
+			}
+
 			// For each valid NodeData.
 			for (int process_phase = PROCESS_PHASE_EARLY; process_phase < PROCESS_PHASE_COUNT; ++process_phase) {
 				// Append the contained functions.
@@ -2316,13 +2735,10 @@ bool SceneSynchronizerBase::process_functions__execute() {
 		return false;
 	}
 
-	if make_unlikely(global_frame_index==GlobalFrameIndex::NONE) {
-		// Reset the frame index before overflow.
-		// Notice that at 60Hz this is triggered after 2 years of never ever
-		// resetting the server, so it's very unlikely.
-		global_frame_index.id = 0;
-	} else {
-		global_frame_index.id++;
+	advance_global_frame_index();
+
+	if (is_client()) {
+		static_cast<ClientSynchronizer *>(synchronizer)->last_interpolation_skipped_processes_count += cached_process_functions_interpolated_objects;
 	}
 
 	process_functions__execute_scheduled_procedure();
@@ -2335,9 +2751,107 @@ bool SceneSynchronizerBase::process_functions__execute() {
 		cached_process_functions[process_phase].broadcast(get_fixed_frame_delta());
 	}
 
+	process_functions__quantize_variables();
+
 	return true;
 }
 
+void SceneSynchronizerBase::process_functions__execute_objects(const std::vector<ObjectData *> &p_objects) {
+	NS_PROFILE
+
+	advance_global_frame_index();
+
+	for (int process_phase = PROCESS_PHASE_EARLY; process_phase < PROCESS_PHASE_COUNT; ++process_phase) {
+		for (ObjectData *od : p_objects) {
+			od->functions[process_phase].broadcast(get_fixed_frame_delta());
+		}
+	}
+
+	DataBuffer db(get_debugger());
+	for (ObjectData *od : p_objects) {
+		quantize_object_variables(*od, db);
+	}
+}
+
+void SceneSynchronizerBase::advance_global_frame_index() {
+	if make_unlikely(global_frame_index==GlobalFrameIndex::NONE) {
+		// Reset the frame index before overflow.
+		// Notice that at 60Hz this is triggered after 2 years of never ever
+		// resetting the server, so it's very unlikely.
+		global_frame_index.id = 0;
+	} else {
+		global_frame_index.id++;
+	}
+}
+
+void SceneSynchronizerBase::lag_compensation_history_record() {
+	NS_PROFILE
+
+	for (ObjectData *od : synchronizer->get_active_objects()) {
+		if (!od || od->lag_compensation_history_frames.empty()) {
+			continue;
+		}
+
+		const std::size_t frames_count = od->lag_compensation_history_frames.size();
+		const std::size_t slot = global_frame_index.id % frames_count;
+		od->lag_compensation_history_frames[slot] = global_frame_index;
+
+		for (VarDescriptor &var_desc : od->vars) {
+			if make_unlikely(var_desc.lag_compensation_history.size() != frames_count) {
+				// This variable was registered after the history got enabled.
+				var_desc.lag_compensation_history.resize(frames_count);
+			}
+			// NOTE: The value was just pulled by `detect_and_signal_changed_variables`.
+			var_desc.lag_compensation_history[slot].copy(var_desc.var.value);
+		}
+	}
+}
+
+void SceneSynchronizerBase::process_functions__quantize_variables() {
+	NS_PROFILE
+
+	// NOTE: This function is executed right after the process functions, on
+	//       both the server and the client, so the simulation always
+	//       continues from the values the server is able to network.
+	DataBuffer db(get_debugger());
+	for (ObjectData *od : synchronizer->get_active_objects()) {
+		if (od) {
+			quantize_object_variables(*od, db);
+		}
+	}
+}
+
+void SceneSynchronizerBase::quantize_object_variables(ObjectData &p_object_data, DataBuffer &r_buffer) {
+	for (VarDescriptor &var_desc : p_object_data.vars) {
+		if (!var_desc.enabled || !var_desc.quantize_on_write) {
+			continue;
+		}
+
+		VarData value;
+		var_desc.get_func(
+				*synchronizer_manager,
+				p_object_data.app_object_handle,
+				var_desc.var.name.c_str(),
+				value);
+
+		r_buffer.begin_write(get_debugger(), 0);
+		SceneSynchronizerBase::var_data_encode(r_buffer, value, var_desc.type);
+		r_buffer.dry();
+		r_buffer.begin_read(get_debugger());
+		VarData quantized_value;
+		SceneSynchronizerBase::var_data_decode(quantized_value, r_buffer, var_desc.type);
+		NS_ENSURE_CONTINUE_MSG(!r_buffer.is_buffer_failed(), "The variable `" + var_desc.var.name + "` of the object `" + p_object_data.get_object_name() + "` failed to be quantized.");
+
+		if (!SceneSynchronizerBase::var_data_compare(value, quantized_value)) {
+			var_desc.set_func(
+					*synchronizer_manager,
+					p_object_data.app_object_handle,
+					var_desc.var.name,
+					quantized_value);
+		}
+	}
+}
+
 void SceneSynchronizerBase::process_functions__execute_scheduled_procedure() {
 	// NOTE this function is executed inside the process phase but after all
 	//      controllers have been executed. check the `process_functions_execute`.
@@ -2578,6 +3092,8 @@ void SceneSynchronizerBase::pull_object_changes(NS::ObjectData &p_object_data) {
 					var_desc.id,
 					var_desc.var.value);
 			var_desc.var.value = std::move(new_val);
+			var_value_version_counter += 1;
+			var_desc.value_version = var_value_version_counter;
 		}
 	}
 }
@@ -2652,7 +3168,13 @@ ServerSynchronizer::ServerSynchronizer(SceneSynchronizerBase *p_node) :
 	NS_ASSERT_COND(NS::SyncGroupId::GLOBAL == sync_group_create());
 }
 
+ServerSynchronizer::~ServerSynchronizer() {
+	snapshot_encoder_stop(false);
+}
+
 void ServerSynchronizer::clear() {
+	// The objects are already dropped, so the pending snapshots are stale.
+	snapshot_encoder_stop(false);
 	objects_relevancy_update_timer = 0.0;
 	// Release the internal memory.
 	sync_groups.clear();
@@ -2678,6 +3200,7 @@ void ServerSynchronizer::process(float p_delta) {
 		const bool executed = scene_synchronizer->process_functions__execute();
 		NS_ASSERT_COND(executed);
 		scene_synchronizer->detect_and_signal_changed_variables(NetEventFlag::CHANGE);
+		scene_synchronizer->lag_compensation_history_record();
 
 		process_snapshot_notificator();
 
@@ -2697,6 +3220,7 @@ void ServerSynchronizer::process(float p_delta) {
 #endif
 	}
 
+	process_dolls_inputs_forwarding();
 	process_trickled_sync(p_delta);
 	update_peers_net_statistics(p_delta);
 }
@@ -2808,15 +3332,36 @@ void ServerSynchronizer::notify_need_full_snapshot(int p_peer, bool p_notify_ASA
 	}
 }
 
-SyncGroupId ServerSynchronizer::sync_group_create() {
-	SyncGroupId id;
-	id.id = (SyncGroupId::IdType)sync_groups.size();
-	sync_groups.resize(id.id + 1);
-	sync_groups[id.id].group_id = id;
-	sync_groups[id.id].scene_sync = scene_synchronizer;
-	return id;
-}
-
+void ServerSynchronizer::notify_state_hash_mismatch(int p_peer, ObjectNetId p_net_id) {
+	ObjectData *od = scene_synchronizer->get_object_data(p_net_id, false);
+	if (!od) {
+		// The object was removed meanwhile.
+		return;
+	}
+
+	// Each group networks the values by its next snapshot, no matter its
+	// cadence.
+	for (SyncGroup &group : sync_groups) {
+		group.notify_state_hash_mismatch(od);
+	}
+
+	notify_need_snapshot_asap(p_peer);
+}
+
+bool ServerSynchronizer::is_full_snapshot_streaming(int p_peer) const {
+	const PeerServerData *psd = MapFunc::get_or_null(peers_data, p_peer);
+	return psd && psd->full_snapshot_streaming;
+}
+
+SyncGroupId ServerSynchronizer::sync_group_create() {
+	SyncGroupId id;
+	id.id = (SyncGroupId::IdType)sync_groups.size();
+	sync_groups.resize(id.id + 1);
+	sync_groups[id.id].group_id = id;
+	sync_groups[id.id].scene_sync = scene_synchronizer;
+	return id;
+}
+
 const SyncGroup *ServerSynchronizer::sync_group_get(SyncGroupId p_group_id) const {
 	NS_ENSURE_V_MSG(p_group_id.id < sync_groups.size(), nullptr, "The group id `" + p_group_id + "` doesn't exist.");
 	return &sync_groups[p_group_id.id];
@@ -3019,6 +3564,15 @@ void ServerSynchronizer::sync_group_debug_print() {
 
 // This function MUST be processed with a fixed delta time.
 void ServerSynchronizer::process_snapshot_notificator() {
+	const bool encoding_async = scene_synchronizer->is_snapshot_encoding_async();
+	if (encoding_async) {
+		// Send the snapshots encoded while this tick was processed.
+		snapshot_encoder_flush();
+		snapshot_encoder_start();
+	} else {
+		snapshot_encoder_stop(true);
+	}
+
 	if (scene_synchronizer->peer_data.empty()) {
 		// No one is listening.
 		return;
@@ -3040,13 +3594,39 @@ void ServerSynchronizer::process_snapshot_notificator() {
 				notify_state,
 				partial_update_simulated_objects_info_indices);
 
+		// The peers receiving the same snapshot are notified at once.
 		bool full_snapshot_need_init = true;
-		DataBuffer full_snapshot(get_debugger());
-		full_snapshot.begin_write(get_debugger(), 0);
+		SnapshotEncodeJob full_snapshot;
+		full_snapshot.group_id = group.group_id;
+		full_snapshot.is_full_snapshot = true;
+		full_snapshot.snapshot.begin_write(get_debugger(), 0);
+		// The values are copied only when encoded by the worker thread.
+		full_snapshot.capture.copy_values = encoding_async;
 
 		bool delta_snapshot_need_init = true;
-		DataBuffer delta_snapshot(get_debugger());
-		delta_snapshot.begin_write(get_debugger(), 0);
+		SnapshotEncodeJob delta_snapshot;
+		delta_snapshot.group_id = group.group_id;
+		delta_snapshot.snapshot.begin_write(get_debugger(), 0);
+		delta_snapshot.capture.copy_values = encoding_async;
+
+		// The state hash is verified by the client against its prediction, so
+		// it can be used only when all the peers are predicting the scene.
+		// When a client prediction mismatched, the group values are networked
+		// until the mismatched objects are notified, so the client can rewind.
+		delta_snapshot.capture.state_hashing =
+				scene_synchronizer->is_snapshot_state_hashing_enabled() &&
+				SceneSynchronizerBase::is_var_data_hash_installed() &&
+				!group.is_state_hash_mismatched();
+		for (int peer_id : group.get_listening_peers()) {
+			if (!delta_snapshot.capture.state_hashing) {
+				break;
+			}
+			if (peer_id == scene_synchronizer->get_network_interface().get_local_peer_id()) {
+				continue;
+			}
+			const PeerData *peer = MapFunc::get_or_null(scene_synchronizer->peer_data, peer_id);
+			delta_snapshot.capture.state_hashing = peer && peer->get_controller();
+		}
 
 		for (int peer_id : group.get_listening_peers()) {
 			if (peer_id == scene_synchronizer->get_network_interface().get_local_peer_id()) {
@@ -3061,49 +3641,84 @@ void ServerSynchronizer::process_snapshot_notificator() {
 			}
 			auto pd_it = MapFunc::insert_if_new(peers_data, peer_id, PeerServerData());
 
-			if (pd_it->second.force_notify_snapshot == false && notify_state == false) {
+			if (pd_it->second.force_notify_snapshot == false && notify_state == false && pd_it->second.full_snapshot_streaming == false) {
 				// Nothing to sync.
 				continue;
 			}
 
 			pd_it->second.force_notify_snapshot = false;
 
-			PeerNetworkedController *controller = peer->get_controller();
-
 			// Fetch the peer input_id for this snapshot
-			FrameIndex input_id = FrameIndex::NONE;
-			if (controller) {
-				input_id = controller->get_current_frame_index();
-			}
-
-			DataBuffer *snap;
-			if (pd_it->second.need_full_snapshot) {
+			const SnapshotRecipient recipient = make_snapshot_recipient(peer_id, peer->get_controller());
+
+			DataBuffer *snap = nullptr;
+			DataBuffer stream_snapshot(get_debugger());
+			SnapshotCapture stream_capture;
+			bool full_snapshot_streaming_completed = false;
+			if (pd_it->second.need_full_snapshot && scene_synchronizer->get_full_snapshot_streaming_budget_bytes() > 0) {
+				// Start streaming the full snapshot: all the objects are pending.
+				pd_it->second.need_full_snapshot = false;
+				pd_it->second.full_snapshot_streaming = true;
+
+				stream_snapshot.begin_write(get_debugger(), 0);
+				full_snapshot_streaming_completed = generate_full_snapshot_stream_chunk(true, group, peer_id, pd_it->second.full_snapshot_pending_objects, stream_snapshot, stream_capture);
+				snap = &stream_snapshot;
+				get_debugger().print(VERBOSE, "Start streaming the full snapshot to peer: " + std::to_string(pd_it->first));
+			} else if (pd_it->second.full_snapshot_streaming && !pd_it->second.need_full_snapshot) {
+				stream_snapshot.begin_write(get_debugger(), 0);
+				full_snapshot_streaming_completed = generate_full_snapshot_stream_chunk(false, group, peer_id, pd_it->second.full_snapshot_pending_objects, stream_snapshot, stream_capture);
+				snap = &stream_snapshot;
+				get_debugger().print(VERBOSE, "Sending streamed full snapshot chunk to peer: " + std::to_string(pd_it->first));
+			} else if (pd_it->second.need_full_snapshot) {
 				pd_it->second.need_full_snapshot = false;
+				pd_it->second.full_snapshot_streaming = false;
+				pd_it->second.full_snapshot_pending_objects.clear();
 				if (full_snapshot_need_init) {
 					full_snapshot_need_init = false;
-					generate_snapshot(true, group, std::vector<std::size_t>(), full_snapshot);
+					capture_snapshot(true, group, std::vector<std::size_t>(), full_snapshot.snapshot, full_snapshot.capture);
 				}
 
-				snap = &full_snapshot;
+				full_snapshot.recipients.push_back(recipient);
 				get_debugger().print(VERBOSE, "Sending full snapshot to peer: " + std::to_string(pd_it->first));
 			} else {
 				if (delta_snapshot_need_init) {
 					delta_snapshot_need_init = false;
-					generate_snapshot(false, group, partial_update_simulated_objects_info_indices, delta_snapshot);
+					capture_snapshot(false, group, partial_update_simulated_objects_info_indices, delta_snapshot.snapshot, delta_snapshot.capture);
 				}
 
-				snap = &delta_snapshot;
+				delta_snapshot.recipients.push_back(recipient);
 				get_debugger().print(VERBOSE, "Sending incremental snapshot to peer: " + std::to_string(pd_it->first));
 			}
 
-			scene_synchronizer->rpc_handler_state.rpc(
-					scene_synchronizer->get_network_interface(),
-					peer_id,
-					*snap);
-			scene_synchronizer->event_sent_snapshot.broadcast(input_id, peer_id);
+			if (snap) {
+				// The streamed snapshot is specific to this peer.
+				scene_synchronizer->rpc_handler_state.rpc(
+						scene_synchronizer->get_network_interface(),
+						peer_id,
+						*snap);
+				bandwidth_stats_add(group.group_id, true, stream_capture, *snap, 1);
+				notify_snapshot_sent(recipient);
+			}
+
+			if (full_snapshot_streaming_completed) {
+				pd_it->second.full_snapshot_streaming = false;
+				pd_it->second.full_snapshot_pending_objects.clear();
+				get_debugger().print(INFO, "The full snapshot streaming to peer `" + std::to_string(peer_id) + "` is completed.");
+				scene_synchronizer->event_full_snapshot_streaming_completed.broadcast(peer_id);
+			}
+		}
+
+		for (SnapshotEncodeJob *job : { &full_snapshot, &delta_snapshot }) {
+			if (job->recipients.empty()) {
+				continue;
+			}
 
-			if (controller) {
-				controller->get_server_controller()->notify_send_state();
+			if (encoding_async) {
+				// The snapshot is encoded by the worker thread and sent on the next tick.
+				snapshot_encode_jobs.push_back(std::move(*job));
+			} else {
+				encode_snapshot_capture(job->capture, job->snapshot);
+				send_snapshot(*job);
 			}
 		}
 
@@ -3116,6 +3731,185 @@ void ServerSynchronizer::process_snapshot_notificator() {
 					partial_update_simulated_objects_info_indices);
 		}
 	}
+
+	snapshot_encoder_submit();
+}
+
+ServerSynchronizer::SnapshotRecipient ServerSynchronizer::make_snapshot_recipient(int p_peer, PeerNetworkedController *p_controller) const {
+	SnapshotRecipient recipient;
+	recipient.peer = p_peer;
+	if (p_controller) {
+		recipient.input_id = p_controller->get_current_frame_index();
+		recipient.void_input = p_controller->get_server_controller()->is_current_input_void();
+	}
+	return recipient;
+}
+
+void ServerSynchronizer::send_snapshot(SnapshotEncodeJob &p_job) {
+	// Skip the peers disconnected meanwhile.
+	cached_snapshot_recipients_peers.clear();
+	for (const SnapshotRecipient &recipient : p_job.recipients) {
+		if (MapFunc::get_or_null(scene_synchronizer->peer_data, recipient.peer)) {
+			cached_snapshot_recipients_peers.push_back(recipient.peer);
+		}
+	}
+
+	if (cached_snapshot_recipients_peers.empty()) {
+		return;
+	}
+
+	scene_synchronizer->rpc_handler_state.rpc(
+			scene_synchronizer->get_network_interface(),
+			cached_snapshot_recipients_peers,
+			p_job.snapshot);
+	bandwidth_stats_add(p_job.group_id, p_job.is_full_snapshot, p_job.capture, p_job.snapshot, cached_snapshot_recipients_peers.size());
+
+	for (const SnapshotRecipient &recipient : p_job.recipients) {
+		notify_snapshot_sent(recipient);
+	}
+}
+
+void ServerSynchronizer::notify_snapshot_sent(const SnapshotRecipient &p_recipient) {
+	PeerData *peer = MapFunc::get_or_null(scene_synchronizer->peer_data, p_recipient.peer);
+	if (!peer) {
+		return;
+	}
+
+	scene_synchronizer->event_sent_snapshot.broadcast(p_recipient.input_id, p_recipient.peer);
+
+	PeerNetworkedController *controller = peer->get_controller();
+	if (controller) {
+		controller->get_server_controller()->notify_send_state(p_recipient.void_input);
+	}
+}
+
+void ServerSynchronizer::snapshot_encoder_start() {
+	if (snapshot_encoder.thread.joinable()) {
+		return;
+	}
+
+	snapshot_encoder.exit = false;
+	snapshot_encoder.working = false;
+	snapshot_encoder.thread = std::thread(&ServerSynchronizer::snapshot_encoder_thread_main, this);
+}
+
+void ServerSynchronizer::snapshot_encoder_stop(bool p_send_pending_snapshots) {
+	if (!snapshot_encoder.thread.joinable()) {
+		return;
+	}
+
+	if (p_send_pending_snapshots) {
+		snapshot_encoder_flush();
+		// The snapshots captured but not yet submitted are encoded right away.
+		for (SnapshotEncodeJob &job : snapshot_encode_jobs) {
+			encode_snapshot_capture(job.capture, job.snapshot);
+			send_snapshot(job);
+		}
+		snapshot_encode_jobs.clear();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(snapshot_encoder.mutex);
+		snapshot_encoder.exit = true;
+	}
+	snapshot_encoder.condition.notify_all();
+	snapshot_encoder.thread.join();
+
+	// The worker completes the submitted jobs before exiting, but at this
+	// point the jobs are no longer relevant: the pending ones are sent above
+	// when requested.
+	snapshot_encoder.jobs.clear();
+	snapshot_encode_jobs.clear();
+}
+
+void ServerSynchronizer::snapshot_encoder_submit() {
+	if (snapshot_encode_jobs.empty()) {
+		return;
+	}
+
+	NS_ASSERT_COND(snapshot_encoder.thread.joinable());
+
+	{
+		std::lock_guard<std::mutex> lock(snapshot_encoder.mutex);
+		// NOTE: The jobs are always flushed before capturing new ones.
+		NS_ASSERT_COND(!snapshot_encoder.working);
+		NS_ASSERT_COND(snapshot_encoder.jobs.empty());
+		std::swap(snapshot_encoder.jobs, snapshot_encode_jobs);
+		snapshot_encoder.working = true;
+	}
+	snapshot_encoder.condition.notify_all();
+}
+
+void ServerSynchronizer::snapshot_encoder_flush() {
+	if (!snapshot_encoder.thread.joinable()) {
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(snapshot_encoder.mutex);
+		snapshot_encoder.condition.wait(lock, [this]() { return !snapshot_encoder.working; });
+	}
+
+	for (SnapshotEncodeJob &job : snapshot_encoder.jobs) {
+		send_snapshot(job);
+	}
+	snapshot_encoder.jobs.clear();
+}
+
+void ServerSynchronizer::bandwidth_stats_add(
+		SyncGroupId p_group_id,
+		bool p_full_snapshot,
+		const SnapshotCapture &p_capture,
+		const DataBuffer &p_snapshot,
+		std::size_t p_recipients_count) {
+	const std::uint32_t window_index = scene_synchronizer->get_bandwidth_stats_window_index();
+	const std::uint32_t recipients_count = std::uint32_t(p_recipients_count);
+
+	if (p_group_id.id < sync_groups.size()) {
+		sync_groups[p_group_id.id].bandwidth_stats.add(p_snapshot.total_size(), p_full_snapshot, window_index, recipients_count);
+	}
+
+	for (const SnapshotCapture::Object &object : p_capture.objects) {
+		// NOTE: The object may be removed meanwhile, when the snapshot is encoded asynchronously.
+		ObjectData *od = scene_synchronizer->get_object_data(object.net_id, false);
+		if (!od) {
+			continue;
+		}
+
+		od->bandwidth_stats.add(object.encoded_bits, p_full_snapshot, window_index, recipients_count);
+
+		for (std::size_t i = object.vars_begin; i < object.vars_end; i += 1) {
+			const SnapshotCapture::Var &var = p_capture.vars[i];
+			const std::size_t var_index = i - object.vars_begin;
+			if (var.has_value && var_index < od->vars.size()) {
+				od->vars[var_index].bandwidth_stats.add(var.encoded_bits, p_full_snapshot, window_index, recipients_count);
+			}
+		}
+	}
+}
+
+void ServerSynchronizer::snapshot_encoder_thread_main() {
+	std::unique_lock<std::mutex> lock(snapshot_encoder.mutex);
+	while (true) {
+		snapshot_encoder.condition.wait(lock, [this]() { return snapshot_encoder.working || snapshot_encoder.exit; });
+
+		if (snapshot_encoder.working) {
+			// The jobs are owned by this thread until `working` is set to false,
+			// so the lock is not needed while encoding.
+			lock.unlock();
+			for (SnapshotEncodeJob &job : snapshot_encoder.jobs) {
+				encode_snapshot_capture(job.capture, job.snapshot);
+			}
+			lock.lock();
+
+			snapshot_encoder.working = false;
+			snapshot_encoder.condition.notify_all();
+		}
+
+		if (snapshot_encoder.exit) {
+			return;
+		}
+	}
 }
 
 void ServerSynchronizer::generate_snapshot(
@@ -3123,14 +3917,113 @@ void ServerSynchronizer::generate_snapshot(
 		const SyncGroup &p_group,
 		const std::vector<std::size_t> &p_partial_update_simulated_objects_info_indices,
 		DataBuffer &r_snapshot_db) const {
+	SnapshotCapture capture;
+	capture_snapshot(
+			p_force_full_snapshot,
+			p_group,
+			p_partial_update_simulated_objects_info_indices,
+			r_snapshot_db,
+			capture);
+	encode_snapshot_capture(capture, r_snapshot_db);
+}
+
+void ServerSynchronizer::capture_snapshot(
+		bool p_force_full_snapshot,
+		const SyncGroup &p_group,
+		const std::vector<std::size_t> &p_partial_update_simulated_objects_info_indices,
+		DataBuffer &r_snapshot_db,
+		SnapshotCapture &r_capture) const {
 	const std::vector<SyncGroup::SimulatedObjectInfo> &relevant_node_data = p_group.get_simulated_sync_objects();
 
-	// First insert the snapshot update mode
 	const bool is_partial_update = p_force_full_snapshot == false && p_partial_update_simulated_objects_info_indices.size() > 0;
-	r_snapshot_db.add(is_partial_update);
+	generate_snapshot_header(
+			p_force_full_snapshot,
+			is_partial_update,
+			r_capture.state_hashing,
+			p_group,
+			p_partial_update_simulated_objects_info_indices,
+			r_snapshot_db);
+
+	if (p_group.is_trickled_node_list_changed() || p_force_full_snapshot) {
+		for (int i = 0; i < int(p_group.get_trickled_sync_objects().size()); ++i) {
+			if (p_group.get_trickled_sync_objects()[i]._unknown || p_force_full_snapshot) {
+				if (p_group.get_trickled_sync_objects()[i].od) {
+					capture_snapshot_object_data(
+							*p_group.get_trickled_sync_objects()[i].od,
+							SnapshotObjectGeneratorMode::FORCE_NODE_PATH_ONLY,
+							NS::SyncGroup::Change(),
+							r_capture);
+				}
+			}
+		}
+	}
+
+	const SnapshotObjectGeneratorMode object_generator_mode = p_force_full_snapshot ? SnapshotObjectGeneratorMode::FORCE_FULL : SnapshotObjectGeneratorMode::NORMAL;
+
+	// Then, generate the snapshot for the relevant objects.
+	if (is_partial_update) {
+		// This is a partial update, insert only the specified objects.
+		for (std::size_t index : p_partial_update_simulated_objects_info_indices) {
+			if (relevant_node_data[index].od) {
+				capture_snapshot_object_data(
+						*relevant_node_data[index].od,
+						object_generator_mode,
+						relevant_node_data[index].change,
+						r_capture);
+			}
+		}
+	} else {
+		// Insert all the simulated and changed objects.
+		for (uint32_t i = 0; i < relevant_node_data.size(); i += 1) {
+			if (relevant_node_data[i].od) {
+				capture_snapshot_object_data(
+						*relevant_node_data[i].od,
+						object_generator_mode,
+						relevant_node_data[i].change,
+						r_capture);
+			}
+		}
+	}
+}
+
+void ServerSynchronizer::encode_snapshot_capture(SnapshotCapture &p_capture, DataBuffer &r_snapshot_db) const {
+	for (SnapshotCapture::Object &object : p_capture.objects) {
+		encode_snapshot_object_data(p_capture, object, r_snapshot_db);
+	}
+
+	// Mark the end.
+	r_snapshot_db.add(ObjectNetId::NONE.id);
+}
+
+void ServerSynchronizer::generate_snapshot_header(
+		bool p_force_full_snapshot,
+		bool p_is_partial_update,
+		bool p_state_hashing,
+		const SyncGroup &p_group,
+		const std::vector<std::size_t> &p_partial_update_simulated_objects_info_indices,
+		DataBuffer &r_snapshot_db) const {
+	const std::vector<SyncGroup::SimulatedObjectInfo> &relevant_node_data = p_group.get_simulated_sync_objects();
+
+	// The ObjectNetId lists are networked as sets, using the cheapest
+	// encoding: check `encode_object_net_id_set`.
+	std::vector<ObjectNetId> net_ids;
+	net_ids.reserve(relevant_node_data.size());
+
+	// First insert the snapshot update mode
+	r_snapshot_db.add(p_is_partial_update);
 
 	r_snapshot_db.add(scene_synchronizer->global_frame_index.id);
 
+	// The adaptive notify timespan, so the client can adjust to it.
+	r_snapshot_db.add(p_group.is_adaptive_notify_timespan_enabled());
+	if (p_group.is_adaptive_notify_timespan_enabled()) {
+		const float notify_timespan_ms = p_group.get_notify_timespan(scene_synchronizer->get_frame_confirmation_timespan()) * 1000.0f;
+		r_snapshot_db.add_uint(std::min(std::uint64_t(std::round(notify_timespan_ms)), std::uint64_t(std::numeric_limits<std::uint16_t>::max())), DataBuffer::COMPRESSION_LEVEL_2);
+	}
+
+	// The objects carry the `has_state_hash` flag only when state hashing.
+	r_snapshot_db.add(p_state_hashing);
+
 	for (int peer_id : p_group.get_simulating_peers()) {
 		const PeerData *pd = MapFunc::get_or_null(scene_synchronizer->peer_data, peer_id);
 		if (pd) {
@@ -3159,34 +4052,32 @@ void ServerSynchronizer::generate_snapshot(
 				// Add a `TRUE` to signal the SyncGroup changed.
 				r_snapshot_db.add(true);
 
+				net_ids.clear();
 				for (uint32_t i = 0; i < relevant_node_data.size(); i += 1) {
 					const ObjectData *od = relevant_node_data[i].od;
 					NS_ASSERT_COND(od->get_net_id() != ObjectNetId::NONE);
 					NS_ASSERT_COND(od->get_net_id().id <= std::numeric_limits<uint16_t>::max());
 					if (od->get_controlled_by_peer() == peer_id) {
-						r_snapshot_db.add(od->get_net_id().id);
+						net_ids.push_back(od->get_net_id());
 					}
 				}
 
-				// Add `uint16_max to signal its end.
-				r_snapshot_db.add(ObjectNetId::NONE.id);
+				encode_object_net_id_set(net_ids, r_snapshot_db);
 			} else {
 				// Add a `FALSE` to specify this is a PARTIAL update.
 				r_snapshot_db.add(false);
 
+				net_ids.clear();
 				for (ObjectNetId added_to_sync_group_net_id : p_group.get_simulated_sync_objects_ADDED()) {
 					NS_ASSERT_COND(added_to_sync_group_net_id != ObjectNetId::NONE);
 					NS_ASSERT_COND(added_to_sync_group_net_id.id <= std::numeric_limits<uint16_t>::max());
 					const ObjectData *od = scene_synchronizer->get_object_data(added_to_sync_group_net_id, false);
 					if (od && od->get_controlled_by_peer() == peer_id) {
-						// Add a `TRUE` to signal we have another ObjectNetId into this sync group.
-						r_snapshot_db.add(true);
-						r_snapshot_db.add(added_to_sync_group_net_id.id);
+						net_ids.push_back(added_to_sync_group_net_id);
 					}
 				}
 
-				// Add `FALSE` to signal the array end.
-				r_snapshot_db.add(false);
+				encode_object_net_id_set(net_ids, r_snapshot_db);
 			}
 		}
 	}
@@ -3199,53 +4090,48 @@ void ServerSynchronizer::generate_snapshot(
 		// Add a `TRUE` to specify this is a full update.
 		r_snapshot_db.add(true);
 
+		net_ids.clear();
 		for (uint32_t i = 0; i < relevant_node_data.size(); i += 1) {
 			const ObjectData *od = relevant_node_data[i].od;
 			NS_ASSERT_COND(od->get_net_id() != ObjectNetId::NONE);
 			NS_ASSERT_COND(od->get_net_id().id <= std::numeric_limits<uint16_t>::max());
 			if (od->get_controlled_by_peer() <= 0) {
-				r_snapshot_db.add(od->get_net_id().id);
+				net_ids.push_back(od->get_net_id());
 			}
 		}
 
-		// Add `uint16_max to signal its end.
-		r_snapshot_db.add(ObjectNetId::NONE.id);
+		encode_object_net_id_set(net_ids, r_snapshot_db);
 	} else {
 		// Add a `FALSE` to specify this is a PARTIAL update.
 		r_snapshot_db.add(false);
 
+		// First the set of the ObjectNetId added into the sync group.
+		net_ids.clear();
 		for (ObjectNetId added_to_sync_group_net_id : p_group.get_simulated_sync_objects_ADDED()) {
 			NS_ASSERT_COND(added_to_sync_group_net_id != ObjectNetId::NONE);
 			NS_ASSERT_COND(added_to_sync_group_net_id.id <= std::numeric_limits<uint16_t>::max());
 			const ObjectData *od = scene_synchronizer->get_object_data(added_to_sync_group_net_id, false);
 			if (od && od->get_controlled_by_peer() <= 0) {
-				// Add a `TRUE` to signal we have another ObjectNetId into this sync group.
-				r_snapshot_db.add(true);
-				r_snapshot_db.add(added_to_sync_group_net_id.id);
-				// Add a `TRUE` to signal this NetId was added into the sync group.
-				r_snapshot_db.add(true);
+				net_ids.push_back(added_to_sync_group_net_id);
 			}
 		}
+		encode_object_net_id_set(net_ids, r_snapshot_db);
 
+		// Then the set of the ObjectNetId removed from the sync group.
+		net_ids.clear();
 		for (ObjectNetId removed_from_sync_group_net_id : p_group.get_simulated_sync_objects_REMOVED()) {
 			NS_ASSERT_COND(removed_from_sync_group_net_id != ObjectNetId::NONE);
 			NS_ASSERT_COND(removed_from_sync_group_net_id.id <= std::numeric_limits<uint16_t>::max());
-			// Add a `TRUE` to signal we have another ObjectNetId into this sync group.
-			r_snapshot_db.add(true);
-			r_snapshot_db.add(removed_from_sync_group_net_id.id);
-			// Add a `FALSE` to signal this NetId was removed from the sync group.
-			r_snapshot_db.add(false);
+			net_ids.push_back(removed_from_sync_group_net_id);
 		}
-
-		// Add `FALSE` to signal the array end.
-		r_snapshot_db.add(false);
+		encode_object_net_id_set(net_ids, r_snapshot_db);
 	}
 
 	// Calling this function to allow to customize the snapshot per group.
 	VarData vd;
 	if (scene_synchronizer->synchronizer_manager->snapshot_get_custom_data(
 			&p_group,
-			is_partial_update,
+			p_is_partial_update,
 			p_partial_update_simulated_objects_info_indices,
 			vd)) {
 #ifdef NS_DEBUG_ENABLED
@@ -3256,57 +4142,141 @@ void ServerSynchronizer::generate_snapshot(
 	} else {
 		r_snapshot_db.add(false);
 	}
+}
 
-	if (p_group.is_trickled_node_list_changed() || p_force_full_snapshot) {
-		for (int i = 0; i < int(p_group.get_trickled_sync_objects().size()); ++i) {
-			if (p_group.get_trickled_sync_objects()[i]._unknown || p_force_full_snapshot) {
-				if (p_group.get_trickled_sync_objects()[i].od) {
-					generate_snapshot_object_data(
-							*p_group.get_trickled_sync_objects()[i].od,
-							SnapshotObjectGeneratorMode::FORCE_NODE_PATH_ONLY,
-							NS::SyncGroup::Change(),
-							r_snapshot_db);
-				}
+bool ServerSynchronizer::generate_full_snapshot_stream_chunk(
+		bool p_is_first_chunk,
+		const SyncGroup &p_group,
+		int p_peer,
+		std::vector<bool> &r_pending_objects,
+		DataBuffer &r_snapshot_db,
+		SnapshotCapture &r_capture) const {
+	const std::vector<SyncGroup::SimulatedObjectInfo> &relevant_node_data = p_group.get_simulated_sync_objects();
+	const std::vector<SyncGroup::TrickledObjectInfo> &trickled_node_data = p_group.get_trickled_sync_objects();
+
+	if (p_is_first_chunk) {
+		// All the objects into the SyncGroup are pending.
+		r_pending_objects.clear();
+		for (const SyncGroup::SimulatedObjectInfo &info : relevant_node_data) {
+			if (info.od) {
+				VecFunc::insert_at_position_expand(r_pending_objects, info.od->get_net_id().id, true, false);
+			}
+		}
+		for (const SyncGroup::TrickledObjectInfo &info : trickled_node_data) {
+			if (info.od) {
+				VecFunc::insert_at_position_expand(r_pending_objects, info.od->get_net_id().id, true, false);
 			}
 		}
 	}
 
-	const SnapshotObjectGeneratorMode object_generator_mode = p_force_full_snapshot ? SnapshotObjectGeneratorMode::FORCE_FULL : SnapshotObjectGeneratorMode::NORMAL;
+	auto is_pending = [&r_pending_objects](const ObjectData &p_od) -> bool {
+		return p_od.get_net_id().id < r_pending_objects.size() && r_pending_objects[p_od.get_net_id().id];
+	};
 
-	// Then, generate the snapshot for the relevant objects.
-	if (is_partial_update) {
-		// This is a partial update, insert only the specified objects.
-		for (std::size_t index : p_partial_update_simulated_objects_info_indices) {
-			if (relevant_node_data[index].od) {
+	// The first chunk carries the full list of simulated objects, so the client
+	// knows the SyncGroup right away. The client only simulates the objects it
+	// has received, so the pending objects are just skipped until delivered.
+	generate_snapshot_header(
+			p_is_first_chunk,
+			false,
+			r_capture.state_hashing,
+			p_group,
+			std::vector<std::size_t>(),
+			r_snapshot_db);
+
+	// The already delivered objects are updated as usual.
+	if (p_group.is_trickled_node_list_changed()) {
+		for (const SyncGroup::TrickledObjectInfo &info : trickled_node_data) {
+			if (info._unknown && info.od && !is_pending(*info.od)) {
 				generate_snapshot_object_data(
-						*relevant_node_data[index].od,
-						object_generator_mode,
-						relevant_node_data[index].change,
-						r_snapshot_db);
+						*info.od,
+						SnapshotObjectGeneratorMode::FORCE_NODE_PATH_ONLY,
+						NS::SyncGroup::Change(),
+						r_snapshot_db,
+						r_capture);
 			}
 		}
-	} else {
-		// Insert all the simulated and changed objects.
-		for (uint32_t i = 0; i < relevant_node_data.size(); i += 1) {
-			if (relevant_node_data[i].od) {
-				generate_snapshot_object_data(
-						*relevant_node_data[i].od,
-						object_generator_mode,
-						relevant_node_data[i].change,
-						r_snapshot_db);
+	}
+
+	for (const SyncGroup::SimulatedObjectInfo &info : relevant_node_data) {
+		if (info.od && !is_pending(*info.od)) {
+			generate_snapshot_object_data(
+					*info.od,
+					SnapshotObjectGeneratorMode::NORMAL,
+					info.change,
+					r_snapshot_db,
+					r_capture);
+		}
+	}
+
+	// Sort the pending objects by relevance: the objects controlled by this
+	// peer, the objects controlled by the other peers, the other simulated
+	// objects and at last the trickled ones.
+	std::vector<std::pair<const ObjectData *, SnapshotObjectGeneratorMode>> pending_objects;
+	for (int relevance = 0; relevance < 3; relevance++) {
+		for (const SyncGroup::SimulatedObjectInfo &info : relevant_node_data) {
+			if (!info.od || !is_pending(*info.od)) {
+				continue;
 			}
+			const int controlled_by_peer = info.od->get_controlled_by_peer();
+			const int object_relevance = controlled_by_peer == p_peer ? 0 : (controlled_by_peer > 0 ? 1 : 2);
+			if (object_relevance == relevance) {
+				pending_objects.push_back(std::make_pair(info.od, SnapshotObjectGeneratorMode::FORCE_FULL));
+			}
+		}
+	}
+	for (const SyncGroup::TrickledObjectInfo &info : trickled_node_data) {
+		if (info.od && is_pending(*info.od)) {
+			pending_objects.push_back(std::make_pair(info.od, SnapshotObjectGeneratorMode::FORCE_NODE_PATH_ONLY));
+		}
+	}
+
+	// Stream the pending objects until the budget is consumed, though always
+	// send at least one object per chunk to guarantee the streaming progresses.
+	const int budget_bits = scene_synchronizer->get_full_snapshot_streaming_budget_bytes() * 8;
+	const int end_mark_bits = int(sizeof(ObjectNetId::IdType)) * 8;
+	std::size_t streamed_count = 0;
+	for (const auto &[od, mode] : pending_objects) {
+		const int offset_before_object = r_snapshot_db.get_bit_offset();
+		const std::size_t captured_objects_count = r_capture.objects.size();
+		generate_snapshot_object_data(*od, mode, NS::SyncGroup::Change(), r_snapshot_db, r_capture);
+
+		if (streamed_count > 0 && (r_snapshot_db.get_bit_offset() + end_mark_bits) > budget_bits) {
+			// This object doesn't fit the budget, drop it: it's sent with the next chunk.
+			r_snapshot_db.seek(offset_before_object);
+			r_snapshot_db.shrink_to(r_snapshot_db.get_metadata_size(), offset_before_object - r_snapshot_db.get_metadata_size());
+			r_capture.objects.resize(captured_objects_count);
+			break;
 		}
+
+		r_pending_objects[od->get_net_id().id] = false;
+		streamed_count += 1;
 	}
 
 	// Mark the end.
 	r_snapshot_db.add(ObjectNetId::NONE.id);
+
+	return streamed_count == pending_objects.size();
 }
 
 void ServerSynchronizer::generate_snapshot_object_data(
 		const ObjectData &p_object_data,
 		SnapshotObjectGeneratorMode p_mode,
 		const SyncGroup::Change &p_change,
-		DataBuffer &r_snapshot_db) const {
+		DataBuffer &r_snapshot_db,
+		SnapshotCapture &r_capture) const {
+	const std::size_t objects_count = r_capture.objects.size();
+	capture_snapshot_object_data(p_object_data, p_mode, p_change, r_capture);
+	if (r_capture.objects.size() > objects_count) {
+		encode_snapshot_object_data(r_capture, r_capture.objects.back(), r_snapshot_db);
+	}
+}
+
+void ServerSynchronizer::capture_snapshot_object_data(
+		const ObjectData &p_object_data,
+		SnapshotObjectGeneratorMode p_mode,
+		const SyncGroup::Change &p_change,
+		SnapshotCapture &r_capture) const {
 	if (p_object_data.app_object_handle == ObjectHandle::NONE || p_object_data.get_object_name().empty()) {
 		return;
 	}
@@ -3327,24 +4297,19 @@ void ServerSynchronizer::generate_snapshot_object_data(
 		return;
 	}
 
-	// Insert OBJECT DATA NetId.
-	r_snapshot_db.add(p_object_data.get_net_id().id);
+	SnapshotCapture::Object &object = r_capture.objects.emplace_back();
+	object.net_id = p_object_data.get_net_id();
 
 	if (force_using_node_path || unknown) {
 		// This object is unknown.
-		r_snapshot_db.add(true); // Has the object name?
-		r_snapshot_db.add(p_object_data.get_object_name());
-	} else {
-		// This node is already known on clients, just set the node ID.
-		r_snapshot_db.add(false); // Has the object name?
+		object.has_name = true;
+		object.name = p_object_data.get_object_name();
 	}
 
 	// Insert the NetSchemeID
 	if (unknown || force_snapshot_scheme_id) {
-		r_snapshot_db.add(true); // Has the NetSchemeID?
-		r_snapshot_db.add(p_object_data.get_scheme_id().id);
-	} else {
-		r_snapshot_db.add(false); // Has the NetSchemeID?
+		object.has_scheme_id = true;
+		object.scheme_id = p_object_data.get_scheme_id();
 	}
 
 	const bool allow_vars =
@@ -3357,15 +4322,35 @@ void ServerSynchronizer::generate_snapshot_object_data(
 			(object_has_procedure_changes && !skip_snapshot_scheduled_procedures) ||
 			unknown;
 
-	// This is necessary to allow the client decode the snapshot even if it
-	// doesn't know this object.
-	const int buffer_offset_for_vars_size_bits = r_snapshot_db.get_bit_offset();
-	std::uint16_t vars_size_bits = 0;
-	r_snapshot_db.add(vars_size_bits);
-	const int buffer_offset_start_vars = r_snapshot_db.get_bit_offset();
+	// The predicted objects network the state hash in place of the changed
+	// hashed variables, the client verifies it against its own prediction.
+	// NOTE: The objects controlled by a peer are never hashed, because the
+	//       snapshot is shared with the peers simulating them as dolls.
+	if (
+			r_capture.state_hashing &&
+			p_mode == SnapshotObjectGeneratorMode::NORMAL &&
+			!unknown &&
+			p_object_data.get_controlled_by_peer() <= 0) {
+		for (VarId var_id : p_change.vars) {
+			if (var_id.id < p_object_data.vars.size() && p_object_data.vars[var_id.id].is_state_hashed()) {
+				object.has_state_hash = true;
+				break;
+			}
+		}
+
+		if (object.has_state_hash) {
+			// The hash covers all the hashed variables, not just the changed ones.
+			for (const VarDescriptor &var : p_object_data.vars) {
+				if (var.is_state_hashed()) {
+					object.state_hash = SceneSynchronizerBase::var_data_hash(var.var.value, object.state_hash);
+				}
+			}
+		}
+	}
 
 	// This is assuming the client and the server have the same vars registered
 	// with the same order.
+	object.vars_begin = r_capture.vars.size();
 	for (VarId::IdType i = 0; i < p_object_data.vars.size(); i += 1) {
 		const VarDescriptor &var = p_object_data.vars[i];
 
@@ -3381,6 +4366,11 @@ void ServerSynchronizer::generate_snapshot_object_data(
 			var_has_value = false;
 		}
 
+		if (var_has_value && object.has_state_hash && var.is_state_hashed()) {
+			// Networked through the state hash.
+			var_has_value = false;
+		}
+
 #ifdef NS_DEBUG_ENABLED
 		if (scene_synchronizer->pedantic_checks) {
 			// Make sure the value read from `var.var.value` equals to the one
@@ -3395,14 +4385,22 @@ void ServerSynchronizer::generate_snapshot_object_data(
 		}
 #endif
 
-		r_snapshot_db.add(var_has_value);
+		SnapshotCapture::Var &captured_var = r_capture.vars.emplace_back();
+		captured_var.has_value = var_has_value;
 		if (var_has_value) {
-			SceneSynchronizerBase::var_data_encode(r_snapshot_db, var.var.value, var.type);
+			captured_var.type = var.type;
+			if (r_capture.copy_values) {
+				captured_var.value.copy(var.var.value);
+			} else {
+				captured_var.value_ref = &var.var.value;
+			}
 		}
 	}
+	object.vars_end = r_capture.vars.size();
 
 	// This is assuming the client and the server have the same procedures registered
 	// with the same order.
+	object.procedures_begin = r_capture.procedures.size();
 	for (ScheduledProcedureId::IdType i = 0; i < p_object_data.get_scheduled_procedures().size(); i += 1) {
 		const ScheduledProcedureId procedure_id{ i };
 		const ObjectData::ScheduledProcedureInfo &proc_info = p_object_data.get_scheduled_procedures()[i];
@@ -3419,20 +4417,94 @@ void ServerSynchronizer::generate_snapshot_object_data(
 			procedure_has_value = false;
 		}
 
-		r_snapshot_db.add(procedure_has_value);
+		SnapshotCapture::Procedure &captured_procedure = r_capture.procedures.emplace_back();
+		captured_procedure.has_value = procedure_has_value;
 		if (procedure_has_value) {
-			r_snapshot_db.add(p_object_data.scheduled_procedure_is_inprogress(procedure_id));
+			captured_procedure.execute_frame = proc_info.execute_frame;
 			if (p_object_data.scheduled_procedure_is_inprogress(procedure_id)) {
-				// In progress
-				r_snapshot_db.add(p_object_data.get_scheduled_procedures()[procedure_id.id].execute_frame.id);
-				r_snapshot_db.add(p_object_data.get_scheduled_procedures()[procedure_id.id].args);
+				captured_procedure.status = SnapshotCapture::ProcedureStatus::IN_PROGRESS;
+				if (r_capture.copy_values) {
+					captured_procedure.args = proc_info.args;
+				} else {
+					captured_procedure.args_ref = &proc_info.args;
+				}
 			} else if (p_object_data.scheduled_procedure_is_paused(procedure_id)) {
-				// Paused
-				r_snapshot_db.add(true);
-				r_snapshot_db.add(p_object_data.get_scheduled_procedures()[procedure_id.id].execute_frame.id);
-				r_snapshot_db.add(p_object_data.get_scheduled_procedures()[procedure_id.id].paused_frame.id);
+				captured_procedure.status = SnapshotCapture::ProcedureStatus::PAUSED;
+				captured_procedure.paused_frame = proc_info.paused_frame;
 				// NOTE: No need to network the args here because as soon as we restart this the arguments are
 				//       networked again.
+			} else {
+				captured_procedure.status = SnapshotCapture::ProcedureStatus::STOPPED;
+			}
+		}
+	}
+	object.procedures_end = r_capture.procedures.size();
+}
+
+void ServerSynchronizer::encode_snapshot_object_data(
+		SnapshotCapture &p_capture,
+		SnapshotCapture::Object &p_object,
+		DataBuffer &r_snapshot_db) const {
+	const int buffer_offset_start_object = r_snapshot_db.get_bit_offset();
+
+	// Insert OBJECT DATA NetId.
+	r_snapshot_db.add(p_object.net_id.id);
+
+	if (p_object.has_name) {
+		// This object is unknown.
+		r_snapshot_db.add(true); // Has the object name?
+		r_snapshot_db.add(p_object.name);
+	} else {
+		// This node is already known on clients, just set the node ID.
+		r_snapshot_db.add(false); // Has the object name?
+	}
+
+	// Insert the NetSchemeID
+	if (p_object.has_scheme_id) {
+		r_snapshot_db.add(true); // Has the NetSchemeID?
+		r_snapshot_db.add(p_object.scheme_id.id);
+	} else {
+		r_snapshot_db.add(false); // Has the NetSchemeID?
+	}
+
+	// This is necessary to allow the client decode the snapshot even if it
+	// doesn't know this object.
+	const int buffer_offset_for_vars_size_bits = r_snapshot_db.get_bit_offset();
+	std::uint16_t vars_size_bits = 0;
+	r_snapshot_db.add(vars_size_bits);
+	const int buffer_offset_start_vars = r_snapshot_db.get_bit_offset();
+
+	if (p_capture.state_hashing) {
+		r_snapshot_db.add(p_object.has_state_hash);
+		if (p_object.has_state_hash) {
+			r_snapshot_db.add(p_object.state_hash);
+		}
+	}
+
+	for (std::size_t i = p_object.vars_begin; i < p_object.vars_end; i += 1) {
+		SnapshotCapture::Var &var = p_capture.vars[i];
+		r_snapshot_db.add(var.has_value);
+		if (var.has_value) {
+			const int buffer_offset_start_var = r_snapshot_db.get_bit_offset();
+			SceneSynchronizerBase::var_data_encode(r_snapshot_db, var.get_value(), var.type);
+			var.encoded_bits = r_snapshot_db.get_bit_offset() - buffer_offset_start_var;
+		}
+	}
+
+	for (std::size_t i = p_object.procedures_begin; i < p_object.procedures_end; i += 1) {
+		const SnapshotCapture::Procedure &procedure = p_capture.procedures[i];
+		r_snapshot_db.add(procedure.has_value);
+		if (procedure.has_value) {
+			r_snapshot_db.add(procedure.status == SnapshotCapture::ProcedureStatus::IN_PROGRESS);
+			if (procedure.status == SnapshotCapture::ProcedureStatus::IN_PROGRESS) {
+				// In progress
+				r_snapshot_db.add(procedure.execute_frame.id);
+				r_snapshot_db.add(procedure.get_args());
+			} else if (procedure.status == SnapshotCapture::ProcedureStatus::PAUSED) {
+				// Paused
+				r_snapshot_db.add(true);
+				r_snapshot_db.add(procedure.execute_frame.id);
+				r_snapshot_db.add(procedure.paused_frame.id);
 			} else {
 				// Stopped
 				r_snapshot_db.add(false);
@@ -3448,6 +4520,8 @@ void ServerSynchronizer::generate_snapshot_object_data(
 	r_snapshot_db.seek(buffer_offset_for_vars_size_bits);
 	r_snapshot_db.add(vars_size_bits);
 	r_snapshot_db.seek(buffer_offset_end_vars);
+
+	p_object.encoded_bits = buffer_offset_end_vars - buffer_offset_start_object;
 }
 
 void ServerSynchronizer::process_trickled_sync(float p_delta) {
@@ -3581,6 +4655,98 @@ void ServerSynchronizer::update_peers_net_statistics(float p_delta) {
 	}
 }
 
+void ServerSynchronizer::process_dolls_inputs_forwarding() {
+	NS_PROFILE
+
+	const int server_peer = scene_synchronizer->get_network_interface().get_server_peer();
+
+	// 1. Append the new inputs of each controller to the packet of each peer
+	//    simulating it.
+	for (auto &[peer, peer_data] : scene_synchronizer->peer_data) {
+		PeerNetworkedController *controller = peer_data.get_controller();
+		if make_unlikely(!controller || !controller->is_server_controller()) {
+			continue;
+		}
+
+		ServerController *server_controller = controller->get_server_controller_unchecked();
+		if (!server_controller->has_inputs_to_forward()) {
+			continue;
+		}
+
+		// The forwarding is unreliable, so each peer receives the new inputs
+		// together with the previous ones, as many as the redundant inputs
+		// its connection requires.
+		cached_dolls_inputs_recipients.clear();
+		for (int recipient : server_controller->peers_simulating_this_controller) {
+			if (recipient == peer || recipient == server_peer) {
+				continue;
+			}
+			auto peer_server_data_it = peers_data.find(recipient);
+			if make_unlikely(peer_server_data_it == peers_data.end()) {
+				continue;
+			}
+			auto recipient_peer_data_it = scene_synchronizer->peer_data.find(recipient);
+			const PeerNetworkedController *recipient_controller = recipient_peer_data_it != scene_synchronizer->peer_data.end() ? recipient_peer_data_it->second.get_controller() : nullptr;
+			const int redundant_inputs = recipient_controller ? recipient_controller->get_redundant_inputs() : scene_synchronizer->get_max_redundant_inputs();
+			cached_dolls_inputs_recipients.push_back(std::make_pair(
+					server_controller->get_first_input_to_forward(redundant_inputs),
+					&peer_server_data_it->second.dolls_inputs_packet));
+		}
+
+		// The inputs are encoded once for all the peers receiving the same inputs.
+		std::sort(
+				cached_dolls_inputs_recipients.begin(),
+				cached_dolls_inputs_recipients.end(),
+				[](const std::pair<FrameIndex, std::vector<std::uint8_t> *> &p_a, const std::pair<FrameIndex, std::vector<std::uint8_t> *> &p_b) {
+					return p_a.first < p_b.first;
+				});
+
+		std::size_t recipients_begin = 0;
+		while (recipients_begin < cached_dolls_inputs_recipients.size()) {
+			const FrameIndex first_input_id = cached_dolls_inputs_recipients[recipients_begin].first;
+			std::size_t recipients_end = recipients_begin + 1;
+			while (recipients_end < cached_dolls_inputs_recipients.size() && cached_dolls_inputs_recipients[recipients_end].first == first_input_id) {
+				recipients_end += 1;
+			}
+
+			FrameIndex input_id = first_input_id;
+			while (const std::vector<std::uint8_t> *inputs = server_controller->encode_next_inputs_to_forward(input_id)) {
+				NS_ENSURE_CONTINUE_MSG(inputs->size() <= std::numeric_limits<std::uint16_t>::max(), "The inputs of the peer " + std::to_string(peer) + " are too big to be forwarded.");
+
+				for (std::size_t r = recipients_begin; r < recipients_end; r++) {
+					std::vector<std::uint8_t> &packet = *cached_dolls_inputs_recipients[r].second;
+					packet.push_back(std::uint8_t(std::uint32_t(peer) & 0xFF));
+					packet.push_back(std::uint8_t((std::uint32_t(peer) >> 8) & 0xFF));
+					packet.push_back(std::uint8_t((std::uint32_t(peer) >> 16) & 0xFF));
+					packet.push_back(std::uint8_t((std::uint32_t(peer) >> 24) & 0xFF));
+					packet.push_back(std::uint8_t(inputs->size() & 0xFF));
+					packet.push_back(std::uint8_t((inputs->size() >> 8) & 0xFF));
+					packet.insert(packet.end(), inputs->begin(), inputs->end());
+				}
+			}
+
+			recipients_begin = recipients_end;
+		}
+
+		server_controller->notify_inputs_forwarded();
+	}
+
+	// 2. Send a single packet to each peer.
+	for (auto &[peer, peer_server_data] : peers_data) {
+		if (peer_server_data.dolls_inputs_packet.empty()) {
+			continue;
+		}
+
+		scene_synchronizer->rpc_handle_receive_dolls_inputs.rpc(
+				scene_synchronizer->get_network_interface(),
+				peer,
+				peer_server_data.dolls_inputs_packet);
+
+		// Clear it, keeping the memory for the next tick.
+		peer_server_data.dolls_inputs_packet.clear();
+	}
+}
+
 void ServerSynchronizer::send_net_stat_to_peer(int p_peer, PeerData &p_peer_data) {
 	PeerNetworkedController &controller = *p_peer_data.get_controller();
 	if (controller.get_server_controller_unchecked()->streaming_paused) {
@@ -3605,6 +4771,13 @@ void ServerSynchronizer::send_net_stat_to_peer(int p_peer, PeerData &p_peer_data
 			std::clamp(int(controller.get_server_controller_unchecked()->get_inputs_count()), int(0), int(std::numeric_limits<std::uint8_t>::max()));
 	db.add(compressed_input_count);
 
+	// Redundant inputs - from 1 to 255
+	const std::uint8_t redundant_inputs =
+			std::clamp(controller.get_server_controller_unchecked()->fetch_optimal_redundant_inputs(p_peer_data.get_out_packet_loss_percentage()), int(1), int(std::numeric_limits<std::uint8_t>::max()));
+	db.add(redundant_inputs);
+	// The same redundancy is used to forward the dolls inputs to this peer.
+	controller.set_redundant_inputs(redundant_inputs);
+
 	scene_synchronizer->rpc_handle_notify_netstats.rpc(
 			scene_synchronizer->get_network_interface(),
 			p_peer,
@@ -3618,7 +4791,12 @@ ClientSynchronizer::ClientSynchronizer(SceneSynchronizerBase *p_node) :
 	notify_server_full_snapshot_is_needed();
 }
 
+ClientSynchronizer::~ClientSynchronizer() {
+	snapshot_decoder_stop(false);
+}
+
 void ClientSynchronizer::clear() {
+	snapshot_decoder_stop(false);
 	player_controller = nullptr;
 	objects_names.clear();
 	objects_schemes_id.clear();
@@ -3628,8 +4806,14 @@ void ClientSynchronizer::clear() {
 	last_received_server_snapshot_index = FrameIndex::NONE;
 	last_received_server_snapshot.reset();
 	last_checked_input = FrameIndex::NONE;
+	rewind_pending = false;
+	rewind_pending_frames_count = 0;
+	has_rewind_visible_snapshot = false;
+	rewind_visible_snapshot_applied = false;
 	enabled = true;
 	need_full_snapshot_notified = false;
+	prediction_memory_max_frames = std::numeric_limits<std::size_t>::max();
+	prediction_memory_paused = false;
 }
 
 bool ClientSynchronizer::can_execute_scene_process() const {
@@ -3651,6 +4835,11 @@ bool ClientSynchronizer::can_execute_scene_process() const {
 	// introduce virtual lag.
 	player_controller->get_player_controller()->notify_frame_checked(scene_synchronizer->client_get_last_checked_frame_index());
 	const bool accept_new_inputs = player_controller->get_player_controller()->can_accept_new_inputs();
+	if make_unlikely(accept_new_inputs && client_snapshots.size() >= prediction_memory_max_frames) {
+		// The predicted frames don't fit the memory budget: wait the server
+		// to validate the stored ones. Check `process_prediction_memory_budget()`.
+		return false;
+	}
 	if (accept_new_inputs) {
 		return true;
 	} else {
@@ -3663,6 +4852,14 @@ bool ClientSynchronizer::can_execute_scene_process() const {
 void ClientSynchronizer::process(float p_delta) {
 	NS_PROFILE
 
+	if (scene_synchronizer->is_snapshot_decoding_async()) {
+		// Process the snapshots decoded since the last process, if ready.
+		snapshot_decoder_consume();
+		snapshot_decoder_start();
+	} else {
+		snapshot_decoder_stop(true);
+	}
+
 	try_fetch_pending_snapshot_objects();
 
 	scene_synchronizer->get_debugger().print(VERBOSE, "ClientSynchronizer::process", scene_synchronizer->get_network_interface().get_owner_name());
@@ -3673,9 +4870,13 @@ void ClientSynchronizer::process(float p_delta) {
 	}
 #endif
 
+	last_interpolation_skipped_processes_count = 0;
+
 	process_server_sync();
+	process_prediction_memory_budget();
 	process_simulation(p_delta);
 	process_trickled_sync(p_delta);
+	process_interpolation(p_delta);
 
 #if NS_DEBUG_ENABLED
 	if (player_controller && player_controller->can_simulate()) {
@@ -3687,6 +4888,22 @@ void ClientSynchronizer::process(float p_delta) {
 }
 
 void ClientSynchronizer::receive_snapshot(DataBuffer &p_snapshot) {
+	if (snapshot_decoder.thread.joinable()) {
+		// The snapshot is decoded by the worker thread and processed on the
+		// next process.
+		if (snapshot_decode_jobs.size() <= snapshot_decode_jobs_count) {
+			snapshot_decode_jobs.emplace_back();
+		}
+		snapshot_decode_jobs[snapshot_decode_jobs_count].snapshot.copy(p_snapshot);
+		snapshot_decode_jobs_count += 1;
+		snapshot_decoder_submit();
+		return;
+	}
+
+	process_received_snapshot(p_snapshot, nullptr);
+}
+
+void ClientSynchronizer::process_received_snapshot(DataBuffer &p_snapshot, SnapshotDecodeJob *p_decoded_snapshot) {
 	// The received snapshot is parsed and stored into the `last_received_snapshot`
 	// that contains always the last received snapshot.
 	// Later, the snapshot is stored into the server queue.
@@ -3695,27 +4912,286 @@ void ClientSynchronizer::receive_snapshot(DataBuffer &p_snapshot) {
 	// incremental update so the last received data is always needed to fully
 	// reconstruct it.
 
-	scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server snapshot.", scene_synchronizer->get_network_interface().get_owner_name());
+	if (scene_synchronizer->get_debugger().is_printing(VERBOSE)) {
+		scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server snapshot.", scene_synchronizer->get_network_interface().get_owner_name());
+	}
 
 	// Parse server snapshot.
-	const bool success = parse_snapshot(p_snapshot, true);
+	const bool success = parse_snapshot(p_snapshot, true, p_decoded_snapshot);
 
 	if (success == false) {
 		return;
 	}
 
+	store_interpolation_samples();
+
+	if (!verify_state_hashes(last_received_snapshot)) {
+		// The mismatched objects values were requested, meanwhile this
+		// snapshot can't be used to check the sync.
+		return;
+	}
+
 	// Finalize data.
 	store_controllers_snapshot(last_received_snapshot);
 }
 
+void ClientSynchronizer::snapshot_decoder_start() {
+	if (snapshot_decoder.thread.joinable()) {
+		return;
+	}
+
+	snapshot_decoder.exit = false;
+	snapshot_decoder.working = false;
+	snapshot_decoder.jobs_count = 0;
+	// The objects may have changed while the worker was stopped.
+	snapshot_decoder_schemes_dirty = true;
+	snapshot_decoder.thread = std::thread(&ClientSynchronizer::snapshot_decoder_thread_main, this);
+}
+
+void ClientSynchronizer::snapshot_decoder_stop(bool p_process_pending_snapshots) {
+	if (!snapshot_decoder.thread.joinable()) {
+		return;
+	}
+
+	if (p_process_pending_snapshots) {
+		snapshot_decoder_flush();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(snapshot_decoder.mutex);
+		snapshot_decoder.exit = true;
+	}
+	snapshot_decoder.condition.notify_all();
+	snapshot_decoder.thread.join();
+
+	// The worker completes the submitted jobs before exiting, but at this
+	// point the jobs are no longer relevant: the pending ones are processed
+	// above when requested.
+	snapshot_decoder.jobs_count = 0;
+	snapshot_decode_jobs_count = 0;
+}
+
+void ClientSynchronizer::snapshot_decoder_update_schemes() {
+	snapshot_decoder.custom_data_type = scene_synchronizer->get_synchronizer_manager().snapshot_get_custom_data_type();
+
+	if (!snapshot_decoder_schemes_dirty) {
+		return;
+	}
+	snapshot_decoder_schemes_dirty = false;
+	snapshot_decoder.schemes_version += 1;
+
+	// The worker decodes only the vars of the objects without scheduled
+	// procedures, the others are parsed by the main thread.
+	const std::vector<ObjectData *> &sorted_objects_data = scene_synchronizer->objects_data_storage.get_sorted_objects_data();
+	if (snapshot_decoder.schemes.size() < sorted_objects_data.size()) {
+		snapshot_decoder.schemes.resize(sorted_objects_data.size());
+	}
+	for (std::size_t i = 0; i < snapshot_decoder.schemes.size(); i++) {
+		SnapshotDecoderObjectScheme &scheme = snapshot_decoder.schemes[i];
+		const ObjectData *od = i < sorted_objects_data.size() ? sorted_objects_data[i] : nullptr;
+		if (od == nullptr || !od->get_scheduled_procedures().empty()) {
+			scheme.local_id = ObjectLocalId::NONE;
+			continue;
+		}
+
+		scheme.local_id = od->get_local_id();
+		scheme.scheme_id = od->get_scheme_id();
+		scheme.object_name = od->get_object_name();
+		scheme.vars_type.resize(od->vars.size());
+		for (std::size_t v = 0; v < od->vars.size(); v++) {
+			scheme.vars_type[v] = od->vars[v].type;
+		}
+	}
+}
+
+void ClientSynchronizer::snapshot_decoder_submit() {
+	if (snapshot_decode_jobs_count == 0) {
+		return;
+	}
+
+	NS_ASSERT_COND(snapshot_decoder.thread.joinable());
+
+	{
+		std::lock_guard<std::mutex> lock(snapshot_decoder.mutex);
+		if (snapshot_decoder.working || snapshot_decoder.jobs_count > 0) {
+			// The worker jobs are not processed yet, the received snapshots
+			// are submitted by the flush.
+			return;
+		}
+	}
+
+	// The worker is idle, so the schemes can be updated.
+	snapshot_decoder_update_schemes();
+
+	{
+		std::lock_guard<std::mutex> lock(snapshot_decoder.mutex);
+		// Swaps the jobs, so both keep their memory.
+		std::swap(snapshot_decoder.jobs, snapshot_decode_jobs);
+		std::swap(snapshot_decoder.jobs_count, snapshot_decode_jobs_count);
+		snapshot_decoder.working = true;
+	}
+	snapshot_decoder.condition.notify_all();
+}
+
+void ClientSynchronizer::snapshot_decoder_wait() {
+	if (!snapshot_decoder.thread.joinable()) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(snapshot_decoder.mutex);
+	snapshot_decoder.condition.wait(lock, [this]() { return !snapshot_decoder.working; });
+}
+
+void ClientSynchronizer::snapshot_decoder_consume() {
+	if (!snapshot_decoder.thread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(snapshot_decoder.mutex);
+		if (snapshot_decoder.working) {
+			// Still decoding, the snapshots are processed by the next call.
+			return;
+		}
+	}
+
+	for (std::size_t i = 0; i < snapshot_decoder.jobs_count; i++) {
+		SnapshotDecodeJob &job = snapshot_decoder.jobs[i];
+		process_received_snapshot(job.snapshot, &job);
+	}
+	snapshot_decoder.jobs_count = 0;
+
+	// Submit the snapshots received meanwhile.
+	snapshot_decoder_submit();
+}
+
+void ClientSynchronizer::snapshot_decoder_flush() {
+	if (!snapshot_decoder.thread.joinable()) {
+		return;
+	}
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(snapshot_decoder.mutex);
+			snapshot_decoder.condition.wait(lock, [this]() { return !snapshot_decoder.working; });
+		}
+
+		// The snapshots are processed in the receive order: the worker jobs
+		// were received before the ones still to submit.
+		for (std::size_t i = 0; i < snapshot_decoder.jobs_count; i++) {
+			SnapshotDecodeJob &job = snapshot_decoder.jobs[i];
+			process_received_snapshot(job.snapshot, &job);
+		}
+		snapshot_decoder.jobs_count = 0;
+
+		if (snapshot_decode_jobs_count == 0) {
+			break;
+		}
+		snapshot_decoder_submit();
+	}
+}
+
+void ClientSynchronizer::snapshot_decoder_thread_main() {
+	std::unique_lock<std::mutex> lock(snapshot_decoder.mutex);
+	while (true) {
+		snapshot_decoder.condition.wait(lock, [this]() { return snapshot_decoder.working || snapshot_decoder.exit; });
+
+		if (snapshot_decoder.working) {
+			// The jobs are owned by this thread until `working` is set to false,
+			// so the lock is not needed while decoding.
+			lock.unlock();
+			for (std::size_t i = 0; i < snapshot_decoder.jobs_count; i++) {
+				decode_snapshot(snapshot_decoder.jobs[i]);
+			}
+			lock.lock();
+
+			snapshot_decoder.working = false;
+			snapshot_decoder.condition.notify_all();
+		}
+
+		if (snapshot_decoder.exit) {
+			return;
+		}
+	}
+}
+
+void ClientSynchronizer::decode_snapshot(SnapshotDecodeJob &r_job) const {
+	NS_PROFILE
+
+	r_job.is_header_decoded = false;
+	r_job.is_objects_decoded = false;
+	r_job.objects_count = 0;
+	r_job.schemes_version = snapshot_decoder.schemes_version;
+
+	DataBuffer &snapshot = r_job.snapshot;
+	snapshot.begin_read(get_debugger());
+	if (snapshot.size() <= 0) {
+		// Nothing to do.
+		r_job.is_header_decoded = true;
+		r_job.is_objects_decoded = true;
+		return;
+	}
+
+	if (!decode_sync_data_header(snapshot, snapshot_decoder.custom_data_type, r_job.header)) {
+		return;
+	}
+	r_job.is_header_decoded = true;
+
+	while (true) {
+		// The decoded objects are reused.
+		if (r_job.objects.size() <= r_job.objects_count) {
+			r_job.objects.resize(r_job.objects_count + 1);
+		}
+		DecodedSyncDataObject &object = r_job.objects[r_job.objects_count];
+		if (!decode_sync_data_object_header(snapshot, object.header)) {
+			return;
+		}
+
+		if (object.header.net_id == ObjectNetId::NONE) {
+			// All the Objects fetched.
+			break;
+		}
+		r_job.objects_count += 1;
+
+		// The vars are decoded only when the object is known and it's not
+		// going to change by this snapshot. The name resolution and the
+		// registration are done by the main thread.
+		object.decoded_for = ObjectLocalId::NONE;
+		const int offset_after_vars_reading = object.header.vars_bit_offset + object.header.vars_size_in_bits;
+		const SnapshotDecoderObjectScheme *scheme = object.header.net_id.id < snapshot_decoder.schemes.size() ? &snapshot_decoder.schemes[object.header.net_id.id] : nullptr;
+		if (
+				scheme &&
+				scheme->local_id != ObjectLocalId::NONE &&
+				(!object.header.has_object_name || object.header.object_name == scheme->object_name) &&
+				(!object.header.has_scheme_id || object.header.scheme_id == scheme->scheme_id)) {
+			if (decode_sync_data_object_vars(snapshot, r_job.header.state_hashing, *scheme, object) && snapshot.get_bit_offset() == offset_after_vars_reading) {
+				object.decoded_for = scheme->local_id;
+			}
+		}
+
+		snapshot.seek(offset_after_vars_reading);
+	}
+
+	r_job.is_objects_decoded = true;
+}
+
 void ClientSynchronizer::on_object_data_added(ObjectData &p_object_data) {
+	snapshot_decoder_schemes_dirty = true;
 	finalize_object_data_synchronization(p_object_data);
 }
 
 void ClientSynchronizer::on_object_data_removed(NS::ObjectData &p_object_data) {
+	snapshot_decoder_schemes_dirty = true;
 	VecFunc::remove_unordered(simulated_objects, p_object_data.get_net_id());
 	VecFunc::remove_unordered(active_objects, &p_object_data);
 
+	for (std::size_t i = 0; i < interpolated_objects.size(); i++) {
+		if (interpolated_objects[i].local_id == p_object_data.get_local_id()) {
+			interpolated_objects.erase(interpolated_objects.begin() + i);
+			break;
+		}
+	}
+
 	if (p_object_data.get_net_id().id < uint32_t(last_received_snapshot.objects.size())) {
 		last_received_snapshot.objects[p_object_data.get_net_id().id].vars.clear();
 		last_received_snapshot.objects[p_object_data.get_net_id().id].procedures.clear();
@@ -3725,9 +5201,14 @@ void ClientSynchronizer::on_object_data_removed(NS::ObjectData &p_object_data) {
 }
 
 void ClientSynchronizer::on_object_data_name_known(ObjectData &p_object_data) {
+	snapshot_decoder_schemes_dirty = true;
 	finalize_object_data_synchronization(p_object_data);
 }
 
+void ClientSynchronizer::on_variable_added(ObjectData *p_object_data, const std::string &p_var_name) {
+	snapshot_decoder_schemes_dirty = true;
+}
+
 void ClientSynchronizer::on_variable_changed(NS::ObjectData *p_object_data, VarId p_var_id, const VarData &p_old_value, int p_flag) {
 	if (p_flag & NetEventFlag::SYNC) {
 		const EndSyncEvent ese(
@@ -3793,12 +5274,16 @@ void ClientSynchronizer::try_fetch_pending_snapshot_objects() {
 	NS_PROFILE
 
 	std::vector<ObjectNetId> pending_objects;
-	for (const auto &[net_id, snapshots] : objects_pending_snapshots) {
-		pending_objects.push_back(net_id);
-		if (snapshots.size() > 60) {
+	for (const ObjectPendingSnapshots &pending : objects_pending_snapshots) {
+		if (pending.net_id == ObjectNetId::NONE || pending.count <= 0) {
+			// This entry is free.
+			continue;
+		}
+		pending_objects.push_back(pending.net_id);
+		if (pending.count > 60) {
 			// We have more than 60 snapshots for this objects and still it doesn't exist yet.
 			// this is a bug.
-			get_debugger().print(ERROR, "The object with NetId `" + std::to_string(net_id.id) + "` have more than " + std::to_string(snapshots.size()) + " and still it's not yet registered on the client. This is likely a bug that you should investigate or report. Requesting a full snapshot to try recovering it, but still this is likely a bug that you have to fix anyway.");
+			get_debugger().print(ERROR, "The object with NetId `" + std::to_string(pending.net_id.id) + "` have more than " + std::to_string(pending.count) + " and still it's not yet registered on the client. This is likely a bug that you should investigate or report. Requesting a full snapshot to try recovering it, but still this is likely a bug that you have to fix anyway.");
 			notify_server_full_snapshot_is_needed();
 			return;
 		}
@@ -3818,44 +5303,249 @@ void ClientSynchronizer::try_fetch_pending_snapshot_objects() {
 				ObjectData *od = scene_synchronizer->get_object_data(reg_obj_id);
 				od->set_net_id(pending_registration_net_id);
 				finalize_object_data_synchronization(*od);
-				NS_ASSERT_COND(MapFunc::get_or_null(objects_pending_snapshots, pending_registration_net_id)==nullptr);
+				NS_ASSERT_COND(get_object_pending_snapshots(pending_registration_net_id) == nullptr);
 			}
 		}
 	}
 }
 
-void ClientSynchronizer::store_snapshot() {
-	NS_PROFILE
+ClientSynchronizer::ObjectPendingSnapshots *ClientSynchronizer::get_object_pending_snapshots(ObjectNetId p_net_id) {
+	for (ObjectPendingSnapshots &pending : objects_pending_snapshots) {
+		if (pending.net_id == p_net_id) {
+			return &pending;
+		}
+	}
+	return nullptr;
+}
 
-#ifdef NS_DEBUG_ENABLED
-	if make_unlikely(client_snapshots.size() > 0 && player_controller->get_current_frame_index() <= client_snapshots.back().input_id && client_snapshots.back().input_id != FrameIndex::NONE) {
-		NS_ASSERT_NO_ENTRY_MSG("During snapshot creation, for controller " + std::to_string(player_controller->get_authority_peer()) + ", was found an ID for an older snapshots. New input ID: " + std::string(player_controller->get_current_frame_index()) + " Last saved snapshot input ID: " + std::string(client_snapshots.back().input_id) + ".");
+ClientSynchronizer::ObjectPendingSnapshots &ClientSynchronizer::fetch_object_pending_snapshots(ObjectNetId p_net_id) {
+	ObjectPendingSnapshots *pending = get_object_pending_snapshots(p_net_id);
+	if (pending) {
+		return *pending;
 	}
-#endif
 
-	client_snapshots.push_back(Snapshot());
+	// Reuse a released entry, so its buffers are reused too.
+	pending = get_object_pending_snapshots(ObjectNetId::NONE);
+	if (!pending) {
+		pending = &objects_pending_snapshots.emplace_back();
+	}
+	pending->net_id = p_net_id;
+	pending->count = 0;
+	return *pending;
+}
 
-	Snapshot &snap = client_snapshots.back();
-	snap.input_id = player_controller->get_current_frame_index();
+void ClientSynchronizer::release_object_pending_snapshots(ObjectPendingSnapshots &p_pending) {
+	p_pending.net_id = ObjectNetId::NONE;
+	p_pending.count = 0;
+}
 
-	update_client_snapshot(snap);
+Snapshot &ClientSynchronizer::emplace_last_received_server_snapshot() {
+	if (!last_received_server_snapshot.has_value()) {
+		last_received_server_snapshot.emplace(std::move(recycled_server_snapshot));
+	}
+	return last_received_server_snapshot.value();
 }
 
-void ClientSynchronizer::store_controllers_snapshot(
-		const RollingUpdateSnapshot &p_snapshot) {
-	// Put the parsed snapshot into the queue.
+void ClientSynchronizer::release_last_received_server_snapshot() {
+	if (last_received_server_snapshot.has_value()) {
+		recycled_server_snapshot = std::move(last_received_server_snapshot.value());
+		last_received_server_snapshot.reset();
+	}
+}
 
-	if make_unlikely(!scene_synchronizer->synchronizer_manager->can_client_store_server_snapshot(p_snapshot)) {
-		// Do not store this snapshot.
+void ClientSynchronizer::store_interpolation_samples() {
+	NS_PROFILE
+
+	const GlobalFrameIndex snapshot_frame = last_received_snapshot.global_frame_index;
+	if (interpolation_last_snapshot_frame != GlobalFrameIndex::NONE && snapshot_frame <= interpolation_last_snapshot_frame) {
+		// This snapshot is older than the stored ones.
 		return;
 	}
 
-	if (p_snapshot.input_id == FrameIndex::NONE) {
-		scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server snapshot WITHOUT `input_id`.", scene_synchronizer->get_network_interface().get_owner_name());
-		// The controller node is not registered so just assume this snapshot is the most up-to-date.
-		last_received_server_snapshot.emplace(Snapshot::make_copy(p_snapshot));
-		last_received_server_snapshot_index = p_snapshot.input_id;
-	} else {
+	for (ObjectNetId net_id : last_received_snapshot.just_updated_object_vars) {
+		ObjectData *od = scene_synchronizer->get_object_data(net_id, false);
+		if (od == nullptr || !od->is_client_interpolated() || net_id.id >= last_received_snapshot.objects.size()) {
+			continue;
+		}
+
+		InterpolatedObject *interpolated_object = nullptr;
+		for (InterpolatedObject &io : interpolated_objects) {
+			if (io.local_id == od->get_local_id()) {
+				interpolated_object = &io;
+				break;
+			}
+		}
+		if (interpolated_object == nullptr) {
+			interpolated_object = &interpolated_objects.emplace_back();
+			interpolated_object->local_id = od->get_local_id();
+		}
+
+		RingBuffer<InterpolationSample> &samples = interpolated_object->samples;
+		if (!samples.empty() && samples.back().frame_index < interpolation_last_snapshot_frame) {
+			// The server sends only the changed objects, so this object didn't
+			// change until the previous snapshot: hold the value until then,
+			// rather than interpolating across the whole gap.
+			InterpolationSample &hold_sample = samples.push_back();
+			hold_sample.frame_index = interpolation_last_snapshot_frame;
+			hold_sample.object.copy(samples[samples.size() - 2].object);
+		}
+
+		InterpolationSample &sample = samples.push_back();
+		sample.frame_index = snapshot_frame;
+		sample.object.copy(last_received_snapshot.objects[net_id.id]);
+
+		// The samples are consumed by `process_interpolation`, this limits
+		// the storage when the client doesn't process.
+		while (samples.size() > 32) {
+			samples.pop_front();
+		}
+	}
+
+	interpolation_last_snapshot_frame = snapshot_frame;
+}
+
+void ClientSynchronizer::process_interpolation(float p_delta) {
+	NS_PROFILE
+
+	last_interpolated_objects_count = 0;
+	last_interpolation_usec = 0;
+
+	if (interpolated_objects.empty() || interpolation_last_snapshot_frame == GlobalFrameIndex::NONE) {
+		return;
+	}
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Advances the interpolation frame, keeping it `interpolation_delay`
+	// behind the last received snapshot.
+	const double frames_per_second = double(scene_synchronizer->get_frames_per_seconds());
+	const double delay_frames = double(scene_synchronizer->get_interpolation_delay()) * frames_per_second;
+	const double max_extrapolation_frames = double(scene_synchronizer->get_max_extrapolation()) * frames_per_second;
+	const double last_snapshot_frame = double(interpolation_last_snapshot_frame.id);
+	if (interpolation_frame < 0.0 || interpolation_frame + double(p_delta) * frames_per_second < last_snapshot_frame - (delay_frames * 2.0)) {
+		// Not started yet or too far behind: this happens on the first
+		// snapshot or after a stall.
+		interpolation_frame = last_snapshot_frame - delay_frames;
+	} else {
+		interpolation_frame += double(p_delta) * frames_per_second;
+	}
+	// The extrapolation is capped, when the snapshots are late.
+	interpolation_frame = std::min(interpolation_frame, last_snapshot_frame + max_extrapolation_frames);
+
+	scene_synchronizer->change_events_begin(NetEventFlag::SERVER_UPDATE);
+
+	for (std::size_t i = 0; i < interpolated_objects.size(); i++) {
+		InterpolatedObject &interpolated_object = interpolated_objects[i];
+		ObjectData *od = scene_synchronizer->get_object_data(interpolated_object.local_id, false);
+		if (od == nullptr || !od->is_client_interpolated()) {
+			// This object is no longer interpolated.
+			interpolated_objects.erase(interpolated_objects.begin() + i);
+			i--;
+			continue;
+		}
+
+		RingBuffer<InterpolationSample> &samples = interpolated_object.samples;
+		if (samples.empty()) {
+			continue;
+		}
+
+		// Drops the samples already rendered, keeping two to extrapolate.
+		while (samples.size() > 2 && double(samples[1].frame_index.id) <= interpolation_frame) {
+			samples.pop_front();
+		}
+
+		// Interpolates toward the first sample after the interpolation frame,
+		// so the path through the samples in between is followed. It's
+		// extrapolated only when no sample after that is left.
+		const InterpolationSample &from = samples.front();
+		const InterpolationSample &to = samples.size() > 1 ? samples[1] : samples.front();
+		float alpha = 0.0f;
+		if (to.frame_index > from.frame_index) {
+			alpha = float((interpolation_frame - double(from.frame_index.id)) / double(to.frame_index.id - from.frame_index.id));
+			alpha = std::max(alpha, 0.0f);
+			if (to.frame_index != interpolation_last_snapshot_frame) {
+				// The object didn't change with the last snapshot, so it's
+				// not extrapolated.
+				alpha = std::min(alpha, 1.0f);
+			}
+		}
+
+		const std::size_t vars_count = std::max(from.object.vars.size(), to.object.vars.size());
+		interpolation_object_snapshot.vars.resize(vars_count);
+		for (std::size_t v = 0; v < vars_count; v++) {
+			const std::optional<VarData> *from_var = v < from.object.vars.size() && from.object.vars[v].has_value() ? &from.object.vars[v] : nullptr;
+			const std::optional<VarData> *to_var = v < to.object.vars.size() && to.object.vars[v].has_value() ? &to.object.vars[v] : nullptr;
+			std::optional<VarData> &result = interpolation_object_snapshot.vars[v];
+			if (from_var && to_var) {
+				result.emplace();
+				if (!SceneSynchronizerBase::var_data_interpolate(result.value(), from_var->value(), to_var->value(), alpha)) {
+					// This value can't be interpolated, so it's snapped.
+					result->copy(alpha >= 1.0f ? to_var->value() : from_var->value());
+				}
+			} else if (to_var || from_var) {
+				result.emplace(VarData::make_copy(to_var ? to_var->value() : from_var->value()));
+			} else {
+				result.reset();
+			}
+		}
+
+		apply_snapshot_object_vars(*od, interpolation_object_snapshot, nullptr);
+		last_interpolated_objects_count += 1;
+	}
+
+	scene_synchronizer->change_events_flush();
+
+	last_interpolation_usec = std::uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void ClientSynchronizer::store_snapshot() {
+	NS_PROFILE
+
+#ifdef NS_DEBUG_ENABLED
+	if make_unlikely(client_snapshots.size() > 0 && player_controller->get_current_frame_index() <= client_snapshots.back().input_id && client_snapshots.back().input_id != FrameIndex::NONE) {
+		NS_ASSERT_NO_ENTRY_MSG("During snapshot creation, for controller " + std::to_string(player_controller->get_authority_peer()) + ", was found an ID for an older snapshots. New input ID: " + std::string(player_controller->get_current_frame_index()) + " Last saved snapshot input ID: " + std::string(client_snapshots.back().input_id) + ".");
+	}
+#endif
+
+	if (scene_synchronizer->get_client_prediction_memory_budget() > 0) {
+		// The ring grows one slot at a time, so it retains only the memory of
+		// the frames predicted so far. Check `process_prediction_memory_budget()`.
+		client_snapshots.reserve(client_snapshots.size() + 1);
+	} else {
+		// Make sure the ring can store all the predicted frames, so the storage
+		// doesn't grow during the prediction.
+		client_snapshots.reserve(scene_synchronizer->get_client_max_frames_storage_size() + 1);
+	}
+
+	Snapshot &snap = client_snapshots.push_back();
+	snap.recycle();
+	snap.input_id = player_controller->get_current_frame_index();
+
+	fetch_reconciling_dolls();
+	update_client_snapshot(snap);
+
+	if (scene_synchronizer->get_client_prediction_memory_budget() > 0) {
+		client_snapshot_memory_usage = snap.get_memory_usage();
+	}
+}
+
+void ClientSynchronizer::store_controllers_snapshot(
+		const RollingUpdateSnapshot &p_snapshot) {
+	// Put the parsed snapshot into the queue.
+
+	if make_unlikely(!scene_synchronizer->synchronizer_manager->can_client_store_server_snapshot(p_snapshot)) {
+		// Do not store this snapshot.
+		return;
+	}
+
+	if (p_snapshot.input_id == FrameIndex::NONE) {
+		if (scene_synchronizer->get_debugger().is_printing(VERBOSE)) {
+			scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server snapshot WITHOUT `input_id`.", scene_synchronizer->get_network_interface().get_owner_name());
+		}
+		// The controller node is not registered so just assume this snapshot is the most up-to-date.
+		emplace_last_received_server_snapshot().copy(p_snapshot);
+		last_received_server_snapshot_index = p_snapshot.input_id;
+	} else {
 		NS_ENSURE_MSG(
 				last_received_server_snapshot_index == FrameIndex::NONE ||
 				last_received_server_snapshot_index <= p_snapshot.input_id,
@@ -3874,10 +5564,13 @@ void ClientSynchronizer::store_controllers_snapshot(
 			// The resulting snapshot is not a fully accurate one, but it's good
 			// enough to (eventually) rewind part of the scene objects, without
 			// breaking the sync.
-			scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server [PARTIAL] snapshot: " + p_snapshot.input_id, scene_synchronizer->get_network_interface().get_owner_name());
-			for (const Snapshot &client_snapshot : client_snapshots) {
+			if (scene_synchronizer->get_debugger().is_printing(VERBOSE)) {
+				scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server [PARTIAL] snapshot: " + p_snapshot.input_id, scene_synchronizer->get_network_interface().get_owner_name());
+			}
+			for (std::size_t i = 0; i < client_snapshots.size(); i++) {
+				const Snapshot &client_snapshot = client_snapshots[i];
 				if (client_snapshot.input_id == p_snapshot.input_id) {
-					last_received_server_snapshot.emplace(Snapshot::make_copy(client_snapshot));
+					emplace_last_received_server_snapshot().copy(client_snapshot);
 					break;
 				}
 			}
@@ -3894,6 +5587,7 @@ void ClientSynchronizer::store_controllers_snapshot(
 			if (p_snapshot.is_just_updated_simulated_objects) {
 				the_storing_snapshot.simulated_objects = p_snapshot.simulated_objects;
 			}
+			the_storing_snapshot.state_hash_verified_objects = p_snapshot.state_hash_verified_objects;
 			for (ObjectNetId net_id : p_snapshot.just_updated_object_vars) {
 				if (uint32_t(the_storing_snapshot.objects.size()) <= net_id.id) {
 					// Ensure the vector is big enough.
@@ -3915,8 +5609,10 @@ void ClientSynchronizer::store_controllers_snapshot(
 			last_received_server_snapshot_index = p_snapshot.input_id;
 		} else {
 			// The current snapshot represent the full server copy, so just copy it.
-			scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server snapshot: " + p_snapshot.input_id, scene_synchronizer->get_network_interface().get_owner_name());
-			last_received_server_snapshot.emplace(Snapshot::make_copy(p_snapshot));
+			if (scene_synchronizer->get_debugger().is_printing(VERBOSE)) {
+				scene_synchronizer->get_debugger().print(VERBOSE, "The Client received the server snapshot: " + p_snapshot.input_id, scene_synchronizer->get_network_interface().get_owner_name());
+			}
+			emplace_last_received_server_snapshot().copy(p_snapshot);
 			last_received_server_snapshot_index = p_snapshot.input_id;
 		}
 	}
@@ -3927,24 +5623,107 @@ void ClientSynchronizer::store_controllers_snapshot(
 	// NOTE 2: Using the last_received_server_snapshot instead of last_received_snapshot
 	//         because on the former we do extra stuff in order to properly parse
 	//         it in case the received one is a partial update.
+	dolls_store_server_snapshot(last_received_server_snapshot.value());
 	scene_synchronizer->event_received_server_snapshot.broadcast(last_received_server_snapshot.value());
 }
 
+bool ClientSynchronizer::verify_state_hashes(RollingUpdateSnapshot &r_snapshot) {
+	NS_PROFILE
+
+	if (r_snapshot.just_received_state_hashes.empty()) {
+		return true;
+	}
+
+	// The hash is computed by the server on the state it had after processing
+	// the `input_id`, which is what the client snapshot stores.
+	const Snapshot *client_snapshot = nullptr;
+	if (r_snapshot.input_id != FrameIndex::NONE) {
+		for (std::size_t i = 0; i < client_snapshots.size(); i++) {
+			if (client_snapshots[i].input_id == r_snapshot.input_id) {
+				client_snapshot = &client_snapshots[i];
+				break;
+			}
+		}
+	}
+
+	std::vector<ObjectNetId> mismatched_objects;
+	for (const auto &[net_id, server_state_hash] : r_snapshot.just_received_state_hashes) {
+		const ObjectData *od = scene_synchronizer->get_object_data(net_id);
+		if (od == nullptr || od->realtime_sync_enabled_on_client == false) {
+			// This object is not checked by the client.
+			continue;
+		}
+
+		bool verified = client_snapshot && net_id.id < client_snapshot->objects.size();
+		std::uint32_t client_state_hash = 0;
+		for (std::size_t v = 0; verified && v < od->vars.size(); v++) {
+			if (od->vars[v].is_state_hashed()) {
+				const std::vector<std::optional<VarData>> &client_vars = client_snapshot->objects[net_id.id].vars;
+				verified = v < client_vars.size() && client_vars[v].has_value();
+				if (verified) {
+					client_state_hash = SceneSynchronizerBase::var_data_hash(client_vars[v].value(), client_state_hash);
+				}
+			}
+		}
+
+		if (!verified || client_state_hash != server_state_hash) {
+			state_hash_mismatches_count += 1;
+			get_debugger().print(INFO, "The state hash of the object `" + od->get_object_name() + "` doesn't match the client prediction for the input `" + std::to_string(r_snapshot.input_id.id) + "`, requesting its values.", scene_synchronizer->get_network_interface().get_owner_name());
+			mismatched_objects.push_back(net_id);
+			continue;
+		}
+
+		// The prediction was correct: use the client values in place of the
+		// ones not networked. This is done even when other objects mismatch,
+		// since the server doesn't network this object again until it changes.
+		ObjectDataSnapshot &object_snapshot = r_snapshot.objects[net_id.id];
+		object_snapshot.vars.resize(od->vars.size());
+		for (std::size_t v = 0; v < od->vars.size(); v++) {
+			if (od->vars[v].is_state_hashed()) {
+				object_snapshot.vars[v].emplace(VarData::make_copy(client_snapshot->objects[net_id.id].vars[v].value()));
+			}
+		}
+		r_snapshot.state_hash_verified_objects.push_back(net_id);
+		state_hash_verified_objects_count += 1;
+	}
+
+	if (!mismatched_objects.empty()) {
+		// Only the mismatched objects are requested, rather than the full
+		// snapshot: the server networks their values with the next snapshot.
+		DataBuffer request(get_debugger());
+		request.begin_write(get_debugger(), 0);
+		request.add_uint(mismatched_objects.size(), DataBuffer::COMPRESSION_LEVEL_2);
+		for (ObjectNetId net_id : mismatched_objects) {
+			request.add(net_id.id);
+		}
+		scene_synchronizer->rpc_handler_notify_state_hash_mismatch.rpc(
+				scene_synchronizer->get_network_interface(),
+				scene_synchronizer->network_interface->get_server_peer(),
+				request);
+		return false;
+	}
+
+	return true;
+}
+
 void ClientSynchronizer::process_server_sync() {
 	NS_PROFILE
-	process_received_server_state();
+	if (!process_received_server_state()) {
+		// Resimulates the frames of the ongoing rewind.
+		process_pending_rewind();
+	}
 
 	// Now trigger the END_SYNC event.
 	signal_end_sync_changed_variables_events();
 }
 
-void ClientSynchronizer::process_received_server_state() {
+bool ClientSynchronizer::process_received_server_state() {
 	NS_PROFILE
 
 	// --- Phase one: find the snapshot to check. ---
 	if (!last_received_server_snapshot) {
 		// No snapshots to recover for this controller. Nothing to do.
-		return;
+		return false;
 	}
 
 	if (last_received_server_snapshot->input_id == FrameIndex::NONE) {
@@ -3952,11 +5731,11 @@ void ClientSynchronizer::process_received_server_state() {
 		scene_synchronizer->get_debugger().print(VERBOSE, "The client received a \"no input\" snapshot, so the client is setting it right away assuming is the most updated one.", scene_synchronizer->get_network_interface().get_owner_name());
 
 		apply_snapshot(*last_received_server_snapshot, NetEventFlag::SERVER_UPDATE, 0, nullptr);
-		last_received_server_snapshot.reset();
-		return;
+		release_last_received_server_snapshot();
+		return false;
 	}
 
-	NS_ENSURE_MSG(player_controller && player_controller->can_simulate(), "There is no player controller and the only allowed snapshot are the one with `FrameIndex` set to NONE. The current one is set to " + last_received_server_snapshot->input_id + " so it's ignored.");
+	NS_ENSURE_V_MSG(player_controller && player_controller->can_simulate(), false, "There is no player controller and the only allowed snapshot are the one with `FrameIndex` set to NONE. The current one is set to " + last_received_server_snapshot->input_id + " so it's ignored.");
 
 	PlayerController *inner_player_controller = player_controller->get_player_controller();
 
@@ -3972,8 +5751,8 @@ void ClientSynchronizer::process_received_server_state() {
 		process_paused_controller_recovery();
 		scene_synchronizer->event_state_validated.broadcast(last_checked_input, false);
 		// Clear the server snapshot.
-		last_received_server_snapshot.reset();
-		return;
+		release_last_received_server_snapshot();
+		return false;
 	}
 
 	// Find the best recoverable input_id.
@@ -3984,6 +5763,15 @@ void ClientSynchronizer::process_received_server_state() {
 		client_snapshots.pop_front();
 	}
 
+	// The server state can arrive while the time-sliced rewind is still
+	// resimulating the predicted frames: the frames not yet resimulated can't
+	// be checked, so the rewind restarts from this server state.
+	bool rewind_interrupted = false;
+	if make_unlikely(rewind_pending) {
+		rewind_pending_frames_count = std::min(rewind_pending_frames_count, int(client_snapshots.size()));
+		rewind_interrupted = int(client_snapshots.size()) <= rewind_pending_frames_count;
+	}
+
 #ifdef NS_DEBUG_ENABLED
 	// This can't be triggered because this case is already handled above,
 	// by checking last_received_server_snapshot->input_id == FrameIndex::NONE.
@@ -4001,8 +5789,9 @@ void ClientSynchronizer::process_received_server_state() {
 	const int frame_count_after_input_id = inner_player_controller->count_frames_after(last_checked_input);
 
 	bool need_rewind;
+	bool selective_rewind = false;
 	Snapshot no_rewind_recover;
-	if make_likely(!client_snapshots.empty() && client_snapshots.front().input_id == last_checked_input) {
+	if make_likely(!rewind_interrupted && !client_snapshots.empty() && client_snapshots.front().input_id == last_checked_input) {
 		// In this case the client is checking the frame for the first time, and
 		// this is the most common case.
 
@@ -4012,8 +5801,24 @@ void ClientSynchronizer::process_received_server_state() {
 				*inner_player_controller,
 				no_rewind_recover);
 
+		if make_unlikely(rewind_pending && !need_rewind && no_rewind_recover.input_id == FrameIndex{ { 0 } }) {
+			// The partial recover can't be applied to the scene while it's
+			// still rewinding, so rewind once again.
+			need_rewind = true;
+		}
+
+		if (need_rewind && !rewind_pending && scene_synchronizer->is_selective_rewind_enabled()) {
+			selective_rewind = __pcr__fetch_selective_rewind_objects(selective_rewind_objects);
+		}
+
 		// Popout the client snapshot.
 		client_snapshots.pop_front();
+	} else if make_unlikely(rewind_interrupted) {
+		// The rewind restarts from this server state.
+		need_rewind = true;
+		if (client_snapshots.front().input_id == last_checked_input) {
+			client_snapshots.pop_front();
+		}
 	} else {
 		// This case is less likely to happen, and in this case the client
 		// received the same frame (from the server) twice, so just assume we
@@ -4026,6 +5831,7 @@ void ClientSynchronizer::process_received_server_state() {
 
 	// --- Phase three: recover and rewind. ---
 
+	bool rewind_processed = false;
 	if (need_rewind) {
 		scene_synchronizer->get_debugger().notify_event(SceneSynchronizerDebugger::FrameEvent::CLIENT_DESYNC_DETECTED);
 		scene_synchronizer->get_debugger().print(
@@ -4036,23 +5842,43 @@ void ClientSynchronizer::process_received_server_state() {
 		scene_synchronizer->event_rewind_starting.broadcast();
 
 		// Sync.
-		__pcr__sync__rewind(
-				last_checked_input,
-				frame_count_after_input_id,
-				*inner_player_controller);
+		if (selective_rewind) {
+			__pcr__selective_sync__rewind();
+		} else {
+			__pcr__sync__rewind(
+					last_checked_input,
+					frame_count_after_input_id,
+					*inner_player_controller);
+		}
 
 		// Emit this signal here, which is when we are 100% sure the snapshot is applied and can be cleared.
 		scene_synchronizer->event_state_validated.broadcast(last_checked_input, need_rewind);
 
 		// Rewind.
-		__pcr__rewind(
-				last_checked_input,
-				frame_count_after_input_id,
-				player_controller,
-				inner_player_controller);
+		if (selective_rewind) {
+			__pcr__selective_rewind(
+					frame_count_after_input_id,
+					inner_player_controller);
+
+			// The objects not rewound keep the predicted state, so recover
+			// their differences that don't need a rewind.
+			if (__pcr__filter_selective_no_rewind_recover(no_rewind_recover)) {
+				__pcr__sync__no_rewind(no_rewind_recover);
+			}
 
-		// The rewind is now completed.
-		scene_synchronizer->event_rewind_completed.broadcast();
+			// The rewind is now completed.
+			scene_synchronizer->event_rewind_completed.broadcast();
+		} else {
+			__pcr__rewind(
+					frame_count_after_input_id,
+					inner_player_controller);
+
+			// Resimulates the frames now, so the `event_rewind_completed` is
+			// emitted before the server snapshot is released, when the rewind
+			// is not sliced.
+			process_pending_rewind();
+			rewind_processed = true;
+		}
 	} else {
 		if (no_rewind_recover.input_id == FrameIndex{ { 0 } }) {
 			scene_synchronizer->get_debugger().notify_event(SceneSynchronizerDebugger::FrameEvent::CLIENT_DESYNC_DETECTED_SOFT);
@@ -4069,7 +5895,8 @@ void ClientSynchronizer::process_received_server_state() {
 	}
 
 	// Clear the server snapshot.
-	last_received_server_snapshot.reset();
+	release_last_received_server_snapshot();
+	return rewind_processed;
 }
 
 bool ClientSynchronizer::__pcr__fetch_recovery_info(
@@ -4079,6 +5906,7 @@ bool ClientSynchronizer::__pcr__fetch_recovery_info(
 		Snapshot &r_no_rewind_recover) {
 	NS_PROFILE
 	std::vector<std::string> differences_info;
+	std::vector<std::pair<ObjectNetId, VarId>> rewind_trigger_vars;
 
 #ifdef NS_DEBUG_ENABLED
 	std::vector<ObjectNetId> different_node_data;
@@ -4090,7 +5918,8 @@ bool ClientSynchronizer::__pcr__fetch_recovery_info(
 			client_snapshots.front(),
 			scene_synchronizer->network_interface->get_local_peer_id(),
 			&r_no_rewind_recover,
-			scene_synchronizer->debug_rewindings_enabled ? &differences_info : nullptr
+			scene_synchronizer->debug_rewindings_enabled ? &differences_info : nullptr,
+			&rewind_trigger_vars
 #ifdef NS_DEBUG_ENABLED
 			,
 			&different_node_data
@@ -4105,7 +5934,8 @@ bool ClientSynchronizer::__pcr__fetch_recovery_info(
 						p_input_id,
 						p_rewind_frame_count,
 						&r_no_rewind_recover,
-						scene_synchronizer->debug_rewindings_enabled ? &differences_info : nullptr
+						scene_synchronizer->debug_rewindings_enabled ? &differences_info : nullptr,
+						&rewind_trigger_vars
 #ifdef NS_DEBUG_ENABLED
 						,
 						&different_node_data
@@ -4121,6 +5951,16 @@ bool ClientSynchronizer::__pcr__fetch_recovery_info(
 		}
 	}
 
+	// Track the variables that triggered the rewind.
+	if (!is_equal) {
+		for (const auto &[net_id, var_id] : rewind_trigger_vars) {
+			ObjectData *od = scene_synchronizer->get_object_data(net_id, false);
+			if (od && var_id.id < od->vars.size()) {
+				od->vars[var_id.id].rewind_triggers_count += 1;
+			}
+		}
+	}
+
 #ifdef NS_DEBUG_ENABLED
 	// Emit the de-sync detected signal.
 	if (!is_equal) {
@@ -4199,9 +6039,7 @@ void ClientSynchronizer::__pcr__sync__rewind(
 }
 
 void ClientSynchronizer::__pcr__rewind(
-		const FrameIndex p_checkable_frame_index,
 		const int p_rewind_frame_count,
-		PeerNetworkedController *p_local_controller,
 		PlayerController *p_local_player_controller) {
 	NS_PROFILE
 	// At this point the old inputs are cleared out and the remaining one are
@@ -4218,11 +6056,44 @@ void ClientSynchronizer::__pcr__rewind(
 	NS_ASSERT_COND_MSG(client_snapshots.size() == size_t(frames_to_rewind), "Beware that `client_snapshots.size()` (" + std::to_string(client_snapshots.size()) + ") and `remaining_inputs` (" + std::to_string(frames_to_rewind) + ") should be the same.");
 #endif
 
+	// All the predicted frames are pending, this also drops the rewind
+	// interrupted by this server state.
+	// NOTE: The scene was just reset to the server state, which is where the
+	//       rewind starts from.
+	rewind_visible_snapshot_applied = false;
+	rewind_pending = true;
+	rewind_pending_frames_count = frames_to_rewind;
+	last_rewind_resimulated_objects_count = std::uint32_t(active_objects.size());
+}
+
+bool ClientSynchronizer::__pcr__rewind_pending_frames(
+		PeerNetworkedController *p_local_controller,
+		PlayerController *p_local_player_controller,
+		int p_max_frames) {
+	NS_PROFILE
+	const int frames_to_rewind = p_local_player_controller->get_frames_count();
+
+#ifdef NS_DEBUG_ENABLED
+	NS_ASSERT_COND_MSG(client_snapshots.size() == size_t(frames_to_rewind), "Beware that `client_snapshots.size()` (" + std::to_string(client_snapshots.size()) + ") and `remaining_inputs` (" + std::to_string(frames_to_rewind) + ") should be the same.");
+	NS_ASSERT_COND(rewind_pending_frames_count <= frames_to_rewind);
+#endif
+
+	const int first_frame = frames_to_rewind - rewind_pending_frames_count;
+	const int end_frame = std::min(frames_to_rewind, first_frame + p_max_frames);
+
+	if (rewind_visible_snapshot_applied) {
+		// The scene shows the latest completed state: reset it to the last
+		// resimulated frame to go on with the rewind.
+		NS_ASSERT_COND(first_frame > 0);
+		apply_snapshot(client_snapshots[first_frame - 1], NetEventFlag::SYNC_RESET, 0, nullptr, false, false, false, true);
+		rewind_visible_snapshot_applied = false;
+	}
+
 #ifdef NS_DEBUG_ENABLED
 	// Used to double check all the instants have been processed.
 	bool has_next = false;
 #endif
-	for (int i = 0; i < frames_to_rewind; i += 1) {
+	for (int i = first_frame; i < end_frame; i += 1) {
 		const FrameIndex frame_id_to_process = p_local_player_controller->get_stored_frame_index(i);
 #ifdef NS_PROFILING_ENABLED
 		std::string prof_info = "Index: " + std::to_string(i) + " Frame ID: " + std::to_string(frame_id_to_process.id);
@@ -4233,6 +6104,7 @@ void ClientSynchronizer::__pcr__rewind(
 
 		// Step 1 -- Notify the local controller about the instant to process
 		//           on the next process.
+		dolls_rewind_frame_begin(frame_id_to_process, i, frames_to_rewind);
 		scene_synchronizer->event_rewind_frame_begin.broadcast(frame_id_to_process, i, frames_to_rewind);
 #ifdef NS_DEBUG_ENABLED
 		has_next = p_local_controller->has_another_instant_to_process_after(i);
@@ -4263,108 +6135,544 @@ void ClientSynchronizer::__pcr__rewind(
 		}
 	}
 
+	rewind_pending_frames_count = frames_to_rewind - end_frame;
+	if (rewind_pending_frames_count > 0) {
+		// Until the rewind completes, the scene shows the latest completed
+		// state: the newest client snapshot, not yet resimulated.
+		// NOTE: When the rewind is restarted the scene keeps showing the
+		//       snapshot taken by the first rewind.
+		if (!has_rewind_visible_snapshot) {
+			rewind_visible_snapshot.copy(client_snapshots.back());
+			has_rewind_visible_snapshot = true;
+		}
+		apply_snapshot(rewind_visible_snapshot, NetEventFlag::SYNC_RESET, 0, nullptr, false, false, false, true);
+		rewind_visible_snapshot_applied = true;
+		return false;
+	}
+
 #ifdef NS_DEBUG_ENABLED
 	// Unreachable because the above loop consume all instants, so the last
 	// process will set this to false.
 	NS_ASSERT_COND(!has_next);
 #endif
-}
-
-void ClientSynchronizer::__pcr__sync__no_rewind(const Snapshot &p_no_rewind_recover) {
-	NS_PROFILE
-	NS_ASSERT_COND_MSG(p_no_rewind_recover.input_id == FrameIndex{ { 0 } }, "This function is never called unless there is something to recover without rewinding.");
-
-	// Apply found differences without rewind.
-	std::vector<std::string> applied_data_info;
 
-	apply_snapshot(
-			p_no_rewind_recover,
-			NetEventFlag::SERVER_UPDATE,
-			0,
-			scene_synchronizer->debug_rewindings_enabled ? &applied_data_info : nullptr,
-			// ALWAYS skips custom data because partial snapshots don't contain custom_data.
-			true,
-			// Never update the simulating object when applying this snapshot as the array of simulating objects is empty.
-			true);
+	rewind_pending = false;
+	has_rewind_visible_snapshot = false;
+	return true;
+}
 
-	if (applied_data_info.size() > 0) {
-		scene_synchronizer->get_debugger().print(VERBOSE, "Partial reset:", scene_synchronizer->get_network_interface().get_owner_name());
-		for (int i = 0; i < int(applied_data_info.size()); i++) {
-			scene_synchronizer->get_debugger().print(VERBOSE, "|- " + applied_data_info[i], scene_synchronizer->get_network_interface().get_owner_name());
-		}
+int ClientSynchronizer::fetch_rewind_frames_budget() {
+	const int max_rewind_frames = scene_synchronizer->get_max_rewind_frames_per_process();
+	if (max_rewind_frames <= 0) {
+		return std::numeric_limits<int>::max();
 	}
 
-	// Update the last client snapshot.
-	if (!client_snapshots.empty()) {
-		update_client_snapshot(client_snapshots.back());
+	// The dolls reconciliation offsets the rewinding frames relative to the
+	// received snapshot, so the rewind is never sliced when dolls are around.
+	for (const DollController *doll : reconciling_dolls) {
+		if (!doll->peer_controller->get_sorted_controllable_objects().empty()) {
+			return std::numeric_limits<int>::max();
+		}
 	}
-}
 
-void ClientSynchronizer::__pcr__no_rewind(
-		const FrameIndex p_checkable_input_id,
-		PlayerController *p_player_controller) {
-	NS_PROFILE
+	return max_rewind_frames;
 }
 
-void ClientSynchronizer::process_paused_controller_recovery() {
+void ClientSynchronizer::process_pending_rewind() {
 	NS_PROFILE
 
-#ifdef NS_DEBUG_ENABLED
-	NS_ASSERT_COND(last_received_server_snapshot);
-	NS_ASSERT_COND(client_snapshots.empty());
-#endif
+	if make_likely(!rewind_pending) {
+		return;
+	}
 
-	std::vector<std::string> applied_data_info;
+	if make_unlikely(!player_controller || !player_controller->can_simulate()) {
+		// The controller can't simulate anymore, the rewind can't go on.
+		rewind_pending = false;
+		rewind_pending_frames_count = 0;
+		has_rewind_visible_snapshot = false;
+		rewind_visible_snapshot_applied = false;
+		return;
+	}
 
-	apply_snapshot(
-			*last_received_server_snapshot,
-			NetEventFlag::SERVER_UPDATE,
-			0,
-			&applied_data_info);
+	// The dolls are fetched once, rather than on each rewound frame.
+	fetch_reconciling_dolls();
 
-	last_received_server_snapshot.reset();
+	const bool completed = __pcr__rewind_pending_frames(
+			player_controller,
+			player_controller->get_player_controller(),
+			fetch_rewind_frames_budget());
 
-	if (applied_data_info.size() > 0) {
-		scene_synchronizer->get_debugger().print(VERBOSE, "Paused controller recover:", scene_synchronizer->get_network_interface().get_owner_name());
-		for (int i = 0; i < int(applied_data_info.size()); i++) {
-			scene_synchronizer->get_debugger().print(VERBOSE, "|- " + applied_data_info[i], scene_synchronizer->get_network_interface().get_owner_name());
-		}
+	if (completed) {
+		// The rewind is now completed.
+		scene_synchronizer->event_rewind_completed.broadcast();
 	}
 }
 
-int ClientSynchronizer::calculates_sub_ticks(const float p_delta) {
-	const float frames_per_seconds = 1.0f / p_delta;
-	// Extract the frame acceleration:
-	// 1. convert the Accelerated Tick Hz to second.
-	const float fully_accelerated_delta = 1.0f / (frames_per_seconds + acceleration_fps_speed);
-
-	// 2. Subtract the `accelerated_delta - delta` to obtain the acceleration magnitude.
-	const float acceleration_delta = std::abs(fully_accelerated_delta - p_delta);
-
-	// 3. Avoids overshots by taking the smallest value between `acceleration_delta` and the `remaining timer`.
-	const float frame_acceleration_delta = std::max(0.0f, std::min(acceleration_delta, acceleration_fps_timer));
-
-	// Updates the timer by removing the extra acceleration.
-	acceleration_fps_timer = std::max(acceleration_fps_timer - frame_acceleration_delta, 0.0f);
+bool ClientSynchronizer::__pcr__fetch_selective_rewind_objects(std::vector<ObjectData *> &r_objects) {
+	NS_PROFILE
 
-	// Calculates the pretended delta.
-	pretended_delta = p_delta + (frame_acceleration_delta * NS::sign(acceleration_fps_speed));
+	r_objects.clear();
 
-	// Fetch the process count using the pretended delta.
-	const int sub_ticks = scene_synchronizer->fetch_sub_processes_count(pretended_delta);
+	const Snapshot &server_snapshot = *last_received_server_snapshot;
+	const Snapshot &client_snapshot = client_snapshots.front();
 
-#ifdef NS_DEBUG_ENABLED
-	if (scene_synchronizer->disable_client_sub_ticks) {
-		if (sub_ticks > 1) {
-			return 1;
+	// The dolls reconciliation and the scheduled procedures are driven by the
+	// whole scene processing.
+	for (auto &[peer, data] : scene_synchronizer->peer_data) {
+		if (data.get_controller() && data.get_controller()->is_doll_controller() && !data.get_controller()->get_sorted_controllable_objects().empty()) {
+			return false;
 		}
 	}
-#endif
+	if (!scene_synchronizer->objects_data_storage.get_sorted_active_scheduled_procedures().empty()) {
+		return false;
+	}
 
-	NS_ENSURE_V_MSG(
-			sub_ticks <= scene_synchronizer->get_max_sub_process_per_frame(),
-			scene_synchronizer->get_max_sub_process_per_frame(),
-			"This client generated a sub tick count of `" + std::to_string(sub_ticks) + "` that is higher than the `max_sub_process_per_frame` specified of `" + std::to_string(scene_synchronizer->get_max_sub_process_per_frame()) + "`. If the number is way too high (like 100 or 1k) it's a bug in the algorithm that you should notify, if it's just above the threshould you set, make sure the threshold is correctly set or ignore it if the client perfs are too poor." +
+	// Only the objects state can be rewound selectively.
+	if (server_snapshot.global_frame_index != client_snapshot.global_frame_index) {
+		return false;
+	}
+	if (server_snapshot.simulated_objects.size() != client_snapshot.simulated_objects.size()) {
+		return false;
+	}
+	for (std::size_t i = 0; i < server_snapshot.simulated_objects.size(); i++) {
+		if (server_snapshot.simulated_objects[i].net_id != client_snapshot.simulated_objects[i].net_id || server_snapshot.simulated_objects[i].controlled_by_peer != client_snapshot.simulated_objects[i].controlled_by_peer) {
+			return false;
+		}
+	}
+	if (server_snapshot.has_custom_data != client_snapshot.has_custom_data) {
+		return false;
+	}
+	if (server_snapshot.has_custom_data && !SceneSynchronizerBase::var_data_compare(server_snapshot.custom_data, client_snapshot.custom_data)) {
+		return false;
+	}
+
+	// Collect the islands of the desynchronized objects.
+	std::vector<RewindIslandId> islands;
+	const std::vector<ObjectData *> &sorted_objects_data = scene_synchronizer->objects_data_storage.get_sorted_objects_data();
+	for (const ObjectData *od : sorted_objects_data) {
+		if (od == nullptr || od->realtime_sync_enabled_on_client == false || od->is_client_interpolated()) {
+			continue;
+		}
+
+		if (!Snapshot::compare_object_vars(*od, server_snapshot, client_snapshot)) {
+			if (od->rewind_island == RewindIslandId::NONE || od->get_controlled_by_peer() > 0) {
+				// This object is rewound with the whole scene.
+				return false;
+			}
+			VecFunc::insert_unique(islands, od->rewind_island);
+		}
+	}
+
+	if (islands.empty()) {
+		// The difference was detected somewhere else.
+		return false;
+	}
+
+	for (ObjectData *od : sorted_objects_data) {
+		if (od && od->realtime_sync_enabled_on_client && !od->is_client_interpolated() && VecFunc::has(islands, od->rewind_island)) {
+			if (od->get_controlled_by_peer() > 0) {
+				// The controlled objects are processed using the inputs, which
+				// are rewound only by the whole scene rewind.
+				r_objects.clear();
+				return false;
+			}
+			r_objects.push_back(od);
+		}
+	}
+
+	return true;
+}
+
+bool ClientSynchronizer::__pcr__filter_selective_no_rewind_recover(Snapshot &r_no_rewind_recover) const {
+	if (r_no_rewind_recover.input_id != FrameIndex{ { 0 } }) {
+		// Nothing to recover.
+		return false;
+	}
+
+	// The rewound objects were already reset to the server state.
+	for (const ObjectData *od : selective_rewind_objects) {
+		const ObjectNetId net_id = od->get_net_id();
+		if (net_id.id < r_no_rewind_recover.objects.size()) {
+			r_no_rewind_recover.objects[net_id.id].clear();
+		}
+		VecFunc::remove(r_no_rewind_recover.simulated_objects, net_id);
+	}
+
+	return !r_no_rewind_recover.simulated_objects.empty();
+}
+
+void ClientSynchronizer::__pcr__selective_sync__rewind() {
+	NS_PROFILE
+
+	// Apply the server state only to the objects to rewind, the rest of the
+	// scene keeps the predicted state.
+	std::vector<std::string> applied_data_info;
+
+	const Snapshot &server_snapshot = *last_received_server_snapshot;
+	scene_synchronizer->change_events_begin(NetEventFlag::SERVER_UPDATE | NetEventFlag::SYNC_RESET);
+	scene_synchronizer->global_frame_index = server_snapshot.global_frame_index;
+	for (ObjectData *od : selective_rewind_objects) {
+		if (server_snapshot.objects.size() <= od->get_net_id().id) {
+			continue;
+		}
+
+		if (scene_synchronizer->debug_rewindings_enabled) {
+			applied_data_info.push_back("Applied snapshot on the object: " + od->get_object_name());
+		}
+		apply_snapshot_object_vars(
+				*od,
+				server_snapshot.objects[od->get_net_id().id],
+				scene_synchronizer->debug_rewindings_enabled ? &applied_data_info : nullptr);
+	}
+	scene_synchronizer->change_events_flush();
+
+	if (applied_data_info.size() > 0) {
+		scene_synchronizer->get_debugger().print(VERBOSE, "Selective reset:", scene_synchronizer->get_network_interface().get_owner_name());
+		for (int i = 0; i < int(applied_data_info.size()); i++) {
+			scene_synchronizer->get_debugger().print(VERBOSE, "|- " + applied_data_info[i], scene_synchronizer->get_network_interface().get_owner_name());
+		}
+	}
+}
+
+void ClientSynchronizer::__pcr__selective_rewind(
+		const int p_rewind_frame_count,
+		PlayerController *p_local_player_controller) {
+	NS_PROFILE
+	const int frames_to_rewind = p_local_player_controller->get_frames_count();
+	NS_ASSERT_COND(frames_to_rewind == p_rewind_frame_count);
+
+#ifdef NS_DEBUG_ENABLED
+	NS_ASSERT_COND_MSG(client_snapshots.size() == size_t(frames_to_rewind), "Beware that `client_snapshots.size()` (" + std::to_string(client_snapshots.size()) + ") and `remaining_inputs` (" + std::to_string(frames_to_rewind) + ") should be the same.");
+#endif
+
+	// NOTE: The controllers are not processed, so the `event_rewind_frame_begin`
+	//       is not emitted: only the objects of the rewinding islands are
+	//       processed, and these are never controlled.
+	for (int i = 0; i < frames_to_rewind; i += 1) {
+		scene_synchronizer->change_events_begin(NetEventFlag::SERVER_UPDATE | NetEventFlag::SYNC_REWIND);
+
+		scene_synchronizer->process_functions__execute_objects(selective_rewind_objects);
+
+		for (ObjectData *od : selective_rewind_objects) {
+			scene_synchronizer->pull_object_changes(*od);
+		}
+		scene_synchronizer->change_events_flush();
+
+		// The other objects in the snapshot already have the predicted state.
+		for (ObjectData *od : selective_rewind_objects) {
+			update_client_snapshot_object(client_snapshots[i], *od);
+		}
+	}
+
+	last_rewind_resimulated_objects_count = std::uint32_t(selective_rewind_objects.size());
+}
+
+void ClientSynchronizer::__pcr__sync__no_rewind(const Snapshot &p_no_rewind_recover) {
+	NS_PROFILE
+	NS_ASSERT_COND_MSG(p_no_rewind_recover.input_id == FrameIndex{ { 0 } }, "This function is never called unless there is something to recover without rewinding.");
+
+	// Apply found differences without rewind.
+	std::vector<std::string> applied_data_info;
+
+	apply_snapshot(
+			p_no_rewind_recover,
+			NetEventFlag::SERVER_UPDATE,
+			0,
+			scene_synchronizer->debug_rewindings_enabled ? &applied_data_info : nullptr,
+			// ALWAYS skips custom data because partial snapshots don't contain custom_data.
+			true,
+			// Never update the simulating object when applying this snapshot as the array of simulating objects is empty.
+			true);
+
+	if (applied_data_info.size() > 0) {
+		scene_synchronizer->get_debugger().print(VERBOSE, "Partial reset:", scene_synchronizer->get_network_interface().get_owner_name());
+		for (int i = 0; i < int(applied_data_info.size()); i++) {
+			scene_synchronizer->get_debugger().print(VERBOSE, "|- " + applied_data_info[i], scene_synchronizer->get_network_interface().get_owner_name());
+		}
+	}
+
+	// Update the last client snapshot.
+	if (!client_snapshots.empty()) {
+		fetch_reconciling_dolls();
+		update_client_snapshot(client_snapshots.back());
+	}
+}
+
+void ClientSynchronizer::__pcr__no_rewind(
+		const FrameIndex p_checkable_input_id,
+		PlayerController *p_player_controller) {
+	NS_PROFILE
+}
+
+void ClientSynchronizer::process_paused_controller_recovery() {
+	NS_PROFILE
+
+#ifdef NS_DEBUG_ENABLED
+	NS_ASSERT_COND(last_received_server_snapshot);
+	NS_ASSERT_COND(client_snapshots.empty());
+#endif
+
+	std::vector<std::string> applied_data_info;
+
+	apply_snapshot(
+			*last_received_server_snapshot,
+			NetEventFlag::SERVER_UPDATE,
+			0,
+			&applied_data_info);
+
+	release_last_received_server_snapshot();
+
+	if (applied_data_info.size() > 0) {
+		scene_synchronizer->get_debugger().print(VERBOSE, "Paused controller recover:", scene_synchronizer->get_network_interface().get_owner_name());
+		for (int i = 0; i < int(applied_data_info.size()); i++) {
+			scene_synchronizer->get_debugger().print(VERBOSE, "|- " + applied_data_info[i], scene_synchronizer->get_network_interface().get_owner_name());
+		}
+	}
+}
+
+void ClientSynchronizer::process_prediction_memory_budget() {
+	NS_PROFILE
+
+	const std::uint64_t budget = scene_synchronizer->get_client_prediction_memory_budget();
+	if make_likely(budget == 0) {
+		prediction_memory_max_frames = std::numeric_limits<std::size_t>::max();
+		prediction_memory_paused = false;
+		return;
+	}
+
+	fetch_reconciling_dolls();
+
+	std::uint64_t dolls_usage = 0;
+	for (const DollController *doll : reconciling_dolls) {
+		dolls_usage += doll->get_snapshots_memory_usage();
+	}
+	std::uint64_t pending_usage = fetch_pending_snapshots_memory_usage();
+	// The popped client snapshots keep their memory to be reused, so the whole
+	// ring is accounted.
+	std::uint64_t client_usage = std::uint64_t(client_snapshots.capacity()) * client_snapshot_memory_usage;
+
+	const bool is_over_budget = (client_usage + dolls_usage + pending_usage) > budget;
+	if make_unlikely(is_over_budget) {
+		prediction_memory_report.degradations_count += 1;
+
+		// 1. The pending snapshots are dropped, the full snapshot contains
+		//    their data anyway. Though the full snapshot is costly, so it's
+		//    requested only when the pending snapshots are at least half of
+		//    the overage.
+		const std::uint64_t overage = client_usage + dolls_usage + pending_usage - budget;
+		if (pending_usage > 0 && pending_usage * 2 >= overage) {
+			if (notify_server_full_snapshot_is_needed()) {
+				prediction_memory_report.full_snapshot_requests_count += 1;
+			}
+			// The released pending snapshots keep their buffers to be reused,
+			// so they are freed.
+			objects_pending_snapshots.clear();
+			objects_pending_snapshots.shrink_to_fit();
+			pending_usage = fetch_pending_snapshots_memory_usage();
+		}
+
+		// 2. Release the client snapshots slots not storing a predicted frame.
+		client_snapshots.shrink(client_snapshots.size());
+		client_usage = std::uint64_t(client_snapshots.capacity()) * client_snapshot_memory_usage;
+
+		// 3. Drop the oldest dolls snapshots so that the dolls use at most
+		//    half of the remaining budget, the other half is for the prediction.
+		//    The predicted frames can't be dropped, so when they already use
+		//    more than their half the dolls get what's left.
+		const std::uint64_t remaining_budget = budget - std::min(budget, pending_usage);
+		const std::uint64_t dolls_budget = std::min(remaining_budget / 2, remaining_budget - std::min(remaining_budget, client_usage));
+		if (dolls_usage > dolls_budget) {
+			const std::uint64_t doll_budget = dolls_budget / std::max(reconciling_dolls.size(), std::size_t(1));
+			dolls_usage = 0;
+			for (DollController *doll : reconciling_dolls) {
+				if (doll->snapshot_memory_usage > 0) {
+					// Keep at least one snapshot, so the doll can still reconcile.
+					const std::size_t max_snapshots = std::max(std::size_t(doll_budget / doll->snapshot_memory_usage), std::size_t(1));
+					prediction_memory_report.dropped_doll_snapshots_count += doll->drop_oldest_snapshots(max_snapshots);
+				}
+				dolls_usage += doll->get_snapshots_memory_usage();
+			}
+		}
+	}
+
+	// 4. Limit the prediction to the frames fitting the remaining budget, the
+	//    client predicts at least one frame ahead.
+	if (client_snapshot_memory_usage > 0) {
+		const std::uint64_t used = dolls_usage + pending_usage;
+		const std::uint64_t prediction_budget = budget > used ? budget - used : 0;
+		prediction_memory_max_frames = std::max(std::size_t(prediction_budget / client_snapshot_memory_usage), std::size_t(1));
+	} else {
+		prediction_memory_max_frames = std::numeric_limits<std::size_t>::max();
+	}
+
+	if (client_snapshots.size() >= prediction_memory_max_frames) {
+		// The prediction is paused by `can_execute_scene_process()`.
+		prediction_memory_report.paused_frames_count += 1;
+		if (!prediction_memory_paused) {
+			// Logged once per pause.
+			prediction_memory_paused = true;
+			prediction_memory_report.pauses_count += 1;
+			get_debugger().print(WARNING, "The prediction is paused, as the predicted frames don't fit the memory budget. Frames: " + std::to_string(client_snapshots.size()) + " max_frames: " + std::to_string(prediction_memory_max_frames) + ".", scene_synchronizer->get_network_interface().get_owner_name());
+		}
+	} else if (prediction_memory_paused) {
+		prediction_memory_paused = false;
+		get_debugger().print(INFO, "The prediction is resumed, as the predicted frames fit the memory budget.", scene_synchronizer->get_network_interface().get_owner_name());
+	}
+
+	prediction_memory_report.memory_usage_bytes = client_usage + dolls_usage + pending_usage;
+	prediction_memory_report.frame_memory_bytes = client_snapshot_memory_usage;
+	prediction_memory_report.max_predicted_frames = std::uint32_t(std::min(prediction_memory_max_frames, std::size_t(std::numeric_limits<std::uint32_t>::max())));
+}
+
+std::size_t ClientSynchronizer::fetch_pending_snapshots_memory_usage() const {
+	// The released entries keep their buffers to be reused, so all the
+	// allocated memory is accounted.
+	std::size_t usage = objects_pending_snapshots.capacity() * sizeof(ObjectPendingSnapshots);
+	for (const ObjectPendingSnapshots &pending : objects_pending_snapshots) {
+		usage += pending.snapshots.capacity() * sizeof(DataBuffer);
+		usage += pending.state_hashing.capacity() / 8;
+		for (const DataBuffer &snapshot : pending.snapshots) {
+			usage += snapshot.get_buffer().get_bytes().capacity();
+		}
+	}
+	return usage;
+}
+
+void ClientSynchronizer::fetch_reconciling_dolls() {
+	reconciling_dolls.clear();
+	for (auto &[peer, data] : scene_synchronizer->peer_data) {
+		if (data.get_controller() && data.get_controller()->is_doll_controller()) {
+			reconciling_dolls.push_back(data.get_controller()->get_doll_controller());
+		}
+	}
+}
+
+void ClientSynchronizer::fetch_dolls_controlled_objects(const Snapshot &p_snapshot) {
+	NS_PROFILE
+
+	for (DollController *doll : reconciling_dolls) {
+		doll->snapshot_controlled_objects.clear();
+	}
+
+	if (reconciling_dolls.empty()) {
+		return;
+	}
+
+	for (const SimulatedObjectInfo &sim_object : p_snapshot.simulated_objects) {
+		PeerData *peer_data = MapFunc::get_or_null(scene_synchronizer->peer_data, sim_object.controlled_by_peer);
+		if (!peer_data || !peer_data->get_controller() || !peer_data->get_controller()->is_doll_controller()) {
+			// Not controlled by a doll.
+			continue;
+		}
+
+		ObjectData *object_data = scene_synchronizer->get_object_data(sim_object.net_id);
+		if (object_data) {
+			peer_data->get_controller()->get_doll_controller()->snapshot_controlled_objects.push_back(object_data);
+		} else {
+			scene_synchronizer->get_debugger().print(WARNING, "The object data with ID `" + sim_object.net_id + "` was not found, but it's expected to be found as this peer is simulating and controlling it. If this happens too many times and the game miss behave, this might be something to investigate.");
+		}
+	}
+}
+
+void ClientSynchronizer::dolls_store_server_snapshot(const Snapshot &p_snapshot) {
+	NS_PROFILE
+
+	fetch_reconciling_dolls();
+	fetch_dolls_controlled_objects(p_snapshot);
+	for (DollController *doll : reconciling_dolls) {
+		doll->on_received_server_snapshot(p_snapshot);
+	}
+}
+
+void ClientSynchronizer::dolls_store_client_snapshot(const Snapshot &p_snapshot) {
+	NS_PROFILE
+
+	fetch_dolls_controlled_objects(p_snapshot);
+	for (DollController *doll : reconciling_dolls) {
+		doll->on_snapshot_update_finished(p_snapshot);
+	}
+}
+
+void ClientSynchronizer::dolls_rewind_frame_begin(FrameIndex p_frame_index, int p_rewinding_index, int p_rewinding_frame_count) {
+	for (DollController *doll : reconciling_dolls) {
+		doll->on_rewind_frame_begin(p_frame_index, p_rewinding_index, p_rewinding_frame_count);
+	}
+}
+
+void ClientSynchronizer::dolls_reconcile(const Snapshot &p_snapshot, int p_frame_count_to_rewind) {
+	NS_PROFILE
+
+	fetch_reconciling_dolls();
+
+	dolls_snapshots_to_apply.clear();
+	for (DollController *doll : reconciling_dolls) {
+		doll->on_snapshot_applied(p_snapshot, p_frame_count_to_rewind, dolls_snapshots_to_apply);
+	}
+
+#ifdef NS_DEBUG_ENABLED
+	if make_unlikely(debug_reconcile_dolls_one_by_one) {
+		last_dolls_applied_snapshots_count = 0;
+		for (const Snapshot *snapshot : dolls_snapshots_to_apply) {
+			apply_snapshot(*snapshot, 0, 0, nullptr, true, true, true, true, true, false);
+			last_dolls_applied_snapshots_count += 1;
+		}
+		return;
+	}
+#endif
+
+	// The dolls which received a partially updated snapshot are reset using
+	// the global snapshot: it's applied only once and before the doll
+	// snapshots, which contain just the objects controlled by each doll.
+	bool global_snapshot_applied = false;
+	for (const Snapshot *snapshot : dolls_snapshots_to_apply) {
+		if (snapshot == &p_snapshot && !global_snapshot_applied) {
+			apply_snapshot(p_snapshot, 0, 0, nullptr, true, true, true, true, true, false);
+			global_snapshot_applied = true;
+		}
+	}
+
+	last_dolls_applied_snapshots_count = global_snapshot_applied ? 1 : 0;
+	for (const Snapshot *snapshot : dolls_snapshots_to_apply) {
+		if (snapshot != &p_snapshot) {
+			apply_snapshot(*snapshot, 0, 0, nullptr, true, true, true, true, true, false);
+			last_dolls_applied_snapshots_count += 1;
+		}
+	}
+}
+
+int ClientSynchronizer::calculates_sub_ticks(const float p_delta) {
+	const float frames_per_seconds = 1.0f / p_delta;
+	// Extract the frame acceleration:
+	// 1. convert the Accelerated Tick Hz to second.
+	const float fully_accelerated_delta = 1.0f / (frames_per_seconds + acceleration_fps_speed);
+
+	// 2. Subtract the `accelerated_delta - delta` to obtain the acceleration magnitude.
+	const float acceleration_delta = std::abs(fully_accelerated_delta - p_delta);
+
+	// 3. Avoids overshots by taking the smallest value between `acceleration_delta` and the `remaining timer`.
+	const float frame_acceleration_delta = std::max(0.0f, std::min(acceleration_delta, acceleration_fps_timer));
+
+	// Updates the timer by removing the extra acceleration.
+	acceleration_fps_timer = std::max(acceleration_fps_timer - frame_acceleration_delta, 0.0f);
+
+	// Calculates the pretended delta.
+	pretended_delta = p_delta + (frame_acceleration_delta * NS::sign(acceleration_fps_speed));
+
+	// Fetch the process count using the pretended delta.
+	const int sub_ticks = scene_synchronizer->fetch_sub_processes_count(pretended_delta);
+
+#ifdef NS_DEBUG_ENABLED
+	if (scene_synchronizer->disable_client_sub_ticks) {
+		if (sub_ticks > 1) {
+			return 1;
+		}
+	}
+#endif
+
+	NS_ENSURE_V_MSG(
+			sub_ticks <= scene_synchronizer->get_max_sub_process_per_frame(),
+			scene_synchronizer->get_max_sub_process_per_frame(),
+			"This client generated a sub tick count of `" + std::to_string(sub_ticks) + "` that is higher than the `max_sub_process_per_frame` specified of `" + std::to_string(scene_synchronizer->get_max_sub_process_per_frame()) + "`. If the number is way too high (like 100 or 1k) it's a bug in the algorithm that you should notify, if it's just above the threshould you set, make sure the threshold is correctly set or ignore it if the client perfs are too poor." +
 			" (in delta: " + std::to_string(p_delta) +
 			" iteration per seconds: " + std::to_string(scene_synchronizer->get_frames_per_seconds()) +
 			" fully_accelerated_delta: " + std::to_string(fully_accelerated_delta) +
@@ -4406,6 +6714,22 @@ void ClientSynchronizer::process_simulation(float p_delta) {
 	NS_PROFILE_SET_INFO(perf_info);
 #endif
 
+	if make_unlikely(rewind_pending) {
+		// The time-sliced rewind didn't reach the last predicted frame yet, so
+		// the new frames can't be processed: their inputs are collected and
+		// queued to the rewind, so the inputs stream doesn't stall.
+		for (; sub_ticks > 0; sub_ticks -= 1) {
+			if (!can_execute_scene_process()) {
+				break;
+			}
+			if (player_controller->get_player_controller()->collect_deferred_input(scene_synchronizer->get_fixed_frame_delta())) {
+				store_snapshot();
+				rewind_pending_frames_count += 1;
+			}
+		}
+		return;
+	}
+
 	if (sub_ticks == 0) {
 		scene_synchronizer->get_debugger().print(VERBOSE, "No sub ticks: this is not bu a bug; it's the lag compensation algorithm.", scene_synchronizer->get_network_interface().get_owner_name());
 	}
@@ -4444,23 +6768,17 @@ void ClientSynchronizer::process_simulation(float p_delta) {
 
 bool ClientSynchronizer::parse_sync_data(
 		DataBuffer &p_snapshot,
-		void *p_user_pointer,
+		bool p_is_server_snapshot,
+		RollingUpdateSnapshot &r_snapshot,
 		ClientParsingErrors &r_parsing_errors,
-		void (*p_notify_parsing_failed_for_object)(void *p_user_pointer, ObjectData &p_object_data),
-		void (*p_notify_update_mode)(void *p_user_pointer, bool p_is_partial_update),
-		void (*p_parse_global_frame_index)(void *p_user_pointer, GlobalFrameIndex p_global_frame_index),
-		void (*p_custom_data_parse)(void *p_user_pointer, VarData &&p_custom_data),
-		void (*p_object_parse)(void *p_user_pointer, ObjectData *p_object_data),
-		bool (*p_peers_frame_index_parse)(void *p_user_pointer, std::map<int, FrameIndexWithMeta> &&p_frames_index),
-		void (*p_variable_parse)(void *p_user_pointer, ObjectData &p_object_data, VarId p_var_id, VarData &&p_value),
-		void (*p_scheduled_procedure_parse)(void *p_user_pointer, ObjectData &p_object_data, ScheduledProcedureId p_procedure_id, ScheduledProcedureSnapshot &&p_value),
-		void (*p_simulated_object_add_or_remove_parse)(void *p_user_pointer, bool p_add, SimulatedObjectInfo &&p_simulated_objects),
-		void (*p_simulated_objects_parse)(void *p_user_pointer, std::vector<SimulatedObjectInfo> &&p_simulated_objects)) {
+		SnapshotDecodeJob *p_decoded_snapshot) {
 	NS_PROFILE
 
 	// The snapshot is a DataBuffer that contains the scene information.
 	// NOTE: Check generate_snapshot to see the DataBuffer format.
-	std::map<int, FrameIndexWithMeta> frames_index;
+	// NOTE: The parsing uses the storage of the `ClientSynchronizer`, so the
+	//       steady state parsing doesn't allocate.
+	parse_peers_frame_index.clear();
 
 	p_snapshot.begin_read(get_debugger());
 	if (p_snapshot.size() <= 0) {
@@ -4468,212 +6786,137 @@ bool ClientSynchronizer::parse_sync_data(
 		return true;
 	}
 
-	{
-		// Fetch the update mode of this snapshot.
-		bool is_partial_update;
-		p_snapshot.read(is_partial_update);
-		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `is_partial_update` boolean expected is not set.");
-		p_notify_update_mode(p_user_pointer, is_partial_update);
-	}
-
-	{
-		// Fetch the global frame index
-		GlobalFrameIndex GFI;
-		p_snapshot.read(GFI.id);
-		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `GlobalFrameIndex` expected is not set.");
-		p_parse_global_frame_index(p_user_pointer, GFI);
+	SyncDataHeader *header = &parse_header;
+	if (p_decoded_snapshot) {
+		// The errors were already reported by the `SnapshotDecoder`.
+		if (!p_decoded_snapshot->is_header_decoded) {
+			return false;
+		}
+		header = &p_decoded_snapshot->header;
+	} else if (!decode_sync_data_header(p_snapshot, scene_synchronizer->get_synchronizer_manager().snapshot_get_custom_data_type(), parse_header)) {
+		return false;
 	}
 
-	std::vector<SimulatedObjectInfo> sd_simulated_objects_full_array;
-	sd_simulated_objects_full_array.reserve(scene_synchronizer->get_all_object_data().size());
+	// When the partial update is set to true the server didn't
+	// send all the changed objects of the SyncGroup.
+	r_snapshot.was_partially_updated = header->is_partial_update;
+	r_snapshot.global_frame_index = header->global_frame_index;
 
-	{
-		// Fetch the peer information
-		while (true) {
-			bool has_next_peer_info = false;
-			p_snapshot.read(has_next_peer_info);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `has_next_peer_info` failed.");
+	if (header->is_adaptive_notify_timespan) {
+		server_notify_timespan = float(header->notify_timespan_ms) / 1000.0f;
+	} else {
+		server_notify_timespan = -1.0f;
+	}
 
-			if (!has_next_peer_info) {
-				// Array is empty now.
-				break;
-			}
+	parse_simulated_objects.clear();
 
-			// Fetch the peer
-			int peer;
-			p_snapshot.read(peer);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `peer` failed.");
-
-			std::map<int, PeerData>::iterator peer_data_it = MapFunc::insert_if_new(scene_synchronizer->peer_data, peer, PeerData());
+	const auto add_or_remove_simulated_object = [&r_snapshot](bool p_add, SimulatedObjectInfo &&p_simulated_object) {
+		if (p_add) {
+			VecFunc::insert_or_update(r_snapshot.simulated_objects, std::move(p_simulated_object));
+		} else {
+			VecFunc::remove_unordered(r_snapshot.simulated_objects, p_simulated_object);
+		}
+		r_snapshot.is_just_updated_simulated_objects = true;
+	};
 
-			// Fetch the frame index
-			FrameIndex frame_index;
-			p_snapshot.read(frame_index.id);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching the peer `frame_index` failed.");
+	// Apply the peer information
+	for (std::size_t i = 0; i < header->peers_count; i++) {
+		const SyncDataHeader::PeerInfo &peer_info = header->peers[i];
 
-			MapFunc::assign(frames_index, peer, FrameIndexWithMeta(frame_index));
+		std::map<int, PeerData>::iterator peer_data_it = MapFunc::insert_if_new(scene_synchronizer->peer_data, peer_info.peer, PeerData());
 
-			// Fetch the latency
-			bool has_latency;
-			p_snapshot.read(has_latency);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching the peer `has_latency` failed.");
+		parse_peers_frame_index.push_back(std::make_pair(peer_info.peer, peer_info.frame_index));
 
-			if (has_latency) {
-				std::uint8_t compressed_latency;
-				p_snapshot.read(compressed_latency);
-				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `compressed_latency` failed.");
+		if (peer_info.has_latency) {
+			peer_data_it->second.set_compressed_latency(peer_info.compressed_latency);
+		}
 
-				peer_data_it->second.set_compressed_latency(compressed_latency);
+		// The simulated object info for all the objects controlled by this peer.
+		if (peer_info.is_simulated_objects_full_update) {
+			for (ObjectNetId id : peer_info.simulated_objects) {
+				parse_simulated_objects.push_back(SimulatedObjectInfo(id, peer_info.peer));
 			}
-
-			// Fetch the controlled objects?
-			// Fetch the simulated object info for all the objects controlled by this peer.
-			// Fetch the update type (FULL | INCREMENTAL)
-			bool is_simulated_object_array_full_update;
-			p_snapshot.read(is_simulated_object_array_full_update);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `is_full_update` boolean expected is not set.");
-
-			if (is_simulated_object_array_full_update) {
-				// Fetch the array.
-				while (true) {
-					ObjectNetId id;
-					p_snapshot.read(id.id);
-					NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `ObjectNetId` failed.");
-
-					if (id == ObjectNetId::NONE) {
-						// The end.
-						break;
-					}
-
-					sd_simulated_objects_full_array.push_back(SimulatedObjectInfo(id, peer));
-				}
-			} else {
-				// Fetch the array.
-				while (true) {
-					bool has_net_id;
-					p_snapshot.read(has_net_id);
-					NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `has_net_id` failed.");
-
-					if (!has_net_id) {
-						// We reached the end of the array.
-						break;
-					}
-
-					ObjectNetId id;
-					p_snapshot.read(id.id);
-					NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `ObjectNetId` failed.");
-
-					// NOTE: No need to fetch the was_added as done below because
-					// objects associated to a peer are always added;
-					// When they are removed the peer is not assigned and they
-					// are retrieved below.
-					const bool was_added = true;
-
-					p_simulated_object_add_or_remove_parse(p_user_pointer, was_added, SimulatedObjectInfo(id, peer));
-				}
+		} else {
+			for (ObjectNetId id : peer_info.simulated_objects) {
+				// NOTE: No need to fetch the was_added as done below because
+				// objects associated to a peer are always added;
+				// When they are removed the peer is not assigned and they
+				// are retrieved below.
+				const bool was_added = true;
+
+				add_or_remove_simulated_object(was_added, SimulatedObjectInfo(id, peer_info.peer));
 			}
 		}
 	}
 
-	{
-		// Fetch the simulated object info for all the objects not controlled by a peer.
-		// Fetch the update type (FULL | PARTIAL)
-		bool is_simulated_object_array_full_update;
-		p_snapshot.read(is_simulated_object_array_full_update);
-		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `is_full_update` boolean expected is not set.");
-
-		if (is_simulated_object_array_full_update) {
-			// Fetch the array.
-			while (true) {
-				ObjectNetId id;
-				p_snapshot.read(id.id);
-				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `ObjectNetId` failed.");
-
-				if (id == ObjectNetId::NONE) {
-					// The end.
-					break;
-				}
-
-				sd_simulated_objects_full_array.push_back(SimulatedObjectInfo(id, -1));
-			}
-
-			p_simulated_objects_parse(p_user_pointer, std::move(sd_simulated_objects_full_array));
-		} else {
-			// In normal conditions this can't trigger because the generator
-			// can't compose a snapshot that has both full array and incremental changes.
-			NS_ENSURE_V_MSG(sd_simulated_objects_full_array.empty(), false, "This snapshot is corrupted because the sd_simulated_object_full_array is expected to be empty at this point.");
-
-			// Fetch the array.
-			while (true) {
-				bool has_net_id;
-				p_snapshot.read(has_net_id);
-				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `has_net_id` failed.");
-
-				if (!has_net_id) {
-					// We reached the end of the array.
-					break;
-				}
-
-				ObjectNetId id;
-				p_snapshot.read(id.id);
-				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `ObjectNetId` failed.");
+	// The simulated object info for all the objects not controlled by a peer.
+	if (header->is_simulated_objects_full_update) {
+		for (ObjectNetId id : header->simulated_objects) {
+			parse_simulated_objects.push_back(SimulatedObjectInfo(id, -1));
+		}
 
-				bool was_added;
-				p_snapshot.read(was_added);
-				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `was_added` failed.");
+		// Swaps the vectors, so both keep their memory.
+		std::swap(r_snapshot.simulated_objects, parse_simulated_objects);
+		r_snapshot.is_just_updated_simulated_objects = true;
+	} else {
+		// In normal conditions this can't trigger because the generator
+		// can't compose a snapshot that has both full array and incremental changes.
+		NS_ENSURE_V_MSG(parse_simulated_objects.empty(), false, "This snapshot is corrupted because the parse_simulated_objects is expected to be empty at this point.");
 
-				p_simulated_object_add_or_remove_parse(p_user_pointer, was_added, SimulatedObjectInfo(id, -1));
-			}
+		for (ObjectNetId id : header->added_simulated_objects) {
+			add_or_remove_simulated_object(true, SimulatedObjectInfo(id, -1));
+		}
+		for (ObjectNetId id : header->removed_simulated_objects) {
+			add_or_remove_simulated_object(false, SimulatedObjectInfo(id, -1));
 		}
 	}
 
-	{
-		bool has_custom_data = false;
-		p_snapshot.read(has_custom_data);
-		if (has_custom_data) {
-			VarData vd;
-			SceneSynchronizerBase::var_data_decode(vd, p_snapshot, scene_synchronizer->get_synchronizer_manager().snapshot_get_custom_data_type());
-			p_custom_data_parse(p_user_pointer, std::move(vd));
-		}
+	if (header->has_custom_data) {
+		r_snapshot.custom_data = std::move(header->custom_data);
+		r_snapshot.has_custom_data = true;
+		r_snapshot.is_just_updated_custom_data = true;
 	}
 
+	std::size_t decoded_object_index = 0;
 	while (true) {
 		// First extract the object data
+		SyncDataObjectHeader *object_header = &parse_object_header;
+		DecodedSyncDataObject *decoded_object = nullptr;
+		if (p_decoded_snapshot) {
+			if (decoded_object_index >= p_decoded_snapshot->objects_count) {
+				// All the decoded Objects fetched.
+				break;
+			}
+			decoded_object = &p_decoded_snapshot->objects[decoded_object_index];
+			decoded_object_index += 1;
+			object_header = &decoded_object->header;
+			p_snapshot.seek(object_header->vars_bit_offset);
+		} else {
+			if (!decode_sync_data_object_header(p_snapshot, parse_object_header)) {
+				return false;
+			}
+		}
+
 		ObjectData *synchronizer_object_data = nullptr;
-		ObjectNetId net_id = ObjectNetId::NONE;
+		const ObjectNetId net_id = object_header->net_id;
 		{
-			p_snapshot.read(net_id.id);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The NetId was expected at this point.");
-
 			if (net_id == ObjectNetId::NONE) {
 				// All the Objects fetched.
 				break;
 			}
 
-			// Fetch the object name
-			bool has_object_name = false;
-			p_snapshot.read(has_object_name);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `has_object_name` was expected at this point.");
-
-			std::string object_name;
+			const bool has_object_name = object_header->has_object_name;
+			std::string &object_name = object_header->object_name;
 			if (has_object_name) {
-				// Extract the object name
-				p_snapshot.read(object_name);
-				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `object_name` was expected at this point.");
-
 				// Associate the ID with the path.
 				MapFunc::assign(objects_names, net_id, object_name);
+			} else {
+				object_name.clear();
 			}
 
-			// Fetch the NetSchemeID
-			bool has_scheme_id;
-			p_snapshot.read(has_scheme_id);
-			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `has_scheme_id` was expected here.");
-			SchemeId scheme_id;
+			bool has_scheme_id = object_header->has_scheme_id;
+			SchemeId scheme_id = object_header->scheme_id;
 			if (has_scheme_id) {
-				p_snapshot.read(scheme_id.id);
-				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `scheme_id` was expected here.");
-
 				// Associate the ID with the path.
 				MapFunc::assign(objects_schemes_id, net_id, scheme_id);
 			}
@@ -4779,92 +7022,378 @@ bool ClientSynchronizer::parse_sync_data(
 			}
 		}
 
-		const bool skip_object = synchronizer_object_data == nullptr;
+		const bool skip_object = synchronizer_object_data == nullptr;
+
+		if (!skip_object) {
+#ifdef NS_DEBUG_ENABLED
+			// At this point the ID is never ObjectNetId::NONE thanks to the above
+			// mechanism.
+			NS_ASSERT_COND(synchronizer_object_data->get_net_id() != ObjectNetId::NONE);
+#endif
+
+			r_snapshot.just_updated_object_vars.push_back(synchronizer_object_data->get_net_id());
+
+			// make sure this node is part of the server node too.
+			if (uint32_t(r_snapshot.objects.size()) <= synchronizer_object_data->get_net_id().id) {
+				r_snapshot.objects.resize(synchronizer_object_data->get_net_id().id + 1);
+			}
+		}
+
+		// Now it's time to fetch the variables.
+		const std::uint16_t vars_size_in_bits = object_header->vars_size_in_bits;
+		const int offset_after_vars_reading = object_header->vars_bit_offset + vars_size_in_bits;
+
+		if (skip_object) {
+			if (net_id != ObjectNetId::NONE) {
+				// Store the snapshot information so we can use them to sync the
+				// late registered object as soon as it's registered.
+				// Reuses the buffers of the released pending snapshots.
+				ObjectPendingSnapshots &pending = fetch_object_pending_snapshots(net_id);
+				if (pending.snapshots.size() <= pending.count) {
+					pending.snapshots.resize(pending.count + 1);
+					pending.state_hashing.resize(pending.count + 1);
+				}
+				pending.state_hashing[pending.count] = header->state_hashing;
+				DataBuffer &object_snapshot_buffer = pending.snapshots[pending.count];
+				object_snapshot_buffer.begin_write(get_debugger(), 0);
+				const bool slicing_success = p_snapshot.slice(object_snapshot_buffer, p_snapshot.get_bit_offset(), vars_size_in_bits);
+#if NS_DEBUG_ENABLED
+				if (scene_synchronizer->pedantic_checks) {
+					NS_ASSERT_COND(slicing_success);
+					NS_ASSERT_COND(object_snapshot_buffer.get_bit_offset() == vars_size_in_bits);
+				}
+#endif
+				if (!slicing_success || object_snapshot_buffer.get_bit_offset() != vars_size_in_bits) {
+					get_debugger().print(ERROR, "The received snapshot is corrupted because it was impossible to properly slice the Object info using the encoded size `" + std::to_string(vars_size_in_bits) + "`. This should never happen.");
+					return false;
+				}
+				// Store the extracted object info.
+				pending.count += 1;
+				get_debugger().print(INFO, "The object info snapshot was sliced and stored into the pending snapshots. ObjectID: " + std::to_string(net_id.id));
+			} else {
+				// This is not possible because NetID NONE signals the end of the
+				// buffer and this is never reached.
+				NS_ASSERT_NO_ENTRY_MSG("The parse_sync_data function was unable to store the object information for a late restore because the NetId is NONE.");
+			}
+
+			// Skip the object data now.
+			p_snapshot.seek(offset_after_vars_reading);
+		} else if (
+				decoded_object &&
+				decoded_object->decoded_for == synchronizer_object_data->get_local_id() &&
+				p_decoded_snapshot->schemes_version == snapshot_decoder.schemes_version &&
+				!snapshot_decoder_schemes_dirty) {
+			// The vars were decoded by the `SnapshotDecoder` and the objects
+			// didn't change since.
+			ObjectDataSnapshot &object_snapshot = r_snapshot.objects[synchronizer_object_data->get_net_id().id];
+			for (std::size_t i = 0; i < decoded_object->object.vars.size(); i++) {
+				std::optional<VarData> &value = decoded_object->object.vars[i];
+				if (value.has_value()) {
+					if (synchronizer_object_data->vars.size() != object_snapshot.vars.size()) {
+						object_snapshot.vars.resize(synchronizer_object_data->vars.size());
+					}
+					object_snapshot.vars[i].emplace(std::move(value.value()));
+				}
+			}
+			if (decoded_object->has_state_hash) {
+				r_snapshot.just_received_state_hashes.push_back(std::make_pair(synchronizer_object_data->get_net_id(), decoded_object->state_hash));
+			}
+			p_snapshot.seek(offset_after_vars_reading);
+			snapshot_decoder_applied_objects_count += 1;
+		} else {
+			bool has_state_hash = false;
+			std::uint32_t state_hash = 0;
+			const bool object_data_parsing_state = parse_sync_data_object_info(
+					p_snapshot,
+					*synchronizer_object_data,
+					r_snapshot.objects[synchronizer_object_data->get_net_id().id],
+					false,
+					header->state_hashing,
+					has_state_hash,
+					state_hash);
+			if (has_state_hash) {
+				r_snapshot.just_received_state_hashes.push_back(std::make_pair(synchronizer_object_data->get_net_id(), state_hash));
+			}
+
+			if make_unlikely(scene_synchronizer->pedantic_checks) {
+				const int buffer_offset = p_snapshot.get_bit_offset();
+				NS_ASSERT_COND(object_data_parsing_state);
+				NS_ASSERT_COND_MSG(buffer_offset == offset_after_vars_reading, "The snapshot is corrupted because the data_object parsing failed for the object: " + synchronizer_object_data->get_object_name() + " - NetId: " + std::to_string(synchronizer_object_data->get_net_id().id));
+			} else {
+				const int buffer_offset = p_snapshot.get_bit_offset();
+				if (!object_data_parsing_state || buffer_offset != offset_after_vars_reading) {
+					get_debugger().print(ERROR,
+							"The snapshot is corrupted because the data_object parsing failed for the object: " + synchronizer_object_data->get_object_name() + " - NetId: " + std::to_string(synchronizer_object_data->get_net_id().id) + " - SchemeID: " + std::to_string(synchronizer_object_data->get_scheme_id().id) + " - Size in bits: " + std::to_string(vars_size_in_bits) + " - Expected offset: " + std::to_string(offset_after_vars_reading) + " - Current offset: " + std::to_string(buffer_offset));
+					r_parsing_errors.objects += 1;
+
+					// Do not mark this object as updated, it has corrupted values.
+					const ObjectNetId failed_net_id = synchronizer_object_data->get_net_id();
+					VecFunc::remove_unordered(r_snapshot.just_updated_object_vars, failed_net_id);
+					if (has_state_hash) {
+						r_snapshot.just_received_state_hashes.pop_back();
+					}
+
+					// Resets the objects to the previous snapshots values.
+					if (uint32_t(last_received_snapshot.objects.size()) > failed_net_id.id) {
+						r_snapshot.objects[failed_net_id.id].copy(last_received_snapshot.objects[failed_net_id.id]);
+					} else {
+						r_snapshot.objects[failed_net_id.id].clear();
+					}
+
+					// Set the buffer cursor to the correct offset to keep
+					// reading the data for the other objects.
+					p_snapshot.seek(offset_after_vars_reading);
+				}
+			}
+		}
+	}
+
+	if (p_decoded_snapshot && !p_decoded_snapshot->is_objects_decoded) {
+		// The errors were already reported by the `SnapshotDecoder`.
+		return false;
+	}
+
+	// Updates the frames index. The map is updated in place, so the nodes
+	// are reallocated only when the peers change.
+	for (auto it = r_snapshot.peers_frames_index.begin(); it != r_snapshot.peers_frames_index.end();) {
+		bool is_parsed = false;
+		for (const auto &[peer, frame_index] : parse_peers_frame_index) {
+			if (peer == it->first) {
+				is_parsed = true;
+				break;
+			}
+		}
+		if (is_parsed) {
+			it++;
+		} else {
+			it = r_snapshot.peers_frames_index.erase(it);
+		}
+	}
+	for (const auto &[peer, frame_index] : parse_peers_frame_index) {
+		r_snapshot.peers_frames_index[peer] = FrameIndexWithMeta(p_is_server_snapshot, frame_index);
+	}
+
+	// Extract the InputID for the controller processed as Authority by this client.
+	r_snapshot.input_id = player_controller ? MapFunc::at(r_snapshot.peers_frames_index, player_controller->get_authority_peer(), FrameIndexWithMeta()).frame_index : FrameIndex::NONE;
+
+	return true;
+}
+
+bool ClientSynchronizer::decode_sync_data_header(
+		DataBuffer &p_snapshot,
+		std::uint8_t p_custom_data_type,
+		SyncDataHeader &r_header) const {
+	{
+		// Fetch the update mode of this snapshot.
+		p_snapshot.read(r_header.is_partial_update);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `is_partial_update` boolean expected is not set.");
+	}
+
+	{
+		// Fetch the global frame index
+		p_snapshot.read(r_header.global_frame_index.id);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `GlobalFrameIndex` expected is not set.");
+	}
+
+	{
+		// Fetch the adaptive notify timespan
+		r_header.is_adaptive_notify_timespan = false;
+		p_snapshot.read(r_header.is_adaptive_notify_timespan);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `is_adaptive_notify_timespan` boolean expected is not set.");
+		if (r_header.is_adaptive_notify_timespan) {
+			r_header.notify_timespan_ms = p_snapshot.read_uint(DataBuffer::COMPRESSION_LEVEL_2);
+			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `notify_timespan` expected is not set.");
+		}
+	}
+
+	{
+		r_header.state_hashing = false;
+		p_snapshot.read(r_header.state_hashing);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `state_hashing` boolean expected is not set.");
+	}
+
+	// The ObjectNetId lists are networked as sets: check `encode_object_net_id_set`.
+	{
+		// Fetch the peer information
+		r_header.peers_count = 0;
+		while (true) {
+			bool has_next_peer_info = false;
+			p_snapshot.read(has_next_peer_info);
+			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `has_next_peer_info` failed.");
+
+			if (!has_next_peer_info) {
+				// Array is empty now.
+				break;
+			}
+
+			// The peers info are reused.
+			if (r_header.peers.size() <= r_header.peers_count) {
+				r_header.peers.resize(r_header.peers_count + 1);
+			}
+			SyncDataHeader::PeerInfo &peer_info = r_header.peers[r_header.peers_count];
+			r_header.peers_count += 1;
+
+			// Fetch the peer
+			p_snapshot.read(peer_info.peer);
+			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `peer` failed.");
+
+			// Fetch the frame index
+			p_snapshot.read(peer_info.frame_index.id);
+			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching the peer `frame_index` failed.");
+
+			// Fetch the latency
+			p_snapshot.read(peer_info.has_latency);
+			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching the peer `has_latency` failed.");
+
+			if (peer_info.has_latency) {
+				p_snapshot.read(peer_info.compressed_latency);
+				NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as fetching `compressed_latency` failed.");
+			}
+
+			// Fetch the simulated object info for all the objects controlled by this peer.
+			// Fetch the update type (FULL | INCREMENTAL)
+			p_snapshot.read(peer_info.is_simulated_objects_full_update);
+			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `is_full_update` boolean expected is not set.");
+
+			// Fetch the set.
+			peer_info.simulated_objects.clear();
+			NS_ENSURE_V_MSG(decode_object_net_id_set(peer_info.simulated_objects, p_snapshot), false, "This snapshot is corrupted as fetching the `ObjectNetId` set failed.");
+		}
+	}
+
+	{
+		// Fetch the simulated object info for all the objects not controlled by a peer.
+		// Fetch the update type (FULL | PARTIAL)
+		p_snapshot.read(r_header.is_simulated_objects_full_update);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `is_full_update` boolean expected is not set.");
 
-		if (!skip_object) {
-#ifdef NS_DEBUG_ENABLED
-			// At this point the ID is never ObjectNetId::NONE thanks to the above
-			// mechanism.
-			NS_ASSERT_COND(synchronizer_object_data->get_net_id() != ObjectNetId::NONE);
-#endif
+		r_header.simulated_objects.clear();
+		r_header.added_simulated_objects.clear();
+		r_header.removed_simulated_objects.clear();
+		if (r_header.is_simulated_objects_full_update) {
+			// Fetch the set.
+			NS_ENSURE_V_MSG(decode_object_net_id_set(r_header.simulated_objects, p_snapshot), false, "This snapshot is corrupted as fetching the `ObjectNetId` set failed.");
+		} else {
+			// Fetch the set of the added objects, then the set of the removed ones.
+			NS_ENSURE_V_MSG(decode_object_net_id_set(r_header.added_simulated_objects, p_snapshot), false, "This snapshot is corrupted as fetching the `ObjectNetId` set failed.");
+			NS_ENSURE_V_MSG(decode_object_net_id_set(r_header.removed_simulated_objects, p_snapshot), false, "This snapshot is corrupted as fetching the `ObjectNetId` set failed.");
+		}
+	}
 
-			p_object_parse(p_user_pointer, synchronizer_object_data);
+	{
+		r_header.has_custom_data = false;
+		p_snapshot.read(r_header.has_custom_data);
+		if (r_header.has_custom_data) {
+			SceneSynchronizerBase::var_data_decode(r_header.custom_data, p_snapshot, p_custom_data_type);
 		}
+	}
 
-		// Now it's time to fetch the variables.
-		std::uint16_t vars_size_in_bits;
-		p_snapshot.read(vars_size_in_bits);
-		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `vars_count` was expected here.");
+	return true;
+}
 
-		const int offset_after_vars_reading = p_snapshot.get_bit_offset() + vars_size_in_bits;
+bool ClientSynchronizer::decode_sync_data_object_header(
+		DataBuffer &p_snapshot,
+		SyncDataObjectHeader &r_object_header) const {
+	r_object_header.net_id = ObjectNetId::NONE;
+	p_snapshot.read(r_object_header.net_id.id);
+	NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The NetId was expected at this point.");
 
-		if (skip_object) {
-			if (net_id != ObjectNetId::NONE) {
-				// Store the snapshot information so we can use them to sync the
-				// late registered object as soon as it's registered.
-				DataBuffer object_snapshot_buffer;
-				object_snapshot_buffer.begin_write(get_debugger(), 0);
-				const bool slicing_success = p_snapshot.slice(object_snapshot_buffer, p_snapshot.get_bit_offset(), vars_size_in_bits);
-#if NS_DEBUG_ENABLED
-				if (scene_synchronizer->pedantic_checks) {
-					NS_ASSERT_COND(slicing_success);
-					NS_ASSERT_COND(object_snapshot_buffer.get_bit_offset() == vars_size_in_bits);
-				}
-#endif
-				if (!slicing_success || object_snapshot_buffer.get_bit_offset() != vars_size_in_bits) {
-					get_debugger().print(ERROR, "The received snapshot is corrupted because it was impossible to properly slice the Object info using the encoded size `" + std::to_string(vars_size_in_bits) + "`. This should never happen.");
-					return false;
-				}
-				// Store the extracted object info.
-				std::vector<DataBuffer> &pending_snapshots = MapFunc::insert_if_new(objects_pending_snapshots, net_id, std::vector<DataBuffer>())->second;
-				pending_snapshots.push_back(std::move(object_snapshot_buffer));
-				get_debugger().print(INFO, "The object info snapshot was sliced and stored into the pending snapshots. ObjectID: " + std::to_string(net_id.id));
-			} else {
-				// This is not possible because NetID NONE signals the end of the
-				// buffer and this is never reached.
-				NS_ASSERT_NO_ENTRY_MSG("The parse_sync_data function was unable to store the object information for a late restore because the NetId is NONE.");
-			}
+	if (r_object_header.net_id == ObjectNetId::NONE) {
+		// All the Objects fetched.
+		return true;
+	}
 
-			// Skip the object data now.
-			p_snapshot.seek(offset_after_vars_reading);
-		} else {
-			const bool object_data_parsing_state = parse_sync_data_object_info(
-					p_snapshot,
-					p_user_pointer,
-					*synchronizer_object_data,
-					p_variable_parse,
-					p_scheduled_procedure_parse);
+	// Fetch the object name
+	r_object_header.has_object_name = false;
+	p_snapshot.read(r_object_header.has_object_name);
+	NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `has_object_name` was expected at this point.");
 
-			if make_unlikely(scene_synchronizer->pedantic_checks) {
-				const int buffer_offset = p_snapshot.get_bit_offset();
-				NS_ASSERT_COND(object_data_parsing_state);
-				NS_ASSERT_COND_MSG(buffer_offset == offset_after_vars_reading, "The snapshot is corrupted because the data_object parsing failed for the object: " + synchronizer_object_data->get_object_name() + " - NetId: " + std::to_string(synchronizer_object_data->get_net_id().id));
-			} else {
-				const int buffer_offset = p_snapshot.get_bit_offset();
-				if (!object_data_parsing_state || buffer_offset != offset_after_vars_reading) {
-					get_debugger().print(ERROR,
-							"The snapshot is corrupted because the data_object parsing failed for the object: " + synchronizer_object_data->get_object_name() + " - NetId: " + std::to_string(synchronizer_object_data->get_net_id().id) + " - SchemeID: " + std::to_string(synchronizer_object_data->get_scheme_id().id) + " - Size in bits: " + std::to_string(vars_size_in_bits) + " - Expected offset: " + std::to_string(offset_after_vars_reading) + " - Current offset: " + std::to_string(buffer_offset));
-					r_parsing_errors.objects += 1;
-					p_notify_parsing_failed_for_object(p_user_pointer, *synchronizer_object_data);
-					// Set the buffer cursor to the correct offset to keep
-					// reading the data for the other objects.
-					p_snapshot.seek(offset_after_vars_reading);
-				}
-			}
+	if (r_object_header.has_object_name) {
+		// Extract the object name
+		p_snapshot.read(r_object_header.object_name);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `object_name` was expected at this point.");
+	}
+
+	// Fetch the NetSchemeID
+	r_object_header.has_scheme_id = false;
+	p_snapshot.read(r_object_header.has_scheme_id);
+	NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `has_scheme_id` was expected here.");
+	r_object_header.scheme_id = SchemeId::DEFAULT;
+	if (r_object_header.has_scheme_id) {
+		p_snapshot.read(r_object_header.scheme_id.id);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `scheme_id` was expected here.");
+	}
+
+	// Fetch the size of the variables.
+	p_snapshot.read(r_object_header.vars_size_in_bits);
+	NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `vars_count` was expected here.");
+	r_object_header.vars_bit_offset = p_snapshot.get_bit_offset();
+
+	return true;
+}
+
+bool ClientSynchronizer::decode_sync_data_object_vars(
+		DataBuffer &p_snapshot,
+		bool p_state_hashing,
+		const SnapshotDecoderObjectScheme &p_scheme,
+		DecodedSyncDataObject &r_object) {
+	// NOTE: This is the same format parsed by `parse_sync_data_object_info`,
+	//       for the objects without scheduled procedures.
+	r_object.has_state_hash = false;
+	if (p_state_hashing) {
+		p_snapshot.read(r_object.has_state_hash);
+		if (p_snapshot.is_buffer_failed()) {
+			return false;
+		}
+	}
+	if (r_object.has_state_hash) {
+		p_snapshot.read(r_object.state_hash);
+		if (p_snapshot.is_buffer_failed()) {
+			return false;
 		}
 	}
 
-	NS_ENSURE_V_MSG(p_peers_frame_index_parse(p_user_pointer, std::move(frames_index)), false, "This snapshot is corrupted as the frame index parsing failed.");
+	r_object.object.vars.resize(p_scheme.vars_type.size());
+	for (std::size_t i = 0; i < p_scheme.vars_type.size(); i++) {
+		std::optional<VarData> &value = r_object.object.vars[i];
+		value.reset();
+
+		bool var_has_value = false;
+		p_snapshot.read(var_has_value);
+		if (p_snapshot.is_buffer_failed()) {
+			return false;
+		}
+
+		if (var_has_value) {
+			value.emplace();
+			SceneSynchronizerBase::var_data_decode(value.value(), p_snapshot, p_scheme.vars_type[i]);
+			if (p_snapshot.is_buffer_failed()) {
+				return false;
+			}
+		}
+	}
 
 	return true;
 }
 
 bool ClientSynchronizer::parse_sync_data_object_info(
 		DataBuffer &p_snapshot,
-		void *p_user_pointer,
 		ObjectData &p_object_data,
-		void (*p_variable_parse)(void *p_user_pointer, ObjectData &p_object_data, VarId p_var_id, VarData &&p_value),
-		void (*p_scheduled_procedure_parse)(void *p_user_pointer, ObjectData &p_object_data, ScheduledProcedureId p_procedure_id, ScheduledProcedureSnapshot &&p_value)) {
+		ObjectDataSnapshot &r_object_snapshot,
+		bool p_apply_values,
+		bool p_state_hashing,
+		bool &r_has_state_hash,
+		std::uint32_t &r_state_hash) {
+	r_has_state_hash = false;
+	if (p_state_hashing) {
+		p_snapshot.read(r_has_state_hash);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `has_state_hash` was expected at this point. Object: `" + p_object_data.get_object_name() + "`");
+	}
+	if (r_has_state_hash) {
+		p_snapshot.read(r_state_hash);
+		NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `state_hash` was expected at this point. Object: `" + p_object_data.get_object_name() + "`");
+	}
+
 	for (auto &var_desc : p_object_data.vars) {
 		bool var_has_value = false;
 		p_snapshot.read(var_has_value);
@@ -4875,12 +7404,21 @@ bool ClientSynchronizer::parse_sync_data_object_info(
 			SceneSynchronizerBase::var_data_decode(value, p_snapshot, var_desc.type);
 			NS_ENSURE_V_MSG(!p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `variable value` was expected at this point. Object: `" + p_object_data.get_object_name() + "` Var: `" + var_desc.var.name + "`");
 
-			// Variable fetched, now parse this variable.
-			p_variable_parse(
-					p_user_pointer,
-					p_object_data,
-					var_desc.id,
-					std::move(value));
+			if (p_object_data.vars.size() != r_object_snapshot.vars.size()) {
+				// The parser may have added a variable, so make sure to resize the vars array.
+				r_object_snapshot.vars.resize(p_object_data.vars.size());
+			}
+
+			if (p_apply_values) {
+				// Updates the actual value.
+				var_desc.set_func(
+						scene_synchronizer->get_synchronizer_manager(),
+						p_object_data.app_object_handle,
+						var_desc.var.name,
+						value);
+			}
+
+			r_object_snapshot.vars[var_desc.id.id].emplace(std::move(value));
 		}
 	}
 
@@ -4911,7 +7449,17 @@ bool ClientSynchronizer::parse_sync_data_object_info(
 				}
 			}
 
-			p_scheduled_procedure_parse(p_user_pointer, p_object_data, procedure_id, std::move(procedure_snapshot));
+			if (p_object_data.get_scheduled_procedures().size() != r_object_snapshot.procedures.size()) {
+				// The parser may have added a procedure, so make sure to resize the procedure array.
+				r_object_snapshot.procedures.resize(p_object_data.get_scheduled_procedures().size());
+			}
+
+			if (p_apply_values) {
+				// Updates the actual value.
+				p_object_data.scheduled_procedure_reset_to(procedure_id, procedure_snapshot);
+			}
+
+			r_object_snapshot.procedures[procedure_id.id] = std::move(procedure_snapshot);
 		}
 	}
 
@@ -4937,6 +7485,10 @@ void ClientSynchronizer::set_enabled(bool p_enabled) {
 }
 
 void ClientSynchronizer::receive_trickled_sync_data(const std::vector<std::uint8_t> &p_data) {
+	// The snapshots received before this data are processed first, to
+	// preserve the receive order.
+	snapshot_decoder_flush();
+
 	DataBuffer future_epoch_buffer(BitArray(get_debugger(), p_data));
 	future_epoch_buffer.begin_read(get_debugger());
 
@@ -5095,7 +7647,7 @@ void ClientSynchronizer::remove_object_from_trickled_sync(NS::ObjectData *p_obje
 	VecFunc::remove_unordered(trickled_sync_array, TrickledSyncInterpolationData(p_object_data, get_debugger()));
 }
 
-bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot, bool p_is_server_snapshot) {
+bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot, bool p_is_server_snapshot, SnapshotDecodeJob *p_decoded_snapshot) {
 	if (want_to_enable) {
 		if (enabled) {
 			scene_synchronizer->get_debugger().print(ERROR, "At this point the client is supposed to be disabled. This is a bug that must be solved.", scene_synchronizer->get_network_interface().get_owner_name());
@@ -5108,9 +7660,11 @@ bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot, bool p_is_server
 
 	need_full_snapshot_notified = false;
 
-	RollingUpdateSnapshot received_snapshot;
+	// Reuses the memory of the previously received snapshot.
 	received_snapshot.copy(last_received_snapshot);
+	received_snapshot.clear_update_info();
 	received_snapshot.input_id = FrameIndex::NONE;
+	received_snapshot.state_hash_verified_objects.clear();
 
 #ifdef NS_DEBUG_ENABLED
 	// Ensure these properties are not set at this point.
@@ -5120,158 +7674,14 @@ bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot, bool p_is_server
 	NS_ASSERT_COND(received_snapshot.just_updated_object_vars.size() == 0);
 #endif
 
-	struct ParseData {
-		RollingUpdateSnapshot &snapshot;
-		const RollingUpdateSnapshot &last_received_snapshot;
-		PeerNetworkedController *player_controller;
-		SceneSynchronizerBase *scene_synchronizer;
-		ClientSynchronizer *client_synchronizer;
-		bool is_server_snapshot;
-	};
-
-	ParseData parse_data{
-		received_snapshot,
-		last_received_snapshot,
-		player_controller,
-		scene_synchronizer,
-		this,
-		p_is_server_snapshot
-	};
-
 	ClientParsingErrors parsing_errors;
 
 	const bool success = parse_sync_data(
 			p_snapshot,
-			&parse_data,
+			p_is_server_snapshot,
+			received_snapshot,
 			parsing_errors,
-
-			// Failed parsing for object.
-			[](void *p_user_pointer, ObjectData &p_object_data) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-
-				// Do not mark this object as updated, it has corrupted values.
-				VecFunc::remove_unordered(pd->snapshot.just_updated_object_vars, p_object_data.get_net_id());
-
-				// Resets the objects to the previous snapshots values.
-				if (uint32_t(pd->snapshot.objects.size()) > p_object_data.get_net_id().id) {
-					if (uint32_t(pd->last_received_snapshot.objects.size()) > p_object_data.get_net_id().id) {
-						pd->snapshot.objects[p_object_data.get_net_id().id].copy(pd->last_received_snapshot.objects[p_object_data.get_net_id().id]);
-					} else {
-						pd->snapshot.objects[p_object_data.get_net_id().id].clear();
-					}
-				}
-			},
-
-			// Notify update mode:
-			[](void *p_user_pointer, bool p_is_partial_update) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-				// When the partial update is set to true the server didn't
-				// send all the changed objects of the SyncGroup.
-				pd->snapshot.was_partially_updated = p_is_partial_update;
-			},
-
-			[](void *p_user_pointer, GlobalFrameIndex p_global_frame_index) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-				pd->snapshot.global_frame_index = p_global_frame_index;
-			},
-
-			// Custom data:
-			[](void *p_user_pointer, VarData &&p_custom_data) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-				pd->snapshot.has_custom_data = true;
-				pd->snapshot.custom_data = std::move(p_custom_data);
-				pd->snapshot.is_just_updated_custom_data = true;
-			},
-
-			// Parse object:
-			[](void *p_user_pointer, ObjectData *p_object_data) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-
-#ifdef NS_DEBUG_ENABLED
-				// This function should never receive undefined IDs.
-				NS_ASSERT_COND(p_object_data->get_net_id() != ObjectNetId::NONE);
-#endif
-
-				pd->snapshot.just_updated_object_vars.push_back(p_object_data->get_net_id());
-
-				// make sure this node is part of the server node too.
-				if (uint32_t(pd->snapshot.objects.size()) <= p_object_data->get_net_id().id) {
-					pd->snapshot.objects.resize(p_object_data->get_net_id().id + 1);
-				}
-			},
-
-			// Parse peer frames index
-			[](void *p_user_pointer, std::map<int, FrameIndexWithMeta> &&p_peers_frames_index) -> bool {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-
-				// Extract the InputID for the controller processed as Authority by this client.
-				const FrameIndexWithMeta authority_frame_index_meta = pd->player_controller ? MapFunc::at(p_peers_frames_index, pd->player_controller->get_authority_peer(), FrameIndexWithMeta()) : FrameIndexWithMeta();
-
-				// Store it.
-				pd->snapshot.input_id = authority_frame_index_meta.frame_index;
-
-				for (auto &[peer, meta] : p_peers_frames_index) {
-					meta.is_server_validated = pd->is_server_snapshot;
-				}
-
-				// Store the frames index.
-				pd->snapshot.peers_frames_index = std::move(p_peers_frames_index);
-
-#ifdef NS_DEBUG_ENABLED
-				// Assert that the FrameIndex were properly moved.
-				for (const auto &[peer, meta] : pd->snapshot.peers_frames_index) {
-					NS_ASSERT_COND(meta.is_server_validated == pd->is_server_snapshot);
-				}
-#endif
-
-				return true;
-			},
-
-			// Parse variable:
-			[](void *p_user_pointer, ObjectData &p_object_data, VarId p_var_id, VarData &&p_value) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-
-				if (p_object_data.vars.size() != uint32_t(pd->snapshot.objects[p_object_data.get_net_id().id].vars.size())) {
-					// The parser may have added a variable, so make sure to resize the vars array.
-					pd->snapshot.objects[p_object_data.get_net_id().id].vars.resize(p_object_data.vars.size());
-				}
-
-				if (pd->snapshot.objects[p_object_data.get_net_id().id].vars.size() > p_var_id.id) {
-					pd->snapshot.objects[p_object_data.get_net_id().id].vars[p_var_id.id].emplace(std::move(p_value));
-				}
-			},
-
-			// Parse scheduled procedure:
-			[](void *p_user_pointer, ObjectData &p_object_data, ScheduledProcedureId p_procedure_id, ScheduledProcedureSnapshot &&p_procedure_snapshot) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-
-				if (p_object_data.get_scheduled_procedures().size() != uint32_t(pd->snapshot.objects[p_object_data.get_net_id().id].procedures.size())) {
-					// The parser may have added a procedure, so make sure to resize the procedure array.
-					pd->snapshot.objects[p_object_data.get_net_id().id].procedures.resize(p_object_data.get_scheduled_procedures().size());
-				}
-
-				if (pd->snapshot.objects[p_object_data.get_net_id().id].procedures.size() > p_procedure_id.id) {
-					pd->snapshot.objects[p_object_data.get_net_id().id].procedures[p_procedure_id.id] = std::move(p_procedure_snapshot);
-				}
-			},
-
-			// Parse object activation:
-			[](void *p_user_pointer, bool p_add, SimulatedObjectInfo &&p_simulated_objects) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-				if (p_add) {
-					VecFunc::insert_or_update(pd->snapshot.simulated_objects, std::move(p_simulated_objects));
-				} else {
-					VecFunc::remove_unordered(pd->snapshot.simulated_objects, p_simulated_objects);
-				}
-				pd->snapshot.is_just_updated_simulated_objects = true;
-			},
-
-			// Parse objects activation:
-			[](void *p_user_pointer, std::vector<SimulatedObjectInfo> &&p_simulated_objects) {
-				ParseData *pd = static_cast<ParseData *>(p_user_pointer);
-				pd->snapshot.simulated_objects = std::move(p_simulated_objects);
-				pd->snapshot.is_just_updated_simulated_objects = true;
-			});
+			p_decoded_snapshot);
 
 	if (!success || parsing_errors.objects > 0 || parsing_errors.missing_object_names > 0) {
 		snapshot_parsing_failures += 1;
@@ -5308,7 +7718,8 @@ bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot, bool p_is_server
 		scene_synchronizer->get_debugger().print(ERROR, "The player controller (" + std::to_string(player_controller->get_authority_peer()) + ") was not part of the received snapshot, this happens when the server destroys the peer controller.");
 	}
 
-	last_received_snapshot = std::move(received_snapshot);
+	// Swaps the snapshots, so the next parsing reuses the memory.
+	std::swap(last_received_snapshot, received_snapshot);
 
 	snapshot_parsing_failures = 0;
 
@@ -5357,75 +7768,33 @@ void ClientSynchronizer::finalize_object_data_synchronization(ObjectData &p_obje
 		NS_ASSERT_COND(p_object_data.get_scheme_id() == SchemeId::DEFAULT);
 	}
 
-	std::vector<DataBuffer> *pending_snapshots = MapFunc::get_or_null(objects_pending_snapshots, p_object_data.get_net_id());
-	if (!pending_snapshots || pending_snapshots->size() <= 0) {
+	ObjectPendingSnapshots *pending = get_object_pending_snapshots(p_object_data.get_net_id());
+	if (!pending || pending->count <= 0) {
 		// Nothing pending to initialize.
 		return;
 	}
 
-	struct PendingObjectSnapshotsParseData {
-		RollingUpdateSnapshot &snapshot;
-		SceneSynchronizerBase *scene_synchronizer;
-		ClientSynchronizer *client_synchronizer;
-	};
-
-	PendingObjectSnapshotsParseData parse_data{
-		last_received_snapshot,
-		scene_synchronizer,
-		this,
-	};
-
 	// Make sure this node is part of the server node too.
-	if (uint32_t(parse_data.snapshot.objects.size()) <= p_object_data.get_net_id().id) {
-		parse_data.snapshot.objects.resize(p_object_data.get_net_id().id + 1);
+	if (uint32_t(last_received_snapshot.objects.size()) <= p_object_data.get_net_id().id) {
+		last_received_snapshot.objects.resize(p_object_data.get_net_id().id + 1);
 	}
 
-	for (DataBuffer &snapshot : *pending_snapshots) {
+	for (std::size_t i = 0; i < pending->count; i++) {
+		DataBuffer &snapshot = pending->snapshots[i];
 		snapshot.begin_read(get_debugger());
+
+		// Updates the object values and saves them into the local snapshot,
+		// so incremental updates works fine.
+		bool has_state_hash = false;
+		std::uint32_t state_hash = 0;
 		const bool parsing_success = parse_sync_data_object_info(
 				snapshot,
-				&parse_data,
 				p_object_data,
-
-				// Parse variable:
-				[](void *p_user_pointer, ObjectData &p_object_data, VarId p_var_id, VarData &&p_value) {
-					PendingObjectSnapshotsParseData *pd = static_cast<PendingObjectSnapshotsParseData *>(p_user_pointer);
-
-					if (p_object_data.vars.size() != uint32_t(pd->snapshot.objects[p_object_data.get_net_id().id].vars.size())) {
-						// The parser may have added a variable, so make sure to resize the vars array.
-						pd->snapshot.objects[p_object_data.get_net_id().id].vars.resize(p_object_data.vars.size());
-					}
-
-					if (pd->snapshot.objects[p_object_data.get_net_id().id].vars.size() > p_var_id.id) {
-						// Updates the actual value.
-						p_object_data.vars[p_var_id.id].set_func(
-								pd->scene_synchronizer->get_synchronizer_manager(),
-								p_object_data.app_object_handle,
-								p_object_data.vars[p_var_id.id].var.name,
-								p_value);
-
-						// Save the variable into the local snapshot, so increamental updates works fine.
-						pd->snapshot.objects[p_object_data.get_net_id().id].vars[p_var_id.id].emplace(std::move(p_value));
-					}
-				},
-
-				// Parse scheduled procedure:
-				[](void *p_user_pointer, ObjectData &p_object_data, ScheduledProcedureId p_procedure_id, ScheduledProcedureSnapshot &&p_procedure_snapshot) {
-					PendingObjectSnapshotsParseData *pd = static_cast<PendingObjectSnapshotsParseData *>(p_user_pointer);
-
-					if (p_object_data.get_scheduled_procedures().size() != uint32_t(pd->snapshot.objects[p_object_data.get_net_id().id].procedures.size())) {
-						// The parser may have added a procedure, so make sure to resize the procedure array.
-						pd->snapshot.objects[p_object_data.get_net_id().id].procedures.resize(p_object_data.get_scheduled_procedures().size());
-					}
-
-					if (pd->snapshot.objects[p_object_data.get_net_id().id].procedures.size() > p_procedure_id.id) {
-						// Updates the actual value.
-						p_object_data.scheduled_procedure_reset_to(p_procedure_id, p_procedure_snapshot);
-
-						// Save the variable into the local snapshot, so incremental updates works fine.
-						pd->snapshot.objects[p_object_data.get_net_id().id].procedures[p_procedure_id.id] = std::move(p_procedure_snapshot);
-					}
-				});
+				last_received_snapshot.objects[p_object_data.get_net_id().id],
+				true,
+				pending->state_hashing[i],
+				has_state_hash,
+				state_hash);
 
 #if NS_DEBUG_ENABLED
 		if (scene_synchronizer->pedantic_checks) {
@@ -5441,16 +7810,24 @@ void ClientSynchronizer::finalize_object_data_synchronization(ObjectData &p_obje
 			return;
 		}
 
-		get_debugger().print(INFO, "The object data finalization applied " + std::to_string(pending_snapshots->size()) + " pending snapshots on the object name `" + p_object_data.get_object_name() + "`, NetId `" + std::to_string(p_object_data.get_net_id().id) + "`.");
+		if (has_state_hash) {
+			// There is no prediction to verify the hash against for the
+			// objects not yet registered: the values are needed.
+			get_debugger().print(INFO, "The pending snapshots of the object `" + p_object_data.get_object_name() + "` contain the state hash, requesting the full snapshot.");
+			notify_server_full_snapshot_is_needed();
+			return;
+		}
+
+		get_debugger().print(INFO, "The object data finalization applied " + std::to_string(pending->count) + " pending snapshots on the object name `" + p_object_data.get_object_name() + "`, NetId `" + std::to_string(p_object_data.get_net_id().id) + "`.");
 	}
 
-	// Object initialize, we can finally erase it.
-	objects_pending_snapshots.erase(p_object_data.get_net_id());
+	// Object initialize, we can finally release it.
+	release_object_pending_snapshots(*pending);
 }
 
-void ClientSynchronizer::notify_server_full_snapshot_is_needed() {
+bool ClientSynchronizer::notify_server_full_snapshot_is_needed() {
 	if (need_full_snapshot_notified) {
-		return;
+		return false;
 	}
 
 	// Notify the server that a full snapshot is needed.
@@ -5460,7 +7837,10 @@ void ClientSynchronizer::notify_server_full_snapshot_is_needed() {
 			scene_synchronizer->network_interface->get_server_peer());
 
 	// No need to keep track of these, since a new snapshot is going to override everything.
-	objects_pending_snapshots.clear();
+	for (ObjectPendingSnapshots &pending : objects_pending_snapshots) {
+		release_object_pending_snapshots(pending);
+	}
+	return true;
 }
 
 void ClientSynchronizer::update_client_snapshot(Snapshot &r_snapshot) {
@@ -5482,59 +7862,90 @@ void ClientSynchronizer::update_client_snapshot(Snapshot &r_snapshot) {
 	// Make sure we have room for all the NodeData.
 	r_snapshot.objects.resize(scene_synchronizer->objects_data_storage.get_sorted_objects_data().size());
 
-	// Updates the Peers executed FrameIndex
-	r_snapshot.peers_frames_index.clear();
+	// Updates the Peers executed FrameIndex.
+	// NOTE: The stale entries are removed one by one, rather than clearing the
+	//       map, to reuse the map nodes of the recycled snapshot.
+	for (auto it = r_snapshot.peers_frames_index.begin(); it != r_snapshot.peers_frames_index.end();) {
+		const PeerData *pd = MapFunc::get_or_null(scene_synchronizer->peer_data, it->first);
+		if (pd && pd->controller) {
+			++it;
+		} else {
+			it = r_snapshot.peers_frames_index.erase(it);
+		}
+	}
 	for (const auto &[peer, data] : scene_synchronizer->peer_data) {
 		if (data.controller) {
 			MapFunc::assign(r_snapshot.peers_frames_index, peer, FrameIndexWithMeta(false, data.controller->get_current_frame_index()));
 		}
 	}
 
+	client_snapshot_copied_vars_count = 0;
+	client_snapshot_reused_vars_count = 0;
+
 	// Create the snapshot, even for the objects controlled by the dolls.
-	for (const ObjectData *od : scene_synchronizer->objects_data_storage.get_sorted_objects_data()) {
+	const std::vector<ObjectData *> &sorted_objects_data = scene_synchronizer->objects_data_storage.get_sorted_objects_data();
+	for (std::size_t i = 0; i < sorted_objects_data.size(); i++) {
 		NS_PROFILE_NAMED("Update object data");
+		const ObjectData *od = sorted_objects_data[i];
 
-		if (od == nullptr || od->realtime_sync_enabled_on_client == false) {
+		if (od == nullptr || od->realtime_sync_enabled_on_client == false || od->is_client_interpolated()) {
+			// The snapshot may be recycled: drop the old data.
+			r_snapshot.objects[i].clear();
 			continue;
 		}
 
+		update_client_snapshot_object(r_snapshot, *od);
+	}
+
+	dolls_store_client_snapshot(r_snapshot);
+	scene_synchronizer->event_snapshot_update_finished.broadcast(r_snapshot);
+}
+
+void ClientSynchronizer::update_client_snapshot_object(Snapshot &r_snapshot, const ObjectData &p_object_data) {
 #ifdef NS_PROFILING_ENABLED
-		std::string perf_info = "Object Name: " + od->get_object_name();
-		NS_PROFILE_SET_INFO(perf_info);
+	std::string perf_info = "Object Name: " + p_object_data.get_object_name();
+	NS_PROFILE_SET_INFO(perf_info);
 #endif
 
-		// Make sure this ID is valid.
-		NS_ENSURE_MSG(od->get_net_id() != ObjectNetId::NONE, "[BUG] It's not expected that the client has an uninitialized NetNodeId into the `organized_node_data` ");
+	// Make sure this ID is valid.
+	NS_ENSURE_MSG(p_object_data.get_net_id() != ObjectNetId::NONE, "[BUG] It's not expected that the client has an uninitialized NetNodeId into the `organized_node_data` ");
 
 #ifdef NS_DEBUG_ENABLED
-		NS_ASSERT_COND_MSG(od->get_net_id().id < uint32_t(r_snapshot.objects.size()), "This array was resized above, this can't be triggered.");
+	NS_ASSERT_COND_MSG(p_object_data.get_net_id().id < uint32_t(r_snapshot.objects.size()), "The objects array is resized by `update_client_snapshot`, this can't be triggered.");
 #endif
 
-		ObjectDataSnapshot *object_data_snap = r_snapshot.objects.data() + od->get_net_id().id;
-		object_data_snap->vars.resize(od->vars.size());
+	ObjectDataSnapshot *object_data_snap = r_snapshot.objects.data() + p_object_data.get_net_id().id;
+	object_data_snap->vars.resize(p_object_data.vars.size());
+	object_data_snap->vars_version.resize(p_object_data.vars.size(), 0);
 
-		std::optional<VarData> *od_snap_vars_ptr = object_data_snap->vars.data();
-		for (std::size_t v = 0; v < od->vars.size(); v += 1) {
+	std::optional<VarData> *od_snap_vars_ptr = object_data_snap->vars.data();
+	std::uint64_t *od_snap_vars_version_ptr = object_data_snap->vars_version.data();
+	for (std::size_t v = 0; v < p_object_data.vars.size(); v += 1) {
 #ifdef NS_PROFILING_ENABLED
-			std::string sub_perf_info = "Var: " + od->vars[v].var.name;
-			NS_PROFILE_NAMED_WITH_INFO("Update object data variable", sub_perf_info);
+		std::string sub_perf_info = "Var: " + p_object_data.vars[v].var.name;
+		NS_PROFILE_NAMED_WITH_INFO("Update object data variable", sub_perf_info);
 #endif
-			if (od->vars[v].enabled) {
-				od_snap_vars_ptr[v].emplace(VarData::make_copy(od->vars[v].var.value));
-			} else {
-				od_snap_vars_ptr[v].reset();
+		if (p_object_data.vars[v].enabled) {
+			if (od_snap_vars_ptr[v].has_value() && od_snap_vars_version_ptr[v] == p_object_data.vars[v].value_version) {
+				// The recycled snapshot already stores this value.
+				client_snapshot_reused_vars_count += 1;
+				continue;
 			}
-		}
-
-		object_data_snap->procedures.resize(od->get_scheduled_procedures().size());
-		for (std::size_t p = 0; p < od->get_scheduled_procedures().size(); p += 1) {
-			object_data_snap->procedures[p].execute_frame = od->get_scheduled_procedures()[p].execute_frame;
-			object_data_snap->procedures[p].paused_frame = od->get_scheduled_procedures()[p].paused_frame;
-			object_data_snap->procedures[p].args = od->get_scheduled_procedures()[p].args;
+			od_snap_vars_ptr[v].emplace(VarData::make_copy(p_object_data.vars[v].var.value));
+			od_snap_vars_version_ptr[v] = p_object_data.vars[v].value_version;
+			client_snapshot_copied_vars_count += 1;
+		} else {
+			od_snap_vars_ptr[v].reset();
+			od_snap_vars_version_ptr[v] = 0;
 		}
 	}
 
-	scene_synchronizer->event_snapshot_update_finished.broadcast(r_snapshot);
+	object_data_snap->procedures.resize(p_object_data.get_scheduled_procedures().size());
+	for (std::size_t p = 0; p < p_object_data.get_scheduled_procedures().size(); p += 1) {
+		object_data_snap->procedures[p].execute_frame = p_object_data.get_scheduled_procedures()[p].execute_frame;
+		object_data_snap->procedures[p].paused_frame = p_object_data.get_scheduled_procedures()[p].paused_frame;
+		object_data_snap->procedures[p].args = p_object_data.get_scheduled_procedures()[p].args;
+	}
 }
 
 void ClientSynchronizer::update_simulated_objects_list(const std::vector<SimulatedObjectInfo> &p_simulated_objects) {
@@ -5577,7 +7988,12 @@ void ClientSynchronizer::update_simulated_objects_list(const std::vector<Simulat
 	simulated_objects = p_simulated_objects;
 	active_objects.clear();
 	for (const SimulatedObjectInfo &info : simulated_objects) {
-		active_objects.push_back(scene_synchronizer->get_object_data(info.net_id));
+		// NOTE: The object may not be known yet (e.g. while the full snapshot
+		//       is being streamed), in that case it's not simulated.
+		ObjectData *od = scene_synchronizer->get_object_data(info.net_id, false);
+		if (od) {
+			active_objects.push_back(od);
+		}
 	}
 }
 
@@ -5607,7 +8023,7 @@ void ClientSynchronizer::apply_snapshot(
 	}
 
 	for (const SimulatedObjectInfo &info : p_snapshot.simulated_objects) {
-		ObjectData *object_data = scene_synchronizer->get_object_data(info.net_id);
+		ObjectData *object_data = scene_synchronizer->get_object_data(info.net_id, false);
 
 		if (object_data == nullptr) {
 			// This can happen, and it's totally expected, because the server
@@ -5628,6 +8044,11 @@ void ClientSynchronizer::apply_snapshot(
 		}
 #endif
 
+		if (object_data->is_client_interpolated()) {
+			// The interpolated objects are updated by `process_interpolation`.
+			continue;
+		}
+
 		if (
 			!p_disable_apply_non_doll_controlled_only &&
 			object_data->get_controlled_by_peer() > 0 &&
@@ -5645,58 +8066,7 @@ void ClientSynchronizer::apply_snapshot(
 			r_applied_data_info->push_back("Applied snapshot on the object: " + object_data->get_object_name());
 		}
 
-		// NOTE: The vars may not contain ALL the variables: it depends on how
-		//       the snapshot was captured.
-		// NOTE: Since it's possible to re-register the object changing the variables
-		//       registered dynamically, the snapshot might contain more variables
-		//       than the new registered one. The line below address that.
-		const VarId::IdType vars_count = VarId::IdType(std::min(object_data_snapshot.vars.size(), object_data->vars.size()));
-		for (VarId v = VarId{ { 0 } }; v < VarId{ { vars_count } }; v += 1) {
-			if (!object_data_snapshot.vars[v.id].has_value()) {
-				// This variable was not set, skip it.
-				continue;
-			}
-
-			const std::string &variable_name = object_data->vars[v.id].var.name;
-			const VarData &snap_value = object_data_snapshot.vars[v.id].value();
-			VarData current_val;
-			object_data->vars[v.id].get_func(
-					*scene_synchronizer->synchronizer_manager,
-					object_data->app_object_handle,
-					variable_name.c_str(),
-					current_val);
-
-			if (!SceneSynchronizerBase::var_data_compare(current_val, snap_value)) {
-				object_data->vars[v.id].var.value.copy(snap_value);
-
-				object_data->vars[v.id].set_func(
-						*scene_synchronizer->synchronizer_manager,
-						object_data->app_object_handle,
-						variable_name.c_str(),
-						snap_value);
-
-				scene_synchronizer->change_event_add(
-						object_data,
-						v,
-						current_val);
-
-#ifdef NS_DEBUG_ENABLED
-				if (scene_synchronizer->pedantic_checks) {
-					// Make sure the set value matches the one just set.
-					object_data->vars[v.id].get_func(
-							*scene_synchronizer->synchronizer_manager,
-							object_data->app_object_handle,
-							variable_name.c_str(),
-							current_val);
-					NS_ASSERT_COND_MSG(SceneSynchronizerBase::var_data_compare(current_val, snap_value), "There was a fatal error while setting the propertly `" + variable_name + "` on the object `" + object_data->get_object_name() + "`. The set data differs from the property set by the NetSync: set data `" + scene_synchronizer->var_data_stringify(current_val, true) + "` NetSync data `" + scene_synchronizer->var_data_stringify(snap_value, true) + "`");
-				}
-#endif
-
-				if (r_applied_data_info) {
-					r_applied_data_info->push_back(std::string() + " |- Variable: " + variable_name + " New value: " + SceneSynchronizerBase::var_data_stringify(snap_value));
-				}
-			}
-		}
+		apply_snapshot_object_vars(*object_data, object_data_snapshot, r_applied_data_info);
 
 		if (!p_skip_scheduled_procedures) {
 			for (ScheduledProcedureId procedure_id = { 0 }; procedure_id.id < ScheduledProcedureId::IdType(object_data_snapshot.procedures.size()); procedure_id += 1) {
@@ -5713,6 +8083,7 @@ void ClientSynchronizer::apply_snapshot(
 	}
 
 	if (!p_skip_snapshot_applied_event_broadcast) {
+		dolls_reconcile(p_snapshot, p_frame_count_to_rewind);
 		scene_synchronizer->event_snapshot_applied.broadcast(p_snapshot, p_frame_count_to_rewind);
 	}
 
@@ -5721,4 +8092,65 @@ void ClientSynchronizer::apply_snapshot(
 	}
 }
 
+
+void ClientSynchronizer::apply_snapshot_object_vars(
+		ObjectData &p_object_data,
+		const ObjectDataSnapshot &p_object_data_snapshot,
+		std::vector<std::string> *r_applied_data_info) {
+	// NOTE: The vars may not contain ALL the variables: it depends on how
+	//       the snapshot was captured.
+	// NOTE: Since it's possible to re-register the object changing the variables
+	//       registered dynamically, the snapshot might contain more variables
+	//       than the new registered one. The line below address that.
+	const VarId::IdType vars_count = VarId::IdType(std::min(p_object_data_snapshot.vars.size(), p_object_data.vars.size()));
+	for (VarId v = VarId{ { 0 } }; v < VarId{ { vars_count } }; v += 1) {
+		if (!p_object_data_snapshot.vars[v.id].has_value()) {
+			// This variable was not set, skip it.
+			continue;
+		}
+
+		const std::string &variable_name = p_object_data.vars[v.id].var.name;
+		const VarData &snap_value = p_object_data_snapshot.vars[v.id].value();
+		VarData current_val;
+		p_object_data.vars[v.id].get_func(
+				*scene_synchronizer->synchronizer_manager,
+				p_object_data.app_object_handle,
+				variable_name.c_str(),
+				current_val);
+
+		if (!SceneSynchronizerBase::var_data_compare(current_val, snap_value)) {
+			p_object_data.vars[v.id].var.value.copy(snap_value);
+			scene_synchronizer->var_value_version_counter += 1;
+			p_object_data.vars[v.id].value_version = scene_synchronizer->var_value_version_counter;
+
+			p_object_data.vars[v.id].set_func(
+					*scene_synchronizer->synchronizer_manager,
+					p_object_data.app_object_handle,
+					variable_name.c_str(),
+					snap_value);
+
+			scene_synchronizer->change_event_add(
+					&p_object_data,
+					v,
+					current_val);
+
+#ifdef NS_DEBUG_ENABLED
+			if (scene_synchronizer->pedantic_checks) {
+				// Make sure the set value matches the one just set.
+				p_object_data.vars[v.id].get_func(
+						*scene_synchronizer->synchronizer_manager,
+						p_object_data.app_object_handle,
+						variable_name.c_str(),
+						current_val);
+				NS_ASSERT_COND_MSG(SceneSynchronizerBase::var_data_compare(current_val, snap_value), "There was a fatal error while setting the propertly `" + variable_name + "` on the object `" + p_object_data.get_object_name() + "`. The set data differs from the property set by the NetSync: set data `" + scene_synchronizer->var_data_stringify(current_val, true) + "` NetSync data `" + scene_synchronizer->var_data_stringify(snap_value, true) + "`");
+			}
+#endif
+
+			if (r_applied_data_info) {
+				r_applied_data_info->push_back(std::string() + " |- Variable: " + variable_name + " New value: " + SceneSynchronizerBase::var_data_stringify(snap_value));
+			}
+		}
+	}
+}
+
 NS_NAMESPACE_END
\ No newline at end of file
@@ -4,12 +4,17 @@
 #include "core/network_interface.h"
 #include "core/object_data_storage.h"
 #include "core/processor.h"
+#include "core/ring_buffer.h"
 #include "core/net_utilities.h"
 #include "core/snapshot.h"
 #include "core/scheduled_procedure.h"
+#include <condition_variable>
 #include <deque>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
 NS_NAMESPACE_BEGIN
@@ -123,6 +128,11 @@ struct LagCompensationSettings {
 	/// The minimum amount of frames needed to trigger the input reconciliation.
 	/// NOTE: This must be more than 1
 	int doll_force_input_reconciliation_min_frames = 5;
+
+	/// The amount of frames stored by the lag compensation history of the
+	/// objects that enabled it, on the server.
+	/// See `SceneSynchronizerBase::set_lag_compensation_history_enabled`.
+	int history_frames_count = 30;
 };
 
 struct Settings {
@@ -212,7 +222,10 @@ protected:
 	static void (*var_data_encode_func)(class DataBuffer &r_buffer, const VarData &p_val);
 	static void (*var_data_decode_func)(VarData &r_val, DataBuffer &p_buffer, std::uint8_t p_var_type);
 	static bool (*var_data_compare_func)(const VarData &p_A, const VarData &p_B);
+	static bool (*var_data_compare_approx_func)(const VarData &p_A, const VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance);
 	static std::string (*var_data_stringify_func)(const VarData &p_var_data, bool p_verbose);
+	static std::uint32_t (*var_data_hash_func)(const VarData &p_val, std::uint32_t p_seed);
+	static bool (*var_data_interpolate_func)(VarData &r_result, const VarData &p_A, const VarData &p_B, float p_alpha);
 	static bool var_data_stringify_force_verbose;
 
 	static void (*print_line_func)(PrintMessageType p_level, const std::string &p_str);
@@ -262,6 +275,12 @@ protected: // --------------------------------------------------------- Settings
 	/// they are sent in an unreliable way.
 	int max_redundant_inputs = 6;
 
+	/// The server adapts the amount of time each player inputs is re-sent to
+	/// the server, from `min_redundant_inputs` to `max_redundant_inputs`,
+	/// depending on the observed packet loss and loss bursts.
+	/// NOTE: Set it to `max_redundant_inputs` to disable the adaptation.
+	int min_redundant_inputs = 2;
+
 	/// Negligible packet loss we can just ignore.
 	float negligible_packet_loss = 0.001f;
 
@@ -311,6 +330,79 @@ protected: // --------------------------------------------------------- Settings
 	/// snapshot to the server.
 	int max_snapshot_parsing_failures = 10;
 
+	/// When greater than 0, the full snapshot (sent to the peers that just
+	/// joined or that requested it) is streamed across multiple frames, sending
+	/// at most this amount of bytes per frame to each peer.
+	/// The most relevant objects are sent first while the others stay pending.
+	/// Set to 0 to send the full snapshot all at once.
+	int full_snapshot_streaming_budget_bytes = 0;
+
+	/// When true, the server captures the snapshot data at the end of the tick
+	/// and encodes it on a worker thread while the next tick is processed.
+	/// The snapshots are then sent one tick later, and the `event_sent_snapshot`
+	/// is emitted once sent.
+	/// NOTE: The `var_data_encode_func` is called by the worker thread, while
+	///       the main thread processes the scene, so it must be thread safe.
+	bool snapshot_encoding_async = false;
+
+	/// When true, the client decodes the received snapshots on a worker
+	/// thread, while the objects are resolved and the snapshots applied by
+	/// the next process.
+	bool snapshot_decoding_async = false;
+
+	/// When true, the server networks a hash of the state of the objects
+	/// predicted by the clients, instead of the changed variables values.
+	/// The client compares the hash with its own prediction and requests the
+	/// full snapshot only on mismatch.
+	/// NOTE: It's used only when `var_data_hash_func` is installed.
+	bool snapshot_state_hashing_enabled = false;
+
+	/// When true, the client rewinds only the interaction islands containing
+	/// the desynchronized objects, while the rest of the scene keeps its
+	/// predicted state. Check `set_object_rewind_island`.
+	bool selective_rewind_enabled = false;
+
+	/// When greater than 0, the client resimulates at most this amount of
+	/// frames per process, spreading the long rewinds across multiple frames.
+	/// Meanwhile, the inputs of the new frames are collected and queued to the
+	/// rewind, and the scene shows the latest completed state until the rewind
+	/// completes. Since each frame queues a new frame, this is never less than 2.
+	/// Set to 0 to always rewind all the frames at once.
+	int max_rewind_frames_per_process = 0;
+
+	/// The threads used by the client to compare the server snapshot with the
+	/// predicted one: the objects are split across the threads, each having
+	/// at least `Snapshot::COMPARE_MIN_OBJECTS_PER_THREAD` objects.
+	/// Set to 1 to compare the snapshots on the calling thread only.
+	/// NOTE: When greater than 1, the installed `var_data_compare_func` and
+	///       `var_data_compare_approx_func` are called by many threads at once,
+	///       so they must be thread safe.
+	int snapshot_compare_threads_count = 1;
+
+	/// The threads used to compare the snapshots, kept alive across the
+	/// comparisons. Check `snapshot_compare_threads_count`.
+	mutable SnapshotComparePool snapshot_compare_pool;
+
+	/// The delay (seconds) the client renders the interpolated objects at,
+	/// behind the last received server snapshot. Check `set_object_interpolation_enabled`.
+	float interpolation_delay = 0.1f;
+
+	/// The maximum time (seconds) the interpolated objects are extrapolated
+	/// past the last received server snapshot, when the snapshots are late.
+	float max_extrapolation = 0.05f;
+
+	/// The window (seconds) used to average the bandwidth stats.
+	float bandwidth_stats_window_seconds = 1.0f;
+
+	/// The memory (bytes) the client can use to store the prediction history:
+	/// the client snapshots, the dolls snapshots and the pending snapshots.
+	/// When over budget, the client requests the full snapshot to drop the
+	/// pending snapshots, drops the oldest dolls snapshots and stops predicting
+	/// new frames until the stored ones fit the budget.
+	/// Check `client_get_prediction_memory_report`.
+	/// Set to 0 to disable the budget.
+	std::uint64_t client_prediction_memory_budget = 0;
+
 protected: // ----------------------------------------------------- User defined
 	class NetworkInterface *network_interface = nullptr;
 	SynchronizerManager *synchronizer_manager = nullptr;
@@ -318,6 +410,7 @@ protected: // ----------------------------------------------------- User defined
 protected: // -------------------------------------------------------- Internals
 	RpcHandle<DataBuffer &> rpc_handler_state;
 	RpcHandle<> rpc_handler_notify_need_full_snapshot;
+	RpcHandle<DataBuffer &> rpc_handler_notify_state_hash_mismatch;
 	RpcHandle<bool> rpc_handler_set_network_enabled;
 	RpcHandle<bool> rpc_handler_notify_peer_status;
 	RpcHandle<const std::vector<std::uint8_t> &> rpc_handler_trickled_sync_data;
@@ -328,12 +421,25 @@ protected: // -------------------------------------------------------- Internals
 
 	// Controller RPCs.
 	RpcHandle<int, const std::vector<std::uint8_t> &> rpc_handle_receive_input;
+	RpcHandle<const std::vector<std::uint8_t> &> rpc_handle_receive_dolls_inputs;
 
 	GlobalFrameIndex global_frame_index = GlobalFrameIndex{ 0 };
 
 	Settings settings;
 	bool settings_changed = true;
 
+	struct LagCompensationRestoreInfo {
+		ObjectLocalId id;
+		VarId var_id;
+		VarData value;
+	};
+	/// The values to restore at the end of the lag compensation rewind.
+	std::vector<LagCompensationRestoreInfo> lag_compensation_restore_info;
+	bool lag_compensation_rewind_in_progress = false;
+
+	/// Generates the `VarDescriptor::value_version`.
+	std::uint64_t var_value_version_counter = 0;
+
 	SynchronizerType synchronizer_type = SYNCHRONIZER_TYPE_NULL;
 
 	class Synchronizer *synchronizer = nullptr;
@@ -360,6 +466,8 @@ protected: // -------------------------------------------------------- Internals
 
 	bool cached_process_functions_valid = false;
 	Processor<float> cached_process_functions[PROCESS_PHASE_COUNT];
+	/// The client interpolated objects left out of `cached_process_functions`.
+	std::uint32_t cached_process_functions_interpolated_objects = 0;
 
 	bool debug_rewindings_enabled = false;
 	PrintMessageType debug_rewindings_log_level = VERBOSE;
@@ -383,6 +491,9 @@ public: // -------------------------------------------------------------- Events
 	EventProcessor<> event_rewind_starting;
 	EventProcessor<> event_rewind_completed;
 	EventProcessor<FrameIndex, int /*p_peer*/> event_sent_snapshot;
+	/// Emitted by the server when the full snapshot streaming completes: at
+	/// this point the peer received the full baseline of its SyncGroup.
+	EventProcessor<int /*p_peer*/> event_full_snapshot_streaming_completed;
 	/// This event is emitted when the current client state is stored into the snapshot.
 	/// NOTE: This even is also executed during the rewinding, to update the previously stored states.
 	/// NOTE: Something to remark is that the Snapshot data passed, is equal to
@@ -412,6 +523,26 @@ public: // -------------------------------------------------------- Manager APIs
 			void (*p_print_code_message_func)(const char *p_function, const char *p_file, int p_line, const std::string &p_error, const std::string &p_message, NS::PrintMessageType p_type),
 			void (*p_print_flush_stdout_func)());
 
+	/// Installs the function used to compare the variables having a
+	/// `VarComparePolicy` with tolerances. When not installed, these variables
+	/// are compared strictly.
+	static void install_var_data_compare_approx(
+			bool (*p_var_data_compare_approx_func)(const VarData &p_A, const VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance));
+
+	/// Installs the function used to hash the variables, when the
+	/// `snapshot_state_hashing_enabled` is set. The hash must be deterministic
+	/// across the peers: the same value must produce the same hash given the
+	/// same seed. When not installed, the state hashing is not used.
+	static void install_var_data_hash(
+			std::uint32_t (*p_var_data_hash_func)(const VarData &p_val, std::uint32_t p_seed));
+
+	/// Installs the function used by the client to interpolate the values of
+	/// the interpolated objects. It returns false when the values can't be
+	/// interpolated, in which case the values are snapped. The `p_alpha` is
+	/// greater than 1 when extrapolating.
+	static void install_var_data_interpolate(
+			bool (*p_var_data_interpolate_func)(VarData &r_result, const VarData &p_A, const VarData &p_B, float p_alpha));
+
 	/// Setup the synchronizer
 	void setup(SynchronizerManager &p_synchronizer_manager);
 
@@ -428,6 +559,10 @@ public:
 	static void var_data_encode(DataBuffer &r_buffer, const VarData &p_val, std::uint8_t p_variable_type);
 	static void var_data_decode(VarData &r_val, DataBuffer &p_buffer, std::uint8_t p_variable_type);
 	static bool var_data_compare(const VarData &p_A, const VarData &p_B);
+	static bool var_data_compare_approx(const VarData &p_A, const VarData &p_B, const VarComparePolicy &p_policy);
+	static bool is_var_data_hash_installed();
+	static std::uint32_t var_data_hash(const VarData &p_val, std::uint32_t p_seed);
+	static bool var_data_interpolate(VarData &r_result, const VarData &p_A, const VarData &p_B, float p_alpha);
 	static std::string var_data_stringify(const VarData &p_var_data, bool p_verbose = false);
 	static void __print_line(PrintMessageType p_level, const std::string &p_str);
 	static void print_code_message(SceneSynchronizerDebugger *p_debugger, const char *p_function, const char *p_file, int p_line, const std::string &p_error, const std::string &p_message, NS::PrintMessageType p_type);
@@ -504,6 +639,14 @@ public:
 		return max_redundant_inputs;
 	}
 
+	void set_min_redundant_inputs(int p_val) {
+		min_redundant_inputs = p_val;
+	}
+
+	int get_min_redundant_inputs() const {
+		return min_redundant_inputs;
+	}
+
 	void set_negligible_packet_loss(float p_val);
 	float get_negligible_packet_loss() const;
 
@@ -542,6 +685,105 @@ public:
 		return max_snapshot_parsing_failures;
 	}
 
+	void set_full_snapshot_streaming_budget_bytes(int p_budget_bytes) {
+		full_snapshot_streaming_budget_bytes = p_budget_bytes;
+	}
+
+	int get_full_snapshot_streaming_budget_bytes() const {
+		return full_snapshot_streaming_budget_bytes;
+	}
+
+	void set_snapshot_encoding_async(bool p_enabled) {
+		snapshot_encoding_async = p_enabled;
+	}
+
+	bool is_snapshot_encoding_async() const {
+		return snapshot_encoding_async;
+	}
+
+	void set_snapshot_decoding_async(bool p_enabled) {
+		snapshot_decoding_async = p_enabled;
+	}
+
+	bool is_snapshot_decoding_async() const {
+		return snapshot_decoding_async;
+	}
+
+	void set_snapshot_state_hashing_enabled(bool p_enabled) {
+		snapshot_state_hashing_enabled = p_enabled;
+	}
+
+	bool is_snapshot_state_hashing_enabled() const {
+		return snapshot_state_hashing_enabled;
+	}
+
+	void set_selective_rewind_enabled(bool p_enabled) {
+		selective_rewind_enabled = p_enabled;
+	}
+
+	bool is_selective_rewind_enabled() const {
+		return selective_rewind_enabled;
+	}
+
+	void set_max_rewind_frames_per_process(int p_frames) {
+		max_rewind_frames_per_process = p_frames <= 0 ? 0 : std::max(p_frames, 2);
+	}
+
+	int get_max_rewind_frames_per_process() const {
+		return max_rewind_frames_per_process;
+	}
+
+	void set_snapshot_compare_threads_count(int p_threads_count) {
+		snapshot_compare_threads_count = std::max(p_threads_count, 1);
+		// The calling thread compares the snapshots too.
+		snapshot_compare_pool.start(std::size_t(snapshot_compare_threads_count - 1));
+	}
+
+	int get_snapshot_compare_threads_count() const {
+		return snapshot_compare_threads_count;
+	}
+
+	SnapshotComparePool &get_snapshot_compare_pool() const {
+		return snapshot_compare_pool;
+	}
+
+	void set_interpolation_delay(float p_seconds) {
+		interpolation_delay = std::max(p_seconds, 0.0f);
+	}
+
+	float get_interpolation_delay() const {
+		return interpolation_delay;
+	}
+
+	void set_max_extrapolation(float p_seconds) {
+		max_extrapolation = std::max(p_seconds, 0.0f);
+	}
+
+	float get_max_extrapolation() const {
+		return max_extrapolation;
+	}
+
+	void set_bandwidth_stats_window_seconds(float p_seconds);
+
+	float get_bandwidth_stats_window_seconds() const {
+		return bandwidth_stats_window_seconds;
+	}
+
+	/// Returns the index of the current bandwidth stats window.
+	std::uint32_t get_bandwidth_stats_window_index() const;
+
+	void set_client_prediction_memory_budget(std::uint64_t p_bytes) {
+		client_prediction_memory_budget = p_bytes;
+	}
+
+	std::uint64_t get_client_prediction_memory_budget() const {
+		return client_prediction_memory_budget;
+	}
+
+	/// Returns the memory used by the client to store the prediction history,
+	/// measured only when the `client_prediction_memory_budget` is set.
+	PredictionMemoryReport client_get_prediction_memory_report() const;
+
 	bool is_variable_registered(ObjectLocalId p_id, const std::string &p_variable) const;
 
 	void set_debug_rewindings_enabled(bool p_enabled);
@@ -576,6 +818,7 @@ public:
 public: // ---------------------------------------------------------------- RPCs
 	void rpc_receive_state(DataBuffer &p_snapshot);
 	void rpc__notify_need_full_snapshot();
+	void rpc__notify_state_hash_mismatch(DataBuffer &p_data);
 	void rpc_set_network_enabled(bool p_enabled);
 	void rpc_notify_peer_status(bool p_enabled);
 	void rpc_trickled_sync_data(const std::vector<std::uint8_t> &p_data);
@@ -587,6 +830,7 @@ public: // ---------------------------------------------------------------- RPCs
 	void call_rpc_receive_inputs(const std::vector<int> &p_recipients, int p_peer, const std::vector<std::uint8_t> &p_data);
 
 	void rpc_receive_inputs(int p_peer, const std::vector<std::uint8_t> &p_data);
+	void rpc_receive_dolls_inputs(const std::vector<std::uint8_t> &p_data);
 
 public: // ---------------------------------------------------------------- APIs
 	GlobalFrameIndex get_global_frame_index() const {
@@ -629,6 +873,51 @@ public: // ---------------------------------------------------------------- APIs
 
 	void set_skip_rewinding(ObjectLocalId p_id, const std::string &p_variable, bool p_skip_rewinding);
 
+	/// When enabled, after each processed frame the variable is set to the
+	/// value obtained by encoding and decoding it, as it's networked.
+	/// Use this with the variables networked at reduced precision, so the
+	/// client and the server simulate using the same values and the
+	/// precision loss never triggers a rewind.
+	void set_quantize_on_write(ObjectLocalId p_id, const std::string &p_variable, bool p_quantize_on_write);
+
+	/// Sets how the client compares this variable against the server value.
+	/// Use this to avoid triggering rewinds for cosmetic variables drifting
+	/// by a negligible amount.
+	void set_compare_policy(ObjectLocalId p_id, const std::string &p_variable, const VarComparePolicy &p_policy);
+
+	/// Returns the amount of rewinds triggered by this variable, on the client.
+	/// NOTE: On release builds, only the first different variable of each
+	///       rewind is counted.
+	std::uint64_t get_rewind_triggers_count(ObjectLocalId p_id, const std::string &p_variable) const;
+
+	/// Sets the interaction island of this object, used by the selective
+	/// rewind. The app must guarantee that the objects of an island never
+	/// interact with the objects outside it.
+	/// NOTE: The objects without island, the controlled objects and the
+	///       objects with scheduled procedures are always rewound with the
+	///       whole scene.
+	void set_object_rewind_island(ObjectLocalId p_id, RewindIslandId p_island);
+	RewindIslandId get_object_rewind_island(ObjectLocalId p_id) const;
+
+	/// When enabled, the client doesn't predict this object: it's excluded
+	/// from the processing, the client snapshots and the rewinds, and it's
+	/// rendered interpolating the received server values, `interpolation_delay`
+	/// seconds in the past. Only the objects not controlled by any peer are
+	/// interpolated. It has no effect on the server.
+	/// NOTE: The state hashing can't be used with the interpolated objects,
+	///       because their values are needed. Check `snapshot_state_hashing_enabled`.
+	void set_object_interpolation_enabled(ObjectLocalId p_id, bool p_enabled);
+	bool is_object_interpolation_enabled(ObjectLocalId p_id) const;
+
+	/// Returns the bandwidth used by the server snapshots to network this
+	/// object, including the object header and the scheduled procedures.
+	BandwidthReport get_object_bandwidth(ObjectLocalId p_id) const;
+	/// Returns the bandwidth used by the server snapshots to network this variable.
+	BandwidthReport get_variable_bandwidth(ObjectLocalId p_id, const std::string &p_variable) const;
+	/// Returns the bandwidth used by this variable across all the objects
+	/// using this `SchemeId`.
+	BandwidthReport get_scheme_variable_bandwidth(SchemeId p_scheme_id, const std::string &p_variable) const;
+
 	ListenerHandle track_variable_changes(
 			ObjectLocalId p_id,
 			const std::string &p_variable,
@@ -742,6 +1031,28 @@ public:
 	/// On client: This function returns 0 for non local peers.
 	float get_peer_packet_loss_percentage(int p_peer) const;
 
+	/// Enables the lag compensation history for this object, on the server:
+	/// the variables values of the last `LagCompensationSettings::history_frames_count`
+	/// frames are kept, so the object can be rewound with `lag_compensation_rewind`.
+	/// NOTE: Call this after registering the object variables.
+	void set_lag_compensation_history_enabled(ObjectLocalId p_id, bool p_enabled);
+	bool is_lag_compensation_history_enabled(ObjectLocalId p_id) const;
+
+	/// Returns the frame the peer was seeing when it produced the input the
+	/// server is processing right now, computed using the peer latency and
+	/// the inputs buffered by its controller.
+	GlobalFrameIndex lag_compensation_get_peer_view_frame(int p_peer) const;
+
+	/// Temporarily sets the objects variables to the values they had at the
+	/// given frame. Use `lag_compensation_restore` to restore them.
+	/// Returns false if the frame is not in the history of all the objects.
+	bool lag_compensation_rewind(GlobalFrameIndex p_frame, const std::vector<ObjectLocalId> &p_objects);
+	/// Rewinds the objects to the frame the peer was seeing.
+	bool lag_compensation_rewind_for_peer(int p_peer, const std::vector<ObjectLocalId> &p_objects);
+	/// Restores the objects rewound by `lag_compensation_rewind`.
+	void lag_compensation_restore();
+	bool is_lag_compensation_rewind_in_progress() const;
+
 	/// Creates a sync group containing the list of sync objects.
 	/// The Peers listening to this group will receive the updates only
 	/// from the objects within this group.
@@ -785,6 +1096,29 @@ public:
 	void sync_group_set_user_data(SyncGroupId p_group_id, uint64_t p_user_ptr);
 	uint64_t sync_group_get_user_data(SyncGroupId p_group_id) const;
 
+	/// Makes the group notify its state at an interval that adapts, between
+	/// `p_min_timespan` and `p_max_timespan` (seconds), to its activity: the
+	/// more variables change (up to `p_saturation_changes_per_second`) the more
+	/// often the snapshot is sent. When disabled `frame_confirmation_timespan` is used.
+	/// This function works only on server.
+	void sync_group_set_adaptive_notify_timespan(SyncGroupId p_group_id, bool p_enabled, float p_min_timespan, float p_max_timespan, float p_saturation_changes_per_second);
+	/// The importance scales the group activity used by the adaptive notify
+	/// timespan: `0` always uses the max timespan, `1` is the default.
+	void sync_group_set_importance(SyncGroupId p_group_id, float p_importance);
+	float sync_group_get_importance(SyncGroupId p_group_id) const;
+	/// Returns the timespan (seconds) currently used to notify the group state.
+	float sync_group_get_notify_timespan(SyncGroupId p_group_id) const;
+
+	/// Returns the bandwidth used by the snapshots of this group.
+	/// This function works only on server.
+	BandwidthReport sync_group_get_bandwidth(SyncGroupId p_group_id) const;
+
+	/// Returns the notify timespan (seconds) the server is using for the sync
+	/// group of this client, or the `frame_confirmation_timespan` when the
+	/// server is not using an adaptive timespan.
+	/// This function works only on client.
+	float get_server_notify_timespan() const;
+
 	/// Returns true during the rewinding process and the preceding snapshot apply,
 	/// this is very useful to skip the execution of code during the rewinding process.
 	bool is_resyncing() const;
@@ -852,6 +1186,13 @@ public: // ------------------------------------------------------------ INTERNAL
 	void process_functions__clear();
 	bool process_functions__execute();
 	void process_functions__execute_scheduled_procedure();
+	void process_functions__quantize_variables();
+	/// Process only the given objects, used by the selective rewind.
+	void process_functions__execute_objects(const std::vector<ObjectData *> &p_objects);
+	void quantize_object_variables(ObjectData &p_object_data, DataBuffer &r_buffer);
+	void advance_global_frame_index();
+	void lag_compensation_history_record();
+	void bandwidth_report_add(const BandwidthStats &p_stats, BandwidthReport &r_report) const;
 
 	ObjectLocalId find_object_local_id(ObjectHandle p_app_object) const;
 
@@ -1006,8 +1347,120 @@ class ServerSynchronizer final : public Synchronizer {
 		FORCE_FULL,
 	};
 
+	/// The objects state networked by a snapshot, so the snapshot can be
+	/// encoded away from the scene.
+	/// The vars and procedures of all the objects are stored contiguously.
+	struct SnapshotCapture {
+		struct Object {
+			ObjectNetId net_id = ObjectNetId::NONE;
+			bool has_name = false;
+			std::string name;
+			bool has_scheme_id = false;
+			SchemeId scheme_id = SchemeId::DEFAULT;
+			std::size_t vars_begin = 0;
+			std::size_t vars_end = 0;
+			std::size_t procedures_begin = 0;
+			std::size_t procedures_end = 0;
+			/// When set, the hashed variables are networked using this hash
+			/// rather than their values. Check `VarDescriptor::is_state_hashed`.
+			bool has_state_hash = false;
+			std::uint32_t state_hash = 0;
+			/// Set once encoded.
+			int encoded_bits = 0;
+		};
+
+		struct Var {
+			bool has_value = false;
+			std::uint8_t type = 0;
+			/// The copied value, used when `copy_values` is set.
+			VarData value;
+			/// The value stored into the `ObjectData`, used otherwise.
+			const VarData *value_ref = nullptr;
+			/// Set once encoded.
+			int encoded_bits = 0;
+
+			const VarData &get_value() const {
+				return value_ref ? *value_ref : value;
+			}
+		};
+
+		enum class ProcedureStatus : std::uint8_t {
+			IN_PROGRESS,
+			PAUSED,
+			STOPPED,
+		};
+
+		struct Procedure {
+			bool has_value = false;
+			ProcedureStatus status = ProcedureStatus::STOPPED;
+			GlobalFrameIndex execute_frame = GlobalFrameIndex{ 0 };
+			GlobalFrameIndex paused_frame = GlobalFrameIndex{ 0 };
+			/// The copied arguments, used when `copy_values` is set.
+			DataBuffer args;
+			/// The arguments stored into the `ObjectData`, used otherwise.
+			const DataBuffer *args_ref = nullptr;
+
+			const DataBuffer &get_args() const {
+				return args_ref ? *args_ref : args;
+			}
+		};
+
+		std::vector<Object> objects;
+		std::vector<Var> vars;
+		std::vector<Procedure> procedures;
+		/// When true, the predicted objects state is networked as hash.
+		bool state_hashing = false;
+		/// When true, the vars values and the procedures arguments are copied,
+		/// so the capture can be encoded after the scene changes. Otherwise
+		/// they are referenced, and the capture must be encoded right away.
+		bool copy_values = false;
+	};
+
+	/// A peer receiving a snapshot, notified once the snapshot is sent.
+	struct SnapshotRecipient {
+		int peer = 0;
+		/// The input notified by the snapshot.
+		FrameIndex input_id = FrameIndex::NONE;
+		/// True when the notified input was void, at capture time.
+		bool void_input = false;
+	};
+
+	/// A snapshot captured during the tick and sent once encoded.
+	struct SnapshotEncodeJob {
+		SyncGroupId group_id = SyncGroupId::NONE;
+		bool is_full_snapshot = false;
+		std::vector<SnapshotRecipient> recipients;
+		/// The snapshot buffer, already containing the snapshot header.
+		DataBuffer snapshot;
+		SnapshotCapture capture;
+	};
+
+	/// The worker thread encoding the snapshots when the
+	/// `snapshot_encoding_async` is enabled.
+	struct SnapshotEncoder {
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool exit = false;
+		bool working = false;
+		/// The jobs owned by the worker thread while `working` is true.
+		std::deque<SnapshotEncodeJob> jobs;
+	};
+
+	SnapshotEncoder snapshot_encoder;
+	/// The jobs captured during this tick, submitted to the worker at the end of it.
+	/// NOTE: This is a deque because the `DataBuffer` can't be moved.
+	std::deque<SnapshotEncodeJob> snapshot_encode_jobs;
+	/// The recipients peers of the snapshot being sent, used by `send_snapshot()`.
+	std::vector<int> cached_snapshot_recipients_peers;
+
+	/// The packets of the peers receiving the inputs of a controller, with
+	/// the first input each one receives, used by `process_dolls_inputs_forwarding()`.
+	std::vector<std::pair<FrameIndex, std::vector<std::uint8_t> *>> cached_dolls_inputs_recipients;
+
 public:
 	ServerSynchronizer(SceneSynchronizerBase *p_ss);
+	virtual ~ServerSynchronizer();
 
 	virtual void clear() override;
 
@@ -1031,6 +1484,11 @@ public:
 
 	void notify_need_snapshot_asap(int p_peer);
 	void notify_need_full_snapshot(int p_peer, bool p_notify_ASAP);
+	/// The client prediction of this object doesn't match the received state
+	/// hash: the next snapshot networks the values rather than the hashes, and
+	/// the object hashed variables are networked even if unchanged.
+	void notify_state_hash_mismatch(int p_peer, ObjectNetId p_net_id);
+	bool is_full_snapshot_streaming(int p_peer) const;
 
 	SyncGroupId sync_group_create();
 	/// IMPORTANT: The pointer returned is invalid at the end of the scope executing this function. Never store it.
@@ -1070,13 +1528,94 @@ public:
 			const std::vector<std::size_t> &p_partial_update_simulated_objects_info_indices,
 			DataBuffer &r_snapshot_db) const;
 
+	/// Writes the snapshot header and captures the objects data, that can be
+	/// encoded later using `encode_snapshot_capture`.
+	void capture_snapshot(
+			bool p_force_full_snapshot,
+			const SyncGroup &p_group,
+			const std::vector<std::size_t> &p_partial_update_simulated_objects_info_indices,
+			DataBuffer &r_snapshot_db,
+			SnapshotCapture &r_capture) const;
+
+	/// Encodes the captured objects data and marks the end of the snapshot.
+	/// NOTE: This is thread safe, as it doesn't access the scene.
+	void encode_snapshot_capture(SnapshotCapture &p_capture, DataBuffer &r_snapshot_db) const;
+
+	/// Writes the snapshot header: the update mode, the peers info, the
+	/// simulated objects list and the custom data.
+	void generate_snapshot_header(
+			bool p_force_full_snapshot,
+			bool p_is_partial_update,
+			bool p_state_hashing,
+			const SyncGroup &p_group,
+			const std::vector<std::size_t> &p_partial_update_simulated_objects_info_indices,
+			DataBuffer &r_snapshot_db) const;
+
+	/// Generates the snapshot used to stream the full snapshot to `p_peer`:
+	/// the changes for the already delivered objects are always included,
+	/// then the pending objects are added, by relevance, until the budget is
+	/// consumed.
+	/// Returns true when all the pending objects are delivered.
+	bool generate_full_snapshot_stream_chunk(
+			bool p_is_first_chunk,
+			const SyncGroup &p_group,
+			int p_peer,
+			std::vector<bool> &r_pending_objects,
+			DataBuffer &r_snapshot_db,
+			SnapshotCapture &r_capture) const;
+
+	/// Captures and encodes the object data: the encoded object is appended
+	/// to `r_capture`, so its size can be accounted.
 	void generate_snapshot_object_data(
 			const ObjectData &p_object_data,
 			SnapshotObjectGeneratorMode p_mode,
 			const SyncGroup::Change &p_change,
+			DataBuffer &r_snapshot_db,
+			SnapshotCapture &r_capture) const;
+
+	void capture_snapshot_object_data(
+			const ObjectData &p_object_data,
+			SnapshotObjectGeneratorMode p_mode,
+			const SyncGroup::Change &p_change,
+			SnapshotCapture &r_capture) const;
+
+	void encode_snapshot_object_data(
+			SnapshotCapture &p_capture,
+			SnapshotCapture::Object &p_object,
 			DataBuffer &r_snapshot_db) const;
 
+	/// Accounts the bits sent for the snapshot into the bandwidth stats of
+	/// the group, the objects and the variables.
+	void bandwidth_stats_add(
+			SyncGroupId p_group_id,
+			bool p_full_snapshot,
+			const SnapshotCapture &p_capture,
+			const DataBuffer &p_snapshot,
+			std::size_t p_recipients_count);
+
+	/// Fetches the notification to send with the snapshot to `p_peer`.
+	SnapshotRecipient make_snapshot_recipient(int p_peer, PeerNetworkedController *p_controller) const;
+	/// Sends the encoded snapshot to the recipients still connected, then
+	/// notifies them as sent.
+	void send_snapshot(SnapshotEncodeJob &p_job);
+	/// Emits the `event_sent_snapshot` and notifies the peer controller.
+	void notify_snapshot_sent(const SnapshotRecipient &p_recipient);
+
+	void snapshot_encoder_start();
+	/// Stops the worker thread. When `p_send_pending_snapshots` is true the
+	/// snapshots not yet sent are encoded and sent, otherwise they are
+	/// dropped: e.g. when the scene is cleared they are no longer relevant.
+	void snapshot_encoder_stop(bool p_send_pending_snapshots);
+	/// Hands the snapshots captured during this tick to the worker thread.
+	void snapshot_encoder_submit();
+	/// Waits the worker thread and sends the encoded snapshots.
+	void snapshot_encoder_flush();
+	void snapshot_encoder_thread_main();
+
 	void process_trickled_sync(float p_delta);
+	/// Forwards the inputs received this tick to the peers simulating the
+	/// controllers, using a single packet per peer.
+	void process_dolls_inputs_forwarding();
 	void update_peers_net_statistics(float p_delta);
 	void send_net_stat_to_peer(int p_peer, PeerData &p_peer_data);
 };
@@ -1089,11 +1628,129 @@ public:
 	float acceleration_fps_timer = 0.0;
 	float pretended_delta = 1.0;
 
+	struct InterpolationSample {
+		GlobalFrameIndex frame_index = GlobalFrameIndex::NONE;
+		ObjectDataSnapshot object;
+	};
+
+	struct InterpolatedObject {
+		ObjectLocalId local_id = ObjectLocalId::NONE;
+		/// The received server values, sorted by frame.
+		RingBuffer<InterpolationSample> samples;
+	};
+
+	struct ObjectPendingSnapshots {
+		ObjectNetId net_id = ObjectNetId::NONE;
+		/// The sliced object info, only the first `count` are set.
+		std::vector<DataBuffer> snapshots;
+		/// The `SyncDataHeader::state_hashing` of each sliced snapshot.
+		std::vector<bool> state_hashing;
+		std::size_t count = 0;
+	};
+
 	struct ClientParsingErrors {
 		int objects = 0;
 		int missing_object_names = 0;
 	};
 
+	/// The snapshot header: the update mode, the peers info, the simulated
+	/// objects list and the custom data. Check `generate_snapshot_header`.
+	struct SyncDataHeader {
+		struct PeerInfo {
+			int peer = -1;
+			FrameIndex frame_index = FrameIndex::NONE;
+			bool has_latency = false;
+			std::uint8_t compressed_latency = 0;
+			bool is_simulated_objects_full_update = false;
+			std::vector<ObjectNetId> simulated_objects;
+		};
+
+		bool is_partial_update = false;
+		GlobalFrameIndex global_frame_index = GlobalFrameIndex::NONE;
+		bool is_adaptive_notify_timespan = false;
+		std::uint64_t notify_timespan_ms = 0;
+		/// When true, the objects may network the state hash in place of the
+		/// hashed variables.
+		bool state_hashing = false;
+		/// Only the first `peers_count` are set.
+		std::vector<PeerInfo> peers;
+		std::size_t peers_count = 0;
+		/// The simulated objects not controlled by a peer: the whole list when
+		/// `is_simulated_objects_full_update`, the changes otherwise.
+		bool is_simulated_objects_full_update = false;
+		std::vector<ObjectNetId> simulated_objects;
+		std::vector<ObjectNetId> added_simulated_objects;
+		std::vector<ObjectNetId> removed_simulated_objects;
+		bool has_custom_data = false;
+		VarData custom_data;
+	};
+
+	/// The object info preceding the object vars.
+	struct SyncDataObjectHeader {
+		ObjectNetId net_id = ObjectNetId::NONE;
+		bool has_object_name = false;
+		std::string object_name;
+		bool has_scheme_id = false;
+		SchemeId scheme_id = SchemeId::DEFAULT;
+		std::uint16_t vars_size_in_bits = 0;
+		/// The buffer offset the vars begin at.
+		int vars_bit_offset = 0;
+	};
+
+	/// The object info decoded by the `SnapshotDecoder`.
+	struct DecodedSyncDataObject {
+		SyncDataObjectHeader header;
+		/// The object the vars were decoded for, NONE when the vars are left
+		/// to the main thread parsing.
+		ObjectLocalId decoded_for = ObjectLocalId::NONE;
+		bool has_state_hash = false;
+		std::uint32_t state_hash = 0;
+		ObjectDataSnapshot object;
+	};
+
+	/// The info the `SnapshotDecoder` uses to decode the object vars without
+	/// accessing the scene.
+	struct SnapshotDecoderObjectScheme {
+		/// NONE when the object vars can't be decoded by the worker thread.
+		ObjectLocalId local_id = ObjectLocalId::NONE;
+		SchemeId scheme_id = SchemeId::DEFAULT;
+		std::string object_name;
+		std::vector<std::uint8_t> vars_type;
+	};
+
+	/// A received snapshot, decoded by the `SnapshotDecoder`.
+	struct SnapshotDecodeJob {
+		DataBuffer snapshot;
+		/// False when the decoding failed: the snapshot is corrupted.
+		bool is_header_decoded = false;
+		bool is_objects_decoded = false;
+		SyncDataHeader header;
+		/// Only the first `objects_count` are set.
+		std::vector<DecodedSyncDataObject> objects;
+		std::size_t objects_count = 0;
+		/// The `SnapshotDecoder::schemes_version` the vars were decoded with.
+		std::uint64_t schemes_version = 0;
+	};
+
+	/// The worker thread decoding the received snapshots when the
+	/// `snapshot_decoding_async` is enabled.
+	struct SnapshotDecoder {
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool exit = false;
+		bool working = false;
+		/// The jobs owned by the worker thread while `working` is true. Only
+		/// the first `jobs_count` are set, the others are kept to be reused.
+		/// NOTE: This is a deque because the `DataBuffer` can't be moved.
+		std::deque<SnapshotDecodeJob> jobs;
+		std::size_t jobs_count = 0;
+		/// Indexed by `ObjectNetId`, updated only while the worker is idle.
+		std::vector<SnapshotDecoderObjectScheme> schemes;
+		std::uint64_t schemes_version = 0;
+		std::uint8_t custom_data_type = 0;
+	};
+
 	int snapshot_parsing_failures = 0;
 #ifdef NS_DEBUG_ENABLED
 	std::uint64_t snapshot_parsing_failures_ever = 0;
@@ -1104,13 +1761,100 @@ public:
 	PeerNetworkedController *player_controller = nullptr;
 	std::map<ObjectNetId, std::string> objects_names;
 	std::map<ObjectNetId, SchemeId> objects_schemes_id;
-	std::map<ObjectNetId, std::vector<DataBuffer>> objects_pending_snapshots;
+	/// The object info received for the objects not yet registered. The
+	/// entries, and their buffers, are reused once the objects are registered.
+	std::vector<ObjectPendingSnapshots> objects_pending_snapshots;
 
 	RollingUpdateSnapshot last_received_snapshot;
-	std::deque<Snapshot> client_snapshots;
+	/// The snapshot the received data is parsed into, which is then swapped
+	/// with `last_received_snapshot`: the two are recycled, so the steady
+	/// state snapshot receive doesn't allocate.
+	RollingUpdateSnapshot received_snapshot;
+	/// The storage reused by `parse_sync_data`.
+	std::vector<SimulatedObjectInfo> parse_simulated_objects;
+	std::vector<ObjectNetId> parse_net_ids;
+	std::vector<std::pair<int, FrameIndex>> parse_peers_frame_index;
+	SyncDataHeader parse_header;
+	SyncDataObjectHeader parse_object_header;
+
+	SnapshotDecoder snapshot_decoder;
+	/// The snapshots received while the worker is busy, submitted once the
+	/// worker jobs are processed. Only the first `snapshot_decode_jobs_count` are set.
+	std::deque<SnapshotDecodeJob> snapshot_decode_jobs;
+	std::size_t snapshot_decode_jobs_count = 0;
+	/// Set when the objects change, so the `SnapshotDecoder::schemes` are
+	/// updated before the next submit and the already decoded vars are discarded.
+	bool snapshot_decoder_schemes_dirty = true;
+	/// The objects applied using the vars decoded by the `SnapshotDecoder`.
+	std::uint64_t snapshot_decoder_applied_objects_count = 0;
+	/// The locally generated snapshots not yet checked against the server.
+	/// The ring recycles the snapshots so the prediction doesn't allocate.
+	RingBuffer<Snapshot> client_snapshots;
+	/// The vars copied into, and the vars reused by, the last updated client
+	/// snapshot. The unchanged vars are not copied again.
+	std::uint32_t client_snapshot_copied_vars_count = 0;
+	std::uint32_t client_snapshot_reused_vars_count = 0;
+	/// The objects resimulated by the last rewind.
+	std::uint32_t last_rewind_resimulated_objects_count = 0;
+	/// The objects states received as hash and found equal to the client
+	/// prediction, and the ones found different.
+	std::uint64_t state_hash_verified_objects_count = 0;
+	std::uint64_t state_hash_mismatches_count = 0;
+	std::vector<ObjectData *> selective_rewind_objects;
+	/// The objects interpolated rather than predicted, check `ObjectData::is_client_interpolated`.
+	std::vector<InterpolatedObject> interpolated_objects;
+	/// The server frame, fractional, the interpolated objects are rendered at.
+	double interpolation_frame = -1.0;
+	/// The frame of the last received snapshot used to interpolate.
+	GlobalFrameIndex interpolation_last_snapshot_frame = GlobalFrameIndex::NONE;
+	ObjectDataSnapshot interpolation_object_snapshot;
+	/// The objects interpolated on the last process, and the processing of
+	/// these objects skipped on the last process, resimulations included.
+	std::uint32_t last_interpolated_objects_count = 0;
+	std::uint32_t last_interpolation_skipped_processes_count = 0;
+	/// The time (microseconds) taken by the last interpolation.
+	std::uint64_t last_interpolation_usec = 0;
+	/// True while the rewind is in progress: the time-sliced rewind may
+	/// take more frames to complete.
+	bool rewind_pending = false;
+	/// The frames, at the end of `client_snapshots`, still to resimulate.
+	int rewind_pending_frames_count = 0;
+	/// The latest completed state, which the scene shows between the slices
+	/// of the time-sliced rewind, so the partially resimulated states are
+	/// never visible.
+	bool has_rewind_visible_snapshot = false;
+	Snapshot rewind_visible_snapshot;
+	/// True when the scene shows the `rewind_visible_snapshot`, rather than
+	/// the state of the last resimulated frame.
+	bool rewind_visible_snapshot_applied = false;
 	FrameIndex last_received_server_snapshot_index = FrameIndex::NONE;
 	std::optional<Snapshot> last_received_server_snapshot;
+	/// The released `last_received_server_snapshot`, kept to reuse its memory.
+	Snapshot recycled_server_snapshot;
 	FrameIndex last_checked_input = FrameIndex::NONE;
+	/// The doll controllers, reconciled all together by the `dolls_*` functions.
+	std::vector<DollController *> reconciling_dolls;
+	/// The doll snapshots to apply, collected from all the dolls so they are
+	/// applied in a single pass.
+	std::vector<const Snapshot *> dolls_snapshots_to_apply;
+#ifdef NS_DEBUG_ENABLED
+	/// Used by the tests to apply the doll snapshots one by one, in the order
+	/// the dolls collect them, to compare it with the batched reconciliation.
+	bool debug_reconcile_dolls_one_by_one = false;
+#endif
+	/// The snapshots applied by the last dolls reconciliation.
+	std::uint32_t last_dolls_applied_snapshots_count = 0;
+	/// The estimated memory (bytes) used by the last stored client snapshot,
+	/// measured only when the prediction memory budget is set.
+	std::size_t client_snapshot_memory_usage = 0;
+	/// The predicted frames fitting the prediction memory budget.
+	std::size_t prediction_memory_max_frames = std::numeric_limits<std::size_t>::max();
+	/// True while the prediction is paused by the memory budget.
+	bool prediction_memory_paused = false;
+	PredictionMemoryReport prediction_memory_report;
+	/// The adaptive notify timespan received via snapshot, negative when the
+	/// server uses the `frame_confirmation_timespan`.
+	float server_notify_timespan = -1.0f;
 	bool enabled = true;
 	bool want_to_enable = false;
 
@@ -1221,7 +1965,7 @@ public:
 
 public:
 	ClientSynchronizer(SceneSynchronizerBase *p_node);
-
+	virtual ~ClientSynchronizer();
 
 	virtual void clear() override;
 
@@ -1230,34 +1974,56 @@ public:
 	virtual void on_object_data_added(ObjectData &p_object_data) override;
 	virtual void on_object_data_removed(ObjectData &p_object_data) override;
 	virtual void on_object_data_name_known(ObjectData &p_object_data) override;
+	virtual void on_variable_added(ObjectData *p_object_data, const std::string &p_var_name) override;
 	virtual void on_variable_changed(ObjectData *p_object_data, VarId p_var_id, const VarData &p_old_value, int p_flag) override;
 	void signal_end_sync_changed_variables_events();
 	virtual void on_controller_reset(PeerNetworkedController &p_controller) override;
 	virtual const std::vector<ObjectData *> &get_active_objects() const override;
 
 	void receive_snapshot(DataBuffer &p_snapshot);
+	/// Waits the worker thread to decode the submitted snapshots, that are
+	/// processed by the next `process()`.
+	void snapshot_decoder_wait();
+	/// Parses the received snapshot into `r_snapshot`, which must contain the
+	/// last received snapshot since the server sends incremental updates.
+	/// When `p_decoded_snapshot` is set, the data already decoded by the
+	/// `SnapshotDecoder` is used, and `p_snapshot` is its buffer.
 	bool parse_sync_data(
 			DataBuffer &p_snapshot,
-			void *p_user_pointer,
+			bool p_is_server_snapshot,
+			RollingUpdateSnapshot &r_snapshot,
 			ClientParsingErrors &r_parsing_errors,
-			void (*p_notify_parsing_failed_for_object)(void *p_user_pointer, ObjectData &p_object_data),
-			void (*p_notify_update_mode)(void *p_user_pointer, bool p_is_partial_update),
-			void (*p_parse_global_frame_index)(void *p_user_pointer, GlobalFrameIndex p_global_frame_index),
-			void (*p_custom_data_parse)(void *p_user_pointer, VarData &&p_custom_data),
-			void (*p_object_parse)(void *p_user_pointer, ObjectData *p_object_data),
-			// NOTE: The frame index meta is not initialized by this function,
-			// and it's up to the calling function doint it.
-			bool (*p_peers_frame_index_parse)(void *p_user_pointer, std::map<int, FrameIndexWithMeta> &&p_frames_index),
-			void (*p_variable_parse)(void *p_user_pointer, ObjectData &p_object_data, VarId p_var_id, VarData &&p_value),
-			void (*p_scheduled_procedure_parse)(void *p_user_pointer, ObjectData &p_object_data, ScheduledProcedureId p_procedure_id, ScheduledProcedureSnapshot &&p_value),
-			void (*p_simulated_object_add_or_remove_parse)(void *p_user_pointer, bool p_add, SimulatedObjectInfo &&p_simulated_objects),
-			void (*p_simulated_objects_parse)(void *p_user_pointer, std::vector<SimulatedObjectInfo> &&p_simulated_objects));
+			SnapshotDecodeJob *p_decoded_snapshot = nullptr);
+	/// Decodes the snapshot header.
+	/// NOTE: This is thread safe, as it doesn't access the scene.
+	bool decode_sync_data_header(
+			DataBuffer &p_snapshot,
+			std::uint8_t p_custom_data_type,
+			SyncDataHeader &r_header) const;
+	/// Decodes the object info preceding the object vars, the `net_id` is
+	/// NONE at the end of the snapshot.
+	/// NOTE: This is thread safe, as it doesn't access the scene.
+	bool decode_sync_data_object_header(
+			DataBuffer &p_snapshot,
+			SyncDataObjectHeader &r_object_header) const;
+	/// Decodes the object vars using the given scheme, without printing
+	/// any error since the vars are parsed again on failure.
+	/// NOTE: This is thread safe, as it doesn't access the scene.
+	static bool decode_sync_data_object_vars(
+			DataBuffer &p_snapshot,
+			bool p_state_hashing,
+			const SnapshotDecoderObjectScheme &p_scheme,
+			DecodedSyncDataObject &r_object);
+	/// Parses the object info into `r_object_snapshot`. When `p_apply_values`
+	/// is true, the parsed values are also set to the object.
 	bool parse_sync_data_object_info(
 			DataBuffer &p_snapshot,
-			void *p_user_pointer,
 			ObjectData &p_object_data,
-			void (*p_variable_parse)(void *p_user_pointer, ObjectData &p_object_data, VarId p_var_id, VarData &&p_value),
-			void (*p_scheduled_procedure_parse)(void *p_user_pointer, ObjectData &p_object_data, ScheduledProcedureId p_procedure_id, ScheduledProcedureSnapshot &&p_value));
+			ObjectDataSnapshot &r_object_snapshot,
+			bool p_apply_values,
+			bool p_state_hashing,
+			bool &r_has_state_hash,
+			std::uint32_t &r_state_hash);
 
 
 	void set_enabled(bool p_enabled);
@@ -1270,13 +2036,37 @@ public:
 private:
 	void try_fetch_pending_snapshot_objects();
 
+	/// Stores the values of the interpolated objects received with the last snapshot.
+	void store_interpolation_samples();
+	/// Applies the interpolated values to the interpolated objects.
+	void process_interpolation(float p_delta);
+	ObjectPendingSnapshots *get_object_pending_snapshots(ObjectNetId p_net_id);
+	/// Returns the pending snapshots of this object, reusing a released entry
+	/// when possible.
+	ObjectPendingSnapshots &fetch_object_pending_snapshots(ObjectNetId p_net_id);
+	void release_object_pending_snapshots(ObjectPendingSnapshots &p_pending);
+
+	/// Sets `last_received_server_snapshot`, reusing the memory of the
+	/// released one, and returns it.
+	Snapshot &emplace_last_received_server_snapshot();
+	void release_last_received_server_snapshot();
+
 	/// Store object data organized per controller.
 	void store_snapshot();
 
 	void store_controllers_snapshot(const RollingUpdateSnapshot &p_snapshot);
 
+	/// Checks the objects state hashes received with the snapshot against
+	/// the client snapshot with the same `input_id`. The verified objects get
+	/// the predicted values, since these are the same as the server ones.
+	/// Returns false on mismatch: the values of the mismatched objects are
+	/// requested to the server, meanwhile this snapshot can't be used.
+	bool verify_state_hashes(RollingUpdateSnapshot &r_snapshot);
+
 	void process_server_sync();
-	void process_received_server_state();
+	/// Returns true when it already resimulated the pending rewind frames of
+	/// this process.
+	bool process_received_server_state();
 
 	bool __pcr__fetch_recovery_info(
 			const FrameIndex p_input_id,
@@ -1290,11 +2080,21 @@ private:
 			const PlayerController &p_local_player_controller);
 
 	void __pcr__rewind(
-			const FrameIndex p_checkable_frame_index,
 			const int p_rewind_frame_count,
-			PeerNetworkedController *p_controller,
 			PlayerController *p_player_controller);
 
+	/// Resimulates at most `p_max_frames` of the pending frames, returns true
+	/// when the rewind is completed.
+	bool __pcr__rewind_pending_frames(
+			PeerNetworkedController *p_controller,
+			PlayerController *p_player_controller,
+			int p_max_frames);
+
+	/// Returns the amount of frames the rewind can resimulate on this frame.
+	/// NOTE: It uses the already fetched `reconciling_dolls`.
+	int fetch_rewind_frames_budget();
+	void process_pending_rewind();
+
 	void __pcr__sync__no_rewind(
 			const Snapshot &p_postponed_recover);
 
@@ -1302,18 +2102,74 @@ private:
 			const FrameIndex p_checkable_frame_index,
 			PlayerController *p_player_controller);
 
+	/// Fetches the objects of the islands to rewind, returns false when the
+	/// whole scene must be rewound.
+	bool __pcr__fetch_selective_rewind_objects(std::vector<ObjectData *> &r_objects);
+
+	void __pcr__selective_sync__rewind();
+
+	/// Removes the objects rewound selectively from the recover data, returns
+	/// true when the other objects have something to recover without rewinding.
+	bool __pcr__filter_selective_no_rewind_recover(Snapshot &r_no_rewind_recover) const;
+
+	void __pcr__selective_rewind(
+			const int p_rewind_frame_count,
+			PlayerController *p_player_controller);
+
 	void process_paused_controller_recovery();
 
+	/// Measures the memory used by the prediction history and, when over the
+	/// `client_prediction_memory_budget`, degrades to stay within it.
+	void process_prediction_memory_budget();
+	std::size_t fetch_pending_snapshots_memory_usage() const;
+
+	/// Fetches the doll controllers into `reconciling_dolls`.
+	void fetch_reconciling_dolls();
+	/// Assigns to each doll the controlled objects simulated by this snapshot,
+	/// iterating the snapshot only once for all the dolls.
+	void fetch_dolls_controlled_objects(const Snapshot &p_snapshot);
+	void dolls_store_server_snapshot(const Snapshot &p_snapshot);
+	/// NOTE: It uses the already fetched `reconciling_dolls`, so the rewind
+	///       fetches them once rather than on each rewound frame.
+	void dolls_store_client_snapshot(const Snapshot &p_snapshot);
+	/// NOTE: It uses the already fetched `reconciling_dolls`.
+	void dolls_rewind_frame_begin(FrameIndex p_frame_index, int p_rewinding_index, int p_rewinding_frame_count);
+	/// Reconciles all the dolls with the applied snapshot, then applies the
+	/// doll snapshots together.
+	void dolls_reconcile(const Snapshot &p_snapshot, int p_frame_count_to_rewind);
+
 	/// Returns the amount of frames to process for this frame.
 	int calculates_sub_ticks(const float p_delta);
 	void process_simulation(float p_delta);
 
-	bool parse_snapshot(DataBuffer &p_snapshot, bool p_is_server_snapshot);
+	/// Parses the snapshot and stores it.
+	void process_received_snapshot(DataBuffer &p_snapshot, SnapshotDecodeJob *p_decoded_snapshot);
+	bool parse_snapshot(DataBuffer &p_snapshot, bool p_is_server_snapshot, SnapshotDecodeJob *p_decoded_snapshot);
+
+	void snapshot_decoder_start();
+	/// Stops the worker thread. When `p_process_pending_snapshots` is true the
+	/// received snapshots are decoded and processed first, otherwise they are
+	/// dropped: e.g. when the scene is cleared they are no longer relevant.
+	void snapshot_decoder_stop(bool p_process_pending_snapshots);
+	/// Updates the `SnapshotDecoder::schemes`, when the objects changed.
+	void snapshot_decoder_update_schemes();
+	/// Hands the received snapshots to the worker thread, when it's idle.
+	void snapshot_decoder_submit();
+	/// Processes the snapshots decoded by the worker thread, without waiting
+	/// for it: when still decoding, they are processed by the next call.
+	void snapshot_decoder_consume();
+	/// Waits the worker thread and processes all the received snapshots, in order.
+	void snapshot_decoder_flush();
+	void snapshot_decoder_thread_main();
+	void decode_snapshot(SnapshotDecodeJob &r_job) const;
 	void finalize_object_data_synchronization(ObjectData &p_object_data);
 
-	void notify_server_full_snapshot_is_needed();
+	/// Returns false when the request was already sent, and the full snapshot
+	/// is not yet received.
+	bool notify_server_full_snapshot_is_needed();
 
 	void update_client_snapshot(Snapshot &p_snapshot);
+	void update_client_snapshot_object(Snapshot &r_snapshot, const ObjectData &p_object_data);
 	void update_simulated_objects_list(const std::vector<SimulatedObjectInfo> &p_simulated_objects);
 
 public:
@@ -1329,6 +2185,11 @@ public:
 			const bool p_skip_snapshot_applied_event_broadcast = false,
 			const bool p_skip_change_event = false,
 			const bool p_skip_scheduled_procedures = false);
+
+	void apply_snapshot_object_vars(
+			ObjectData &p_object_data,
+			const ObjectDataSnapshot &p_object_data_snapshot,
+			std::vector<std::string> *r_applied_data_info);
 };
 
 /// This is used to make sure we can safely convert any `BaseType` defined by
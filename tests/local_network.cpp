@@ -5,6 +5,8 @@
 #include "../core/peer_networked_controller.h"
 #include "../core/var_data.h"
 #include "../scene_synchronizer.h"
+#include "local_scene.h"
+#include <algorithm>
 
 NS_NAMESPACE_BEGIN
 float frand() {
@@ -66,36 +68,60 @@ void LocalNetwork::register_object(LocalNetworkInterface &p_interface) {
 	registered_objects.insert(std::make_pair(p_interface.get_owner_name(), &p_interface));
 }
 
-void LocalNetwork::rpc_send(std::string p_object_name, int p_peer_recipient, bool p_reliable, DataBuffer &&p_data_buffer) {
+void LocalNetwork::rpc_send(std::string p_object_name, int p_peer_recipient, bool p_reliable, const DataBuffer &p_data_buffer) {
+	rpc_send_multicast(
+			p_object_name,
+			std::vector<int>(1, p_peer_recipient),
+			p_reliable,
+			std::make_shared<const DataBuffer>(p_data_buffer));
+}
+
+void LocalNetwork::rpc_send_multicast(std::string p_object_name, const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const DataBuffer> &p_data_buffer) {
 	auto object_map_it = registered_objects.find(p_object_name);
 	NS_ASSERT_COND(object_map_it != registered_objects.end());
 
 	LocalNetworkInterface *object_net_interface = object_map_it->second;
 	NS_ASSERT_COND(object_net_interface != nullptr);
 
-	if (!p_reliable && network_properties && network_properties->packet_loss > frand()) {
-		// Simulating packet loss by dropping this packet right away.
-		return;
+	sent_payloads_count += 1;
+	if (store_sent_payloads) {
+		sent_payloads.push_back(p_data_buffer);
 	}
 
-	std::shared_ptr<PendingPacket> packet = std::make_shared<PendingPacket>();
+	for (int peer_recipient : p_peers_recipients) {
+		sent_bytes_count += std::size_t((p_data_buffer->total_size() + 7) / 8);
 
-	if (network_properties) {
-		packet->delay = network_properties->rtt_seconds * 0.5f;
-		if (!p_reliable && network_properties->reorder > frand()) {
-			const float reorder_delay = 0.5f;
-			packet->delay += reorder_delay * ((frand() - 0.5f) / 0.5f);
+		if (!p_reliable && network_properties && packet_loss_burst_remaining > 0) {
+			// Simulating the burst loss, by dropping the packets following a lost one.
+			packet_loss_burst_remaining -= 1;
+			continue;
+		}
+
+		if (!p_reliable && network_properties && network_properties->packet_loss > frand()) {
+			// Simulating packet loss by dropping this packet right away.
+			packet_loss_burst_remaining = network_properties->packet_loss_burst;
+			continue;
+		}
+
+		std::shared_ptr<PendingPacket> packet = std::make_shared<PendingPacket>();
+
+		if (network_properties) {
+			packet->delay = network_properties->rtt_seconds * 0.5f;
+			if (!p_reliable && network_properties->reorder > frand()) {
+				const float reorder_delay = 0.5f;
+				packet->delay += reorder_delay * ((frand() - 0.5f) / 0.5f);
+			}
+		} else {
+			packet->delay = 0.0;
 		}
-	} else {
-		packet->delay = 0.0;
-	}
 
-	packet->peer_recipient = p_peer_recipient;
-	packet->object_name = p_object_name;
-	// packet->data_buffer = std::move(p_data_buffer); // TODO use move here.
-	packet->data_buffer.copy(std::move(p_data_buffer));
+		packet->peer_recipient = peer_recipient;
+		packet->object_name = p_object_name;
+		packet->data_buffer = p_data_buffer;
 
-	sending_packets.push_back(packet);
+		sending_packets.push_back(packet);
+		sent_packets_count += 1;
+	}
 }
 
 void LocalNetwork::process(float p_delta) {
@@ -135,9 +161,14 @@ void LocalNetwork::rpc_receive_internal(int p_peer_sender, const std::shared_ptr
 	LocalNetworkInterface *object_net_interface = object_map_it->second;
 	NS_ASSERT_COND(object_net_interface != nullptr);
 
+	received_bytes_count += std::size_t((p_packet->data_buffer->total_size() + 7) / 8);
+
+	// The payload is shared with the other recipients, so it's read from a
+	// copy as it would happen when the packet is received from the wire.
+	receive_buffer.copy(*p_packet->data_buffer);
 	object_net_interface->rpc_receive(
 			p_peer_sender,
-			p_packet->data_buffer);
+			receive_buffer);
 }
 
 void LocalNetworkInterface::init(LocalNetwork &p_network, const std::string &p_unique_name, int p_authoritative_peer) {
@@ -186,9 +217,14 @@ bool LocalNetworkInterface::is_local_peer_server() const {
 	return network->get_peer() == 1;
 }
 
-void LocalNetworkInterface::rpc_send(int p_peer_recipient, bool p_reliable, DataBuffer &&p_data_buffer) {
+void LocalNetworkInterface::rpc_send(int p_peer_recipient, bool p_reliable, const DataBuffer &p_data_buffer) {
 	NS_ENSURE(network);
-	network->rpc_send(get_owner_name(), p_peer_recipient, p_reliable, std::move(p_data_buffer));
+	network->rpc_send(get_owner_name(), p_peer_recipient, p_reliable, p_data_buffer);
+}
+
+void LocalNetworkInterface::rpc_send_multicast(const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const DataBuffer> &p_data_buffer) {
+	NS_ENSURE(network);
+	network->rpc_send_multicast(get_owner_name(), p_peers_recipients, p_reliable, p_data_buffer);
 }
 
 void LocalNetworkInterface::server_update_net_stats(int p_peer, PeerData &r_peer_data) const {
@@ -206,6 +242,513 @@ void LocalNetworkInterface::server_update_net_stats(int p_peer, PeerData &r_peer
 
 NS_NAMESPACE_END
 
+namespace NS_Test {
+/// Test that the server allocates one snapshot payload per tick, no matter
+/// how many peers are listening.
+void test_local_network_snapshot_payloads() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_3_scene;
+	peer_3_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync = server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync = peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_2_scene.scene_sync = peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_3_scene.scene_sync = peer_3_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	// Notify the snapshot every frame.
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0);
+
+	const float delta = 1.0f / 60.0f;
+	for (int i = 0; i < 5; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+		peer_3_scene.process(delta);
+	}
+
+	const std::size_t peers_count = server_scene.get_network().get_connected_peers().size();
+	NS_ASSERT_COND(peers_count == 3);
+
+	// Now measure the allocations taken to notify the snapshot.
+	std::size_t sent_payloads_count = server_scene.get_network().sent_payloads_count;
+	std::size_t sent_packets_count = server_scene.get_network().sent_packets_count;
+	for (int i = 0; i < 5; i++) {
+		server_scene.process(delta);
+
+		const std::size_t tick_payloads_count = server_scene.get_network().sent_payloads_count - sent_payloads_count;
+		const std::size_t tick_packets_count = server_scene.get_network().sent_packets_count - sent_packets_count;
+		sent_payloads_count = server_scene.get_network().sent_payloads_count;
+		sent_packets_count = server_scene.get_network().sent_packets_count;
+
+		// The snapshot is sent to all the peers using a single payload, so it
+		// takes `peers_count` packets but one payload. Every other rpc sent
+		// this tick goes to one peer, with its own payload.
+		NS_ASSERT_COND(tick_packets_count >= peers_count);
+		NS_ASSERT_COND(tick_payloads_count == tick_packets_count - (peers_count - 1));
+
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+		peer_3_scene.process(delta);
+	}
+}
+
+class LocalNetworkTestObject : public NS::LocalSceneObject {
+public:
+	float value = 0.0f;
+
+	LocalNetworkTestObject() :
+		LocalSceneObject("LocalNetworkTestObject") {
+	}
+
+	virtual void on_scene_entry() override {
+		get_scene()->scene_sync->register_app_object(get_scene()->scene_sync->to_handle(this));
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		p_scene_sync.register_variable(
+				p_id,
+				"value",
+				[](NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, const NS::VarData &p_value) {
+					static_cast<LocalNetworkTestObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->value = p_value.data.f32;
+				},
+				[](const NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, NS::VarData &r_value) {
+					r_value.type = 1;
+					r_value.data.f32 = static_cast<LocalNetworkTestObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->value;
+				});
+	}
+};
+
+/// Returns the payloads sent by the server, in order, while the objects change
+/// each frame. The `r_sent_snapshots_per_frame` is set to the number of
+/// `event_sent_snapshot` emitted each frame.
+std::vector<std::vector<std::uint8_t>> fetch_server_payloads(bool p_snapshot_encoding_async, std::vector<int> &r_sent_snapshots_per_frame) {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync = server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync = peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_2_scene.scene_sync = peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	std::vector<LocalNetworkTestObject *> server_objects;
+	for (int i = 0; i < 3; i++) {
+		const std::string name = "obj_" + std::to_string(i);
+		server_objects.push_back(server_scene.add_object<LocalNetworkTestObject>(name, server_scene.get_peer()));
+		peer_1_scene.add_object<LocalNetworkTestObject>(name, server_scene.get_peer());
+		peer_2_scene.add_object<LocalNetworkTestObject>(name, server_scene.get_peer());
+	}
+
+	// Notify the snapshot every frame.
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0);
+	server_scene.scene_sync->set_snapshot_encoding_async(p_snapshot_encoding_async);
+	server_scene.get_network().store_sent_payloads = true;
+
+	int sent_snapshots = 0;
+	auto sent_snapshot_handler = server_scene.scene_sync->event_sent_snapshot.bind([&sent_snapshots](NS::FrameIndex p_frame_index, int p_peer) {
+		sent_snapshots += 1;
+	});
+
+	const float delta = 1.0f / 60.0f;
+	r_sent_snapshots_per_frame.clear();
+	for (int f = 0; f < 20; f++) {
+		for (int i = 0; i < int(server_objects.size()); i++) {
+			// Change a different set of objects each frame.
+			if ((f + i) % 2 == 0) {
+				server_objects[i]->value += 1.5f;
+			}
+		}
+
+		sent_snapshots = 0;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+		r_sent_snapshots_per_frame.push_back(sent_snapshots);
+	}
+
+	// Send the snapshots still being encoded.
+	server_scene.scene_sync->set_snapshot_encoding_async(false);
+	server_scene.process(delta);
+
+	std::vector<std::vector<std::uint8_t>> payloads;
+	for (const std::shared_ptr<const NS::DataBuffer> &payload : server_scene.get_network().sent_payloads) {
+		const std::vector<std::uint8_t> &bytes = payload->get_buffer().get_bytes();
+		const std::size_t size = std::size_t((payload->total_size() + 7) / 8);
+		NS_ASSERT_COND(size <= bytes.size());
+		payloads.emplace_back(bytes.begin(), bytes.begin() + size);
+	}
+
+	return payloads;
+}
+
+/// Test that the snapshots encoded on the worker thread are identical to the
+/// ones encoded synchronously.
+void test_local_network_async_snapshot_encoding() {
+	std::vector<int> sync_sent_snapshots;
+	std::vector<int> async_sent_snapshots;
+	const std::vector<std::vector<std::uint8_t>> sync_payloads = fetch_server_payloads(false, sync_sent_snapshots);
+	const std::vector<std::vector<std::uint8_t>> async_payloads = fetch_server_payloads(true, async_sent_snapshots);
+
+	// At least one snapshot per frame.
+	NS_ASSERT_COND(sync_payloads.size() >= 20);
+	NS_ASSERT_COND(sync_payloads == async_payloads);
+
+	// The async snapshots are notified as sent one frame later, when they are
+	// actually sent.
+	NS_ASSERT_COND(async_sent_snapshots.size() == sync_sent_snapshots.size());
+	NS_ASSERT_COND(async_sent_snapshots[0] == 0);
+	for (std::size_t f = 1; f < async_sent_snapshots.size(); f++) {
+		NS_ASSERT_COND(async_sent_snapshots[f] == sync_sent_snapshots[f - 1]);
+	}
+	NS_ASSERT_COND(sync_sent_snapshots.back() == 2);
+}
+
+class LocalNetworkControlledObject : public NS::LocalSceneObject {
+public:
+	float position = 0.0f;
+	bool previous_input = false;
+
+	LocalNetworkControlledObject() :
+		LocalSceneObject("LocalNetworkControlledObject") {
+	}
+
+	virtual void on_scene_entry() override {
+		if (get_scene()->scene_sync->is_server()) {
+			get_scene()->scene_sync->register_app_object(get_scene()->scene_sync->to_handle(this));
+		}
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		p_scene_sync.setup_controller(
+				p_id,
+				[this](float p_delta, NS::DataBuffer &r_buffer) {
+					// Alternate the input each frame, so the inputs are never merged.
+					previous_input = !previous_input;
+					r_buffer.add(previous_input);
+				},
+				[](NS::DataBuffer &p_buffer_A, NS::DataBuffer &p_buffer_B) {
+					return p_buffer_A.read_bool() != p_buffer_B.read_bool();
+				},
+				[this](float p_delta, NS::DataBuffer &p_buffer) {
+					position += p_buffer.read_bool() ? 1.0f : -1.0f;
+				});
+
+		if (p_scene_sync.is_server()) {
+			p_scene_sync.set_controlled_by_peer(p_id, authoritative_peer_id);
+		}
+
+		p_scene_sync.register_variable(
+				p_id,
+				"position",
+				[](NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, const NS::VarData &p_value) {
+					static_cast<LocalNetworkControlledObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->position = p_value.data.f32;
+				},
+				[](const NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, NS::VarData &r_value) {
+					r_value.type = 1;
+					r_value.data.f32 = static_cast<LocalNetworkControlledObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->position;
+				});
+	}
+};
+
+/// Test that the server forwards the dolls inputs using a single packet per
+/// peer each tick, containing the redundant inputs to recover the lost packets.
+void test_local_network_dolls_inputs_forwarding() {
+	const int peers_count = 6;
+
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync = server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	std::vector<std::unique_ptr<NS::LocalScene>> peer_scenes;
+	for (int i = 0; i < peers_count; i++) {
+		peer_scenes.push_back(std::make_unique<NS::LocalScene>());
+		peer_scenes.back()->start_as_client(server_scene);
+		peer_scenes.back()->scene_sync = peer_scenes.back()->add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	}
+
+	// Each peer controls an object, which is a doll for the other peers.
+	for (const std::unique_ptr<NS::LocalScene> &controlling_scene : peer_scenes) {
+		const std::string name = "controlled_" + std::to_string(controlling_scene->get_peer());
+		server_scene.add_object<LocalNetworkControlledObject>(name, controlling_scene->get_peer());
+		for (const std::unique_ptr<NS::LocalScene> &peer_scene : peer_scenes) {
+			peer_scene->add_object<LocalNetworkControlledObject>(name, controlling_scene->get_peer());
+		}
+	}
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(1.0f / 10.0f);
+
+	const float delta = 1.0f / 60.0f;
+	auto process = [&]() {
+		server_scene.process(delta);
+		for (const std::unique_ptr<NS::LocalScene> &peer_scene : peer_scenes) {
+			peer_scene->process(delta);
+		}
+	};
+
+	for (int f = 0; f < 30; f++) {
+		process();
+	}
+
+	const NS::PeerNetworkedController *doll_controller = peer_scenes[0]->scene_sync->get_controller_for_peer(peer_scenes[1]->get_peer());
+	NS_ASSERT_COND(doll_controller && doll_controller->get_doll_controller());
+	const NS::FrameIndex doll_last_known_input = doll_controller->get_doll_controller()->last_known_frame_index();
+	NS_ASSERT_COND(doll_last_known_input != NS::FrameIndex::NONE);
+
+	// Measure the messages sent by the server for each tick, without the
+	// snapshots and the netstats.
+	server_scene.scene_sync->set_frame_confirmation_timespan(1000.0f);
+	server_scene.scene_sync->set_netstats_update_interval_sec(1000.0f);
+	process();
+
+	const int frames_count = 60;
+	const std::size_t sent_packets_count = server_scene.get_network().sent_packets_count;
+	const std::size_t sent_bytes_count = server_scene.get_network().sent_bytes_count;
+	for (int f = 0; f < frames_count; f++) {
+		process();
+	}
+	const float packets_per_tick = float(server_scene.get_network().sent_packets_count - sent_packets_count) / float(frames_count);
+	const float bytes_per_tick = float(server_scene.get_network().sent_bytes_count - sent_bytes_count) / float(frames_count);
+	server_scene.scene_sync->get_debugger().print(NS::INFO, "Forwarded the inputs of " + std::to_string(peers_count) + " peers using " + std::to_string(packets_per_tick) + " messages and " + std::to_string(bytes_per_tick) + " bytes per tick.");
+
+	// Each peer receives a single inputs packet per tick, rather than a packet
+	// per doll.
+	NS_ASSERT_COND(packets_per_tick == float(peers_count));
+	// Each tick the packet contains the new input of each doll, and the
+	// previous ones as redundancy: the 6 bytes header and the inputs, mostly
+	// encoded as duplicates, take less than 32 bytes.
+	NS_ASSERT_COND(bytes_per_tick < float(peers_count * (peers_count - 1) * 32));
+
+	// The dolls kept receiving the inputs.
+	NS_ASSERT_COND(doll_last_known_input < doll_controller->get_doll_controller()->last_known_frame_index());
+
+	// With packet loss, the inputs are forwarded again with the next ones, so
+	// the dolls receive all of them.
+	const NS::ServerController &server_controller = *server_scene.scene_sync->get_controller_for_peer(peer_scenes[1]->get_peer())->get_server_controller();
+	const std::size_t forwarding_capacity = server_controller.forwarding_frames_input.capacity();
+	const NS::FrameIndex doll_last_known_input_before_loss = doll_controller->get_doll_controller()->last_known_frame_index();
+
+	NS::LocalNetworkProps network_properties;
+	network_properties.packet_loss = 0.2f;
+	server_scene.get_network().network_properties = &network_properties;
+	srand(1);
+	for (int f = 0; f < frames_count; f++) {
+		process();
+	}
+	server_scene.get_network().network_properties = nullptr;
+
+	const NS::DollController &doll = *doll_controller->get_doll_controller();
+	NS_ASSERT_COND(doll_last_known_input_before_loss < doll.last_known_frame_index());
+	for (NS::FrameIndex input_id = doll.frames_input.front_index(); input_id <= doll.frames_input.back_index(); input_id += 1) {
+		NS_ASSERT_COND(doll.frames_input.find(input_id));
+	}
+
+	// The inputs to forward are stored without allocating new slots.
+	NS_ASSERT_COND(server_controller.forwarding_frames_input.capacity() == forwarding_capacity);
+}
+
+/// Test that during a latency spike the client stays within the prediction
+/// memory budget, pausing the prediction rather than logging each frame, and
+/// that the prediction recovers once the spike is over.
+void test_local_network_prediction_memory_budget_latency_spike() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync = server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+	peer_1_scene.scene_sync = peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+	peer_2_scene.scene_sync = peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	// Each peer controls an object, which is a doll for the other peer.
+	for (NS::LocalScene *controlling_scene : { &peer_1_scene, &peer_2_scene }) {
+		const std::string name = "controlled_" + std::to_string(controlling_scene->get_peer());
+		server_scene.add_object<LocalNetworkControlledObject>(name, controlling_scene->get_peer());
+		peer_1_scene.add_object<LocalNetworkControlledObject>(name, controlling_scene->get_peer());
+		peer_2_scene.add_object<LocalNetworkControlledObject>(name, controlling_scene->get_peer());
+	}
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(1.0f / 30.0f);
+
+	NS::LocalNetworkProps network_properties;
+	server_scene.get_network().network_properties = &network_properties;
+	peer_1_scene.get_network().network_properties = &network_properties;
+	peer_2_scene.get_network().network_properties = &network_properties;
+
+	const float delta = 1.0f / 60.0f;
+	auto process = [&]() {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	};
+
+	NS::SceneSynchronizerBase &peer_1_sync = *peer_1_scene.scene_sync;
+	const NS::ClientSynchronizer &peer_1_client_sync = *static_cast<NS::ClientSynchronizer *>(peer_1_sync.get_synchronizer_internal());
+	const LocalNetworkControlledObject &peer_1_controlled = *peer_1_scene.fetch_object<LocalNetworkControlledObject>(("controlled_" + std::to_string(peer_1_scene.get_peer())).c_str());
+
+	// Measure the memory used by a predicted frame, using a big budget.
+	peer_1_sync.set_client_prediction_memory_budget(1024 * 1024 * 1024);
+	for (int f = 0; f < 30; f++) {
+		process();
+	}
+	const NS::PredictionMemoryReport initial_report = peer_1_sync.client_get_prediction_memory_report();
+	NS_ASSERT_COND(initial_report.frame_memory_bytes > 0);
+	NS_ASSERT_COND(initial_report.pauses_count == 0);
+
+	// The latency spike makes the client predict more frames than the budget
+	// fits, so the prediction gets paused.
+	const std::uint64_t budget = initial_report.frame_memory_bytes * 8;
+	peer_1_sync.set_client_prediction_memory_budget(budget);
+	network_properties.rtt_seconds = 0.5f;
+	for (int f = 0; f < 90; f++) {
+		process();
+		NS_ASSERT_COND(peer_1_sync.client_get_prediction_memory_report().memory_usage_bytes <= budget);
+	}
+
+	const NS::PredictionMemoryReport spike_report = peer_1_sync.client_get_prediction_memory_report();
+	NS_ASSERT_COND(spike_report.paused_frames_count > 0);
+	// Each pause lasts many processes, and it's logged only once.
+	NS_ASSERT_COND(spike_report.pauses_count > 0);
+	NS_ASSERT_COND(spike_report.pauses_count < spike_report.paused_frames_count);
+
+	// Once the spike is over, the prediction recovers.
+	// NOTE: The latency decreases slowly, so the packets are not reordered.
+	while (network_properties.rtt_seconds > 0.0f) {
+		network_properties.rtt_seconds = std::max(network_properties.rtt_seconds - 0.01f, 0.0f);
+		process();
+		NS_ASSERT_COND(peer_1_sync.client_get_prediction_memory_report().memory_usage_bytes <= budget);
+	}
+	for (int f = 0; f < 60; f++) {
+		process();
+	}
+
+	const NS::PredictionMemoryReport recovered_report = peer_1_sync.client_get_prediction_memory_report();
+	const float position = peer_1_controlled.position;
+	const NS::FrameIndex input_id = peer_1_client_sync.player_controller->get_current_frame_index();
+	for (int f = 0; f < 60; f++) {
+		process();
+		NS_ASSERT_COND(peer_1_sync.client_get_prediction_memory_report().memory_usage_bytes <= budget);
+	}
+
+	// The client processed each frame, without pausing nor degrading.
+	const NS::PredictionMemoryReport final_report = peer_1_sync.client_get_prediction_memory_report();
+	NS_ASSERT_COND(final_report.paused_frames_count == recovered_report.paused_frames_count);
+	NS_ASSERT_COND(final_report.pauses_count == recovered_report.pauses_count);
+	NS_ASSERT_COND(final_report.degradations_count == recovered_report.degradations_count);
+	NS_ASSERT_COND(peer_1_client_sync.player_controller->get_current_frame_index() == input_id + 60);
+	// The inputs alternate each frame, so the position is back after an even
+	// number of frames.
+	NS_ASSERT_COND(peer_1_controlled.position == position);
+	NS_ASSERT_COND(!peer_1_client_sync.prediction_memory_paused);
+
+	server_scene.get_network().network_properties = nullptr;
+	peer_1_scene.get_network().network_properties = nullptr;
+	peer_2_scene.get_network().network_properties = nullptr;
+}
+
+/// Test that the client frees the snapshots of the objects not yet registered
+/// to stay within the prediction memory budget, and that it counts only the
+/// full snapshot requests actually sent to the server.
+void test_local_network_prediction_memory_budget_pending_snapshots() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync = server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+	peer_1_scene.scene_sync = peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	const std::string controlled_name = "controlled_" + std::to_string(peer_1_scene.get_peer());
+	server_scene.add_object<LocalNetworkControlledObject>(controlled_name, peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkControlledObject>(controlled_name, peer_1_scene.get_peer());
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(1.0f / 30.0f);
+
+	// The latency makes the client predict more frames than the budget fits.
+	NS::LocalNetworkProps network_properties;
+	network_properties.rtt_seconds = 0.2f;
+	server_scene.get_network().network_properties = &network_properties;
+	peer_1_scene.get_network().network_properties = &network_properties;
+
+	const float delta = 1.0f / 60.0f;
+	std::vector<LocalNetworkTestObject *> server_objects;
+	auto process = [&]() {
+		// The objects change each frame, so each snapshot contains them.
+		for (LocalNetworkTestObject *object : server_objects) {
+			object->value += 1.0f;
+		}
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	};
+
+	NS::SceneSynchronizerBase &peer_1_sync = *peer_1_scene.scene_sync;
+	const NS::ClientSynchronizer &peer_1_client_sync = *static_cast<NS::ClientSynchronizer *>(peer_1_sync.get_synchronizer_internal());
+
+	peer_1_sync.set_client_prediction_memory_budget(1024 * 1024 * 1024);
+	for (int f = 0; f < 30; f++) {
+		process();
+	}
+
+	// These objects are registered on the server only, so the client stores
+	// their snapshots until they get registered.
+	for (int i = 0; i < 10; i++) {
+		server_objects.push_back(server_scene.add_object<LocalNetworkTestObject>("late_obj_" + std::to_string(i), server_scene.get_peer()));
+	}
+	for (int f = 0; f < 30; f++) {
+		process();
+	}
+	NS_ASSERT_COND(!peer_1_client_sync.objects_pending_snapshots.empty());
+	const NS::PredictionMemoryReport initial_report = peer_1_sync.client_get_prediction_memory_report();
+	NS_ASSERT_COND(initial_report.degradations_count == 0);
+	NS_ASSERT_COND(initial_report.full_snapshot_requests_count == 0);
+
+	// The budget fits few predicted frames, so the client degrades.
+	const std::uint64_t budget = initial_report.frame_memory_bytes * 8;
+	peer_1_sync.set_client_prediction_memory_budget(budget);
+
+	// The client notifies the need of the full snapshot at most once per
+	// received snapshot.
+	int received_snapshots = 0;
+	auto received_snapshot_handler = peer_1_sync.event_received_server_snapshot.bind([&received_snapshots](const NS::Snapshot &p_snapshot) {
+		received_snapshots += 1;
+	});
+
+	std::uint64_t full_snapshot_requests_count = 0;
+	for (int f = 0; f < 60; f++) {
+		process();
+		const NS::PredictionMemoryReport report = peer_1_sync.client_get_prediction_memory_report();
+		if (report.full_snapshot_requests_count > full_snapshot_requests_count) {
+			// The pending snapshots got freed, not just released to be reused.
+			NS_ASSERT_COND(peer_1_client_sync.objects_pending_snapshots.capacity() == 0);
+			full_snapshot_requests_count = report.full_snapshot_requests_count;
+		}
+	}
+
+	const NS::PredictionMemoryReport report = peer_1_sync.client_get_prediction_memory_report();
+	NS_ASSERT_COND(report.degradations_count > 0);
+	NS_ASSERT_COND(report.full_snapshot_requests_count > 0);
+	// The requests not sent, since one was already sent, are not counted.
+	NS_ASSERT_COND(report.full_snapshot_requests_count <= std::uint64_t(received_snapshots) + 1);
+
+	server_scene.get_network().network_properties = nullptr;
+	peer_1_scene.get_network().network_properties = nullptr;
+}
+};
+
 /// Test that the LocalNetwork is able to sync stuff.
 void NS_Test::test_local_network() {
 
@@ -443,4 +986,39 @@ void NS_Test::test_local_network() {
 
 	NS_ASSERT_COND(server_rpc_executed_by[2] == server.get_peer()); // Make sure this was executed locally too.
 	NS_ASSERT_COND(peer_2_rpc_executed_by[3] == server.get_peer()); // Make sure this was executed remotely.
+
+	// ---------------------------------------------------------- Test multicast.
+	server_obj_1.get_rpcs_info()[0].call_local = false;
+
+	const std::size_t sent_payloads_count = server.sent_payloads_count;
+	const std::size_t sent_packets_count = server.sent_packets_count;
+	const std::size_t sent_bytes_count = server.sent_bytes_count;
+	const std::size_t peer_1_received_bytes_count = peer_1.received_bytes_count;
+	const std::size_t peer_2_received_bytes_count = peer_2.received_bytes_count;
+
+	rpc_handle_server.rpc(server_obj_1, std::vector<int>{ peer_1.get_peer(), peer_2.get_peer() }, true, 22, 44.0, vec);
+
+	// Make sure the two packets share the same payload.
+	NS_ASSERT_COND(server.sent_payloads_count == sent_payloads_count + 1);
+	NS_ASSERT_COND(server.sent_packets_count == sent_packets_count + 2);
+
+	server.process(delta);
+	peer_1.process(delta);
+	peer_2.process(delta);
+
+	// The bytes are counted per packet.
+	NS_ASSERT_COND(server.sent_bytes_count > sent_bytes_count);
+	NS_ASSERT_COND(server.sent_bytes_count - sent_bytes_count == (peer_1.received_bytes_count - peer_1_received_bytes_count) + (peer_2.received_bytes_count - peer_2_received_bytes_count));
+
+	NS_ASSERT_COND(server_rpc_executed_by.size() == 3);
+	NS_ASSERT_COND(peer_1_rpc_executed_by.size() == 2);
+	NS_ASSERT_COND(peer_1_rpc_executed_by[1] == server.get_peer());
+	NS_ASSERT_COND(peer_2_rpc_executed_by.size() == 5);
+	NS_ASSERT_COND(peer_2_rpc_executed_by[4] == server.get_peer());
+
+	test_local_network_snapshot_payloads();
+	test_local_network_async_snapshot_encoding();
+	test_local_network_dolls_inputs_forwarding();
+	test_local_network_prediction_memory_budget_latency_spike();
+	test_local_network_prediction_memory_budget_pending_snapshots();
 }
\ No newline at end of file
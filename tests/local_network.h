@@ -22,6 +22,9 @@ struct LocalNetworkProps {
 
 	// From 0.0 to 1.0
 	float packet_loss = 0.0;
+
+	// The unreliable packets lost right after a lost one, to simulate the bursts.
+	int packet_loss_burst = 0;
 };
 
 struct PendingPacket {
@@ -30,7 +33,8 @@ struct PendingPacket {
 	float delay = 0.0;
 	int peer_recipient = -1;
 	std::string object_name;
-	DataBuffer data_buffer;
+	// The payload is shared by all the packets sent via multicast.
+	std::shared_ptr<const DataBuffer> data_buffer;
 };
 
 class LocalNetwork {
@@ -51,6 +55,25 @@ public:
 	Processor<int> connected_event;
 	Processor<int> disconnected_event;
 
+	/// The payloads sent so far: the packets sent via multicast share one payload.
+	std::size_t sent_payloads_count = 0;
+	/// The packets sent so far.
+	std::size_t sent_packets_count = 0;
+	/// The bytes sent so far, counting the lost packets too.
+	std::size_t sent_bytes_count = 0;
+	/// The bytes received so far.
+	std::size_t received_bytes_count = 0;
+	/// The unreliable packets still to drop, because of the current loss burst.
+	int packet_loss_burst_remaining = 0;
+
+	/// When true, the sent payloads are stored into `sent_payloads`.
+	bool store_sent_payloads = false;
+	std::vector<std::shared_ptr<const DataBuffer>> sent_payloads;
+
+private:
+	/// The received packets are read from this buffer, so its memory is reused.
+	DataBuffer receive_buffer;
+
 public:
 	int get_peer() const;
 
@@ -70,7 +93,8 @@ public:
 
 	void register_object(LocalNetworkInterface &p_interface);
 
-	void rpc_send(std::string p_object_name, int p_peer_recipient, bool p_reliable, NS::DataBuffer &&p_data_buffer);
+	void rpc_send(std::string p_object_name, int p_peer_recipient, bool p_reliable, const NS::DataBuffer &p_data_buffer);
+	void rpc_send_multicast(std::string p_object_name, const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const NS::DataBuffer> &p_data_buffer);
 
 	void process(float p_delta);
 
@@ -122,7 +146,8 @@ public:
 	/// Can be used to verify if the local peer is the server.
 	virtual bool is_local_peer_server() const override;
 
-	virtual void rpc_send(int p_peer_recipient, bool p_reliable, NS::DataBuffer &&p_data_buffer) override;
+	virtual void rpc_send(int p_peer_recipient, bool p_reliable, const NS::DataBuffer &p_data_buffer) override;
+	virtual void rpc_send_multicast(const std::vector<int> &p_peers_recipients, bool p_reliable, const std::shared_ptr<const NS::DataBuffer> &p_data_buffer) override;
 
 	virtual void server_update_net_stats(int p_peer, PeerData &r_peer_data) const override;
 };
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <cmath>
 #include <cstring>
 
 NS_NAMESPACE_BEGIN
@@ -31,6 +32,24 @@ void (*prev_var_data_encode_func)(NS::DataBuffer &r_buffer, const NS::VarData &p
 void (*prev_var_data_decode_func)(NS::VarData &r_val, NS::DataBuffer &p_buffer, std::uint8_t p_variable_type) = nullptr;
 bool (*prev_var_data_compare_func)(const VarData &p_A, const VarData &p_B) = nullptr;
 std::string (*prev_var_data_stringify_func)(const VarData &p_var_data, bool p_verbose) = nullptr;
+bool (*prev_var_data_compare_approx_func)(const VarData &p_A, const VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance) = nullptr;
+std::uint32_t (*prev_var_data_hash_func)(const VarData &p_val, std::uint32_t p_seed) = nullptr;
+bool (*prev_var_data_interpolate_func)(VarData &r_result, const VarData &p_A, const VarData &p_B, float p_alpha) = nullptr;
+
+bool local_scene_is_equal_approx(double p_A, double p_B, float p_absolute_tolerance, float p_relative_tolerance) {
+	return std::abs(p_A - p_B) <= (p_absolute_tolerance + (p_relative_tolerance * std::abs(p_A)));
+}
+
+// FNV-1a
+std::uint32_t local_scene_hash_bytes(const void *p_bytes, std::size_t p_size, std::uint32_t p_hash) {
+	const std::uint8_t *bytes = static_cast<const std::uint8_t *>(p_bytes);
+	std::uint32_t hash = p_hash ^ 2166136261u;
+	for (std::size_t i = 0; i < p_size; i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
 
 void LocalSceneSynchronizer::install_local_scene_sync() {
 	// Store the already set functions, so we can restore it again after the tests are done.
@@ -38,6 +57,9 @@ void LocalSceneSynchronizer::install_local_scene_sync() {
 	prev_var_data_decode_func = SceneSynchronizerBase::var_data_decode_func;
 	prev_var_data_compare_func = SceneSynchronizerBase::var_data_compare_func;
 	prev_var_data_stringify_func = SceneSynchronizerBase::var_data_stringify_func;
+	prev_var_data_compare_approx_func = SceneSynchronizerBase::var_data_compare_approx_func;
+	prev_var_data_hash_func = SceneSynchronizerBase::var_data_hash_func;
+	prev_var_data_interpolate_func = SceneSynchronizerBase::var_data_interpolate_func;
 
 	install_synchronizer(
 			[](NS::DataBuffer &r_buffer, const NS::VarData &p_val) {
@@ -49,6 +71,9 @@ void LocalSceneSynchronizer::install_local_scene_sync() {
 					for (int v : val) {
 						r_buffer.add(v);
 					}
+				} else if (p_val.type == 4) {
+					// Lossy Vector3: networked at half precision.
+					r_buffer.add_vector3(p_val.data.vec_f32.x, p_val.data.vec_f32.y, p_val.data.vec_f32.z, NS::DataBuffer::COMPRESSION_LEVEL_2);
 				} else {
 					r_buffer.add_bits(reinterpret_cast<const uint8_t *>(&p_val.data), sizeof(p_val.data) * 8);
 					// The shared buffer must have the type set to 3.
@@ -67,6 +92,9 @@ void LocalSceneSynchronizer::install_local_scene_sync() {
 						array.push_back(v);
 					}
 					r_val.shared_buffer = std::make_shared<std::vector<int>>(array);
+				} else if (r_val.type == 4) {
+					memset(&r_val.data, 0, sizeof(r_val.data));
+					p_buffer.read_vector3(r_val.data.vec_f32.x, r_val.data.vec_f32.y, r_val.data.vec_f32.z, NS::DataBuffer::COMPRESSION_LEVEL_2);
 				} else {
 					p_buffer.read_bits(reinterpret_cast<uint8_t *>(&r_val.data), sizeof(r_val.data) * 8);
 				}
@@ -95,6 +123,8 @@ void LocalSceneSynchronizer::install_local_scene_sync() {
 					return std::string("[" + std::to_string(p_var_data.data.vec.x) + ", " + std::to_string(p_var_data.data.vec.y) + ", " + std::to_string(p_var_data.data.vec.z) + "]");
 				} else if (p_var_data.type == 3) {
 					return std::string("[Array of ints]");
+				} else if (p_var_data.type == 4) {
+					return std::string("[" + std::to_string(p_var_data.data.vec_f32.x) + ", " + std::to_string(p_var_data.data.vec_f32.y) + ", " + std::to_string(p_var_data.data.vec_f32.z) + "]");
 				} else {
 					return std::string("[No stringify supported for this VarData type: `" + std::to_string(p_var_data.type) + "`]");
 				}
@@ -102,6 +132,63 @@ void LocalSceneSynchronizer::install_local_scene_sync() {
 			print_line_func,
 			print_code_message_func,
 			print_flush_stdout_func);
+
+	install_var_data_compare_approx(
+			[](const NS::VarData &p_A, const NS::VarData &p_B, float p_absolute_tolerance, float p_relative_tolerance) -> bool {
+				if (p_A.type != p_B.type) {
+					return false;
+				}
+				if (p_A.type == 1) {
+					return local_scene_is_equal_approx(p_A.data.f32, p_B.data.f32, p_absolute_tolerance, p_relative_tolerance);
+				} else if (p_A.type == 2) {
+					return local_scene_is_equal_approx(p_A.data.vec.x, p_B.data.vec.x, p_absolute_tolerance, p_relative_tolerance) &&
+							local_scene_is_equal_approx(p_A.data.vec.y, p_B.data.vec.y, p_absolute_tolerance, p_relative_tolerance) &&
+							local_scene_is_equal_approx(p_A.data.vec.z, p_B.data.vec.z, p_absolute_tolerance, p_relative_tolerance);
+				} else if (p_A.type == 4) {
+					return local_scene_is_equal_approx(p_A.data.vec_f32.x, p_B.data.vec_f32.x, p_absolute_tolerance, p_relative_tolerance) &&
+							local_scene_is_equal_approx(p_A.data.vec_f32.y, p_B.data.vec_f32.y, p_absolute_tolerance, p_relative_tolerance) &&
+							local_scene_is_equal_approx(p_A.data.vec_f32.z, p_B.data.vec_f32.z, p_absolute_tolerance, p_relative_tolerance);
+				} else {
+					// The other types are always compared strictly.
+					return SceneSynchronizerBase::var_data_compare_func(p_A, p_B);
+				}
+			});
+
+	install_var_data_hash(
+			[](const NS::VarData &p_val, std::uint32_t p_seed) -> std::uint32_t {
+				std::uint32_t hash = local_scene_hash_bytes(&p_val.type, sizeof(p_val.type), p_seed);
+				if (p_val.type == 1) {
+					return local_scene_hash_bytes(&p_val.data.f32, sizeof(p_val.data.f32), hash);
+				} else if (p_val.type == 3) {
+					const std::vector<int> &val = *std::static_pointer_cast<std::vector<int>>(p_val.shared_buffer);
+					return local_scene_hash_bytes(val.data(), val.size() * sizeof(int), hash);
+				} else {
+					return local_scene_hash_bytes(&p_val.data, sizeof(p_val.data), hash);
+				}
+			});
+
+	install_var_data_interpolate(
+			[](NS::VarData &r_result, const NS::VarData &p_A, const NS::VarData &p_B, float p_alpha) -> bool {
+				if (p_A.type != p_B.type) {
+					return false;
+				}
+				r_result.type = p_A.type;
+				if (p_A.type == 1) {
+					r_result.data.f32 = p_A.data.f32 + ((p_B.data.f32 - p_A.data.f32) * p_alpha);
+				} else if (p_A.type == 2) {
+					r_result.data.vec.x = p_A.data.vec.x + ((p_B.data.vec.x - p_A.data.vec.x) * p_alpha);
+					r_result.data.vec.y = p_A.data.vec.y + ((p_B.data.vec.y - p_A.data.vec.y) * p_alpha);
+					r_result.data.vec.z = p_A.data.vec.z + ((p_B.data.vec.z - p_A.data.vec.z) * p_alpha);
+				} else if (p_A.type == 4) {
+					r_result.data.vec_f32.x = p_A.data.vec_f32.x + ((p_B.data.vec_f32.x - p_A.data.vec_f32.x) * p_alpha);
+					r_result.data.vec_f32.y = p_A.data.vec_f32.y + ((p_B.data.vec_f32.y - p_A.data.vec_f32.y) * p_alpha);
+					r_result.data.vec_f32.z = p_A.data.vec_f32.z + ((p_B.data.vec_f32.z - p_A.data.vec_f32.z) * p_alpha);
+				} else {
+					// The other types are not interpolable.
+					return false;
+				}
+				return true;
+			});
 }
 
 void LocalSceneSynchronizer::uninstall_local_scene_sync() {
@@ -119,6 +206,15 @@ void LocalSceneSynchronizer::uninstall_local_scene_sync() {
 	prev_var_data_decode_func = nullptr;
 	prev_var_data_compare_func = nullptr;
 	prev_var_data_stringify_func = nullptr;
+
+	install_var_data_compare_approx(prev_var_data_compare_approx_func);
+	prev_var_data_compare_approx_func = nullptr;
+
+	install_var_data_hash(prev_var_data_hash_func);
+	prev_var_data_hash_func = nullptr;
+
+	install_var_data_interpolate(prev_var_data_interpolate_func);
+	prev_var_data_interpolate_func = nullptr;
 }
 
 void LocalSceneSynchronizer::on_scene_entry() {
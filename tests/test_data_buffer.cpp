@@ -3,6 +3,7 @@
 #include "../core/data_buffer.h"
 #include "../core/ensure.h"
 #include "../core/net_math.h"
+#include "../core/network_codec.h"
 #include "../core/scene_synchronizer_debugger.h"
 
 NS::SceneSynchronizerDebugger debugger;
@@ -1122,6 +1123,105 @@ void test_data_buffer_compare() {
 	NS_ASSERT_COND(first_buffer == second_buffer);
 }
 
+void test_data_buffer_object_net_id_set_scene(const std::vector<NS::ObjectNetId> &p_ids, int p_max_bits) {
+	NS::DataBuffer buffer;
+	buffer.begin_write(debugger, 0);
+	buffer.add(true);
+	NS::encode_object_net_id_set(p_ids, buffer);
+	buffer.add(false);
+	const int set_size = buffer.get_bit_offset() - buffer.get_bool_size() * 2;
+
+	// The encoder always picks the cheapest encoding.
+	int cheapest_size = std::numeric_limits<int>::max();
+	for (NS::ObjectNetIdSetEncoding encoding : { NS::ObjectNetIdSetEncoding::SORTED_DELTA, NS::ObjectNetIdSetEncoding::BITSET, NS::ObjectNetIdSetEncoding::RUN_LENGTH }) {
+		cheapest_size = std::min(cheapest_size, NS::get_object_net_id_set_encoded_size(p_ids, encoding));
+	}
+	NS_ASSERT_COND(set_size == cheapest_size);
+	NS_ASSERT_COND(set_size <= p_max_bits);
+
+	// Writing each id as uint16 with a terminator would take this much.
+	const int legacy_size = int(p_ids.size() + 1) * 16;
+	NS_ASSERT_COND(set_size < legacy_size);
+
+	buffer.begin_read(debugger);
+	NS_ASSERT_COND(buffer.read_bool());
+	std::vector<NS::ObjectNetId> decoded_ids;
+	NS_ASSERT_COND(NS::decode_object_net_id_set(decoded_ids, buffer));
+	NS_ASSERT_COND(decoded_ids == p_ids);
+	NS_ASSERT_COND(!buffer.read_bool());
+	NS_ASSERT_COND(!buffer.is_buffer_failed());
+}
+
+void test_data_buffer_object_net_id_set() {
+	// Empty set.
+	test_data_buffer_object_net_id_set_scene({}, 1);
+
+	// Single id.
+	test_data_buffer_object_net_id_set_scene({ NS::ObjectNetId{ { 123 } } }, 24);
+
+	// The set order is not preserved, the ids are decoded sorted.
+	{
+		NS::DataBuffer buffer;
+		buffer.begin_write(debugger, 0);
+		NS::encode_object_net_id_set({ NS::ObjectNetId{ { 9 } }, NS::ObjectNetId{ { 2 } }, NS::ObjectNetId{ { 5 } } }, buffer);
+		buffer.begin_read(debugger);
+		std::vector<NS::ObjectNetId> decoded_ids;
+		NS_ASSERT_COND(NS::decode_object_net_id_set(decoded_ids, buffer));
+		NS_ASSERT_COND(decoded_ids.size() == 3);
+		NS_ASSERT_COND(decoded_ids[0].id == 2);
+		NS_ASSERT_COND(decoded_ids[1].id == 5);
+		NS_ASSERT_COND(decoded_ids[2].id == 9);
+	}
+
+	// Reading a corrupted set, containing `ObjectNetId::NONE`, fails.
+	{
+		NS::DataBuffer buffer;
+		buffer.begin_write(debugger, 0);
+		// Has ids.
+		buffer.add(true);
+		// The SORTED_DELTA encoding.
+		const std::uint8_t encoding = std::uint8_t(NS::ObjectNetIdSetEncoding::SORTED_DELTA);
+		buffer.add_bits(&encoding, 2);
+		// A single id: the count width is 0.
+		const std::uint8_t count_width = 0;
+		buffer.add_bits(&count_width, 5);
+		buffer.add(NS::ObjectNetId::NONE.id);
+		buffer.begin_read(debugger);
+		std::vector<NS::ObjectNetId> decoded_ids;
+		NS_ASSERT_COND(!NS::decode_object_net_id_set(decoded_ids, buffer));
+	}
+
+	// Measure the sets of scenes having 100, 1k and 10k objects.
+	for (int objects_count : { 100, 1000, 10000 }) {
+		// A fresh scene, all the objects are simulated.
+		std::vector<NS::ObjectNetId> dense_ids;
+		// A scene where objects got destroyed and spawned: a quarter of the ids are unused.
+		std::vector<NS::ObjectNetId> churned_ids;
+		// The objects controlled by a single peer: one every eight.
+		std::vector<NS::ObjectNetId> peer_ids;
+
+		std::uint32_t seed = 7;
+		for (int i = 0; i < objects_count; i++) {
+			const NS::ObjectNetId id{ { NS::ObjectNetId::IdType(i) } };
+			dense_ids.push_back(id);
+			seed = seed * 1103515245 + 12345;
+			if (((seed >> 16) % 4) != 0) {
+				churned_ids.push_back(id);
+			}
+			if ((i % 8) == 0) {
+				peer_ids.push_back(id);
+			}
+		}
+
+		// Constant size, no matter how many objects.
+		test_data_buffer_object_net_id_set_scene(dense_ids, 64);
+		// About one bit per object.
+		test_data_buffer_object_net_id_set_scene(churned_ids, objects_count + 64);
+		// About three bits per object.
+		test_data_buffer_object_net_id_set_scene(peer_ids, int(peer_ids.size()) * 3 + 64);
+	}
+}
+
 void NS_Test::test_data_buffer() {
 	test_data_buffer_string();
 	test_data_buffer_u16string();
@@ -1152,4 +1252,5 @@ void NS_Test::test_data_buffer() {
 	test_data_buffer_unaligned_write_read();
 	test_data_buffer_slice_copy();
 	test_data_buffer_compare();
+	test_data_buffer_object_net_id_set();
 }
\ No newline at end of file
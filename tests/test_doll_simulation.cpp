@@ -901,6 +901,503 @@ void test_simulation_with_wrong_input() {
 	}
 }
 
+void assert_batched_doll_reconciliation(NS::LocalScene &p_scene, NS::LocalScene &p_doll_scene, TDSControlledObject *p_doll_object) {
+	NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(p_scene.scene_sync->get_synchronizer_internal());
+	NS::DollController *doll = p_scene.scene_sync->get_controller_for_peer(p_doll_scene.get_peer())->get_doll_controller();
+
+	// The doll is reconciled by the client synchronizer.
+	NS_ASSERT_COND(NS::VecFunc::has(client_sync->reconciling_dolls, doll));
+
+	// The controlled objects are assigned to the doll that controls them.
+	for (NS::DollController *reconciling_doll : client_sync->reconciling_dolls) {
+		if (reconciling_doll == doll) {
+			NS_ASSERT_COND(doll->snapshot_controlled_objects.size() == 1);
+			NS_ASSERT_COND(doll->snapshot_controlled_objects[0] == p_scene.scene_sync->get_object_data(p_doll_object->find_local_id()));
+		} else {
+			NS_ASSERT_COND(reconciling_doll->snapshot_controlled_objects.empty());
+		}
+	}
+
+	// The doll snapshots are stored at their doll executed input.
+	for (NS::FrameIndex i = doll->server_snapshots.front_index(); !doll->server_snapshots.empty() && i <= doll->server_snapshots.back_index(); i += 1) {
+		const NS::DollController::DollSnapshot *snapshot = doll->server_snapshots.find(i);
+		NS_ASSERT_COND(!snapshot || snapshot->doll_executed_input == i);
+	}
+	for (NS::FrameIndex i = doll->client_snapshots.front_index(); !doll->client_snapshots.empty() && i <= doll->client_snapshots.back_index(); i += 1) {
+		const NS::DollController::DollSnapshot *snapshot = doll->client_snapshots.find(i);
+		NS_ASSERT_COND(!snapshot || snapshot->doll_executed_input == i);
+	}
+}
+
+void process_batched_doll_reconciliation(TestDollSimulationStorePositions &test, bool p_reconcile_dolls_one_by_one) {
+	test.frame_confirmation_timespan = 1.0f / 10.0f;
+	test.init_test(true);
+#ifdef NS_DEBUG_ENABLED
+	static_cast<NS::ClientSynchronizer *>(test.peer_1_scene.scene_sync->get_synchronizer_internal())->debug_reconcile_dolls_one_by_one = p_reconcile_dolls_one_by_one;
+	static_cast<NS::ClientSynchronizer *>(test.peer_2_scene.scene_sync->get_synchronizer_internal())->debug_reconcile_dolls_one_by_one = p_reconcile_dolls_one_by_one;
+#endif
+
+	test.do_test(30);
+	NS_ASSERT_COND(test.peer1_desync_detected.size() == 0);
+	NS_ASSERT_COND(test.peer2_desync_detected.size() == 0);
+	assert_batched_doll_reconciliation(test.peer_1_scene, test.peer_2_scene, test.controlled_2_peer1);
+	assert_batched_doll_reconciliation(test.peer_2_scene, test.peer_1_scene, test.controlled_1_peer2);
+
+	// Introduce a desync on both the dolls, which are reconciled by rewinding.
+	test.controlled_1_peer2->set_xy(0, 0);
+	test.controlled_2_peer1->set_xy(0, 0);
+
+	test.do_test(30);
+	assert_batched_doll_reconciliation(test.peer_1_scene, test.peer_2_scene, test.controlled_2_peer1);
+	assert_batched_doll_reconciliation(test.peer_2_scene, test.peer_1_scene, test.controlled_1_peer2);
+
+	NS_ASSERT_COND(test.peer1_desync_detected.size() <= 1);
+	NS_ASSERT_COND(test.peer2_desync_detected.size() <= 1);
+
+	const NS::FrameIndex ensure_no_desync_after = { std::min(test.peer1_desync_detected.size() > 0 ? test.peer1_desync_detected[0].id : 0, test.peer2_desync_detected.size() > 0 ? test.peer2_desync_detected[0].id : 0) };
+	test.assert_no_desync(ensure_no_desync_after, ensure_no_desync_after);
+	test.assert_positions(ensure_no_desync_after, ensure_no_desync_after);
+}
+
+void assert_same_doll_positions(const std::map<NS::FrameIndex, NS::VarData> &p_positions_a, const std::map<NS::FrameIndex, NS::VarData> &p_positions_b) {
+	NS_ASSERT_COND(!p_positions_a.empty());
+	NS_ASSERT_COND(p_positions_a.size() == p_positions_b.size());
+	for (const auto &[frame_index, position] : p_positions_a) {
+		const NS::VarData *other_position = NS::MapFunc::get_or_null(p_positions_b, frame_index);
+		NS_ASSERT_COND(other_position);
+		NS_ASSERT_COND(NS::LocalSceneSynchronizer::var_data_compare(position, *other_position));
+	}
+}
+
+// Test that the dolls reconciled together reach the same state of the players,
+// and the same state of the dolls reconciled one by one: the global snapshot
+// is applied once and before the doll snapshots, rather than in the order
+// the dolls collect it.
+void test_simulation_batched_doll_reconciliation() {
+	// NOTE: The tests run one at a time, as the scenes share the local network.
+	std::map<NS::FrameIndex, NS::VarData> batched_doll_1_positions;
+	std::map<NS::FrameIndex, NS::VarData> batched_doll_2_positions;
+	{
+		TestDollSimulationStorePositions batched_test;
+		process_batched_doll_reconciliation(batched_test, false);
+		batched_doll_1_positions = std::move(batched_test.controlled_1_doll_position);
+		batched_doll_2_positions = std::move(batched_test.controlled_2_doll_position);
+	}
+
+	TestDollSimulationStorePositions one_by_one_test;
+	process_batched_doll_reconciliation(one_by_one_test, true);
+
+	assert_same_doll_positions(batched_doll_1_positions, one_by_one_test.controlled_1_doll_position);
+	assert_same_doll_positions(batched_doll_2_positions, one_by_one_test.controlled_2_doll_position);
+}
+
+/// Verify the doll snapshots are stored into a ring indexed by frame, that
+/// doesn't grow once the simulation is running.
+void test_doll_snapshots_storage() {
+	// Test the ring first.
+	{
+		NS::FrameRingBuffer<std::vector<int>> ring;
+		NS_ASSERT_COND(ring.empty());
+		NS_ASSERT_COND(ring.find(NS::FrameIndex{ { 0 } }) == nullptr);
+
+		bool inserted = false;
+		for (std::uint32_t i = 10; i < 16; i += 2) {
+			ring.insert(NS::FrameIndex{ { i } }, inserted)->assign(1, int(i));
+			NS_ASSERT_COND(inserted);
+		}
+		ring.insert(NS::FrameIndex{ { 12 } }, inserted);
+		NS_ASSERT_COND(!inserted);
+		NS_ASSERT_COND(ring.size() == 3);
+		NS_ASSERT_COND(ring.front_index() == NS::FrameIndex{ { 10 } });
+		NS_ASSERT_COND(ring.back_index() == NS::FrameIndex{ { 14 } });
+		NS_ASSERT_COND((*ring.find(NS::FrameIndex{ { 12 } }))[0] == 12);
+		NS_ASSERT_COND(ring.find(NS::FrameIndex{ { 13 } }) == nullptr);
+		NS_ASSERT_COND((*ring.find_at_or_before(NS::FrameIndex{ { 13 } }))[0] == 12);
+		NS_ASSERT_COND((*ring.find_at_or_after(NS::FrameIndex{ { 13 } }))[0] == 14);
+		NS_ASSERT_COND(ring.find_at_or_before(NS::FrameIndex{ { 9 } }) == nullptr);
+		NS_ASSERT_COND(ring.find_at_or_after(NS::FrameIndex{ { 15 } }) == nullptr);
+
+		// Inserting an older frame is fine too.
+		ring.insert(NS::FrameIndex{ { 9 } }, inserted)->assign(1, 9);
+		NS_ASSERT_COND(ring.front_index() == NS::FrameIndex{ { 9 } });
+
+		ring.remove_older_than(NS::FrameIndex{ { 11 } });
+		NS_ASSERT_COND(ring.size() == 2);
+		NS_ASSERT_COND(ring.front_index() == NS::FrameIndex{ { 12 } });
+		ring.remove_newer_than(NS::FrameIndex{ { 13 } });
+		NS_ASSERT_COND(ring.size() == 1);
+		NS_ASSERT_COND(ring.back_index() == NS::FrameIndex{ { 12 } });
+
+		// The removed slots are returned untouched, with their memory.
+		const std::size_t capacity = ring.capacity();
+		std::vector<int> &recycled = *ring.insert(NS::FrameIndex{ { 14 } }, inserted);
+		NS_ASSERT_COND(inserted);
+		NS_ASSERT_COND(recycled.size() == 1 && recycled[0] == 14);
+		NS_ASSERT_COND(ring.capacity() == capacity);
+
+		// Growing the ring preserves the stored frames.
+		ring.insert(NS::FrameIndex{ { 12 + std::uint32_t(capacity) } }, inserted)->assign(1, 100);
+		NS_ASSERT_COND(ring.capacity() > capacity);
+		NS_ASSERT_COND(ring.size() == 3);
+		NS_ASSERT_COND((*ring.find(NS::FrameIndex{ { 12 } }))[0] == 12);
+		NS_ASSERT_COND((*ring.find(NS::FrameIndex{ { 14 } }))[0] == 14);
+		NS_ASSERT_COND(ring.back()[0] == 100);
+
+		ring.remove_older_than(NS::FrameIndex::NONE);
+		NS_ASSERT_COND(ring.empty());
+		NS_ASSERT_COND(ring.front_index() == NS::FrameIndex::NONE);
+
+		// The ring never grows past the max capacity: the oldest frames are
+		// evicted, and the frames older than the stored ones are refused.
+		ring.set_max_capacity(8);
+		for (std::uint32_t i = 0; i < 4; i++) {
+			ring.insert(NS::FrameIndex{ { i } }, inserted)->assign(1, int(i));
+		}
+		const std::size_t bounded_capacity = ring.capacity();
+		ring.insert(NS::FrameIndex{ { 1 << 30 } }, inserted)->assign(1, 1 << 30);
+		NS_ASSERT_COND(inserted);
+		NS_ASSERT_COND(ring.capacity() == bounded_capacity);
+		NS_ASSERT_COND(ring.size() == 1);
+		NS_ASSERT_COND(ring.front_index() == NS::FrameIndex{ { 1 << 30 } });
+		NS_ASSERT_COND(ring.insert(NS::FrameIndex{ { 3 } }, inserted) == nullptr);
+		NS_ASSERT_COND(!inserted);
+		ring.insert(NS::FrameIndex{ { (1 << 30) - 7 } }, inserted);
+		NS_ASSERT_COND(inserted);
+		NS_ASSERT_COND(ring.size() == 2);
+		NS_ASSERT_COND(ring.capacity() == bounded_capacity);
+
+		// The storage shrinks back, once a removal leaves it mostly unused.
+		ring.clear();
+		ring.set_max_capacity(1 << 16);
+		for (std::uint32_t i = 0; i < 200; i++) {
+			ring.insert(NS::FrameIndex{ { i } }, inserted)->assign(1, int(i));
+		}
+		const std::size_t grown_capacity = ring.capacity();
+		NS_ASSERT_COND(grown_capacity >= 200);
+		// Removing a few frames at a time doesn't shrink it.
+		ring.remove_older_than(NS::FrameIndex{ { 4 } });
+		NS_ASSERT_COND(ring.capacity() == grown_capacity);
+		ring.remove_older_than(NS::FrameIndex{ { 195 } });
+		NS_ASSERT_COND(ring.capacity() < grown_capacity);
+		NS_ASSERT_COND(ring.size() == 5);
+		for (std::uint32_t i = 195; i < 200; i++) {
+			NS_ASSERT_COND((*ring.find(NS::FrameIndex{ { i } }))[0] == int(i));
+		}
+	}
+
+	TestDollSimulationStorePositions test;
+	test.frame_confirmation_timespan = 1.0f / 10.0f;
+	test.init_test(true);
+	test.do_test(60);
+
+	NS::DollController *doll = test.peer_1_scene.scene_sync->get_controller_for_peer(test.peer_2_scene.get_peer())->get_doll_controller();
+	NS_ASSERT_COND(!doll->client_snapshots.empty());
+	NS_ASSERT_COND(!doll->has_not_simulated_server_snapshot);
+	// The snapshots can't span more frames than the stored inputs.
+	NS_ASSERT_COND(doll->server_snapshots.get_max_capacity() == doll->frames_input.get_max_capacity());
+	NS_ASSERT_COND(doll->client_snapshots.get_max_capacity() == doll->frames_input.get_max_capacity());
+	const std::size_t server_capacity = doll->server_snapshots.capacity();
+	const std::size_t client_capacity = doll->client_snapshots.capacity();
+
+	test.do_test(60);
+	NS_ASSERT_COND(doll->server_snapshots.capacity() == server_capacity);
+	NS_ASSERT_COND(doll->client_snapshots.capacity() == client_capacity);
+	NS_ASSERT_COND(test.peer1_desync_detected.size() == 0);
+	NS_ASSERT_COND(test.peer2_desync_detected.size() == 0);
+	test.assert_positions(NS::FrameIndex{ { 0 } }, NS::FrameIndex{ { 0 } });
+}
+
+NS::FrameInput make_test_frame_input(NS::SceneSynchronizerDebugger &p_debugger, NS::FrameIndex p_id, std::uint16_t p_size_in_bits, std::uint64_t p_bits) {
+	NS::FrameInput input(p_debugger);
+	input.id = p_id;
+	// Using its own ID as similarity, so this input is never merged with the previous one.
+	input.similarity = p_id;
+	input.buffer_size_bit = p_size_in_bits;
+	input.inputs_buffer.resize_in_bits(p_size_in_bits);
+	input.inputs_buffer.zero();
+	// The first 16 bits are the metadata containing the size.
+	input.inputs_buffer.store_bits(0, p_size_in_bits, 16);
+	if (p_size_in_bits > 16) {
+		input.inputs_buffer.store_bits(16, p_bits, std::min(int(p_size_in_bits) - 16, 64));
+	}
+	return input;
+}
+
+/// Verify the inputs packet, encoded as the XOR against the previous input, is decoded back.
+void test_inputs_packet_encoding() {
+	TestDollSimulationBase test;
+	test.init_test(true);
+	test.do_test(5);
+
+	NS::PeerNetworkedController *controller = test.peer_1_scene.scene_sync->get_controller_for_peer(test.peer_1_scene.get_peer());
+	NS_ASSERT_COND(controller);
+	NS::SceneSynchronizerDebugger &debugger = controller->get_debugger();
+	controller->get_scene_synchronizer()->set_max_redundant_inputs(10);
+
+	std::deque<NS::FrameInput> frames_input;
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 10 } }, 17, 0b1));
+	// Just one bit changed.
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 11 } }, 17, 0b0));
+	// Same input, the XOR is empty.
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 12 } }, 17, 0b0));
+	// The size grows.
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 13 } }, 16 + 60, 0xF0F0F0F0F0F0F0F));
+	// The size shrinks, the previous bits past the new size are dropped.
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 14 } }, 16 + 5, 0b10101));
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 15 } }, 16 + 64, 0xFFFFFFFFFFFFFFFF));
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 16 } }, 16, 0));
+	// These two are merged as duplicate.
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 17 } }, 16 + 8, 0xAB));
+	frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 18 } }, 16 + 8, 0xAB));
+	frames_input.back().similarity = NS::FrameIndex{ { 17 } };
+
+	std::vector<std::uint8_t> packet;
+	controller->encode_inputs(frames_input, packet);
+
+	struct DecodedInputs {
+		std::vector<NS::FrameIndex> ids;
+		std::vector<std::uint16_t> sizes;
+		std::vector<BitArray> inputs;
+	} decoded;
+
+	const bool success = controller->__input_data_parse(
+			packet,
+			&decoded,
+			[](void *p_user_pointer, NS::FrameIndex p_input_id, std::uint16_t p_input_size_in_bits, const BitArray &p_input) {
+				DecodedInputs *d = static_cast<DecodedInputs *>(p_user_pointer);
+				d->ids.push_back(p_input_id);
+				d->sizes.push_back(p_input_size_in_bits);
+				d->inputs.push_back(p_input);
+			});
+	NS_ASSERT_COND(success);
+	NS_ASSERT_COND(decoded.ids.size() == frames_input.size());
+
+	for (std::size_t i = 0; i < frames_input.size(); i++) {
+		NS_ASSERT_COND(decoded.ids[i] == frames_input[i].id);
+		NS_ASSERT_COND(decoded.sizes[i] == frames_input[i].buffer_size_bit);
+		NS_ASSERT_COND(decoded.inputs[i].get_bytes() == frames_input[i].inputs_buffer.get_bytes());
+	}
+
+	// The packet is smaller than the inputs written in full.
+	std::size_t full_size = 4;
+	for (const NS::FrameInput &input : frames_input) {
+		full_size += 1 + input.inputs_buffer.get_bytes().size();
+	}
+	NS_ASSERT_COND(packet.size() < full_size);
+
+	// A truncated packet is refused.
+	packet.pop_back();
+	NS_ASSERT_COND(!controller->__input_data_parse(packet, &decoded, [](void *, NS::FrameIndex, std::uint16_t, const BitArray &) {}));
+}
+
+/// Measures the bytes per second sent by the client, with more redundant inputs.
+void test_inputs_packet_bandwidth() {
+	TestDollSimulationStorePositions test;
+	test.init_test(true);
+	test.server_scene.scene_sync->set_max_redundant_inputs(12);
+	test.peer_1_scene.scene_sync->set_max_redundant_inputs(12);
+	test.peer_2_scene.scene_sync->set_max_redundant_inputs(12);
+	test.do_test(30);
+
+	const int frames_count = 60;
+	const std::size_t sent_bytes = test.peer_1_scene.get_network().sent_bytes_count;
+	const std::size_t sent_packets = test.peer_1_scene.get_network().sent_packets_count;
+	test.do_test(frames_count);
+	const std::size_t bytes = test.peer_1_scene.get_network().sent_bytes_count - sent_bytes;
+	const std::size_t packets = test.peer_1_scene.get_network().sent_packets_count - sent_packets;
+	const float seconds = float(frames_count) / float(test.peer_1_scene.scene_sync->get_frames_per_seconds());
+	const float bytes_per_second = float(bytes) / seconds;
+
+	NS_ASSERT_COND(packets >= std::size_t(frames_count));
+	// Each input differs from the previous one by a single bit: writing the
+	// 12 inputs in full takes 4 + (12 * 4) bytes, while the XOR takes less than
+	// half, so the client sends less than writing 6 inputs in full.
+	NS_ASSERT_COND(bytes / packets < 4 + (6 * 4));
+	NS_ASSERT_COND(bytes_per_second < float(4 + (6 * 4)) * float(test.peer_1_scene.scene_sync->get_frames_per_seconds()));
+
+	// The inputs were decoded correctly.
+	NS_ASSERT_COND(test.peer1_desync_detected.size() == 0);
+	NS_ASSERT_COND(test.peer2_desync_detected.size() == 0);
+}
+
+/// Verify the server stores the received inputs in order, discarding the redundant
+/// ones, and measures the time taken to receive the inputs of many peers.
+void test_server_inputs_ring() {
+	TestDollSimulationBase test;
+	test.init_test(true);
+	test.do_test(5);
+
+	NS::PeerNetworkedController *peer_controller = test.server_scene.scene_sync->get_controller_for_peer(test.peer_1_scene.get_peer());
+	NS_ASSERT_COND(peer_controller);
+	NS::SceneSynchronizerDebugger &debugger = peer_controller->get_debugger();
+
+	const int redundant_inputs = 10;
+	const int frames_count = 60;
+	test.server_scene.scene_sync->set_max_redundant_inputs(redundant_inputs);
+
+	// Compose the packets sent by the client each frame, each one containing
+	// the last 10 inputs.
+	std::vector<std::vector<std::uint8_t>> packets(frames_count);
+	std::deque<NS::FrameInput> frames_input;
+	for (int f = 0; f < frames_count; f++) {
+		frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { std::uint32_t(f) } }, 16 + 8, std::uint64_t(f)));
+		while (int(frames_input.size()) > redundant_inputs) {
+			frames_input.pop_front();
+		}
+		peer_controller->encode_inputs(frames_input, packets[f]);
+	}
+
+	// 1. The redundant inputs are discarded and the inputs are fetched in
+	//    order, even if the packets arrive out of order.
+	{
+		NS::ServerController controller(peer_controller);
+		NS_ASSERT_COND(controller.receive_inputs(packets[2]));
+		NS_ASSERT_COND(controller.frames_input.size() == 3);
+		NS_ASSERT_COND(controller.receive_inputs(packets[5]));
+		NS_ASSERT_COND(controller.receive_inputs(packets[4]));
+		NS_ASSERT_COND(controller.frames_input.size() == 6);
+		NS_ASSERT_COND(controller.frames_input.front_index() == NS::FrameIndex{ { 0 } });
+		NS_ASSERT_COND(controller.frames_input.back_index() == NS::FrameIndex{ { 5 } });
+
+		for (std::uint32_t i = 0; i < 6; i++) {
+			NS_ASSERT_COND(controller.fetch_next_input(1.0f / 60.0f));
+			NS_ASSERT_COND(controller.current_input_buffer_id == NS::FrameIndex{ { i } });
+			NS_ASSERT_COND(peer_controller->get_inputs_buffer().get_buffer().get_bytes()[2] == std::uint8_t(i));
+		}
+		NS_ASSERT_COND(controller.frames_input.empty());
+
+		// The already processed inputs are not stored again.
+		NS_ASSERT_COND(controller.receive_inputs(packets[5]));
+		NS_ASSERT_COND(controller.frames_input.empty());
+		NS_ASSERT_COND(controller.receive_inputs(packets[7]));
+		NS_ASSERT_COND(controller.frames_input.size() == 2);
+		NS_ASSERT_COND(controller.frames_input.front_index() == NS::FrameIndex{ { 6 } });
+	}
+
+	// 2. An input id far in the future is discarded, and doesn't grow the ring.
+	{
+		NS::ServerController controller(peer_controller);
+		NS_ASSERT_COND(controller.receive_inputs(packets[2]));
+		const std::size_t capacity = controller.frames_input.capacity();
+
+		std::deque<NS::FrameInput> far_frames_input;
+		far_frames_input.push_back(make_test_frame_input(debugger, NS::FrameIndex{ { 2 + (1 << 30) } }, 16 + 8, 0));
+		std::vector<std::uint8_t> far_packet;
+		peer_controller->encode_inputs(far_frames_input, far_packet);
+		controller.receive_inputs(far_packet);
+		NS_ASSERT_COND(controller.frames_input.size() == 3);
+		NS_ASSERT_COND(controller.frames_input.back_index() == NS::FrameIndex{ { 2 } });
+		NS_ASSERT_COND(controller.frames_input.capacity() == capacity);
+
+		// The next inputs are still received.
+		NS_ASSERT_COND(controller.receive_inputs(packets[3]));
+		NS_ASSERT_COND(controller.frames_input.back_index() == NS::FrameIndex{ { 3 } });
+	}
+
+	// 3. Benchmark: 128 peers sending 10 redundant inputs at 60 Hz.
+	const int peers_count = 128;
+	std::vector<std::unique_ptr<NS::ServerController>> controllers;
+	for (int p = 0; p < peers_count; p++) {
+		controllers.push_back(std::make_unique<NS::ServerController>(peer_controller));
+	}
+	const std::size_t capacity = controllers[0]->frames_input.capacity();
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	for (int f = 0; f < frames_count; f++) {
+		for (std::unique_ptr<NS::ServerController> &controller : controllers) {
+			controller->receive_inputs(packets[f]);
+			controller->fetch_next_input(1.0f / 60.0f);
+		}
+	}
+	const double time_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	debugger.print(NS::INFO, "Received the inputs of " + std::to_string(peers_count) + " peers, " + std::to_string(redundant_inputs) + " redundant inputs, for " + std::to_string(frames_count) + " frames in " + std::to_string(time_ms) + "ms.");
+
+	for (std::unique_ptr<NS::ServerController> &controller : controllers) {
+		NS_ASSERT_COND(controller->current_input_buffer_id == NS::FrameIndex{ { std::uint32_t(frames_count - 1) } });
+		NS_ASSERT_COND(controller->frames_input.empty());
+		// The ring never grew, so the inputs were stored without allocating new slots.
+		NS_ASSERT_COND(controller->frames_input.capacity() == capacity);
+	}
+}
+
+struct RedundantInputsResult {
+	std::uint32_t missing_inputs_count = 0;
+	std::size_t sent_bytes_count = 0;
+	int redundant_inputs = 0;
+	int max_redundant_inputs = 0;
+};
+
+RedundantInputsResult run_redundant_inputs_test(int p_min_redundant_inputs, int p_max_redundant_inputs, float p_packet_loss, int p_packet_loss_burst) {
+	TestDollSimulationStorePositions test;
+	test.init_test(true);
+	for (NS::LocalScene *scene : { &test.server_scene, &test.peer_1_scene, &test.peer_2_scene }) {
+		scene->scene_sync->set_min_redundant_inputs(p_min_redundant_inputs);
+		scene->scene_sync->set_max_redundant_inputs(p_max_redundant_inputs);
+		scene->scene_sync->set_netstats_update_interval_sec(0.1f);
+	}
+	// With some latency the client has more unconfirmed inputs than the redundant inputs.
+	test.network_properties.rtt_seconds = 0.1f;
+	test.do_test(30);
+
+	// Use the same sequence each run, so the results are comparable.
+	srand(1);
+	test.network_properties.packet_loss = p_packet_loss;
+	test.network_properties.packet_loss_burst = p_packet_loss_burst;
+
+	NS::PeerNetworkedController *server_controller = test.server_scene.scene_sync->get_controller_for_peer(test.peer_1_scene.get_peer());
+	NS::PeerNetworkedController *peer_1_controller = test.peer_1_scene.scene_sync->get_controller_for_peer(test.peer_1_scene.get_peer());
+	NS_ASSERT_COND(server_controller && server_controller->get_server_controller());
+	NS_ASSERT_COND(peer_1_controller);
+
+	const std::uint32_t missing_inputs_count = server_controller->get_server_controller()->missing_inputs_count;
+	const std::size_t sent_bytes_count = test.peer_1_scene.get_network().sent_bytes_count;
+	RedundantInputsResult result;
+	for (int i = 0; i < 300; i++) {
+		test.do_test(1);
+		result.max_redundant_inputs = std::max(result.max_redundant_inputs, peer_1_controller->get_redundant_inputs());
+	}
+
+	test.network_properties.packet_loss = 0.0f;
+	test.network_properties.packet_loss_burst = 0;
+	test.peer_1_scene.get_network().packet_loss_burst_remaining = 0;
+
+	result.missing_inputs_count = server_controller->get_server_controller()->missing_inputs_count - missing_inputs_count;
+	result.sent_bytes_count = test.peer_1_scene.get_network().sent_bytes_count - sent_bytes_count;
+	result.redundant_inputs = peer_1_controller->get_redundant_inputs();
+	return result;
+}
+
+/// Verify the client sends as many redundant inputs as the packet loss requires.
+void test_adaptive_redundant_inputs() {
+	// 1. Without packet loss, the client sends the minimum redundant inputs
+	//    and so less bytes than the static max.
+	{
+		const RedundantInputsResult static_max = run_redundant_inputs_test(6, 6, 0.0f, 0);
+		const RedundantInputsResult adaptive = run_redundant_inputs_test(1, 6, 0.0f, 0);
+		NS_ASSERT_COND(static_max.redundant_inputs == 6);
+		NS_ASSERT_COND(adaptive.redundant_inputs == 1);
+		NS_ASSERT_COND(adaptive.missing_inputs_count == 0);
+		NS_ASSERT_COND(adaptive.sent_bytes_count < static_max.sent_bytes_count);
+	}
+
+	// 2. With random packet loss, the redundancy increases and the server
+	//    misses less inputs than with the static min.
+	{
+		const RedundantInputsResult static_min = run_redundant_inputs_test(1, 1, 0.2f, 0);
+		const RedundantInputsResult adaptive = run_redundant_inputs_test(1, 6, 0.2f, 0);
+		NS_ASSERT_COND(adaptive.redundant_inputs > 1);
+		NS_ASSERT_COND(adaptive.missing_inputs_count < static_min.missing_inputs_count);
+	}
+
+	// 3. With burst packet loss, the redundancy covers the whole burst.
+	{
+		const RedundantInputsResult static_min = run_redundant_inputs_test(1, 1, 0.05f, 3);
+		const RedundantInputsResult adaptive = run_redundant_inputs_test(1, 6, 0.05f, 3);
+		NS_ASSERT_COND(adaptive.max_redundant_inputs >= 4);
+		NS_ASSERT_COND(adaptive.missing_inputs_count < static_min.missing_inputs_count);
+	}
+}
+
 void test_doll_simulation() {
 	SceneSyncNoSubTicks_Obj1 = std::make_shared<NS::LocalSceneSynchronizerNoSubTicks>();
 	SceneSyncNoSubTicks_Obj2 = std::make_shared<NS::LocalSceneSynchronizerNoSubTicks>();
@@ -927,6 +1424,12 @@ void test_doll_simulation() {
 	test_simulation_with_latency();
 	test_simulation_with_hiccups();
 	test_simulation_with_wrong_input();
+	test_simulation_batched_doll_reconciliation();
+	test_doll_snapshots_storage();
+	test_inputs_packet_encoding();
+	test_inputs_packet_bandwidth();
+	test_server_inputs_ring();
+	test_adaptive_redundant_inputs();
 	// TODO test with great latency and lag compensation.
 	test_latency();
 
@@ -6,11 +6,77 @@
 #include "../core/net_utilities.h"
 #include "../core/var_data.h"
 #include "../core/net_math.h"
+#include "../core/ring_buffer.h"
+#include "../core/snapshot.h"
 #include "local_scene.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <functional>
+#include <map>
+#include <new>
 #include <vector>
 
+#ifdef NS_TEST_ALLOCATIONS_TRACKING_ENABLED
+namespace NS_Test {
+/// Counts the allocations done by this thread while `enabled` is set,
+/// including the ones released right away.
+struct AllocationsTracker {
+	bool enabled = false;
+	int allocations_count = 0;
+};
+
+static thread_local AllocationsTracker allocations_tracker;
+
+void allocations_tracker_begin() {
+	allocations_tracker.enabled = true;
+	allocations_tracker.allocations_count = 0;
+}
+
+/// Stops the tracking and returns the count of the allocations done meanwhile.
+int allocations_tracker_end() {
+	allocations_tracker.enabled = false;
+	return allocations_tracker.allocations_count;
+}
+} //namespace NS_Test
+
+// NOTE: The global allocation functions can't be replaced for a single test,
+//       so they are replaced only when `NS_TEST_ALLOCATIONS_TRACKING_ENABLED`
+//       is defined. Other than counting, they behave like the default ones.
+void *operator new(std::size_t p_size) {
+	if (NS_Test::allocations_tracker.enabled) {
+		NS_Test::allocations_tracker.allocations_count += 1;
+	}
+	while (true) {
+		void *memory = std::malloc(p_size == 0 ? 1 : p_size);
+		if (memory != nullptr) {
+			return memory;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void operator delete(void *p_memory) noexcept {
+	std::free(p_memory);
+}
+
+void operator delete(void *p_memory, std::size_t) noexcept {
+	std::free(p_memory);
+}
+#else
+namespace NS_Test {
+void allocations_tracker_begin() {}
+int allocations_tracker_end() {
+	return 0;
+}
+} //namespace NS_Test
+#endif
+
 namespace NS_Test {
 void test_ids() {
 	NS::VarId var_id_0 = NS::VarId{ { 0 } };
@@ -1112,6 +1178,914 @@ void test_state_no_rewind_notify() {
 	NS_ASSERT_COND(TSO_peer_1->rewinded_frames.size() == 0);
 }
 
+class TSS_FloatSceneObject : public NS::LocalSceneObject {
+public:
+	NS::ObjectLocalId local_id = NS::ObjectLocalId::NONE;
+	float value = 0.0f;
+	std::vector<NS::GlobalFrameIndex> rewinded_frames;
+	int processed_frames_count = 0;
+
+	TSS_FloatSceneObject() :
+		LocalSceneObject("TSS_FloatSceneObject") {
+	}
+
+	virtual void on_scene_entry() override {
+		get_scene()->scene_sync->register_app_object(get_scene()->scene_sync->to_handle(this));
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		local_id = p_id;
+		p_scene_sync.register_variable(
+				p_id,
+				"value",
+				[](NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, const NS::VarData &p_value) {
+					static_cast<TSS_FloatSceneObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->value = p_value.data.f32;
+				},
+				[](const NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, NS::VarData &r_value) {
+					r_value.type = 1;
+					r_value.data.f32 = static_cast<TSS_FloatSceneObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->value;
+				});
+
+		p_scene_sync.register_process(
+				p_id,
+				PROCESS_PHASE_PROCESS,
+				[&p_scene_sync, this](float) {
+					processed_frames_count += 1;
+					if (p_scene_sync.is_rewinding()) {
+						rewinded_frames.push_back(p_scene_sync.get_global_frame_index());
+					}
+				});
+	}
+};
+
+/// Verify the variables compare policy is used to detect the desyncs and that
+/// the rewinds triggered by each variable are tracked.
+void test_state_compare_policy() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	TSS_FloatSceneObject *obj_server = server_scene.add_object<TSS_FloatSceneObject>("obj_1", server_scene.get_peer());
+	TSS_FloatSceneObject *obj_peer_1 = peer_1_scene.add_object<TSS_FloatSceneObject>("obj_1", server_scene.get_peer());
+
+	NS::VarComparePolicy policy;
+	policy.absolute_tolerance = 0.001f;
+	server_scene.scene_sync->set_compare_policy(obj_server->local_id, "value", policy);
+	peer_1_scene.scene_sync->set_compare_policy(obj_peer_1->local_id, "value", policy);
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0);
+
+	obj_server->value = 1.0f;
+	obj_peer_1->value = 1.0f;
+
+	// Process the scenes few times to ensure everything is up to dated.
+	for (int i = 0; i < 5; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	NS_ASSERT_COND(obj_peer_1->rewinded_frames.size() == 0);
+
+	// 1. Drift the client value within the tolerance: no rewind is triggered.
+	obj_peer_1->value = 1.0001f;
+
+	for (int i = 0; i < 5; i++) {
+		peer_1_scene.process(delta);
+	}
+	server_scene.process(delta);
+	peer_1_scene.process(delta);
+
+	NS_ASSERT_COND(obj_peer_1->rewinded_frames.size() == 0);
+	NS_ASSERT_COND(obj_peer_1->value == 1.0001f);
+	NS_ASSERT_COND(peer_1_scene.scene_sync->get_rewind_triggers_count(obj_peer_1->local_id, "value") == 0);
+
+	// 2. Drift the client value above the tolerance: the rewind is triggered.
+	obj_server->value = 2.0f;
+
+	for (int i = 0; i < 5; i++) {
+		peer_1_scene.process(delta);
+	}
+	server_scene.process(delta);
+	peer_1_scene.process(delta);
+
+	NS_ASSERT_COND(obj_peer_1->rewinded_frames.size() > 0);
+	NS_ASSERT_COND(obj_peer_1->value == 2.0f);
+	NS_ASSERT_COND(peer_1_scene.scene_sync->get_rewind_triggers_count(obj_peer_1->local_id, "value") == 1);
+	// The server never rewinds.
+	NS_ASSERT_COND(server_scene.scene_sync->get_rewind_triggers_count(obj_server->local_id, "value") == 0);
+}
+
+/// Verify the `compare_every_n_frames` policy counts the frames since each
+/// variable was last compared, so the variable is compared even when the
+/// snapshots never land on a multiple of N.
+void test_state_compare_policy_every_n_frames() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	TSS_FloatSceneObject *obj = server_scene.add_object<TSS_FloatSceneObject>("obj_1", server_scene.get_peer());
+
+	NS::VarComparePolicy policy;
+	policy.compare_every_n_frames = 2;
+	server_scene.scene_sync->set_compare_policy(obj->local_id, "value", policy);
+
+	const NS::ObjectData *od = server_scene.scene_sync->get_object_data(obj->local_id);
+	const std::size_t index = od->get_net_id().id;
+
+	NS::Snapshot server_snapshot;
+	NS::Snapshot client_snapshot;
+	server_snapshot.objects.resize(index + 1);
+	client_snapshot.objects.resize(index + 1);
+	server_snapshot.objects[index].vars.emplace_back(NS::VarData(1.0f));
+	client_snapshot.objects[index].vars.emplace_back(NS::VarData(2.0f));
+
+	// The snapshots arrive on the odd frames only: the variable is compared
+	// on each one of them, since two frames passed since the last comparison.
+	for (std::uint32_t frame = 1; frame < 20; frame += 2) {
+		server_snapshot.global_frame_index = NS::GlobalFrameIndex{ frame };
+		NS_ASSERT_COND(!NS::Snapshot::compare_object_vars(*od, server_snapshot, client_snapshot));
+	}
+
+	// The snapshots arrive each frame: the variable is compared every 2 frames.
+	for (std::uint32_t frame = 20; frame < 40; frame += 1) {
+		server_snapshot.global_frame_index = NS::GlobalFrameIndex{ frame };
+		const bool is_equal = NS::Snapshot::compare_object_vars(*od, server_snapshot, client_snapshot);
+		NS_ASSERT_COND(is_equal == (frame % 2 == 0));
+	}
+
+	// Comparing the same frame again gives the same result.
+	NS_ASSERT_COND(!NS::Snapshot::compare_object_vars(*od, server_snapshot, client_snapshot));
+}
+
+/// Verify the server lag compensation history allows to rewind the objects
+/// to a past frame and to restore them right after.
+void test_lag_compensation_history() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	NS::Settings settings = server_scene.scene_sync->get_settings();
+	settings.lag_compensation.history_frames_count = 10;
+	server_scene.scene_sync->set_settings(settings);
+
+	TSS_FloatSceneObject *obj_server = server_scene.add_object<TSS_FloatSceneObject>("obj_1", server_scene.get_peer());
+	TSS_FloatSceneObject *obj_2_server = server_scene.add_object<TSS_FloatSceneObject>("obj_2", server_scene.get_peer());
+	peer_1_scene.add_object<TSS_FloatSceneObject>("obj_1", server_scene.get_peer());
+	peer_1_scene.add_object<TSS_FloatSceneObject>("obj_2", server_scene.get_peer());
+
+	server_scene.scene_sync->set_lag_compensation_history_enabled(obj_server->local_id, true);
+	NS_ASSERT_COND(server_scene.scene_sync->is_lag_compensation_history_enabled(obj_server->local_id));
+	NS_ASSERT_COND(!server_scene.scene_sync->is_lag_compensation_history_enabled(obj_2_server->local_id));
+
+	std::map<NS::GlobalFrameIndex, float> values;
+	for (int i = 0; i < 20; i++) {
+		obj_server->value = float(i);
+		obj_2_server->value = float(i);
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		values[server_scene.scene_sync->get_global_frame_index()] = float(i);
+	}
+
+	const NS::GlobalFrameIndex current_frame = server_scene.scene_sync->get_global_frame_index();
+
+	// 1. Rewind to a frame still in the history.
+	const NS::GlobalFrameIndex past_frame = current_frame - 5;
+	NS_ASSERT_COND(server_scene.scene_sync->lag_compensation_rewind(past_frame, { obj_server->local_id }));
+	NS_ASSERT_COND(server_scene.scene_sync->is_lag_compensation_rewind_in_progress());
+	NS_ASSERT_COND(obj_server->value == values[past_frame]);
+	// The other object is untouched.
+	NS_ASSERT_COND(obj_2_server->value == 19.0f);
+
+	server_scene.scene_sync->lag_compensation_restore();
+	NS_ASSERT_COND(!server_scene.scene_sync->is_lag_compensation_rewind_in_progress());
+	NS_ASSERT_COND(obj_server->value == 19.0f);
+
+	// 2. The frames older than the history can't be rewound.
+	NS_ASSERT_COND(!server_scene.scene_sync->lag_compensation_rewind(current_frame - 10, { obj_server->local_id }));
+	NS_ASSERT_COND(obj_server->value == 19.0f);
+	server_scene.scene_sync->lag_compensation_restore();
+
+	// 3. Rewind to the frame the peer is seeing.
+	const NS::GlobalFrameIndex peer_view_frame = server_scene.scene_sync->lag_compensation_get_peer_view_frame(peer_1_scene.get_peer());
+	NS_ASSERT_COND(peer_view_frame != NS::GlobalFrameIndex::NONE);
+	NS_ASSERT_COND(peer_view_frame <= current_frame);
+	NS_ASSERT_COND(server_scene.scene_sync->lag_compensation_rewind_for_peer(peer_1_scene.get_peer(), { obj_server->local_id }));
+	NS_ASSERT_COND(obj_server->value == values[peer_view_frame]);
+	server_scene.scene_sync->lag_compensation_restore();
+	NS_ASSERT_COND(obj_server->value == 19.0f);
+}
+
+/// Verify the bits sent by the server snapshots are accounted per variable,
+/// per object and per SyncGroup.
+void test_bandwidth_stats() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	TSS_FloatSceneObject *obj_1_server = server_scene.add_object<TSS_FloatSceneObject>("obj_1", server_scene.get_peer());
+	TSS_FloatSceneObject *obj_2_server = server_scene.add_object<TSS_FloatSceneObject>("obj_2", server_scene.get_peer());
+	peer_1_scene.add_object<TSS_FloatSceneObject>("obj_1", server_scene.get_peer());
+	peer_1_scene.add_object<TSS_FloatSceneObject>("obj_2", server_scene.get_peer());
+
+	// Notify the snapshot every frame and use a 5 frames window.
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0);
+	server_scene.scene_sync->set_bandwidth_stats_window_seconds(5.0f / float(server_scene.scene_sync->get_frames_per_seconds()));
+
+	for (int i = 0; i < 10; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	// The objects were sent using the full snapshot only.
+	const NS::BandwidthReport group_initial = server_scene.scene_sync->sync_group_get_bandwidth(NS::SyncGroupId::GLOBAL);
+	NS_ASSERT_COND(group_initial.full_snapshot_times_sent >= 1);
+	NS_ASSERT_COND(group_initial.times_sent == group_initial.full_snapshot_times_sent + group_initial.delta_snapshot_times_sent);
+	const NS::BandwidthReport var_1_initial = server_scene.scene_sync->get_variable_bandwidth(obj_1_server->local_id, "value");
+	const NS::BandwidthReport var_2_initial = server_scene.scene_sync->get_variable_bandwidth(obj_2_server->local_id, "value");
+	NS_ASSERT_COND(var_1_initial.full_snapshot_times_sent == group_initial.full_snapshot_times_sent);
+	NS_ASSERT_COND(var_1_initial.delta_snapshot_times_sent == 0);
+	NS_ASSERT_COND(var_2_initial.times_sent == var_1_initial.times_sent);
+	const NS::BandwidthReport obj_1_initial = server_scene.scene_sync->get_object_bandwidth(obj_1_server->local_id);
+
+	// The bits needed to network one value.
+	NS::VarData value;
+	value.type = 1;
+	NS::DataBuffer value_db(server_scene.scene_sync->get_debugger());
+	value_db.begin_write(server_scene.scene_sync->get_debugger(), 0);
+	NS::SceneSynchronizerBase::var_data_encode(value_db, value, 1);
+	const std::uint64_t value_bits = value_db.get_bit_offset();
+	NS_ASSERT_COND(var_1_initial.bits_sent == var_1_initial.times_sent * value_bits);
+
+	// Change only the `obj_1` for 10 frames.
+	for (int i = 0; i < 10; i++) {
+		obj_1_server->value += 1.0f;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	const NS::BandwidthReport var_1 = server_scene.scene_sync->get_variable_bandwidth(obj_1_server->local_id, "value");
+	const NS::BandwidthReport var_2 = server_scene.scene_sync->get_variable_bandwidth(obj_2_server->local_id, "value");
+	NS_ASSERT_COND(var_1.delta_snapshot_times_sent == 10);
+	NS_ASSERT_COND(var_1.bits_sent == var_1_initial.bits_sent + (10 * value_bits));
+	NS_ASSERT_COND(var_1.bits_per_second == float(5 * value_bits) * float(server_scene.scene_sync->get_frames_per_seconds()) / 5.0f);
+	NS_ASSERT_COND(var_2.times_sent == var_2_initial.times_sent);
+	NS_ASSERT_COND(var_2.bits_per_second == 0.0f);
+
+	// The object includes the header too.
+	const NS::BandwidthReport obj_1 = server_scene.scene_sync->get_object_bandwidth(obj_1_server->local_id);
+	NS_ASSERT_COND(obj_1.times_sent == obj_1_initial.times_sent + 10);
+	NS_ASSERT_COND((obj_1.bits_sent - obj_1_initial.bits_sent) > (var_1.bits_sent - var_1_initial.bits_sent));
+
+	// The scheme report aggregates all the objects.
+	const NS::BandwidthReport scheme_var = server_scene.scene_sync->get_scheme_variable_bandwidth(NS::SchemeId::DEFAULT, "value");
+	NS_ASSERT_COND(scheme_var.bits_sent == var_1.bits_sent + var_2.bits_sent);
+	NS_ASSERT_COND(scheme_var.times_sent == var_1.times_sent + var_2.times_sent);
+
+	// The group accounts the whole snapshots.
+	const NS::BandwidthReport group = server_scene.scene_sync->sync_group_get_bandwidth(NS::SyncGroupId::GLOBAL);
+	NS_ASSERT_COND(group.full_snapshot_times_sent == group_initial.full_snapshot_times_sent);
+	NS_ASSERT_COND(group.delta_snapshot_times_sent >= group_initial.delta_snapshot_times_sent + 10);
+	NS_ASSERT_COND((group.bits_sent - group_initial.bits_sent) > (obj_1.bits_sent - obj_1_initial.bits_sent));
+}
+
+/// Verify the client snapshots are stored into a ring that never grows
+/// during the prediction.
+void test_client_snapshot_history() {
+	// Test the ring first.
+	{
+		NS::RingBuffer<std::vector<int>> ring;
+		NS_ASSERT_COND(ring.empty());
+		for (int i = 0; i < 3; i++) {
+			ring.push_back().assign(1, i);
+		}
+		NS_ASSERT_COND(ring.size() == 3);
+		NS_ASSERT_COND(ring.front()[0] == 0);
+		NS_ASSERT_COND(ring.back()[0] == 2);
+
+		ring.pop_front();
+		NS_ASSERT_COND(ring.size() == 2);
+		NS_ASSERT_COND(ring.front()[0] == 1);
+
+		// The popped slot is returned untouched, with its memory.
+		const std::size_t capacity = ring.capacity();
+		for (int i = 3; i < int(3 + capacity - 2); i++) {
+			ring.push_back().assign(1, i);
+		}
+		NS_ASSERT_COND(ring.capacity() == capacity);
+
+		// Growing the ring preserves the order.
+		ring.push_back().assign(1, 100);
+		NS_ASSERT_COND(ring.capacity() > capacity);
+		NS_ASSERT_COND(ring.size() == capacity + 1);
+		for (std::size_t i = 0; i < ring.size() - 1; i++) {
+			NS_ASSERT_COND(ring[i][0] == int(i + 1));
+		}
+		NS_ASSERT_COND(ring.back()[0] == 100);
+
+		// Shrinking releases the popped slots, but never the stored elements.
+		const std::size_t size = ring.size();
+		ring.pop_front();
+		ring.pop_front();
+		ring.shrink(1);
+		NS_ASSERT_COND(ring.capacity() == size - 2);
+		NS_ASSERT_COND(ring.size() == size - 2);
+		for (std::size_t i = 0; i < ring.size() - 1; i++) {
+			NS_ASSERT_COND(ring[i][0] == int(i + 3));
+		}
+		NS_ASSERT_COND(ring.back()[0] == 100);
+
+		ring.clear();
+		NS_ASSERT_COND(ring.empty());
+		ring.push_back();
+		NS_ASSERT_COND(ring.size() == 1);
+	}
+
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	LocalNetworkedController *controlled_server = server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	LocalNetworkedController *controlled_p1 = peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	server_scene.add_object<TSS_TestSceneObject>("obj_1", server_scene.get_peer());
+	TSS_TestSceneObject *TSO_peer_1 = peer_1_scene.add_object<TSS_TestSceneObject>("obj_1", server_scene.get_peer());
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(1.f / 10.f);
+
+	for (int i = 0; i < 30; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+	const std::size_t capacity = client_sync->client_snapshots.capacity();
+	NS_ASSERT_COND(capacity > peer_1_scene.scene_sync->get_client_max_frames_storage_size());
+
+	for (int i = 0; i < 300; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+
+		// The ring is never resized.
+		NS_ASSERT_COND(client_sync->client_snapshots.capacity() == capacity);
+		NS_ASSERT_COND(!client_sync->client_snapshots.empty());
+		for (std::size_t s = 1; s < client_sync->client_snapshots.size(); s++) {
+			NS_ASSERT_COND(client_sync->client_snapshots[s - 1].input_id < client_sync->client_snapshots[s].input_id);
+		}
+		NS_ASSERT_COND(client_sync->client_snapshots.back().input_id == peer_1_scene.scene_sync->get_controller_for_peer(peer_1_scene.get_peer())->get_current_frame_index());
+	}
+
+	// The recycled snapshots never caused a desync.
+	NS_ASSERT_COND(TSO_peer_1->rewinded_frames.size() == 0);
+	NS_ASSERT_COND(controlled_p1->rewinded_frames.size() == 0);
+	NS_ASSERT_COND(controlled_server->rewinded_frames.size() == 0);
+}
+
+/// Verify the client snapshots copy only the vars changed since the recycled
+/// snapshot was stored.
+void test_client_snapshot_copy_on_write() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	std::vector<TSS_FloatSceneObject *> objects_server;
+	std::vector<TSS_FloatSceneObject *> objects_p1;
+	for (int i = 0; i < 10; i++) {
+		const std::string name = "obj_" + std::to_string(i);
+		objects_server.push_back(server_scene.add_object<TSS_FloatSceneObject>(name, server_scene.get_peer()));
+		objects_p1.push_back(peer_1_scene.add_object<TSS_FloatSceneObject>(name, server_scene.get_peer()));
+	}
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(1.f / 10.f);
+
+	const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+
+	// Ensures the last stored snapshot has the same values of the objects.
+	auto assert_last_snapshot_is_valid = [&]() {
+		const NS::Snapshot &snapshot = client_sync->client_snapshots.back();
+		for (const TSS_FloatSceneObject *obj : objects_p1) {
+			const NS::ObjectData *od = peer_1_scene.scene_sync->get_object_data(obj->local_id);
+			const std::vector<std::optional<NS::VarData>> *vars = snapshot.get_object_vars(od->get_net_id());
+			NS_ASSERT_COND(vars);
+			NS_ASSERT_COND(vars->size() == 1);
+			NS_ASSERT_COND((*vars)[0].has_value());
+			NS_ASSERT_COND((*vars)[0]->data.f32 == obj->value);
+		}
+	};
+
+	// Process enough frames to recycle all the snapshots of the ring.
+	for (int i = 0; i < 60; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	for (std::size_t i = 0; i < client_sync->client_snapshots.capacity(); i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		assert_last_snapshot_is_valid();
+	}
+
+	// Nothing changes, so the float objects vars are not copied again.
+	for (int i = 0; i < 30; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		NS_ASSERT_COND(client_sync->client_snapshot_reused_vars_count >= objects_p1.size());
+		assert_last_snapshot_is_valid();
+	}
+
+	// Change some values on the server, the client snapshots must store them.
+	for (int i = 0; i < 30; i++) {
+		objects_server[i % 3]->value += 1.0f;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		assert_last_snapshot_is_valid();
+	}
+
+	for (int i = 0; i < 60; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		assert_last_snapshot_is_valid();
+	}
+
+	for (std::size_t i = 0; i < objects_server.size(); i++) {
+		NS_ASSERT_COND(objects_server[i]->value == objects_p1[i]->value);
+	}
+	NS_ASSERT_COND(objects_p1[0]->value == 10.0f);
+}
+
+struct SnapshotCompareResult {
+	bool is_equal = false;
+	std::vector<std::string> differences_info;
+	std::vector<std::pair<NS::ObjectNetId, NS::VarId>> rewind_trigger_vars;
+	std::vector<NS::ObjectNetId> no_rewind_simulated_objects;
+	std::vector<NS::ObjectNetId> different_objects;
+	double time_ms = 0.0;
+};
+
+SnapshotCompareResult compare_snapshots(NS::LocalSceneSynchronizer &p_scene_sync, const NS::Snapshot &p_server_snapshot, const NS::Snapshot &p_client_snapshot, bool p_collect_differences_info) {
+	SnapshotCompareResult result;
+	NS::Snapshot no_rewind_recover;
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	result.is_equal = NS::Snapshot::compare(
+			p_scene_sync,
+			p_server_snapshot,
+			p_client_snapshot,
+			-1,
+			&no_rewind_recover,
+			p_collect_differences_info ? &result.differences_info : nullptr,
+			&result.rewind_trigger_vars
+#ifdef NS_DEBUG_ENABLED
+			,
+			&result.different_objects
+#endif
+	);
+	result.time_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	for (const NS::SimulatedObjectInfo &info : no_rewind_recover.simulated_objects) {
+		result.no_rewind_simulated_objects.push_back(info.net_id);
+	}
+	return result;
+}
+
+/// Verify the snapshots compared using many threads give the same result of
+/// the single thread comparison.
+/// NOTE: Define `NS_TEST_BENCHMARKS_ENABLED` to also print the time taken by
+///       both comparing many objects.
+void test_snapshot_compare_threads() {
+	// Enough objects to use all the threads.
+	std::vector<int> objects_counts{ int(4 * NS::Snapshot::COMPARE_MIN_OBJECTS_PER_THREAD) };
+#ifdef NS_TEST_BENCHMARKS_ENABLED
+	objects_counts.push_back(10000);
+#endif
+
+	for (int objects_count : objects_counts) {
+		NS::LocalScene server_scene;
+		server_scene.start_as_server();
+		server_scene.scene_sync =
+				server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+		std::vector<TSS_FloatSceneObject *> objects;
+		for (int i = 0; i < objects_count; i++) {
+			objects.push_back(server_scene.add_object<TSS_FloatSceneObject>("obj_" + std::to_string(i), server_scene.get_peer()));
+		}
+
+		// Skip the rewinding on some objects, to verify the no rewind data too.
+		for (int i = 0; i < objects_count; i += 7) {
+			server_scene.scene_sync->set_skip_rewinding(objects[i]->local_id, "value", true);
+		}
+
+		NS::Snapshot server_snapshot;
+		NS::Snapshot client_snapshot;
+		for (NS::ObjectData *od : server_scene.scene_sync->get_all_object_data()) {
+			od->realtime_sync_enabled_on_client = true;
+			const std::size_t index = od->get_net_id().id;
+			if (server_snapshot.objects.size() <= index) {
+				server_snapshot.objects.resize(index + 1);
+				client_snapshot.objects.resize(index + 1);
+			}
+			for (const NS::VarDescriptor &var_desc : od->vars) {
+				server_snapshot.objects[index].vars.emplace_back(NS::VarData::make_copy(var_desc.var.value));
+				client_snapshot.objects[index].vars.emplace_back(NS::VarData::make_copy(var_desc.var.value));
+			}
+		}
+
+		// Makes some client values different.
+		for (int i = 0; i < objects_count; i += 5) {
+			const NS::ObjectData *od = server_scene.scene_sync->get_object_data(objects[i]->local_id);
+			client_snapshot.objects[od->get_net_id().id].vars[0]->data.f32 = 1.0f;
+		}
+
+		server_scene.scene_sync->set_snapshot_compare_threads_count(1);
+		NS_ASSERT_COND(server_scene.scene_sync->get_snapshot_compare_pool().get_workers_count() == 0);
+		const SnapshotCompareResult single_thread = compare_snapshots(*server_scene.scene_sync, server_snapshot, client_snapshot, false);
+
+		server_scene.scene_sync->set_snapshot_compare_threads_count(4);
+		// The calling thread compares the snapshots too.
+		NS_ASSERT_COND(server_scene.scene_sync->get_snapshot_compare_pool().get_workers_count() == 3);
+		const SnapshotCompareResult multi_thread = compare_snapshots(*server_scene.scene_sync, server_snapshot, client_snapshot, false);
+		// The workers are reused by the next comparisons.
+		const SnapshotCompareResult multi_thread_again = compare_snapshots(*server_scene.scene_sync, server_snapshot, client_snapshot, false);
+
+		// The differences info is collected on the calling thread, with the same result.
+		const SnapshotCompareResult differences_info = compare_snapshots(*server_scene.scene_sync, server_snapshot, client_snapshot, true);
+
+		NS_ASSERT_COND(!single_thread.is_equal);
+		NS_ASSERT_COND(single_thread.is_equal == multi_thread.is_equal);
+		NS_ASSERT_COND(single_thread.rewind_trigger_vars == multi_thread.rewind_trigger_vars);
+		NS_ASSERT_COND(multi_thread.rewind_trigger_vars == multi_thread_again.rewind_trigger_vars);
+		NS_ASSERT_COND(multi_thread.rewind_trigger_vars == differences_info.rewind_trigger_vars);
+		NS_ASSERT_COND(!differences_info.differences_info.empty());
+		NS_ASSERT_COND(single_thread.no_rewind_simulated_objects == multi_thread.no_rewind_simulated_objects);
+		NS_ASSERT_COND(single_thread.different_objects == multi_thread.different_objects);
+
+		// The objects divisible by 5 and not by 7 trigger the rewind.
+		NS_ASSERT_COND(single_thread.rewind_trigger_vars.size() == std::size_t((objects_count + 4) / 5 - (objects_count + 34) / 35));
+		// The objects divisible by 35 are recovered without rewinding.
+		NS_ASSERT_COND(single_thread.no_rewind_simulated_objects.size() == std::size_t((objects_count + 34) / 35));
+
+#ifdef NS_TEST_BENCHMARKS_ENABLED
+		server_scene.scene_sync->get_debugger().print(NS::INFO, "Snapshot compare of " + std::to_string(objects_count) + " objects. Single thread: " + std::to_string(single_thread.time_ms) + "ms, 4 threads: " + std::to_string(multi_thread.time_ms) + "ms.");
+#endif
+	}
+}
+
+/// Verify the client receives the snapshots without allocating, once the
+/// parsing buffers are big enough.
+/// NOTE: Define `NS_TEST_ALLOCATIONS_TRACKING_ENABLED` to count the allocations,
+///       otherwise only the received values are verified.
+void test_snapshot_parsing_reuses_memory() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	std::vector<TSS_FloatSceneObject *> objects_server;
+	std::vector<TSS_FloatSceneObject *> objects_p1;
+	for (int i = 0; i < 10; i++) {
+		const std::string name = "obj_" + std::to_string(i);
+		objects_server.push_back(server_scene.add_object<TSS_FloatSceneObject>(name, server_scene.get_peer()));
+		objects_p1.push_back(peer_1_scene.add_object<TSS_FloatSceneObject>(name, server_scene.get_peer()));
+	}
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0f);
+
+	// The server changes all the objects each frame, so each snapshot
+	// updates all of them.
+	// The client receives the snapshot while the server network is processed,
+	// so all the allocations done in there are counted.
+	int allocations_count = 0;
+	const auto process = [&](bool p_track_allocations) {
+		for (TSS_FloatSceneObject *obj : objects_server) {
+			obj->value += 1.0f;
+		}
+		server_scene.scene_sync->process(delta);
+		if (p_track_allocations) {
+			allocations_tracker_begin();
+			server_scene.process_only_network(delta);
+			allocations_count += allocations_tracker_end();
+		} else {
+			server_scene.process_only_network(delta);
+		}
+		peer_1_scene.process(delta);
+	};
+
+	// Process enough frames to make the parsing buffers big enough.
+	for (int i = 0; i < 60; i++) {
+		process(false);
+	}
+
+	const std::size_t peer_1_received_bytes = peer_1_scene.get_network().received_bytes_count;
+	for (int i = 0; i < 60; i++) {
+		process(true);
+	}
+	// Make sure the snapshots were received while tracking.
+	NS_ASSERT_COND(peer_1_scene.get_network().received_bytes_count > peer_1_received_bytes);
+	NS_ASSERT_COND(allocations_count == 0);
+
+	// The received values are still applied.
+	for (int i = 0; i < 30; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	for (std::size_t i = 0; i < objects_server.size(); i++) {
+		NS_ASSERT_COND(objects_server[i]->value == objects_p1[i]->value);
+	}
+}
+
+/// The client state recorded each frame, to compare the synchronous and the
+/// asynchronous snapshot decoding.
+struct SnapshotDecodingFrame {
+	float controller_position = 0.0f;
+	float doll_position = 0.0f;
+	std::vector<float> values;
+	std::size_t rewinded_frames_count = 0;
+
+	bool operator==(const SnapshotDecodingFrame &p_other) const {
+		return controller_position == p_other.controller_position &&
+				doll_position == p_other.doll_position &&
+				values == p_other.values &&
+				rewinded_frames_count == p_other.rewinded_frames_count;
+	}
+};
+
+std::vector<SnapshotDecodingFrame> fetch_client_frames(bool p_snapshot_decoding_async, std::uint64_t &r_decoder_applied_objects_count) {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_2_scene.scene_sync =
+			peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	LocalNetworkedController *controller_1_server = server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	LocalNetworkedController *controller_1_p1 = peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	LocalNetworkedController *controller_1_p2 = peer_2_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	server_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	LocalNetworkedController *controller_2_p1 = peer_1_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	peer_2_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	controller_1_server->incremental_input = true;
+	controller_1_p1->incremental_input = true;
+	controller_1_p2->incremental_input = true;
+
+	std::vector<TSS_FloatSceneObject *> objects_server;
+	std::vector<TSS_FloatSceneObject *> objects_p1;
+	std::vector<TSS_FloatSceneObject *> objects_p2;
+	for (int i = 0; i < 10; i++) {
+		const std::string name = "obj_" + std::to_string(i);
+		objects_server.push_back(server_scene.add_object<TSS_FloatSceneObject>(name, server_scene.get_peer()));
+		objects_p1.push_back(peer_1_scene.add_object<TSS_FloatSceneObject>(name, server_scene.get_peer()));
+		objects_p2.push_back(peer_2_scene.add_object<TSS_FloatSceneObject>(name, server_scene.get_peer()));
+	}
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0f);
+	peer_1_scene.scene_sync->set_snapshot_decoding_async(p_snapshot_decoding_async);
+
+	std::vector<SnapshotDecodingFrame> frames;
+	for (int f = 0; f < 120; f++) {
+		if (f == 30) {
+			// This object is spawned on the client later, so the snapshots
+			// received meanwhile are stored and applied once it's registered.
+			objects_server.push_back(server_scene.add_object<TSS_FloatSceneObject>("late_obj", server_scene.get_peer()));
+		} else if (f == 50) {
+			objects_p1.push_back(peer_1_scene.add_object<TSS_FloatSceneObject>("late_obj", server_scene.get_peer()));
+			objects_p2.push_back(peer_2_scene.add_object<TSS_FloatSceneObject>("late_obj", server_scene.get_peer()));
+		}
+
+		for (std::size_t i = 0; i < objects_server.size(); i++) {
+			// Change a different set of objects each frame.
+			if ((f + int(i)) % 3 == 0) {
+				objects_server[i]->value += 1.5f;
+			}
+		}
+
+		server_scene.process(delta);
+		// The decoded snapshots are processed only once ready, so wait the
+		// worker to compare the same frames.
+		static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal())->snapshot_decoder_wait();
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+
+		SnapshotDecodingFrame &frame = frames.emplace_back();
+		frame.controller_position = controller_1_p1->position.data.f32;
+		frame.doll_position = controller_2_p1->position.data.f32;
+		frame.rewinded_frames_count = controller_1_p1->rewinded_frames.size();
+		for (const TSS_FloatSceneObject *obj : objects_p1) {
+			frame.values.push_back(obj->value);
+			frame.rewinded_frames_count += obj->rewinded_frames.size();
+		}
+	}
+
+	// The clients are in sync with the server.
+	for (std::size_t i = 0; i < objects_server.size(); i++) {
+		NS_ASSERT_COND(objects_server[i]->value == objects_p1[i]->value);
+		NS_ASSERT_COND(objects_server[i]->value == objects_p2[i]->value);
+	}
+
+	r_decoder_applied_objects_count = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal())->snapshot_decoder_applied_objects_count;
+	return frames;
+}
+
+/// Verify the snapshots decoded on the worker thread produce the same client
+/// state, frame by frame, as the snapshots decoded synchronously.
+void test_snapshot_decoding_async() {
+	std::uint64_t sync_applied_objects_count = 0;
+	std::uint64_t async_applied_objects_count = 0;
+	const std::vector<SnapshotDecodingFrame> sync_frames = fetch_client_frames(false, sync_applied_objects_count);
+	const std::vector<SnapshotDecodingFrame> async_frames = fetch_client_frames(true, async_applied_objects_count);
+
+	NS_ASSERT_COND(sync_applied_objects_count == 0);
+	NS_ASSERT_COND(async_applied_objects_count > 0);
+	NS_ASSERT_COND(sync_frames.size() == async_frames.size());
+	for (std::size_t i = 0; i < sync_frames.size(); i++) {
+		NS_ASSERT_COND_MSG(sync_frames[i] == async_frames[i], "The client state differs at frame: " + std::to_string(i));
+	}
+}
+
+struct AdaptiveNotifyTimespanResult {
+	float arena_average_staleness_frames = 0.0f;
+	std::size_t arena_received_bytes = 0;
+	std::size_t lobby_received_bytes = 0;
+	float arena_client_notify_timespan = 0.0f;
+	float lobby_client_notify_timespan = 0.0f;
+};
+
+/// Process a scene with a busy `arena` group, where an object changes each
+/// frame, and a quiet `lobby` group, where an object changes once per second,
+/// and measures the received bytes and the average state staleness.
+AdaptiveNotifyTimespanResult process_mixed_activity_scene(bool p_adaptive_notify_timespan) {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_2_scene.scene_sync =
+			peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	const NS::ObjectLocalId controller_1_id = server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer())->local_id;
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	const NS::ObjectLocalId controller_2_id = server_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer())->local_id;
+	peer_2_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+
+	TSS_FloatSceneObject *arena_obj_server = server_scene.add_object<TSS_FloatSceneObject>("arena_obj", server_scene.get_peer());
+	TSS_FloatSceneObject *arena_obj_peer_1 = peer_1_scene.add_object<TSS_FloatSceneObject>("arena_obj", server_scene.get_peer());
+
+	TSS_FloatSceneObject *lobby_obj_server = server_scene.add_object<TSS_FloatSceneObject>("lobby_obj", server_scene.get_peer());
+	peer_2_scene.add_object<TSS_FloatSceneObject>("lobby_obj", server_scene.get_peer());
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.25f);
+	peer_1_scene.scene_sync->set_frame_confirmation_timespan(0.25f);
+	peer_2_scene.scene_sync->set_frame_confirmation_timespan(0.25f);
+
+	const NS::SyncGroupId arena_group = server_scene.scene_sync->sync_group_create();
+	server_scene.scene_sync->sync_group_add_object(controller_1_id, arena_group, true);
+	server_scene.scene_sync->sync_group_add_object(arena_obj_server->local_id, arena_group, true);
+	server_scene.scene_sync->sync_group_move_peer_to(peer_1_scene.get_peer(), arena_group);
+
+	const NS::SyncGroupId lobby_group = server_scene.scene_sync->sync_group_create();
+	server_scene.scene_sync->sync_group_add_object(controller_2_id, lobby_group, true);
+	server_scene.scene_sync->sync_group_add_object(lobby_obj_server->local_id, lobby_group, true);
+	server_scene.scene_sync->sync_group_move_peer_to(peer_2_scene.get_peer(), lobby_group);
+
+	if (p_adaptive_notify_timespan) {
+		// The arena changes 120 times per second (the controller and the object)
+		// so it reaches the max rate, while the lobby changes about 60 times
+		// per second (only the controller) and it's also less important.
+		server_scene.scene_sync->sync_group_set_adaptive_notify_timespan(arena_group, true, 0.0f, 1.0f, 120.0f);
+		server_scene.scene_sync->sync_group_set_adaptive_notify_timespan(lobby_group, true, 0.0f, 1.0f, 120.0f);
+		server_scene.scene_sync->sync_group_set_importance(lobby_group, 0.5f);
+	}
+
+	// Process the scenes few times to ensure everything is up to dated.
+	for (int i = 0; i < 10; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+
+	AdaptiveNotifyTimespanResult result;
+	const std::size_t peer_1_received_bytes = peer_1_scene.get_network().received_bytes_count;
+	const std::size_t peer_2_received_bytes = peer_2_scene.get_network().received_bytes_count;
+
+	const int frames_count = 300;
+	float staleness_sum = 0.0f;
+	for (int f = 0; f < frames_count; f++) {
+		arena_obj_server->value += 1.0f;
+		if (f % 60 == 0) {
+			lobby_obj_server->value += 1.0f;
+		}
+
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+
+		staleness_sum += arena_obj_server->value - arena_obj_peer_1->value;
+	}
+
+	result.arena_average_staleness_frames = staleness_sum / float(frames_count);
+	result.arena_received_bytes = peer_1_scene.get_network().received_bytes_count - peer_1_received_bytes;
+	result.lobby_received_bytes = peer_2_scene.get_network().received_bytes_count - peer_2_received_bytes;
+	result.arena_client_notify_timespan = peer_1_scene.scene_sync->get_server_notify_timespan();
+	result.lobby_client_notify_timespan = peer_2_scene.scene_sync->get_server_notify_timespan();
+	return result;
+}
+
+void test_adaptive_notify_timespan() {
+	const AdaptiveNotifyTimespanResult fixed = process_mixed_activity_scene(false);
+	const AdaptiveNotifyTimespanResult adaptive = process_mixed_activity_scene(true);
+
+	// With the fixed timespan both the clients are informed about the frame
+	// confirmation timespan.
+	NS_ASSERT_COND(NS::MathFunc::is_equal_approx(fixed.arena_client_notify_timespan, 0.25f));
+	NS_ASSERT_COND(NS::MathFunc::is_equal_approx(fixed.lobby_client_notify_timespan, 0.25f));
+
+	// The busy arena is notified more often than the quiet lobby, and the
+	// clients received the timespan in use via snapshot.
+	NS_ASSERT_COND(adaptive.arena_client_notify_timespan < 0.1f);
+	NS_ASSERT_COND(adaptive.lobby_client_notify_timespan > 0.5f);
+
+	// The arena state is fresher, while the lobby uses less bandwidth.
+	NS_ASSERT_COND(adaptive.arena_average_staleness_frames < fixed.arena_average_staleness_frames);
+	NS_ASSERT_COND(adaptive.lobby_received_bytes < fixed.lobby_received_bytes);
+}
+
 void test_processing_with_late_controller_registration() {
 	// This test make sure that the peer receives the server updates ASAP, despite
 	// the `notify_interval` set.
@@ -1898,7 +2872,89 @@ void test_scheduled_procedure() {
 }
 
 void test_streaming() {
-	// TODO implement this.
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0);
+	// Small budget so the full snapshot is streamed across many frames.
+	server_scene.scene_sync->set_full_snapshot_streaming_budget_bytes(64);
+
+	const int objects_count = 12;
+	for (int i = 0; i < objects_count; i++) {
+		const std::string name = "obj_" + std::to_string(i);
+		server_scene.add_object<TSS_TestSceneObject>(name, server_scene.get_peer())->var_1.data.i32 = 100 + i;
+		peer_1_scene.add_object<TSS_TestSceneObject>(name, server_scene.get_peer())->var_1.data.i32 = 0;
+	}
+
+	int streaming_completed_count = 0;
+	std::unique_ptr<NS::EventProcessor<int>::Handler> streaming_completed_handle = server_scene.scene_sync->event_full_snapshot_streaming_completed.bind([&](int p_peer) {
+		NS_ASSERT_COND(p_peer == peer_1_scene.get_peer());
+		streaming_completed_count += 1;
+	});
+
+	auto count_synced_objects = [&]() -> int {
+		int synced = 0;
+		for (int i = 0; i < objects_count; i++) {
+			const std::string name = "obj_" + std::to_string(i);
+			TSS_TestSceneObject *obj = peer_1_scene.fetch_object<TSS_TestSceneObject>(name.c_str());
+			const NS::ObjectData *od = peer_1_scene.scene_sync->get_object_data(obj->local_id);
+			if (obj->var_1.data.i32 == 100 + i) {
+				synced += 1;
+			} else {
+				// The client simulates only the objects already received.
+				NS_ASSERT_COND(!od->realtime_sync_enabled_on_client);
+			}
+		}
+		return synced;
+	};
+
+	// Process until the client applies the first chunk.
+	int frames = 0;
+	int synced_after_first_chunk = 0;
+	for (; frames < 10 && synced_after_first_chunk == 0; frames++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		synced_after_first_chunk = count_synced_objects();
+	}
+
+	// Only part of the objects got delivered with the first chunk.
+	NS_ASSERT_COND(synced_after_first_chunk > 0);
+	NS_ASSERT_COND(synced_after_first_chunk < objects_count);
+	NS_ASSERT_COND(streaming_completed_count == 0);
+
+	for (; frames < 60 && streaming_completed_count == 0; frames++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	NS_ASSERT_COND(streaming_completed_count == 1);
+	NS_ASSERT_COND(frames > 3);
+
+	// Process few more frames so the client receives the last chunk.
+	for (int i = 0; i < 3; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	NS_ASSERT_COND(count_synced_objects() == objects_count);
+	NS_ASSERT_COND(streaming_completed_count == 1);
+
+	// The changes made during and after the streaming are delivered as usual.
+	server_scene.fetch_object<TSS_TestSceneObject>("obj_0")->var_1.data.i32 = 200;
+	for (int i = 0; i < 3; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	NS_ASSERT_COND(peer_1_scene.fetch_object<TSS_TestSceneObject>("obj_0")->var_1.data.i32 == 200);
 }
 
 void test_no_network() {
@@ -2004,6 +3060,167 @@ void test_sync_mode_reset() {
 	NS_ASSERT_COND(NS::MathFunc::is_equal_approx(controlled_obj_1_peer_1->position.data.f32, frame_count * delta * one_meter * 2.0f, delta * 2.0f));
 }
 
+/// Verify the interpolated objects follow the server snapshots smoothly,
+/// without being processed, compared or rewound by the client.
+void test_snapshot_interpolation() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	TSS_FloatSceneObject *predicted_obj_server = server_scene.add_object<TSS_FloatSceneObject>("predicted_obj", server_scene.get_peer());
+	TSS_FloatSceneObject *predicted_obj_p1 = peer_1_scene.add_object<TSS_FloatSceneObject>("predicted_obj", server_scene.get_peer());
+	TSS_FloatSceneObject *interpolated_obj_server = server_scene.add_object<TSS_FloatSceneObject>("interpolated_obj", server_scene.get_peer());
+	TSS_FloatSceneObject *interpolated_obj_p1 = peer_1_scene.add_object<TSS_FloatSceneObject>("interpolated_obj", server_scene.get_peer());
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0f);
+	peer_1_scene.scene_sync->set_object_interpolation_enabled(interpolated_obj_p1->local_id, true);
+	NS_ASSERT_COND(peer_1_scene.scene_sync->is_object_interpolation_enabled(interpolated_obj_p1->local_id));
+	NS_ASSERT_COND(!peer_1_scene.scene_sync->is_object_interpolation_enabled(predicted_obj_p1->local_id));
+
+	const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+
+	// The server moves the interpolated object each frame, while the
+	// predicted one doesn't change.
+	const auto process = [&]() {
+		interpolated_obj_server->value += 1.0f;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	};
+
+	for (int i = 0; i < 60; i++) {
+		process();
+	}
+
+	const int predicted_processed_frames_count = predicted_obj_p1->processed_frames_count;
+	float prev_value = interpolated_obj_p1->value;
+	std::uint64_t skipped_processes_count = 0;
+	for (int i = 0; i < 60; i++) {
+		process();
+
+		NS_ASSERT_COND(client_sync->last_interpolated_objects_count == 1);
+		skipped_processes_count += client_sync->last_interpolation_skipped_processes_count;
+
+		// The value moves forward smoothly, without jumps.
+		NS_ASSERT_COND(interpolated_obj_p1->value >= prev_value);
+		NS_ASSERT_COND(interpolated_obj_p1->value - prev_value <= 2.0f);
+		prev_value = interpolated_obj_p1->value;
+
+		// The value is rendered behind the server, by the interpolation delay.
+		NS_ASSERT_COND(interpolated_obj_p1->value < interpolated_obj_server->value);
+		NS_ASSERT_COND(interpolated_obj_server->value - interpolated_obj_p1->value <= 30.0f);
+	}
+
+	// The interpolated object is never processed on the client, while the
+	// predicted one is still processed.
+	NS_ASSERT_COND(interpolated_obj_p1->processed_frames_count == 0);
+	NS_ASSERT_COND(predicted_obj_p1->processed_frames_count > predicted_processed_frames_count);
+	NS_ASSERT_COND(skipped_processes_count > 0);
+
+	// The interpolated object never triggers a rewind.
+	NS_ASSERT_COND(interpolated_obj_p1->rewinded_frames.empty());
+	NS_ASSERT_COND(predicted_obj_p1->rewinded_frames.empty());
+
+	// The client doesn't store the interpolated object into its snapshots.
+	const NS::ObjectNetId interpolated_net_id = peer_1_scene.scene_sync->get_object_data(interpolated_obj_p1->local_id)->get_net_id();
+	const NS::ObjectNetId predicted_net_id = peer_1_scene.scene_sync->get_object_data(predicted_obj_p1->local_id)->get_net_id();
+	NS_ASSERT_COND(!client_sync->client_snapshots.empty());
+	const NS::Snapshot &client_snapshot = client_sync->client_snapshots.back();
+	NS_ASSERT_COND(interpolated_net_id.id >= client_snapshot.objects.size() || client_snapshot.objects[interpolated_net_id.id].vars.empty());
+	NS_ASSERT_COND(predicted_net_id.id < client_snapshot.objects.size() && !client_snapshot.objects[predicted_net_id.id].vars.empty());
+
+	// Once the server stops, the interpolated object reaches the server value.
+	for (int i = 0; i < 30; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	NS_ASSERT_COND(interpolated_obj_p1->value == interpolated_obj_server->value);
+	NS_ASSERT_COND(predicted_obj_p1->value == predicted_obj_server->value);
+
+	// Disabling the interpolation, the object is processed again.
+	peer_1_scene.scene_sync->set_object_interpolation_enabled(interpolated_obj_p1->local_id, false);
+	for (int i = 0; i < 10; i++) {
+		process();
+	}
+	NS_ASSERT_COND(interpolated_obj_p1->processed_frames_count > 0);
+	NS_ASSERT_COND(client_sync->last_interpolated_objects_count == 0);
+}
+
+/// Verify the interpolated object follows the path through all the received
+/// samples, when the interpolation delay spans several snapshots.
+void test_snapshot_interpolation_non_linear_motion() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	// Add the scene sync
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	TSS_FloatSceneObject *interpolated_obj_server = server_scene.add_object<TSS_FloatSceneObject>("interpolated_obj", server_scene.get_peer());
+	TSS_FloatSceneObject *interpolated_obj_p1 = peer_1_scene.add_object<TSS_FloatSceneObject>("interpolated_obj", server_scene.get_peer());
+
+	server_scene.scene_sync->set_frame_confirmation_timespan(0.0f);
+	peer_1_scene.scene_sync->set_object_interpolation_enabled(interpolated_obj_p1->local_id, true);
+	// The delay spans several snapshots, and the half frame puts the
+	// interpolation frame between two samples.
+	peer_1_scene.scene_sync->set_interpolation_delay(6.5f * delta);
+
+	const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+
+	// The server moves the object back and forth, turning every 8 frames.
+	std::map<std::uint32_t, float> server_values;
+	int frames_count = 0;
+	const auto process = [&]() {
+		interpolated_obj_server->value += ((frames_count / 8) % 2) == 0 ? 1.0f : -1.0f;
+		frames_count += 1;
+		server_scene.process(delta);
+		server_values[server_scene.scene_sync->get_global_frame_index().id] = interpolated_obj_server->value;
+		peer_1_scene.process(delta);
+	};
+
+	for (int i = 0; i < 60; i++) {
+		process();
+	}
+
+	int checked_frames_count = 0;
+	for (int i = 0; i < 60; i++) {
+		process();
+
+		NS_ASSERT_COND(client_sync->last_interpolated_objects_count == 1);
+
+		// The rendered value is the server one at the interpolation frame:
+		// the motion is linear between the samples.
+		const std::uint32_t frame = std::uint32_t(client_sync->interpolation_frame);
+		const float alpha = float(client_sync->interpolation_frame - double(frame));
+		const auto from_it = server_values.find(frame);
+		const auto to_it = server_values.find(frame + 1);
+		NS_ASSERT_COND(from_it != server_values.end());
+		NS_ASSERT_COND(to_it != server_values.end());
+		const float expected_value = from_it->second + ((to_it->second - from_it->second) * alpha);
+		NS_ASSERT_COND(NS::MathFunc::is_equal_approx(interpolated_obj_p1->value, expected_value, 0.01f));
+		checked_frames_count += 1;
+	}
+	NS_ASSERT_COND(checked_frames_count == 60);
+}
+
 class TestProcessingSceneObject : public NS::LocalSceneObject {
 public:
 	// NOTE, this property isn't sync.
@@ -2739,6 +3956,18 @@ void test_scene_synchronizer() {
 	test_state_notify();
 	test_net_id_reuse();
 	test_state_no_rewind_notify();
+	test_state_compare_policy();
+	test_state_compare_policy_every_n_frames();
+	test_lag_compensation_history();
+	test_bandwidth_stats();
+	test_client_snapshot_history();
+	test_client_snapshot_copy_on_write();
+	test_snapshot_compare_threads();
+	test_snapshot_parsing_reuses_memory();
+	test_snapshot_interpolation();
+	test_snapshot_interpolation_non_linear_motion();
+	test_snapshot_decoding_async();
+	test_adaptive_notify_timespan();
 	test_processing_with_late_controller_registration();
 	test_snapshot_generation();
 	test_state_notify_for_no_rewind_properties();
@@ -11,6 +11,7 @@
 #include "local_network.h"
 #include "local_scene.h"
 #include "test_math_lib.h"
+#include <map>
 #include <string>
 
 namespace NS_Test {
@@ -274,6 +275,8 @@ struct TestSimulationBase {
 	// The reason is that moving the magnet relative to all the moving controllers
 	// is very hard to sync and doesn't make sense to make the test much harder.
 	bool move_magnets = true;
+	/// When set, the magnets stop moving after this frame.
+	NS::FrameIndex move_magnets_until_frame = NS::FrameIndex::NONE;
 
 	TSLocalNetworkedController *controlled_obj_server = nullptr;
 	NS::PeerNetworkedController *controller_server = nullptr;
@@ -289,6 +292,8 @@ struct TestSimulationBase {
 
 	NS::FrameIndex process_until_frame = NS::FrameIndex{ { 300 } };
 	int process_until_frame_timeout = 20;
+	// The max distance allowed between the server and client positions.
+	float position_sync_tolerance = 0.0001f;
 
 	virtual void on_scenes_initialized() {
 	}
@@ -316,6 +321,11 @@ public:
 		return M + (rand() / (float(RAND_MAX) / (N - M)));
 	}
 
+	bool are_magnets_moving(const NS::PeerNetworkedController &p_controller) const {
+		return move_magnets &&
+				(move_magnets_until_frame == NS::FrameIndex::NONE || p_controller.get_current_frame_index() <= move_magnets_until_frame);
+	}
+
 	void do_test() {
 		// Create a server
 		server_scene.start_as_server();
@@ -344,10 +354,10 @@ public:
 
 		// Register the process
 		server_scene.scene_sync->register_process(controlled_obj_server->local_id, PROCESS_PHASE_POST, [=](float p_delta) -> void {
-			process_magnets_simulation(*server_scene.scene_sync, p_delta, move_magnets);
+			process_magnets_simulation(*server_scene.scene_sync, p_delta, are_magnets_moving(*controller_server));
 		});
 		peer_1_scene.scene_sync->register_process(controlled_obj_p1->local_id, PROCESS_PHASE_POST, [=](float p_delta) -> void {
-			process_magnets_simulation(*peer_1_scene.scene_sync, p_delta, move_magnets);
+			process_magnets_simulation(*peer_1_scene.scene_sync, p_delta, are_magnets_moving(*controller_p1));
 		});
 		server_scene.scene_sync->register_process(controlled_obj_server->local_id, PROCESS_PHASE_LATE, [=](float p_delta) -> void {
 			on_server_process(p_delta);
@@ -430,9 +440,9 @@ public:
 
 		// Now, make sure the client and server positions are the same: ensuring the
 		// sync worked.
-		NS_ASSERT_COND(controller_server_position_at_target_frame.distance_to(controller_p1_position_at_target_frame) < 0.0001);
-		NS_ASSERT_COND(light_mag_server_position_at_target_frame.distance_to(light_mag_p1_position_at_target_frame) < 0.0001);
-		NS_ASSERT_COND(heavy_mag_server_position_at_target_frame.distance_to(heavy_mag_p1_position_at_target_frame) < 0.0001);
+		NS_ASSERT_COND(controller_server_position_at_target_frame.distance_to(controller_p1_position_at_target_frame) < position_sync_tolerance);
+		NS_ASSERT_COND(light_mag_server_position_at_target_frame.distance_to(light_mag_p1_position_at_target_frame) < position_sync_tolerance);
+		NS_ASSERT_COND(heavy_mag_server_position_at_target_frame.distance_to(heavy_mag_p1_position_at_target_frame) < position_sync_tolerance);
 		NS_ASSERT_COND(global_frame_index_on_server == global_frame_index_on_p1);
 
 		on_scenes_done();
@@ -596,6 +606,159 @@ struct TestSimulationWithRewindAndPartialUpdate : public TestSimulationWithRewin
 	}
 };
 
+/// This test validates the time-sliced rewind.
+/// It desyncs the controller on the server while the client is predicting a
+/// lot of frames: when the client resimulates at most 2 frames per process,
+/// the rewind is spread across multiple frames and the final state must be
+/// the same of the non-sliced rewind.
+struct TestSimulationWithTimeSlicedRewind : public TestSimulationBase {
+	const int max_rewind_frames_per_process;
+	NS::LocalNetworkProps network_properties;
+	NS::FrameIndex add_latency_on_frame = NS::FrameIndex{ { 20 } };
+	NS::FrameIndex reset_position_on_frame = NS::FrameIndex{ { 100 } };
+
+	int rewinds_completed = 0;
+	int rewinds_completed_before_snapshot_release = 0;
+	int processes_with_pending_rewind = 0;
+	Vec3 controller_p1_position_at_target_frame;
+	Vec3 controller_p1_previous_position;
+	std::unique_ptr<NS::EventProcessor<>::Handler> event_rewind_completed_handle = nullptr;
+
+	TestSimulationWithTimeSlicedRewind(int p_max_rewind_frames_per_process) :
+		max_rewind_frames_per_process(p_max_rewind_frames_per_process) {
+	}
+
+	virtual void on_scenes_initialized() override {
+		server_scene.scene_sync->set_max_predicted_intervals(20);
+		peer_1_scene.scene_sync->set_max_rewind_frames_per_process(max_rewind_frames_per_process);
+
+		event_rewind_completed_handle =
+				peer_1_scene.scene_sync->event_rewind_completed.bind([this]() {
+					rewinds_completed += 1;
+					const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+					if (client_sync->last_received_server_snapshot) {
+						rewinds_completed_before_snapshot_release += 1;
+					}
+				});
+	}
+
+	virtual void on_server_process(float p_delta) override {
+		if (controller_server->get_current_frame_index() == add_latency_on_frame) {
+			// The latency makes the client predict more frames than the budget.
+			network_properties.rtt_seconds = 0.2f;
+			server_scene.get_network().network_properties = &network_properties;
+			peer_1_scene.get_network().network_properties = &network_properties;
+		}
+
+		if (controller_server->get_current_frame_index() == reset_position_on_frame) {
+			// Reset the character position only on the server, to simulate a desync.
+			controlled_obj_server->set_position(Vec3(0.0, 0.0, 0.0));
+		}
+	}
+
+	virtual void on_scenes_processed(float p_delta) override {
+		const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+		if (client_sync->rewind_pending) {
+			processes_with_pending_rewind += 1;
+			// While the rewind is pending, the scene keeps showing the latest
+			// completed state rather than the partially resimulated one.
+			NS_ASSERT_COND(controlled_obj_p1->get_position().distance_to(controller_p1_previous_position) <= 0.0);
+		}
+		controller_p1_previous_position = controlled_obj_p1->get_position();
+
+		if (controller_p1->get_current_frame_index() == process_until_frame) {
+			controller_p1_position_at_target_frame = controlled_obj_p1->get_position();
+		}
+	}
+
+	virtual void on_scenes_done() override {
+		NS_ASSERT_COND(rewinds_completed > 0);
+		if (max_rewind_frames_per_process > 0) {
+			NS_ASSERT_COND(peer_1_scene.scene_sync->get_max_rewind_frames_per_process() == max_rewind_frames_per_process);
+			// The rewind was spread across multiple frames.
+			NS_ASSERT_COND(processes_with_pending_rewind > 0);
+		} else {
+			NS_ASSERT_COND(processes_with_pending_rewind == 0);
+			// The rewind completes before the server snapshot is released.
+			NS_ASSERT_COND(rewinds_completed_before_snapshot_release == rewinds_completed);
+		}
+	}
+};
+
+void test_simulation_with_time_sliced_rewind() {
+	// Both the simulations use the same random deltas.
+	srand(1);
+	TestSimulationWithTimeSlicedRewind non_sliced(0);
+	non_sliced.do_test();
+
+	srand(1);
+	TestSimulationWithTimeSlicedRewind sliced(2);
+	sliced.do_test();
+
+	NS_ASSERT_COND(sliced.controller_p1_position_at_target_frame.distance_to(non_sliced.controller_p1_position_at_target_frame) < sliced.position_sync_tolerance);
+}
+
+/// This test validates the quantize on write feature.
+/// It networks the controller position at half precision, which alone makes
+/// the client rewind constantly since its unquantized simulation never
+/// matches the networked state. By quantizing the position after each frame
+/// on both the server and the client, the simulations are identical and the
+/// client never rewinds.
+struct TestSimulationWithQuantizeOnWrite : public TestSimulationBase {
+	const bool quantize_on_write;
+	int client_rewinds_count = 0;
+	std::unique_ptr<NS::EventProcessor<NS::FrameIndex, bool>::Handler> event_state_validated_handle = nullptr;
+
+public:
+	TestSimulationWithQuantizeOnWrite(bool p_quantize_on_write) :
+		quantize_on_write(p_quantize_on_write) {
+		if (!quantize_on_write) {
+			// Without quantization the client keeps the networked (half
+			// precision) position after each rewind, while the server doesn't.
+			position_sync_tolerance = 0.01f;
+		}
+	}
+
+	static void register_quantized_position(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id, bool p_quantize_on_write) {
+		p_scene_sync.register_variable(
+				p_id, "quantized_position",
+				[](NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, const NS::VarData &p_value) {
+					static_cast<TSLocalNetworkedController *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->position = Vec3(p_value.data.vec_f32.x, p_value.data.vec_f32.y, p_value.data.vec_f32.z);
+				},
+				[](const NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, NS::VarData &r_value) {
+					const Vec3 &position = static_cast<const TSLocalNetworkedController *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->position;
+					r_value.type = 4; // Lossy Vector3.
+					r_value.data.vec_f32.x = position.x;
+					r_value.data.vec_f32.y = position.y;
+					r_value.data.vec_f32.z = position.z;
+				});
+		p_scene_sync.set_quantize_on_write(p_id, "quantized_position", p_quantize_on_write);
+	}
+
+	virtual void on_scenes_initialized() override {
+		// Make sure the client can predict as many frames it needs (no need to add some more noise to this test).
+		server_scene.scene_sync->set_max_predicted_intervals(20);
+
+		register_quantized_position(*server_scene.scene_sync, controlled_obj_server->local_id, quantize_on_write);
+		register_quantized_position(*peer_1_scene.scene_sync, controlled_obj_p1->local_id, quantize_on_write);
+
+		event_state_validated_handle =
+				controller_p1->get_scene_synchronizer()->event_state_validated.bind([this](NS::FrameIndex p_frame_index, bool p_desync) {
+					if (p_desync) {
+						client_rewinds_count += 1;
+					}
+				});
+	}
+
+	virtual void on_scenes_done() override {
+		if (quantize_on_write) {
+			NS_ASSERT_COND(client_rewinds_count == 0);
+		} else {
+			NS_ASSERT_COND(client_rewinds_count > 0);
+		}
+	}
+};
+
 class ActorSceneObject : public NS::LocalSceneObject {
 public:
 	NS::ObjectLocalId local_id = NS::ObjectLocalId::NONE;
@@ -1077,6 +1240,295 @@ struct TestObjectSimulationWithPartialUpdateAndCustomDataAndDoll : public TestOb
 	}
 };
 
+class IslandSceneObject : public NS::LocalSceneObject {
+public:
+	NS::ObjectLocalId local_id = NS::ObjectLocalId::NONE;
+	float value = 0.0f;
+	/// The `value` change per second.
+	float speed = 0.0f;
+	/// Recovered without rewinding.
+	float no_rewind_value = 0.0f;
+	int processed_frames = 0;
+	int rewound_frames = 0;
+	/// The `value` processed on each global frame.
+	std::map<std::uint32_t, float> values_history;
+
+	IslandSceneObject() :
+		LocalSceneObject("IslandSceneObject") {
+	}
+
+	virtual void on_scene_entry() override {
+		get_scene()->scene_sync->register_app_object(get_scene()->scene_sync->to_handle(this));
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		local_id = p_id;
+		p_scene_sync.register_variable(
+				p_id, "value",
+				[](NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, const NS::VarData &p_value) {
+					static_cast<IslandSceneObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->value = p_value.data.f32;
+				},
+				[](const NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, NS::VarData &r_value) {
+					r_value.type = 1;
+					r_value.data.f32 = static_cast<const IslandSceneObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->value;
+				});
+		p_scene_sync.register_variable(
+				p_id, "no_rewind_value",
+				[](NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, const NS::VarData &p_value) {
+					static_cast<IslandSceneObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->no_rewind_value = p_value.data.f32;
+				},
+				[](const NS::SynchronizerManager &p_synchronizer_manager, NS::ObjectHandle p_handle, const std::string &p_var_name, NS::VarData &r_value) {
+					r_value.type = 1;
+					r_value.data.f32 = static_cast<const IslandSceneObject *>(NS::LocalSceneSynchronizer::from_handle(p_handle))->no_rewind_value;
+				});
+		p_scene_sync.set_skip_rewinding(p_id, "no_rewind_value", true);
+
+		p_scene_sync.register_process(
+				p_id,
+				PROCESS_PHASE_PROCESS,
+				[&p_scene_sync, this](float p_delta) {
+					value += speed * p_delta;
+					values_history[p_scene_sync.get_global_frame_index().id] = value;
+					processed_frames += 1;
+					if (p_scene_sync.is_rewinding()) {
+						rewound_frames += 1;
+					}
+				});
+	}
+};
+
+/// This test validates the selective rewind: when an object desyncs, only the
+/// objects of its interaction island are reset and resimulated while the
+/// other objects keep their predicted state, reaching the same state of the
+/// full rewind. When the island contains a controlled object, the whole scene
+/// is rewound instead.
+struct TestSimulationWithSelectiveRewind {
+	const bool selective_rewind;
+	const bool controlled_object_in_island;
+
+	NS::LocalScene server_scene;
+	NS::LocalScene peer_1_scene;
+
+	std::vector<IslandSceneObject *> objects_server;
+	std::vector<IslandSceneObject *> objects_p1;
+
+	int rewinds_count = 0;
+	std::vector<std::uint32_t> resimulated_objects_per_rewind;
+
+public:
+	TestSimulationWithSelectiveRewind(bool p_selective_rewind, bool p_controlled_object_in_island) :
+		selective_rewind(p_selective_rewind),
+		controlled_object_in_island(p_controlled_object_in_island) {
+	}
+
+	void process(int p_frames) {
+		for (int i = 0; i < p_frames; i++) {
+			server_scene.process(delta);
+			peer_1_scene.process(delta);
+		}
+	}
+
+	/// Returns the client objects values at the end of the test.
+	std::vector<float> do_test() {
+		server_scene.start_as_server();
+		peer_1_scene.start_as_client(server_scene);
+
+		server_scene.scene_sync =
+				server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+		peer_1_scene.scene_sync =
+				peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+		server_scene.add_object<TSLocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+		TSLocalNetworkedController *controller_p1 = peer_1_scene.add_object<TSLocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+		// 3 islands of 2 objects each, each object changing its state.
+		for (int i = 0; i < 6; i++) {
+			const std::string name = "obj_" + std::to_string(i);
+			objects_server.push_back(server_scene.add_object<IslandSceneObject>(name, server_scene.get_peer()));
+			objects_p1.push_back(peer_1_scene.add_object<IslandSceneObject>(name, server_scene.get_peer()));
+			objects_server.back()->speed = float(i + 1);
+			objects_p1.back()->speed = float(i + 1);
+			peer_1_scene.scene_sync->set_object_rewind_island(objects_p1.back()->local_id, NS::RewindIslandId{ { NS::RewindIslandId::IdType(i / 2) } });
+		}
+
+		if (controlled_object_in_island) {
+			peer_1_scene.scene_sync->set_object_rewind_island(controller_p1->local_id, NS::RewindIslandId{ { 1 } });
+		}
+
+		peer_1_scene.scene_sync->set_selective_rewind_enabled(selective_rewind);
+
+		const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+		float no_rewind_value_on_first_rewind = 0.0f;
+		auto rewind_completed_handler = peer_1_scene.scene_sync->event_rewind_completed.bind([this, client_sync, &no_rewind_value_on_first_rewind]() {
+			if (rewinds_count == 0) {
+				no_rewind_value_on_first_rewind = objects_p1[4]->no_rewind_value;
+			}
+			rewinds_count += 1;
+			resimulated_objects_per_rewind.push_back(client_sync->last_rewind_resimulated_objects_count);
+		});
+
+		process(100);
+		NS_ASSERT_COND(rewinds_count == 0);
+
+		// Desync the object 2, that is part of the island 1, and change the
+		// object 4, of the island 2, without triggering a rewind: both are
+		// detected by the same snapshot.
+		objects_server[2]->value += 10.0f;
+		objects_server[4]->no_rewind_value = 5.0f;
+
+		process(100);
+
+		NS_ASSERT_COND(rewinds_count > 0);
+		for (std::size_t i = 0; i < objects_server.size(); i++) {
+			// The client is ahead of the server, so compare the last frame
+			// processed by the server.
+			const auto &[last_server_frame, last_server_value] = *objects_server[i]->values_history.rbegin();
+			NS_ASSERT_COND(objects_p1[i]->values_history[last_server_frame] == last_server_value);
+			NS_ASSERT_COND(objects_server[i]->no_rewind_value == objects_p1[i]->no_rewind_value);
+		}
+		// The object not rewound was recovered by the rewind.
+		NS_ASSERT_COND(no_rewind_value_on_first_rewind == 5.0f);
+
+		std::vector<float> values;
+		for (IslandSceneObject *obj : objects_p1) {
+			values.push_back(obj->value);
+		}
+
+		if (selective_rewind && !controlled_object_in_island) {
+			// Only the island 1 was resimulated.
+			for (std::uint32_t resimulated_objects : resimulated_objects_per_rewind) {
+				NS_ASSERT_COND(resimulated_objects == 2);
+			}
+			for (std::size_t i = 0; i < objects_p1.size(); i++) {
+				if (i == 2 || i == 3) {
+					NS_ASSERT_COND(objects_p1[i]->rewound_frames > 0);
+				} else {
+					NS_ASSERT_COND(objects_p1[i]->rewound_frames == 0);
+				}
+			}
+		} else {
+			// The whole scene was resimulated.
+			for (std::uint32_t resimulated_objects : resimulated_objects_per_rewind) {
+				NS_ASSERT_COND(resimulated_objects == client_sync->get_active_objects().size());
+			}
+			for (IslandSceneObject *obj : objects_p1) {
+				NS_ASSERT_COND(obj->rewound_frames > 0);
+			}
+		}
+
+		return values;
+	}
+};
+
+/// This test validates the state hashing: the server networks the magnets
+/// state as hash, since these are predicted by the client. The client verifies
+/// it against its own prediction and, only when the magnet is desynchronized on
+/// the server, requests the values of the mismatched objects through
+/// `rpc_handler_notify_state_hash_mismatch`.
+struct TestSimulationWithStateHashing : public TestSimulationBase {
+	const bool desync;
+	NS::FrameIndex reset_position_on_frame = NS::FrameIndex{ { 100 } };
+
+	std::vector<NS::FrameIndex> client_rewinded_frames;
+	std::unique_ptr<NS::EventProcessor<NS::FrameIndex, bool>::Handler> event_state_validated_handle = nullptr;
+
+	TestSimulationWithStateHashing(bool p_desync) :
+		desync(p_desync) {
+	}
+
+	virtual void on_scenes_initialized() override {
+		server_scene.scene_sync->set_frame_confirmation_timespan(0.0f);
+		server_scene.scene_sync->set_max_predicted_intervals(20);
+		server_scene.scene_sync->set_snapshot_state_hashing_enabled(true);
+
+		event_state_validated_handle =
+				peer_1_scene.scene_sync->event_state_validated.bind([this](NS::FrameIndex p_frame_index, bool p_desync) {
+					if (p_desync) {
+						client_rewinded_frames.push_back(p_frame_index);
+					}
+				});
+	}
+
+	virtual void on_server_process(float p_delta) override {
+		if (desync && controller_server->get_current_frame_index() == reset_position_on_frame) {
+			// Reset the magnet position only on the server, to simulate a desync.
+			light_magnet_server->set_position(Vec3(0.0, 0.0, 0.0));
+		}
+	}
+
+	virtual void on_scenes_done() override {
+		NS_ASSERT_COND(server_scene.scene_sync->is_snapshot_state_hashing_enabled());
+
+		const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+		NS_ASSERT_COND(client_sync->state_hash_verified_objects_count > 0);
+
+		const NS::BandwidthReport group = server_scene.scene_sync->sync_group_get_bandwidth(NS::SyncGroupId::GLOBAL);
+		const NS::BandwidthReport light_magnet = server_scene.scene_sync->get_object_bandwidth(light_magnet_server->local_id);
+		const NS::BandwidthReport light_magnet_position = server_scene.scene_sync->get_variable_bandwidth(light_magnet_server->local_id, "position");
+		// The magnet is networked by the delta snapshots.
+		NS_ASSERT_COND(light_magnet.delta_snapshot_times_sent > 0);
+		// The full snapshot is never requested.
+		NS_ASSERT_COND(group.full_snapshot_times_sent == 1);
+
+		if (desync) {
+			// The mismatch requested the magnet values, which triggered the rewind.
+			NS_ASSERT_COND(client_sync->state_hash_mismatches_count > 0);
+			NS_ASSERT_COND(light_magnet_position.delta_snapshot_times_sent > 0);
+			NS_ASSERT_COND(client_rewinded_frames.size() > 0);
+			NS_ASSERT_COND(client_rewinded_frames[0] >= reset_position_on_frame);
+		} else {
+			// The magnet position is networked only by the full snapshot.
+			NS_ASSERT_COND(light_magnet_position.delta_snapshot_times_sent == 0);
+			NS_ASSERT_COND(light_magnet_position.times_sent == group.full_snapshot_times_sent);
+			NS_ASSERT_COND(client_sync->state_hash_mismatches_count == 0);
+			NS_ASSERT_COND(client_rewinded_frames.size() == 0);
+		}
+	}
+};
+
+/// This test validates that the objects verified by the state hash are stored
+/// even when an object before them, in the same snapshot, mismatches: the
+/// server doesn't network them again until they change.
+struct TestSimulationWithStateHashingPartialMismatch : public TestSimulationBase {
+	const NS::FrameIndex desync_frame = NS::FrameIndex{ { 100 } };
+
+	virtual void on_scenes_initialized() override {
+		server_scene.scene_sync->set_frame_confirmation_timespan(0.0f);
+		server_scene.scene_sync->set_max_predicted_intervals(20);
+		server_scene.scene_sync->set_snapshot_state_hashing_enabled(true);
+
+		// Both the magnets change on the desync frame, then they stay still:
+		// the snapshot of that frame hashes both.
+		move_magnets_until_frame = desync_frame;
+	}
+
+	virtual void on_server_process(float p_delta) override {
+		if (controller_server->get_current_frame_index() == desync_frame) {
+			// Desync only the light magnet, that comes first in the snapshot.
+			light_magnet_server->set_position(Vec3(0.0, 0.0, 0.0));
+		}
+	}
+
+	virtual void on_scenes_done() override {
+		const NS::ClientSynchronizer *client_sync = static_cast<NS::ClientSynchronizer *>(peer_1_scene.scene_sync->get_synchronizer_internal());
+		NS_ASSERT_COND(client_sync->state_hash_mismatches_count > 0);
+
+		const NS::ObjectData *light_magnet_od = peer_1_scene.scene_sync->get_object_data(light_magnet_p1->local_id);
+		const NS::ObjectData *heavy_magnet_od = peer_1_scene.scene_sync->get_object_data(heavy_magnet_p1->local_id);
+		NS_ASSERT_COND(light_magnet_od->get_net_id() < heavy_magnet_od->get_net_id());
+
+		// The received server state matches the server, despite the heavy
+		// magnet is never networked after the desync frame.
+		for (const auto &[od, magnet_server] : { std::make_pair(light_magnet_od, light_magnet_server), std::make_pair(heavy_magnet_od, heavy_magnet_server) }) {
+			const std::vector<std::optional<NS::VarData>> &vars = client_sync->last_received_snapshot.objects[od->get_net_id().id].vars;
+			const NS::VarId position_id = od->find_variable_id("position");
+			NS_ASSERT_COND(position_id.id < vars.size());
+			NS_ASSERT_COND(vars[position_id.id].has_value());
+			NS_ASSERT_COND(Vec3::from(vars[position_id.id].value()).distance_to(magnet_server->get_position()) <= 0.0001f);
+		}
+	}
+};
+
 void test_simulation() {
 	TestSimulationBase().do_test();
 	TestSimulationReRegistration().do_test();
@@ -1085,6 +1537,16 @@ void test_simulation() {
 	TestSimulationWithRewind(1.0f).do_test();
 	TestSimulationWithRewindAndPartialUpdate(0.0f).do_test();
 	TestSimulationWithRewindAndPartialUpdate(1.0f).do_test();
+	test_simulation_with_time_sliced_rewind();
+	TestSimulationWithQuantizeOnWrite(false).do_test();
+	TestSimulationWithQuantizeOnWrite(true).do_test();
+	const std::vector<float> full_rewind_values = TestSimulationWithSelectiveRewind(false, false).do_test();
+	const std::vector<float> selective_rewind_values = TestSimulationWithSelectiveRewind(true, false).do_test();
+	NS_ASSERT_COND(full_rewind_values == selective_rewind_values);
+	TestSimulationWithSelectiveRewind(true, true).do_test();
+	TestSimulationWithStateHashing(false).do_test();
+	TestSimulationWithStateHashing(true).do_test();
+	TestSimulationWithStateHashingPartialMismatch().do_test();
 	TestObjectSimulationWithPartialUpdate(false).do_test();
 	TestObjectSimulationWithPartialUpdate(true).do_test();
 	TestObjectSimulationWithPartialUpdateAndCustomData(false).do_test();